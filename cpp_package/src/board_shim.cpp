@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <memory>
 #include <sstream>
 #include <stdlib.h>
 #include <string.h>
@@ -106,11 +107,12 @@ BoardShim::BoardShim (int board_id, struct BrainFlowInputParams params)
     serialized_params = params_to_string (params);
     this->params = params;
     this->board_id = board_id;
+    session_handle = 0;
 }
 
 void BoardShim::prepare_session ()
 {
-    int res = ::prepare_session (board_id, serialized_params.c_str ());
+    int res = ::prepare_session_with_handle (board_id, serialized_params.c_str (), &session_handle);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         throw BrainFlowException ("failed to prepare session", res);
@@ -170,6 +172,7 @@ void BoardShim::stop_stream ()
 void BoardShim::release_session ()
 {
     int res = ::release_session (board_id, serialized_params.c_str ());
+    session_handle = 0;
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         throw BrainFlowException ("failed to release session", res);
@@ -179,7 +182,11 @@ void BoardShim::release_session ()
 int BoardShim::get_board_data_count (int preset)
 {
     int data_count = 0;
-    int res = ::get_board_data_count (preset, &data_count, board_id, serialized_params.c_str ());
+    int res = ::get_board_data_count_by_handle (preset, &data_count, session_handle);
+    if (res == (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR)
+    {
+        res = ::get_board_data_count (preset, &data_count, board_id, serialized_params.c_str ());
+    }
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         throw BrainFlowException ("failed to get board data count", res);
@@ -201,33 +208,84 @@ BrainFlowArray<double, 2> BoardShim::get_board_data (int num_datapoints, int pre
     }
     int num_samples = std::min (get_board_data_count (preset), num_datapoints);
     int num_data_channels = get_num_rows (get_board_id (), preset);
-    double *buf = new double[num_samples * num_data_channels];
-    int res = ::get_board_data (num_samples, preset, buf, board_id, serialized_params.c_str ());
+    // board writes channels as rows into this buffer, array adopts it without a copy
+    std::unique_ptr<double[]> buf (new double[num_samples * num_data_channels]);
+    int res = ::get_board_data_by_handle (num_samples, preset, buf.get (), session_handle);
+    if (res == (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR)
+    {
+        res = ::get_board_data (
+            num_samples, preset, buf.get (), board_id, serialized_params.c_str ());
+    }
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
-        delete[] buf;
         throw BrainFlowException ("failed to get board data", res);
     }
-    BrainFlowArray<double, 2> matrix (buf, num_data_channels, num_samples);
-    delete[] buf;
-    return matrix;
+    return BrainFlowArray<double, 2> (std::move (buf), num_data_channels, num_samples);
 }
 
 BrainFlowArray<double, 2> BoardShim::get_current_board_data (int num_samples, int preset)
 {
     int num_data_channels = BoardShim::get_num_rows (get_board_id (), preset);
-    double *buf = new double[num_samples * num_data_channels];
+    std::unique_ptr<double[]> buf (new double[num_samples * num_data_channels]);
+    int len = 0;
+    int res = ::get_current_board_data_by_handle (
+        num_samples, preset, buf.get (), &len, session_handle);
+    if (res == (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR)
+    {
+        res = ::get_current_board_data (
+            num_samples, preset, buf.get (), &len, board_id, serialized_params.c_str ());
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get board data", res);
+    }
+    return BrainFlowArray<double, 2> (std::move (buf), num_data_channels, len);
+}
+
+BrainFlowArray<double, 2> BoardShim::get_current_board_data (
+    int num_samples, std::vector<int> channels, int preset)
+{
+    int num_channels = (int)channels.size ();
+    std::unique_ptr<double[]> buf (new double[num_samples * num_channels]);
+    int len = 0;
+    int res = ::get_current_board_data_channels_by_handle (
+        num_samples, preset, channels.data (), num_channels, buf.get (), &len, session_handle);
+    if (res == (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR)
+    {
+        res = ::get_current_board_data_channels (num_samples, preset, channels.data (),
+            num_channels, buf.get (), &len, board_id, serialized_params.c_str ());
+    }
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get board data", res);
+    }
+    return BrainFlowArray<double, 2> (std::move (buf), num_channels, len);
+}
+
+BrainFlowArray<double, 2> BoardShim::get_board_data (
+    int num_datapoints, std::vector<int> channels, int preset)
+{
+    if (num_datapoints < 0)
+    {
+        throw BrainFlowException (
+            "invalid num_datapoints", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    int num_samples = std::min (get_board_data_count (preset), num_datapoints);
+    int num_channels = (int)channels.size ();
+    std::unique_ptr<double[]> buf (new double[num_samples * num_channels]);
     int len = 0;
-    int res = ::get_current_board_data (
-        num_samples, preset, buf, &len, board_id, serialized_params.c_str ());
+    int res = ::get_board_data_channels_by_handle (
+        num_samples, preset, channels.data (), num_channels, buf.get (), &len, session_handle);
+    if (res == (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR)
+    {
+        res = ::get_board_data_channels (num_samples, preset, channels.data (), num_channels,
+            buf.get (), &len, board_id, serialized_params.c_str ());
+    }
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
-        delete[] buf;
         throw BrainFlowException ("failed to get board data", res);
     }
-    BrainFlowArray<double, 2> matrix (buf, num_data_channels, len);
-    delete[] buf;
-    return matrix;
+    return BrainFlowArray<double, 2> (std::move (buf), num_channels, len);
 }
 
 std::string BoardShim::config_board (std::string config)
@@ -255,7 +313,11 @@ void BoardShim::config_board_with_bytes (const char *bytes, int len)
 
 void BoardShim::insert_marker (double value, int preset)
 {
-    int res = ::insert_marker (value, preset, board_id, serialized_params.c_str ());
+    int res = ::insert_marker_by_handle (value, preset, session_handle);
+    if (res == (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR)
+    {
+        res = ::insert_marker (value, preset, board_id, serialized_params.c_str ());
+    }
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         throw BrainFlowException ("failed to insert marker", res);
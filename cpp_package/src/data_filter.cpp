@@ -1,6 +1,7 @@
 #include <cstdarg>
 #include <stdlib.h>
 #include <string.h>
+#include <vector>
 
 #include "brainflow_constants.h"
 #include "data_filter.h"
@@ -75,6 +76,56 @@ void DataFilter::perform_bandstop (double *data, int data_len, int sampling_rate
     }
 }
 
+void DataFilter::perform_lowpass (BrainFlowArray<double, 2> &data, std::vector<int> channels,
+    int sampling_rate, double cutoff, int order, int filter_type, double ripple)
+{
+    int res = ::perform_lowpass_multichannel (data.get_raw_ptr (), data.get_size (0),
+        data.get_size (1), channels.data (), (int)channels.size (), sampling_rate, cutoff, order,
+        filter_type, ripple);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to filter signal", res);
+    }
+}
+
+void DataFilter::perform_highpass (BrainFlowArray<double, 2> &data, std::vector<int> channels,
+    int sampling_rate, double cutoff, int order, int filter_type, double ripple)
+{
+    int res = ::perform_highpass_multichannel (data.get_raw_ptr (), data.get_size (0),
+        data.get_size (1), channels.data (), (int)channels.size (), sampling_rate, cutoff, order,
+        filter_type, ripple);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to filter signal", res);
+    }
+}
+
+void DataFilter::perform_bandpass (BrainFlowArray<double, 2> &data, std::vector<int> channels,
+    int sampling_rate, double start_freq, double stop_freq, int order, int filter_type,
+    double ripple)
+{
+    int res = ::perform_bandpass_multichannel (data.get_raw_ptr (), data.get_size (0),
+        data.get_size (1), channels.data (), (int)channels.size (), sampling_rate, start_freq,
+        stop_freq, order, filter_type, ripple);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to filter signal", res);
+    }
+}
+
+void DataFilter::perform_bandstop (BrainFlowArray<double, 2> &data, std::vector<int> channels,
+    int sampling_rate, double start_freq, double stop_freq, int order, int filter_type,
+    double ripple)
+{
+    int res = ::perform_bandstop_multichannel (data.get_raw_ptr (), data.get_size (0),
+        data.get_size (1), channels.data (), (int)channels.size (), sampling_rate, start_freq,
+        stop_freq, order, filter_type, ripple);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to filter signal", res);
+    }
+}
+
 void DataFilter::remove_environmental_noise (
     double *data, int data_len, int sampling_rate, int noise_type)
 {
@@ -96,6 +147,52 @@ void DataFilter::restore_data_from_wavelet_detailed_coeffs (double *data, int da
     }
 }
 
+int DataFilter::create_streaming_filter (int filter_operation, int num_channels,
+    int sampling_rate, double start_freq, double stop_freq, int order, int filter_type,
+    double ripple)
+{
+    int filter_id = 0;
+    int res = ::create_streaming_filter (filter_operation, num_channels, sampling_rate, start_freq,
+        stop_freq, order, filter_type, ripple, &filter_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to create filter", res);
+    }
+    return filter_id;
+}
+
+void DataFilter::process_streaming_filter (int filter_id, double *data, int data_len)
+{
+    int res = ::process_streaming_filter (filter_id, data, data_len);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to filter signal", res);
+    }
+}
+
+void DataFilter::process_streaming_filter (int filter_id, BrainFlowArray<double, 2> &data)
+{
+    process_streaming_filter (filter_id, data.get_raw_ptr (), data.get_size (1));
+}
+
+void DataFilter::reset_streaming_filter (int filter_id)
+{
+    int res = ::reset_streaming_filter (filter_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to reset filter", res);
+    }
+}
+
+void DataFilter::release_streaming_filter (int filter_id)
+{
+    int res = ::release_streaming_filter (filter_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to release filter", res);
+    }
+}
+
 void DataFilter::detect_peaks_z_score (
     double *data, int data_len, int lag, double threshold, double influence, double *output)
 {
@@ -106,6 +203,53 @@ void DataFilter::detect_peaks_z_score (
     }
 }
 
+int DataFilter::create_peak_detector (int lag, double threshold, double influence, int num_channels)
+{
+    int detector_id = 0;
+    int res = ::create_peak_detector (lag, threshold, influence, num_channels, &detector_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to create detector", res);
+    }
+    return detector_id;
+}
+
+void DataFilter::process_peak_detector (int detector_id, double *data, int data_len, double *output)
+{
+    int res = ::process_peak_detector (detector_id, data, data_len, output);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to detect", res);
+    }
+}
+
+BrainFlowArray<double, 2> DataFilter::process_peak_detector (
+    int detector_id, const BrainFlowArray<double, 2> &data)
+{
+    BrainFlowArray<double, 2> output (data.get_size (0), data.get_size (1));
+    process_peak_detector (
+        detector_id, (double *)data.get_raw_ptr (), data.get_size (1), output.get_raw_ptr ());
+    return output;
+}
+
+void DataFilter::reset_peak_detector (int detector_id)
+{
+    int res = ::reset_peak_detector (detector_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to reset detector", res);
+    }
+}
+
+void DataFilter::release_peak_detector (int detector_id)
+{
+    int res = ::release_peak_detector (detector_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to release detector", res);
+    }
+}
+
 void DataFilter::perform_rolling_filter (double *data, int data_len, int period, int agg_operation)
 {
     int res = ::perform_rolling_filter (data, data_len, period, agg_operation);
@@ -115,6 +259,49 @@ void DataFilter::perform_rolling_filter (double *data, int data_len, int period,
     }
 }
 
+int DataFilter::create_rolling_filter (int period, int agg_operation, int num_channels)
+{
+    int filter_id = 0;
+    int res = ::create_rolling_filter (period, agg_operation, num_channels, &filter_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to create filter", res);
+    }
+    return filter_id;
+}
+
+void DataFilter::process_rolling_filter (int filter_id, double *data, int data_len)
+{
+    int res = ::process_rolling_filter (filter_id, data, data_len);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to filter signal", res);
+    }
+}
+
+void DataFilter::process_rolling_filter (int filter_id, BrainFlowArray<double, 2> &data)
+{
+    process_rolling_filter (filter_id, data.get_raw_ptr (), data.get_size (1));
+}
+
+void DataFilter::reset_rolling_filter (int filter_id)
+{
+    int res = ::reset_rolling_filter (filter_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to reset filter", res);
+    }
+}
+
+void DataFilter::release_rolling_filter (int filter_id)
+{
+    int res = ::release_rolling_filter (filter_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to release filter", res);
+    }
+}
+
 double *DataFilter::perform_downsampling (
     double *data, int data_len, int period, int agg_operation, int *filtered_size)
 {
@@ -134,6 +321,76 @@ double *DataFilter::perform_downsampling (
     return filtered_data;
 }
 
+double *DataFilter::perform_resampling (
+    double *data, int data_len, int input_rate, int output_rate, int *resampled_size)
+{
+    if ((data == NULL) || (data_len <= 0) || (input_rate <= 0) || (output_rate <= 0))
+    {
+        throw BrainFlowException (
+            "invalid input params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    double *resampled_data = new double[(long long)data_len * output_rate / input_rate + 1];
+    int res = ::perform_resampling (
+        data, data_len, input_rate, output_rate, resampled_data, resampled_size);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] resampled_data;
+        throw BrainFlowException ("failed to resample signal", res);
+    }
+    return resampled_data;
+}
+
+int DataFilter::create_resampler (int input_rate, int output_rate, int num_channels)
+{
+    int resampler_id = 0;
+    int res = ::create_resampler (input_rate, output_rate, num_channels, &resampler_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to create resampler", res);
+    }
+    return resampler_id;
+}
+
+BrainFlowArray<double, 2> DataFilter::process_resampler (
+    int resampler_id, const BrainFlowArray<double, 2> &data)
+{
+    int rows = data.get_size (0);
+    int cols = data.get_size (1);
+    int max_len = 0;
+    int res = ::get_resampler_output_len (resampler_id, cols, &max_len);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to resample signal", res);
+    }
+    std::vector<double> output ((size_t)rows * max_len);
+    int output_len = 0;
+    res = ::process_resampler (
+        resampler_id, (double *)data.get_raw_ptr (), cols, output.data (), &output_len);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to resample signal", res);
+    }
+    return BrainFlowArray<double, 2> (output.data (), rows, output_len);
+}
+
+void DataFilter::reset_resampler (int resampler_id)
+{
+    int res = ::reset_resampler (resampler_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to reset resampler", res);
+    }
+}
+
+void DataFilter::release_resampler (int resampler_id)
+{
+    int res = ::release_resampler (resampler_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to release resampler", res);
+    }
+}
+
 std::pair<double *, int *> DataFilter::perform_wavelet_transform (
     double *data, int data_len, int wavelet, int decomposition_level, int extension_type)
 {
@@ -189,6 +446,19 @@ void DataFilter::perform_wavelet_denoising (double *data, int data_len, int wave
     }
 }
 
+void DataFilter::perform_wavelet_denoising (BrainFlowArray<double, 2> &data,
+    std::vector<int> channels, int wavelet, int decomposition_level, int wavelet_denoising,
+    int threshold, int extenstion_type, int noise_level)
+{
+    int res = ::perform_wavelet_denoising_multichannel (data.get_raw_ptr (), data.get_size (0),
+        data.get_size (1), channels.data (), (int)channels.size (), wavelet, decomposition_level,
+        wavelet_denoising, threshold, extenstion_type, noise_level);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to perform wavelet denoising", res);
+    }
+}
+
 std::pair<BrainFlowArray<double, 2>, BrainFlowArray<double, 1>> DataFilter::get_csp (
     const BrainFlowArray<double, 3> &data, const BrainFlowArray<double, 1> &labels)
 {
@@ -365,6 +635,79 @@ std::pair<double *, double *> DataFilter::get_custom_band_powers (
     return std::make_pair (avg_bands, stddev_bands);
 }
 
+int DataFilter::create_band_power_engine (
+    int num_channels, int sampling_rate, int window_len, bool apply_filters)
+{
+    int engine_id = 0;
+    int res = ::create_band_power_engine (
+        num_channels, sampling_rate, window_len, (int)apply_filters, &engine_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to create band power engine", res);
+    }
+    return engine_id;
+}
+
+void DataFilter::update_band_power_engine (int engine_id, double *data, int data_len)
+{
+    int res = ::update_band_power_engine (engine_id, data, data_len);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to update band power engine", res);
+    }
+}
+
+void DataFilter::update_band_power_engine (int engine_id, const BrainFlowArray<double, 2> &data)
+{
+    update_band_power_engine (engine_id, (double *)data.get_raw_ptr (), data.get_size (1));
+}
+
+std::pair<double *, double *> DataFilter::get_band_power_engine_powers (
+    int engine_id, std::vector<std::pair<double, double>> bands)
+{
+    if (bands.empty ())
+    {
+        throw BrainFlowException (
+            "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    std::vector<double> start_freqs (bands.size ());
+    std::vector<double> stop_freqs (bands.size ());
+    for (int i = 0; i < (int)bands.size (); i++)
+    {
+        start_freqs[i] = std::get<0> (bands[i]);
+        stop_freqs[i] = std::get<1> (bands[i]);
+    }
+    double *avg_bands = new double[bands.size ()];
+    double *stddev_bands = new double[bands.size ()];
+    int res = ::get_band_power_engine_powers (engine_id, start_freqs.data (), stop_freqs.data (),
+        (int)bands.size (), avg_bands, stddev_bands);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] avg_bands;
+        delete[] stddev_bands;
+        throw BrainFlowException ("failed to get band powers", res);
+    }
+    return std::make_pair (avg_bands, stddev_bands);
+}
+
+void DataFilter::reset_band_power_engine (int engine_id)
+{
+    int res = ::reset_band_power_engine (engine_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to reset band power engine", res);
+    }
+}
+
+void DataFilter::release_band_power_engine (int engine_id)
+{
+    int res = ::release_band_power_engine (engine_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to release band power engine", res);
+    }
+}
+
 double DataFilter::get_band_power (
     std::pair<double *, double *> psd, int data_len, double freq_start, double freq_end)
 {
@@ -574,6 +917,70 @@ DataFilter::perform_ica (const BrainFlowArray<double, 2> &data, int num_componen
     return perform_ica (data, num_components, channels);
 }
 
+int DataFilter::create_ica_engine (int num_components, int max_it, double tol, int seed)
+{
+    int engine_id = 0;
+    int res = ::create_ica_engine (num_components, max_it, tol, seed, &engine_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to create ica engine", res);
+    }
+    return engine_id;
+}
+
+std::tuple<BrainFlowArray<double, 2>, BrainFlowArray<double, 2>, BrainFlowArray<double, 2>,
+    BrainFlowArray<double, 2>>
+DataFilter::process_ica_engine (int engine_id, const BrainFlowArray<double, 2> &data,
+    int num_components, std::vector<int> channels)
+{
+    if ((data.empty ()) || (channels.empty ()) || (num_components < 1))
+    {
+        throw BrainFlowException (
+            "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+
+    int cols = data.get_size (1);
+    int channels_len = (int)channels.size ();
+    BrainFlowArray<double, 2> selected_data (channels_len, cols);
+    for (int i = 0; i < channels_len; i++)
+    {
+        for (int j = 0; j < cols; j++)
+        {
+            selected_data.at (i, j) = data.at (channels[i], j);
+        }
+    }
+    BrainFlowArray<double, 2> w_mat (num_components, num_components);
+    BrainFlowArray<double, 2> k_mat (num_components, channels_len);
+    BrainFlowArray<double, 2> a_mat (channels_len, num_components);
+    BrainFlowArray<double, 2> s_mat (num_components, cols);
+    int res = ::process_ica_engine (engine_id, selected_data.get_raw_ptr (), channels_len, cols,
+        num_components, w_mat.get_raw_ptr (), k_mat.get_raw_ptr (), a_mat.get_raw_ptr (),
+        s_mat.get_raw_ptr ());
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to process ica engine", res);
+    }
+    return std::make_tuple (w_mat, k_mat, a_mat, s_mat);
+}
+
+void DataFilter::reset_ica_engine (int engine_id)
+{
+    int res = ::reset_ica_engine (engine_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to reset ica engine", res);
+    }
+}
+
+void DataFilter::release_ica_engine (int engine_id)
+{
+    int res = ::release_ica_engine (engine_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to release ica engine", res);
+    }
+}
+
 double DataFilter::get_railed_percentage (double *data, int data_len, int gain)
 {
     double output = 0;
@@ -21,6 +21,9 @@ class BoardShim
 {
     std::string serialized_params;
     struct BrainFlowInputParams params;
+    // handle of session prepared by this object, 0 if there is no such session, methods fall
+    // back to json params if session was released or prepared by another object
+    int session_handle;
 
 public:
     /// disable BrainFlow loggers
@@ -261,6 +264,21 @@ public:
     BrainFlowArray<double, 2> get_board_data (int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
     /// get required amount of datapoints or less and flush it from internal buffer
     BrainFlowArray<double, 2> get_board_data (int num_datapoints, int preset);
+    /**
+     * get latest collected data only for rows from channels, doesnt remove it from ringbuffer
+     * @param channels row indexes, e.g. eeg channels and timestamp channel
+     * @return array with one row per element of channels
+     */
+    BrainFlowArray<double, 2> get_current_board_data (int num_samples, std::vector<int> channels,
+        int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    /**
+     * get required amount of datapoints or less only for rows from channels, all rows of returned
+     * datapoints are flushed from internal buffer
+     * @param channels row indexes, e.g. eeg channels and timestamp channel
+     * @return array with one row per element of channels
+     */
+    BrainFlowArray<double, 2> get_board_data (int num_datapoints, std::vector<int> channels,
+        int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
     /// send string to a board, use it carefully and only if you understand what you are doing
     std::string config_board (std::string config);
     /// send raw bytes to a board, not implemented for majority of devices, not recommended to use
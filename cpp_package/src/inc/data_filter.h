@@ -40,14 +40,78 @@ public:
     /// perform bandstop filter in-place
     static void perform_bandstop (double *data, int data_len, int sampling_rate, double start_freq,
         double stop_freq, int order, int filter_type, double ripple);
+    /// perform low pass filter in-place for rows from channels, coefficients are designed once
+    static void perform_lowpass (BrainFlowArray<double, 2> &data, std::vector<int> channels,
+        int sampling_rate, double cutoff, int order, int filter_type, double ripple);
+    /// perform high pass filter in-place for rows from channels, coefficients are designed once
+    static void perform_highpass (BrainFlowArray<double, 2> &data, std::vector<int> channels,
+        int sampling_rate, double cutoff, int order, int filter_type, double ripple);
+    /// perform bandpass filter in-place for rows from channels, coefficients are designed once
+    static void perform_bandpass (BrainFlowArray<double, 2> &data, std::vector<int> channels,
+        int sampling_rate, double start_freq, double stop_freq, int order, int filter_type,
+        double ripple);
+    /// perform bandstop filter in-place for rows from channels, coefficients are designed once
+    static void perform_bandstop (BrainFlowArray<double, 2> &data, std::vector<int> channels,
+        int sampling_rate, double start_freq, double stop_freq, int order, int filter_type,
+        double ripple);
+    /**
+     * create filter which keeps state between calls, use it to filter data in chunks
+     * @param filter_operation use FilterOperations enum
+     * @param num_channels number of rows in data passed to process_streaming_filter
+     * @param start_freq cutoff for lowpass and highpass
+     * @param filter_type use FilterTypes enum, zero phase types are not supported
+     * @return filter id
+     */
+    static int create_streaming_filter (int filter_operation, int num_channels, int sampling_rate,
+        double start_freq, double stop_freq, int order, int filter_type, double ripple);
+    /// filter num_channels rows with data_len values each in-place
+    static void process_streaming_filter (int filter_id, double *data, int data_len);
+    /// filter all rows of 2d array in-place, number of rows should match num_channels
+    static void process_streaming_filter (int filter_id, BrainFlowArray<double, 2> &data);
+    /// reset filter state
+    static void reset_streaming_filter (int filter_id);
+    /// release filter
+    static void release_streaming_filter (int filter_id);
     /// apply notch filter to remove env noise
     static void remove_environmental_noise (
         double *data, int data_len, int sampling_rate, int noise_type);
     /// perform moving average or moving median filter in-place
     static void perform_rolling_filter (double *data, int data_len, int period, int agg_operation);
+    /**
+     * create moving average or moving median filter which keeps windows between calls
+     * @param agg_operation MEAN or MEDIAN from AggOperations enum
+     * @param num_channels number of rows in data passed to process_rolling_filter
+     * @return filter id
+     */
+    static int create_rolling_filter (int period, int agg_operation, int num_channels);
+    /// filter num_channels rows with data_len values each in-place
+    static void process_rolling_filter (int filter_id, double *data, int data_len);
+    /// filter all rows of 2d array in-place, number of rows should match num_channels
+    static void process_rolling_filter (int filter_id, BrainFlowArray<double, 2> &data);
+    /// reset filter state
+    static void reset_rolling_filter (int filter_id);
+    /// release filter
+    static void release_rolling_filter (int filter_id);
     /// perform data downsampling, it just aggregates several data points
     static double *perform_downsampling (
         double *data, int data_len, int period, int agg_operation, int *filtered_size);
+    /// resample data with polyphase FIR filter, rates are reduced and should be at most 1000 after
+    /// it, for decimation it applies anti-aliasing filter, output delay is compensated
+    static double *perform_resampling (
+        double *data, int data_len, int input_rate, int output_rate, int *resampled_size);
+    /**
+     * create resampler which keeps history between calls, use it to resample data in chunks
+     * @param num_channels number of rows in data passed to process_resampler
+     * @return resampler id
+     */
+    static int create_resampler (int input_rate, int output_rate, int num_channels);
+    /// resample all rows of 2d array, output is delayed by filter group delay
+    static BrainFlowArray<double, 2> process_resampler (
+        int resampler_id, const BrainFlowArray<double, 2> &data);
+    /// reset resampler state
+    static void reset_resampler (int resampler_id);
+    /// release resampler
+    static void release_resampler (int resampler_id);
     // clang-format off
     /**
      * perform wavelet transform
@@ -85,12 +149,35 @@ public:
         int threshold = (int)ThresholdTypes::HARD,
         int extenstion_type = (int)WaveletExtensionTypes::SYMMETRIC,
         int noise_level = (int)NoiseEstimationLevelTypes::FIRST_LEVEL);
+    /// perform wavelet denoising in-place for rows from channels in parallel
+    static void perform_wavelet_denoising (BrainFlowArray<double, 2> &data,
+        std::vector<int> channels, int wavelet, int decomposition_level,
+        int wavelet_denoising = (int)WaveletDenoisingTypes::SURESHRINK,
+        int threshold = (int)ThresholdTypes::HARD,
+        int extenstion_type = (int)WaveletExtensionTypes::SYMMETRIC,
+        int noise_level = (int)NoiseEstimationLevelTypes::FIRST_LEVEL);
     /// restore data from selected detailed coeffs
     static void restore_data_from_wavelet_detailed_coeffs (double *data, int data_len, int wavelet,
         int decomposition_level, int level_to_restore, double *output);
     /// z score peak detection, more info https://stackoverflow.com/a/22640362
     static void detect_peaks_z_score (
         double *data, int data_len, int lag, double threshold, double influence, double *output);
+    /**
+     * create z score peak detector which keeps state between calls, use it to detect peaks in
+     * chunks
+     * @param num_channels number of rows in data passed to process_peak_detector
+     * @return detector id
+     */
+    static int create_peak_detector (int lag, double threshold, double influence, int num_channels);
+    /// detect peaks in num_channels rows with data_len values each, output can be the same as data
+    static void process_peak_detector (int detector_id, double *data, int data_len, double *output);
+    /// detect peaks in all rows of 2d array, number of rows should match num_channels
+    static BrainFlowArray<double, 2> process_peak_detector (
+        int detector_id, const BrainFlowArray<double, 2> &data);
+    /// reset detector state
+    static void reset_peak_detector (int detector_id);
+    /// release detector
+    static void release_peak_detector (int detector_id);
     // clang-format off
     /**
     * calculate filters and the corresponding eigenvalues using the Common Spatial Patterns
@@ -184,6 +271,26 @@ public:
     static std::pair<double *, double *> get_custom_band_powers (
         const BrainFlowArray<double, 2> &data, std::vector<std::pair<double, double>> bands,
         std::vector<int> channels, int sampling_rate, bool apply_filters);
+    /**
+     * create engine which updates band powers over sliding window with new samples
+     * @param num_channels number of rows in data passed to update_band_power_engine
+     * @param window_len number of datapoints in the window
+     * @param apply_filters set to true to apply causal versions of get_custom_band_powers filters
+     * @return engine id
+     */
+    static int create_band_power_engine (
+        int num_channels, int sampling_rate, int window_len, bool apply_filters);
+    /// add num_channels rows with data_len new datapoints each
+    static void update_band_power_engine (int engine_id, double *data, int data_len);
+    /// add new datapoints from all rows of 2d array, number of rows should match num_channels
+    static void update_band_power_engine (int engine_id, const BrainFlowArray<double, 2> &data);
+    /// band powers for the current window in the same format as get_custom_band_powers
+    static std::pair<double *, double *> get_band_power_engine_powers (
+        int engine_id, std::vector<std::pair<double, double>> bands);
+    /// reset engine state
+    static void reset_band_power_engine (int engine_id);
+    /// release engine
+    static void release_band_power_engine (int engine_id);
     /**
      * calculate oxygen level
      * @param ppg_ir input 1d array
@@ -235,6 +342,33 @@ public:
     static std::tuple<BrainFlowArray<double, 2>, BrainFlowArray<double, 2>,
         BrainFlowArray<double, 2>, BrainFlowArray<double, 2>>
     perform_ica (const BrainFlowArray<double, 2> &data, int num_components);
+    /**
+     * create ica engine, it starts from the previous unmixing matrix and converges faster for
+     * sliding windows
+     * @param num_components number of components to find
+     * @param max_it max number of iterations
+     * @param tol tolerance to stop iterations
+     * @param seed seed for initial random matrix, random device is used if it's less than 0
+     * @return engine id
+     */
+    static int create_ica_engine (
+        int num_components, int max_it = 300, double tol = 0.0001, int seed = -1);
+    /**
+     * calculate ICA using engine
+     * @param engine_id engine id
+     * @param data input 2d array, rows are samples
+     * @param num_components should be the same as in create_ica_engine
+     * @param channels rows to use
+     * @return unmixed signal
+     */
+    static std::tuple<BrainFlowArray<double, 2>, BrainFlowArray<double, 2>,
+        BrainFlowArray<double, 2>, BrainFlowArray<double, 2>>
+    process_ica_engine (int engine_id, const BrainFlowArray<double, 2> &data, int num_components,
+        std::vector<int> channels);
+    /// drop previous solution of ica engine
+    static void reset_ica_engine (int engine_id);
+    /// release ica engine
+    static void release_ica_engine (int engine_id);
 
 
     /// get brainflow version
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "shared_export.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    // signal processing methods
+    // ripple param is used only for chebyshev filter
+    SHARED_EXPORT int CALLING_CONVENTION perform_lowpass (double *data, int data_len,
+        int sampling_rate, double cutoff, int order, int filter_type, double ripple);
+    SHARED_EXPORT int CALLING_CONVENTION perform_highpass (double *data, int data_len,
+        int sampling_rate, double cutoff, int order, int filter_type, double ripple);
+    SHARED_EXPORT int CALLING_CONVENTION perform_bandpass (double *data, int data_len,
+        int sampling_rate, double start_freq, double stop_freq, int order, int filter_type,
+        double ripple);
+    SHARED_EXPORT int CALLING_CONVENTION perform_bandstop (double *data, int data_len,
+        int sampling_rate, double start_freq, double stop_width, int order, int filter_type,
+        double ripple);
+    // filter rows from channels of row-major data in-place, coefficients are designed once for all
+    // channels
+    SHARED_EXPORT int CALLING_CONVENTION perform_lowpass_multichannel (double *data, int rows,
+        int cols, int *channels, int num_channels, int sampling_rate, double cutoff, int order,
+        int filter_type, double ripple);
+    SHARED_EXPORT int CALLING_CONVENTION perform_highpass_multichannel (double *data, int rows,
+        int cols, int *channels, int num_channels, int sampling_rate, double cutoff, int order,
+        int filter_type, double ripple);
+    SHARED_EXPORT int CALLING_CONVENTION perform_bandpass_multichannel (double *data, int rows,
+        int cols, int *channels, int num_channels, int sampling_rate, double start_freq,
+        double stop_freq, int order, int filter_type, double ripple);
+    SHARED_EXPORT int CALLING_CONVENTION perform_bandstop_multichannel (double *data, int rows,
+        int cols, int *channels, int num_channels, int sampling_rate, double start_freq,
+        double stop_freq, int order, int filter_type, double ripple);
+    // streaming filters keep state between calls, filter_operation is from FilterOperations, for
+    // lowpass and highpass start_freq is a cutoff, zero phase filter types are not supported
+    SHARED_EXPORT int CALLING_CONVENTION create_streaming_filter (int filter_operation,
+        int num_channels, int sampling_rate, double start_freq, double stop_freq, int order,
+        int filter_type, double ripple, int *filter_id);
+    // data contains num_channels rows with data_len values each
+    SHARED_EXPORT int CALLING_CONVENTION process_streaming_filter (
+        int filter_id, double *data, int data_len);
+    SHARED_EXPORT int CALLING_CONVENTION reset_streaming_filter (int filter_id);
+    SHARED_EXPORT int CALLING_CONVENTION release_streaming_filter (int filter_id);
+    SHARED_EXPORT int CALLING_CONVENTION remove_environmental_noise (
+        double *data, int data_len, int sampling_rate, int noise_type);
+    SHARED_EXPORT int CALLING_CONVENTION perform_rolling_filter (
+        double *data, int data_len, int period, int agg_operation);
+    // rolling filters keep windows between calls, agg_operation is MEAN or MEDIAN from
+    // AggOperations, data contains num_channels rows with data_len values each
+    SHARED_EXPORT int CALLING_CONVENTION create_rolling_filter (
+        int period, int agg_operation, int num_channels, int *filter_id);
+    SHARED_EXPORT int CALLING_CONVENTION process_rolling_filter (
+        int filter_id, double *data, int data_len);
+    SHARED_EXPORT int CALLING_CONVENTION reset_rolling_filter (int filter_id);
+    SHARED_EXPORT int CALLING_CONVENTION release_rolling_filter (int filter_id);
+    SHARED_EXPORT int CALLING_CONVENTION perform_downsampling (
+        double *data, int data_len, int period, int agg_operation, double *output_data);
+    // polyphase FIR resampling with anti-aliasing, output_rate / input_rate is reduced and both
+    // factors must be at most 1000, output_data should hold
+    // data_len * output_rate / input_rate + 1 values
+    SHARED_EXPORT int CALLING_CONVENTION perform_resampling (double *data, int data_len,
+        int input_rate, int output_rate, double *output_data, int *output_len);
+    // resamplers keep history between calls, output is delayed by filter group delay,
+    // data contains num_channels rows with data_len values each, output_data contains
+    // num_channels rows with output_len values each and should hold
+    // num_channels * (data_len * output_rate / input_rate + 1) values
+    SHARED_EXPORT int CALLING_CONVENTION create_resampler (
+        int input_rate, int output_rate, int num_channels, int *resampler_id);
+    SHARED_EXPORT int CALLING_CONVENTION process_resampler (
+        int resampler_id, double *data, int data_len, double *output_data, int *output_len);
+    // max number of values per channel in output of process_resampler for data_len values
+    SHARED_EXPORT int CALLING_CONVENTION get_resampler_output_len (
+        int resampler_id, int data_len, int *output_len);
+    SHARED_EXPORT int CALLING_CONVENTION reset_resampler (int resampler_id);
+    SHARED_EXPORT int CALLING_CONVENTION release_resampler (int resampler_id);
+    SHARED_EXPORT int CALLING_CONVENTION perform_wavelet_transform (double *data, int data_len,
+        int wavelet, int decomposition_level, int extension, double *output_data,
+        int *decomposition_lengths);
+    SHARED_EXPORT int CALLING_CONVENTION perform_inverse_wavelet_transform (double *wavelet_coeffs,
+        int original_data_len, int wavelet, int decomposition_level, int extension,
+        int *decomposition_lengths, double *output_data);
+    SHARED_EXPORT int CALLING_CONVENTION perform_wavelet_denoising (double *data, int data_len,
+        int wavelet, int decomposition_level, int wavelet_denoising, int threshold,
+        int extenstion_type, int noise_level);
+    // denoise rows from channels of row-major data in-place, channels are processed in parallel
+    // if OpenMP is enabled
+    SHARED_EXPORT int CALLING_CONVENTION perform_wavelet_denoising_multichannel (double *data,
+        int rows, int cols, int *channels, int num_channels, int wavelet, int decomposition_level,
+        int wavelet_denoising, int threshold, int extenstion_type, int noise_level);
+    SHARED_EXPORT int CALLING_CONVENTION get_csp (const double *data, const double *labels,
+        int n_epochs, int n_channels, int n_times, double *output_w, double *output_d);
+    SHARED_EXPORT int CALLING_CONVENTION get_window (
+        int window_function, int window_len, double *output_window);
+    SHARED_EXPORT int CALLING_CONVENTION perform_fft (
+        double *data, int data_len, int window_function, double *output_re, double *output_im);
+    SHARED_EXPORT int CALLING_CONVENTION perform_ifft (
+        double *input_re, double *input_im, int data_len, double *restored_data);
+    SHARED_EXPORT int CALLING_CONVENTION get_nearest_power_of_two (int value, int *output);
+    SHARED_EXPORT int CALLING_CONVENTION get_psd (double *data, int data_len, int sampling_rate,
+        int window_function, double *output_ampl, double *output_freq);
+    SHARED_EXPORT int CALLING_CONVENTION detrend (
+        double *data, int data_len, int detrend_operation);
+    SHARED_EXPORT int CALLING_CONVENTION calc_stddev (
+        double *data, int start_pos, int end_pos, double *output);
+    SHARED_EXPORT int CALLING_CONVENTION get_psd_welch (double *data, int data_len, int nfft,
+        int overlap, int sampling_rate, int window_function, double *output_ampl,
+        double *output_freq);
+    SHARED_EXPORT int CALLING_CONVENTION get_band_power (double *ampl, double *freq, int data_len,
+        double freq_start, double freq_end, double *band_power);
+    SHARED_EXPORT int CALLING_CONVENTION get_custom_band_powers (double *raw_data, int rows,
+        int cols, double *start_freqs, double *stop_freqs, int num_bands, int sampling_rate,
+        int apply_filters, double *avg_band_powers, double *stddev_band_powers);
+    // band powers over sliding window updated with new samples, apply_filters uses causal
+    // versions of get_custom_band_powers filters, output has the same layout
+    SHARED_EXPORT int CALLING_CONVENTION create_band_power_engine (
+        int num_channels, int sampling_rate, int window_len, int apply_filters, int *engine_id);
+    // data contains num_channels rows with data_len values each
+    SHARED_EXPORT int CALLING_CONVENTION update_band_power_engine (
+        int engine_id, double *data, int data_len);
+    SHARED_EXPORT int CALLING_CONVENTION get_band_power_engine_powers (int engine_id,
+        double *start_freqs, double *stop_freqs, int num_bands, double *avg_band_powers,
+        double *stddev_band_powers);
+    SHARED_EXPORT int CALLING_CONVENTION reset_band_power_engine (int engine_id);
+    SHARED_EXPORT int CALLING_CONVENTION release_band_power_engine (int engine_id);
+    SHARED_EXPORT int CALLING_CONVENTION get_railed_percentage (
+        double *raw_data, int data_len, int gain, double *output);
+    SHARED_EXPORT int CALLING_CONVENTION get_oxygen_level (double *ppg_ir, double *ppg_red,
+        int data_size, int sampling_rate, double callib_coef1, double callib_coef2,
+        double callib_coef3, double *oxygen_level);
+    SHARED_EXPORT int CALLING_CONVENTION get_heart_rate (double *ppg_ir, double *ppg_red,
+        int data_size, int sampling_rate, int fft_size, double *rate);
+    SHARED_EXPORT int CALLING_CONVENTION restore_data_from_wavelet_detailed_coeffs (double *data,
+        int data_len, int wavelet, int decomposition_level, int level_to_restore, double *output);
+    SHARED_EXPORT int CALLING_CONVENTION detect_peaks_z_score (
+        double *data, int data_len, int lag, double threshold, double influence, double *output);
+    // peak detectors keep state between calls, output is the same as from detect_peaks_z_score for
+    // the whole signal, data and output contain num_channels rows with data_len values each
+    SHARED_EXPORT int CALLING_CONVENTION create_peak_detector (
+        int lag, double threshold, double influence, int num_channels, int *detector_id);
+    SHARED_EXPORT int CALLING_CONVENTION process_peak_detector (
+        int detector_id, double *data, int data_len, double *output);
+    SHARED_EXPORT int CALLING_CONVENTION reset_peak_detector (int detector_id);
+    SHARED_EXPORT int CALLING_CONVENTION release_peak_detector (int detector_id);
+    SHARED_EXPORT int CALLING_CONVENTION perform_ica (double *data, int rows, int cols,
+        int num_components, double *w_mat, double *k_mat, double *a_mat, double *s_mat);
+    // ica engine keeps buffers between calls and starts from the previous unmixing matrix if number
+    // of rows is the same, it's faster for sliding windows, seed < 0 means random seed
+    SHARED_EXPORT int CALLING_CONVENTION create_ica_engine (
+        int num_components, int max_it, double tol, int seed, int *engine_id);
+    SHARED_EXPORT int CALLING_CONVENTION process_ica_engine (int engine_id, double *data, int rows,
+        int cols, int num_components, double *w_mat, double *k_mat, double *a_mat, double *s_mat);
+    SHARED_EXPORT int CALLING_CONVENTION reset_ica_engine (int engine_id);
+    SHARED_EXPORT int CALLING_CONVENTION release_ica_engine (int engine_id);
+
+    // logging methods
+    SHARED_EXPORT int CALLING_CONVENTION set_log_level_data_handler (int log_level);
+    SHARED_EXPORT int CALLING_CONVENTION set_log_file_data_handler (const char *log_file);
+    SHARED_EXPORT int CALLING_CONVENTION log_message_data_handler (int log_level, char *message);
+
+    // file operations
+    SHARED_EXPORT int CALLING_CONVENTION write_file (const double *data, int num_rows, int num_cols,
+        const char *file_name, const char *file_mode);
+    SHARED_EXPORT int CALLING_CONVENTION read_file (
+        double *data, int *num_rows, int *num_cols, const char *file_name, int num_elements);
+    SHARED_EXPORT int CALLING_CONVENTION get_num_elements_in_file (
+        const char *file_name, int *num_elements); // its an internal method for bindings its not
+                                                   // available via high level api
+
+    // platform types and methods
+    SHARED_EXPORT int CALLING_CONVENTION get_version_data_handler (
+        char *version, int *num_chars, int max_chars);
+#ifdef __cplusplus
+}
+#endif
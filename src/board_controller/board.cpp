@@ -1,9 +1,14 @@
 #include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <string.h>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "board.h"
 #include "board_controller.h"
+#include "brainflow_env_vars.h"
 #include "custom_cast.h"
 #include "file_streamer.h"
 #include "multicast_streamer.h"
@@ -73,7 +78,7 @@ int Board::set_log_file (const char *log_file)
 
 int Board::prepare_for_acquisition (int buffer_size, const char *streamer_params)
 {
-    if (buffer_size <= 0 || buffer_size > MAX_CAPTURE_SAMPLES)
+    if (buffer_size <= 0 || buffer_size > MAX_COMPACT_CAPTURE_SAMPLES)
     {
         safe_logger (spdlog::level::err, "invalid array size");
         return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
@@ -91,6 +96,7 @@ int Board::prepare_for_acquisition (int buffer_size, const char *streamer_params
         it->second.clear ();
         marker_queues.erase (it);
     }
+    preset_layouts.clear ();
     int res = (int)BrainFlowExitCodes::STATUS_OK;
 
     std::vector<std::string> required_fields {
@@ -118,6 +124,51 @@ int Board::prepare_for_acquisition (int buffer_size, const char *streamer_params
         }
     }
 
+    for (auto &el : board_descr.items ())
+    {
+        struct PresetLayout layout;
+        if (build_preset_layout (el.value (), layout) != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            safe_logger (spdlog::level::err, "invalid description of preset {} for id {}",
+                el.key (), board_id);
+            preset_layouts.clear ();
+            return (int)BrainFlowExitCodes::GENERAL_ERROR;
+        }
+        preset_layouts[preset_to_int (el.key ())] = layout;
+    }
+
+    DataBufferTypes buffer_type = DataBufferTypes::SPINLOCK;
+    std::string buffer_type_str = get_brainflow_buffer_type ();
+    if (!BaseDataBuffer::type_from_string (buffer_type_str, buffer_type))
+    {
+        safe_logger (spdlog::level::err, "unsupported buffer type {}", buffer_type_str);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    safe_logger (spdlog::level::trace, "buffer type: {}", buffer_type_str);
+
+    std::map<int, DataBufferPrecision> precisions;
+    for (auto &el : preset_layouts)
+    {
+        DataBufferPrecision precision = DataBufferPrecision::FLOAT64;
+        int precision_res = get_buffer_precision (el.first, precision);
+        if (precision_res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            return precision_res;
+        }
+        if ((precision != DataBufferPrecision::FLOAT64) &&
+            (buffer_type != DataBufferTypes::CHANNEL_MAJOR))
+        {
+            safe_logger (spdlog::level::err, "only channel_major buffer supports float32");
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        if ((precision == DataBufferPrecision::FLOAT64) && (buffer_size > MAX_CAPTURE_SAMPLES))
+        {
+            safe_logger (spdlog::level::err, "invalid array size");
+            return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+        }
+        precisions[el.first] = precision;
+    }
+
     if ((streamer_params != NULL) && (streamer_params[0] != '\0'))
     {
         res = add_streamer (streamer_params, (int)BrainFlowPresets::DEFAULT_PRESET);
@@ -125,11 +176,14 @@ int Board::prepare_for_acquisition (int buffer_size, const char *streamer_params
 
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
-        for (auto &el : board_descr.items ())
+        for (auto &el : preset_layouts)
         {
-            json board_preset = el.value ();
-            DataBuffer *db = new DataBuffer ((int)board_preset["num_rows"], buffer_size);
-            if (!db->is_ready ())
+            // timestamps and markers don't fit into float precision
+            std::vector<int> full_precision_rows {
+                el.second.timestamp_channel, el.second.marker_channel};
+            BaseDataBuffer *db = BaseDataBuffer::create (el.second.num_rows, (size_t)buffer_size,
+                buffer_type, precisions[el.first], full_precision_rows);
+            if ((db == NULL) || (!db->is_ready ()))
             {
                 safe_logger (
                     spdlog::level::err, "unable to prepare buffer with size {}", buffer_size);
@@ -139,9 +193,8 @@ int Board::prepare_for_acquisition (int buffer_size, const char *streamer_params
             }
             else
             {
-                int preset_int = preset_to_int (el.key ());
-                dbs[preset_int] = db;
-                marker_queues[preset_int] = std::deque<double> ();
+                dbs[el.first] = db;
+                marker_queues[el.first] = std::deque<double> ();
             }
         }
     }
@@ -156,41 +209,35 @@ int Board::prepare_for_acquisition (int buffer_size, const char *streamer_params
 
 void Board::push_package (double *package, int preset)
 {
-    std::string preset_str = preset_to_string (preset);
-    if ((board_descr.find (preset_str) == board_descr.end ()) || (dbs.find (preset) == dbs.end ()))
+    auto layout = preset_layouts.find (preset);
+    auto db = dbs.find (preset);
+    if ((layout == preset_layouts.end ()) || (db == dbs.end ()))
     {
         safe_logger (spdlog::level::err, "invalid json or push_package args, no such key");
         return;
     }
 
-    lock.lock ();
-    json board_preset = board_descr[preset_str];
-    try
+    lock_for_streamers (preset, 1);
+    std::deque<double> &markers = marker_queues[preset];
+    int marker_channel = layout->second.marker_channel;
+    if (markers.empty ())
     {
-        int marker_channel = board_preset["marker_channel"];
-        if (marker_queues[preset].empty ())
-        {
-            package[marker_channel] = 0.0;
-        }
-        else
-        {
-            double marker = marker_queues[preset].at (0);
-            package[marker_channel] = marker;
-            marker_queues[preset].pop_front ();
-        }
+        package[marker_channel] = 0.0;
     }
-    catch (...)
+    else
     {
-        safe_logger (spdlog::level::err, "Failed to get marker channel/value");
+        package[marker_channel] = markers.front ();
+        markers.pop_front ();
     }
 
-    if (dbs[preset] != NULL)
+    if (db->second != NULL)
     {
-        dbs[preset]->add_data (package);
+        db->second->add_data (package);
     }
-    if (streamers.find (preset) != streamers.end ())
+    auto preset_streamers = streamers.find (preset);
+    if (preset_streamers != streamers.end ())
     {
-        for (auto &streamer : streamers[preset])
+        for (auto &streamer : preset_streamers->second)
         {
             streamer->stream_data (package);
         }
@@ -198,6 +245,83 @@ void Board::push_package (double *package, int preset)
     lock.unlock ();
 }
 
+void Board::push_packages (double *packages, int count, int preset)
+{
+    auto layout = preset_layouts.find (preset);
+    auto db = dbs.find (preset);
+    if ((layout == preset_layouts.end ()) || (db == dbs.end ()))
+    {
+        safe_logger (spdlog::level::err, "invalid json or push_packages args, no such key");
+        return;
+    }
+    if (count <= 0)
+    {
+        return;
+    }
+
+    int num_rows = layout->second.num_rows;
+    int marker_channel = layout->second.marker_channel;
+    // streamers with BLOCK policy can not take more than queue size at once
+    for (int start = 0; start < count; start += STREAMER_QUEUE_SIZE)
+    {
+        int size = std::min (count - start, STREAMER_QUEUE_SIZE);
+        double *block = packages + (size_t)start * num_rows;
+        lock_for_streamers (preset, size);
+        std::deque<double> &markers = marker_queues[preset];
+        for (int i = 0; i < size; i++)
+        {
+            if (markers.empty ())
+            {
+                block[i * num_rows + marker_channel] = 0.0;
+            }
+            else
+            {
+                block[i * num_rows + marker_channel] = markers.front ();
+                markers.pop_front ();
+            }
+        }
+
+        if (db->second != NULL)
+        {
+            db->second->add_data_block (block, (size_t)size);
+        }
+        auto preset_streamers = streamers.find (preset);
+        if (preset_streamers != streamers.end ())
+        {
+            for (auto &streamer : preset_streamers->second)
+            {
+                streamer->stream_data_block (block, size);
+            }
+        }
+        lock.unlock ();
+    }
+}
+
+void Board::lock_for_streamers (int preset, int count)
+{
+    lock.lock ();
+    while (true)
+    {
+        bool waiting_required = false;
+        auto preset_streamers = streamers.find (preset);
+        if (preset_streamers != streamers.end ())
+        {
+            for (auto &streamer : preset_streamers->second)
+            {
+                waiting_required = waiting_required || streamer->is_waiting_required (count);
+            }
+        }
+        if (!waiting_required)
+        {
+            return;
+        }
+        // board data can be read and streamers can be removed while waiting
+        lock.unlock ();
+        std::this_thread::sleep_for (std::chrono::microseconds (100));
+        lock.lock ();
+    }
+}
+
 int Board::insert_marker (double value, int preset)
 {
     if (std::fabs (value) < std::numeric_limits<double>::epsilon ())
@@ -243,6 +367,8 @@ void Board::free_packages ()
         }
         streamers.erase (it);
     }
+
+    preset_layouts.clear ();
 }
 
 int Board::add_streamer (const char *streamer_params, int preset)
@@ -253,7 +379,14 @@ int Board::add_streamer (const char *streamer_params, int preset)
         safe_logger (spdlog::level::err, "invalid preset");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    int num_rows = (int)board_descr[preset_str]["num_rows"];
+    struct PresetLayout layout;
+    if (build_preset_layout (board_descr[preset_str], layout) !=
+        (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        safe_logger (spdlog::level::err, "invalid description of preset {}", preset_str);
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    int num_rows = layout.num_rows;
     std::string streamer_type = "";
     std::string streamer_dest = "";
     std::string streamer_mods = "";
@@ -268,7 +401,9 @@ int Board::add_streamer (const char *streamer_params, int preset)
     {
         safe_logger (spdlog::level::trace, "File Streamer, file: {}, mods: {}",
             streamer_dest.c_str (), streamer_mods.c_str ());
-        streamer = new FileStreamer (streamer_dest.c_str (), streamer_mods.c_str (), num_rows);
+        int sampling_rate = (layout.sampling_rate > 0) ? layout.sampling_rate : 0;
+        streamer = new FileStreamer (streamer_dest.c_str (), streamer_mods.c_str (), num_rows,
+            board_id, preset, sampling_rate);
     }
     if (streamer_type == "streaming_board")
     {
@@ -316,6 +451,15 @@ int Board::add_streamer (const char *streamer_params, int preset)
         safe_logger (spdlog::level::err, "failed to init streamer");
         delete streamer;
         streamer = NULL;
+        return res;
+    }
+
+    res = streamer->start_dispatching (streamer_overflow_policy);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        safe_logger (spdlog::level::err, "failed to start streamer dispatching");
+        delete streamer;
+        streamer = NULL;
     }
     else
     {
@@ -350,9 +494,10 @@ int Board::delete_streamer (const char *streamer_params, int preset)
         if ((*it)->check_equals (streamer_type, streamer_dest, streamer_mods))
         {
             lock.lock ();
-            delete *it;
+            Streamer *streamer = *it;
             it = streamers[preset].erase (it);
             lock.unlock ();
+            delete streamer; // writes queued packages, dont hold the lock for it
             res = (int)BrainFlowExitCodes::STATUS_OK;
             safe_logger (spdlog::level::info, "streamer {} removed", streamer_params);
             break;
@@ -370,6 +515,119 @@ int Board::delete_streamer (const char *streamer_params, int preset)
     return res;
 }
 
+bool Board::is_streamer_config (std::string config)
+{
+    return (config == "get_streamer_stats") || (config.find ("streamer_overflow_policy:") == 0);
+}
+
+bool Board::is_buffer_config (std::string config)
+{
+    return (config == "get_buffer_stats");
+}
+
+int Board::config_buffers (std::string config, std::string &response)
+{
+    json stats = json::array ();
+    for (auto &db : dbs)
+    {
+        if (db.second == NULL)
+        {
+            continue;
+        }
+        struct DataBufferStats buffer_stats;
+        db.second->get_stats (buffer_stats);
+        json preset_stats;
+        preset_stats["preset"] = db.first;
+        preset_stats["count"] = db.second->get_data_count ();
+        preset_stats["overwritten"] = buffer_stats.overwritten;
+        preset_stats["spilled"] = buffer_stats.spilled;
+        preset_stats["spilled_pending"] = buffer_stats.spilled_pending;
+        stats.push_back (preset_stats);
+    }
+    response = stats.dump ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::config_streamers (std::string config, std::string &response)
+{
+    if (config == "get_streamer_stats")
+    {
+        json stats = json::array ();
+        lock.lock ();
+        for (auto &preset_streamers : streamers)
+        {
+            for (Streamer *streamer : preset_streamers.second)
+            {
+                json streamer_stats;
+                streamer_stats["preset"] = preset_streamers.first;
+                streamer_stats["streamer"] = streamer->get_streamer_params ();
+                streamer_stats["overflow_policy"] =
+                    Streamer::policy_to_string (streamer->get_overflow_policy ());
+                streamer_stats["queued"] = streamer->get_queued_count ();
+                streamer_stats["dropped"] = streamer->get_dropped_count ();
+                stats.push_back (streamer_stats);
+            }
+        }
+        lock.unlock ();
+        response = stats.dump ();
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    std::string args = config.substr (strlen ("streamer_overflow_policy:"));
+    size_t idx = args.find (':');
+    std::string policy_str = args.substr (0, idx);
+    StreamerOverflowPolicies policy = StreamerOverflowPolicies::BLOCK;
+    if (!Streamer::policy_from_string (policy_str, policy))
+    {
+        safe_logger (spdlog::level::err, "unsupported overflow policy {}", policy_str);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    if (idx == std::string::npos)
+    {
+        lock.lock ();
+        streamer_overflow_policy = policy;
+        for (auto &preset_streamers : streamers)
+        {
+            for (Streamer *streamer : preset_streamers.second)
+            {
+                streamer->set_overflow_policy (policy);
+            }
+        }
+        lock.unlock ();
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    std::string streamer_type = "";
+    std::string streamer_dest = "";
+    std::string streamer_mods = "";
+    int res = parse_streamer_params (
+        args.substr (idx + 1).c_str (), streamer_type, streamer_dest, streamer_mods);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    res = (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    lock.lock ();
+    for (auto &preset_streamers : streamers)
+    {
+        for (Streamer *streamer : preset_streamers.second)
+        {
+            if (streamer->check_equals (streamer_type, streamer_dest, streamer_mods))
+            {
+                streamer->set_overflow_policy (policy);
+                res = (int)BrainFlowExitCodes::STATUS_OK;
+            }
+        }
+    }
+    lock.unlock ();
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        safe_logger (spdlog::level::err, "no such streamer found");
+    }
+    return res;
+}
+
 int Board::parse_streamer_params (const char *streamer_params, std::string &streamer_type,
     std::string &streamer_dest, std::string &streamer_mods)
 {
@@ -425,12 +683,8 @@ int Board::get_current_board_data (
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
 
-    int num_rows = (int)board_descr[preset_str]["num_rows"];
-
-    double *buf = new double[num_samples * num_rows];
-    int num_data_points = (int)dbs[preset]->get_current_data (num_samples, buf);
-    reshape_data (num_data_points, preset, buf, data_buf);
-    delete[] buf;
+    // buffer writes samples transposed right into caller's [num_rows x num_data_points] layout
+    int num_data_points = (int)dbs[preset]->get_current_data_transposed (num_samples, data_buf);
     *returned_samples = num_data_points;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
@@ -478,26 +732,108 @@ int Board::get_board_data (int data_count, int preset, double *data_buf)
     {
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    int num_rows = (int)board_descr[preset_str]["num_rows"];
-    double *buf = new double[data_count * num_rows];
-    int num_data_points = (int)dbs[preset]->get_data (data_count, buf);
-    reshape_data (num_data_points, preset, buf, data_buf);
-    delete[] buf;
+    dbs[preset]->get_data_transposed (data_count, data_buf);
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
-void Board::reshape_data (int data_count, int preset, const double *buf, double *output_buf)
+int Board::get_current_board_data_channels (int num_samples, int preset, const int *channels,
+    int num_channels, double *data_buf, int *returned_samples)
+{
+    int res = check_channels (preset, channels, num_channels);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    if ((!data_buf) || (!returned_samples) || (num_samples < 0))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *returned_samples = (int)dbs[preset]->get_current_data_channels (
+        num_samples, channels, num_channels, data_buf);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::get_board_data_channels (int data_count, int preset, const int *channels,
+    int num_channels, double *data_buf, int *returned_samples)
+{
+    int res = check_channels (preset, channels, num_channels);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    if ((!data_buf) || (!returned_samples) || (data_count < 0))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *returned_samples =
+        (int)dbs[preset]->get_data_channels (data_count, channels, num_channels, data_buf);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::check_channels (int preset, const int *channels, int num_channels)
 {
     std::string preset_str = preset_to_string (preset);
-    int num_rows = (int)board_descr[preset_str]["num_rows"];
+    if (board_descr.find (preset_str) == board_descr.end ())
+    {
+        safe_logger (spdlog::level::err, "invalid preset");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (dbs.find (preset) == dbs.end ())
+    {
+        safe_logger (spdlog::level::err,
+            "stream is not started or no preset: {} found for this board", preset_str.c_str ());
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (!dbs[preset])
+    {
+        return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+    }
+    if ((!channels) || (num_channels <= 0))
+    {
+        safe_logger (spdlog::level::err, "channels are not provided");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int num_rows = preset_layouts[preset].num_rows;
+    for (int i = 0; i < num_channels; i++)
+    {
+        if ((channels[i] < 0) || (channels[i] >= num_rows))
+        {
+            safe_logger (spdlog::level::err, "invalid channel {}, num rows is {}", channels[i],
+                num_rows);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
 
-    for (int i = 0; i < data_count; i++)
+int Board::get_buffer_precision (int preset, DataBufferPrecision &precision)
+{
+    // either single precision for all presets or comma separated list of preset:precision
+    std::string config = get_brainflow_buffer_precision ();
+    std::string preset_str = preset_to_string (preset);
+    std::string precision_str = "";
+    std::stringstream ss (config);
+    std::string item;
+    while (std::getline (ss, item, ','))
     {
-        for (int j = 0; j < num_rows; j++)
+        size_t idx = item.find (':');
+        if (idx == std::string::npos)
         {
-            output_buf[j * data_count + i] = buf[i * num_rows + j];
+            precision_str = item;
         }
+        else if (item.substr (0, idx) == preset_str)
+        {
+            precision_str = item.substr (idx + 1);
+        }
+    }
+    if (!BaseDataBuffer::precision_from_string (precision_str, precision))
+    {
+        safe_logger (spdlog::level::err, "unsupported buffer precision {}", config);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
+    safe_logger (spdlog::level::trace, "buffer precision for {}: {}", preset_str,
+        precision_str.empty () ? "float64" : precision_str);
+    return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
 std::string Board::preset_to_string (int preset)
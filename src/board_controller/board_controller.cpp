@@ -13,6 +13,7 @@
 #include <string.h>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "aavaa_v3.h"
 #include "ant_neuro.h"
@@ -60,21 +61,49 @@
 using json = nlohmann::json;
 
 
-std::map<std::pair<int, struct BrainFlowInputParams>, std::shared_ptr<Board>> boards;
+// board with its own lock, calls for different boards don't block each other
+struct BoardSession
+{
+    std::shared_ptr<Board> board;
+    std::pair<int, struct BrainFlowInputParams> key;
+    int handle;
+    bool released; // protected by session mutex, board must not be used after release
+    std::mutex mutex;
+};
+
+// global mutex protects maps below and logger, it's not held during calls to boards
+std::map<std::pair<int, struct BrainFlowInputParams>, std::shared_ptr<BoardSession>> boards;
+std::map<int, std::shared_ptr<BoardSession>> sessions;
+int sessions_counter = 0;
 std::mutex mutex;
+// boards which allow only one object per process use non atomic static counters, their
+// construction, preparation, release and destruction are serialized by this mutex
+std::mutex singleton_boards_mutex;
 
 std::pair<int, struct BrainFlowInputParams> get_key (
     int board_id, struct BrainFlowInputParams params);
 static int check_board_session (int board_id, const char *json_brainflow_input_params,
-    std::pair<int, struct BrainFlowInputParams> &key, bool log_error = true);
+    std::shared_ptr<BoardSession> &session, bool log_error = true);
+static int check_board_session (int session_handle, std::shared_ptr<BoardSession> &session);
+static void remove_board_session (std::shared_ptr<BoardSession> session);
+static bool is_singleton_board (int board_id);
 static int string_to_brainflow_input_params (
     const char *json_brainflow_input_params, struct BrainFlowInputParams *params);
 
 
 int prepare_session (int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    int session_handle = 0;
+    return prepare_session_with_handle (board_id, json_brainflow_input_params, &session_handle);
+}
 
+int prepare_session_with_handle (
+    int board_id, const char *json_brainflow_input_params, int *session_handle)
+{
+    if (session_handle == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
     Board::board_logger->info ("incoming json: {}", json_brainflow_input_params);
     struct BrainFlowInputParams params;
     int res = string_to_brainflow_input_params (json_brainflow_input_params, &params);
@@ -84,13 +113,22 @@ int prepare_session (int board_id, const char *json_brainflow_input_params)
     }
 
     std::pair<int, struct BrainFlowInputParams> key = get_key (board_id, params);
-    if (boards.find (key) != boards.end ())
     {
-        Board::board_logger->error (
-            "Board with id {} and the same config already exists", board_id);
-        return (int)BrainFlowExitCodes::ANOTHER_BOARD_IS_CREATED_ERROR;
+        std::lock_guard<std::mutex> lock (mutex);
+        if (boards.find (key) != boards.end ())
+        {
+            Board::board_logger->error (
+                "Board with id {} and the same config already exists", board_id);
+            return (int)BrainFlowExitCodes::ANOTHER_BOARD_IS_CREATED_ERROR;
+        }
     }
 
+    // declared before board to be unlocked after board destruction on errors
+    std::unique_lock<std::mutex> singleton_lock (singleton_boards_mutex, std::defer_lock);
+    if (is_singleton_board (board_id))
+    {
+        singleton_lock.lock ();
+    }
     std::shared_ptr<Board> board = NULL;
     switch (static_cast<BoardIds> (board_id))
     {
@@ -289,27 +327,82 @@ int prepare_session (int board_id, const char *json_brainflow_input_params)
             return (int)BrainFlowExitCodes::UNSUPPORTED_BOARD_ERROR;
     }
     Board::board_logger->trace ("Board object created {}", board->get_board_id ());
+
+    std::shared_ptr<BoardSession> session = std::make_shared<BoardSession> ();
+    session->board = board;
+    session->key = key;
+    session->released = false;
+    // session is registered before preparation to reject the same config from other threads,
+    // calls to it wait for session mutex until preparation is finished
+    std::lock_guard<std::mutex> session_lock (session->mutex);
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        if (boards.find (key) != boards.end ())
+        {
+            Board::board_logger->error (
+                "Board with id {} and the same config already exists", board_id);
+            return (int)BrainFlowExitCodes::ANOTHER_BOARD_IS_CREATED_ERROR;
+        }
+        sessions_counter++;
+        session->handle = sessions_counter;
+        boards[key] = session;
+        sessions[session->handle] = session;
+    }
     res = board->prepare_session ();
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
-        board = NULL;
+        session->released = true;
+        session->board = NULL;
+        remove_board_session (session);
     }
     else
     {
-        boards[key] = board;
+        *session_handle = session->handle;
+    }
+    return res;
+}
+
+int get_session_handle (
+    int board_id, const char *json_brainflow_input_params, int *session_handle)
+{
+    if (session_handle == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<BoardSession> session;
+    int res = check_board_session (board_id, json_brainflow_input_params, session, false);
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        *session_handle = session->handle;
     }
     return res;
 }
 
 int is_prepared (int *prepared, int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    int session_handle = 0;
+    int res = get_session_handle (board_id, json_brainflow_input_params, &session_handle);
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return is_prepared_by_handle (prepared, session_handle);
+    }
+    if (res == (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR)
+    {
+        *prepared = 0;
+        res = (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    return res;
+}
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+int is_prepared_by_handle (int *prepared, int session_handle)
+{
+    std::shared_ptr<BoardSession> session;
+    int res = check_board_session (session_handle, session);
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
-        *prepared = 1;
+        // wait if board is being prepared
+        std::lock_guard<std::mutex> session_lock (session->mutex);
+        *prepared = session->released ? 0 : 1;
     }
     if (res == (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR)
     {
@@ -322,106 +415,269 @@ int is_prepared (int *prepared, int board_id, const char *json_brainflow_input_p
 int start_stream (int buffer_size, const char *streamer_params, int board_id,
     const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    int session_handle = 0;
+    int res = get_session_handle (board_id, json_brainflow_input_params, &session_handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return start_stream_by_handle (buffer_size, streamer_params, session_handle);
+}
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+int start_stream_by_handle (int buffer_size, const char *streamer_params, int session_handle)
+{
+    std::shared_ptr<BoardSession> session;
+    int res = check_board_session (session_handle, session);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->start_stream (buffer_size, streamer_params);
+    std::lock_guard<std::mutex> session_lock (session->mutex);
+    if (session->released)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->start_stream (buffer_size, streamer_params);
 }
 
 int stop_stream (int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    int session_handle = 0;
+    int res = get_session_handle (board_id, json_brainflow_input_params, &session_handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return stop_stream_by_handle (session_handle);
+}
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+int stop_stream_by_handle (int session_handle)
+{
+    std::shared_ptr<BoardSession> session;
+    int res = check_board_session (session_handle, session);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->stop_stream ();
+    std::lock_guard<std::mutex> session_lock (session->mutex);
+    if (session->released)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->stop_stream ();
 }
 
 int insert_marker (double value, int preset, int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    int session_handle = 0;
+    int res = get_session_handle (board_id, json_brainflow_input_params, &session_handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return insert_marker_by_handle (value, preset, session_handle);
+}
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+int insert_marker_by_handle (double value, int preset, int session_handle)
+{
+    std::shared_ptr<BoardSession> session;
+    int res = check_board_session (session_handle, session);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->insert_marker (value, preset);
+    std::lock_guard<std::mutex> session_lock (session->mutex);
+    if (session->released)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->insert_marker (value, preset);
 }
 
 int release_session (int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    int session_handle = 0;
+    int res = get_session_handle (board_id, json_brainflow_input_params, &session_handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return release_session_by_handle (session_handle);
+}
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+int release_session_by_handle (int session_handle)
+{
+    std::shared_ptr<BoardSession> session;
+    int res = check_board_session (session_handle, session);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    res = board_it->second->release_session ();
-    boards.erase (board_it);
+    std::unique_lock<std::mutex> singleton_lock (singleton_boards_mutex, std::defer_lock);
+    if (is_singleton_board (session->key.first))
+    {
+        singleton_lock.lock ();
+    }
+    std::lock_guard<std::mutex> session_lock (session->mutex);
+    if (session->released)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    res = session->board->release_session ();
+    session->released = true;
+    session->board = NULL;
+    remove_board_session (session);
     return res;
 }
 
 int get_current_board_data (int num_samples, int preset, double *data_buf, int *returned_samples,
     int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    int session_handle = 0;
+    int res = get_session_handle (board_id, json_brainflow_input_params, &session_handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return get_current_board_data_by_handle (
+        num_samples, preset, data_buf, returned_samples, session_handle);
+}
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+int get_current_board_data_by_handle (int num_samples, int preset, double *data_buf,
+    int *returned_samples, int session_handle)
+{
+    std::shared_ptr<BoardSession> session;
+    int res = check_board_session (session_handle, session);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->get_current_board_data (
+    std::lock_guard<std::mutex> session_lock (session->mutex);
+    if (session->released)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->get_current_board_data (
         num_samples, preset, data_buf, returned_samples);
 }
 
 int get_board_data_count (
     int preset, int *result, int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    int session_handle = 0;
+    int res = get_session_handle (board_id, json_brainflow_input_params, &session_handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return get_board_data_count_by_handle (preset, result, session_handle);
+}
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+int get_board_data_count_by_handle (int preset, int *result, int session_handle)
+{
+    std::shared_ptr<BoardSession> session;
+    int res = check_board_session (session_handle, session);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->get_board_data_count (preset, result);
+    std::lock_guard<std::mutex> session_lock (session->mutex);
+    if (session->released)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->get_board_data_count (preset, result);
 }
 
 int get_board_data (int data_count, int preset, double *data_buf, int board_id,
     const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    int session_handle = 0;
+    int res = get_session_handle (board_id, json_brainflow_input_params, &session_handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return get_board_data_by_handle (data_count, preset, data_buf, session_handle);
+}
 
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+int get_board_data_by_handle (int data_count, int preset, double *data_buf, int session_handle)
+{
+    std::shared_ptr<BoardSession> session;
+    int res = check_board_session (session_handle, session);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->get_board_data (data_count, preset, data_buf);
+    std::lock_guard<std::mutex> session_lock (session->mutex);
+    if (session->released)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->get_board_data (data_count, preset, data_buf);
+}
+
+int get_current_board_data_channels (int num_samples, int preset, const int *channels,
+    int num_channels, double *data_buf, int *returned_samples, int board_id,
+    const char *json_brainflow_input_params)
+{
+    int session_handle = 0;
+    int res = get_session_handle (board_id, json_brainflow_input_params, &session_handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return get_current_board_data_channels_by_handle (
+        num_samples, preset, channels, num_channels, data_buf, returned_samples, session_handle);
+}
+
+int get_current_board_data_channels_by_handle (int num_samples, int preset, const int *channels,
+    int num_channels, double *data_buf, int *returned_samples, int session_handle)
+{
+    std::shared_ptr<BoardSession> session;
+    int res = check_board_session (session_handle, session);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    std::lock_guard<std::mutex> session_lock (session->mutex);
+    if (session->released)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->get_current_board_data_channels (
+        num_samples, preset, channels, num_channels, data_buf, returned_samples);
+}
+
+int get_board_data_channels (int data_count, int preset, const int *channels, int num_channels,
+    double *data_buf, int *returned_samples, int board_id, const char *json_brainflow_input_params)
+{
+    int session_handle = 0;
+    int res = get_session_handle (board_id, json_brainflow_input_params, &session_handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return get_board_data_channels_by_handle (
+        data_count, preset, channels, num_channels, data_buf, returned_samples, session_handle);
+}
+
+int get_board_data_channels_by_handle (int data_count, int preset, const int *channels,
+    int num_channels, double *data_buf, int *returned_samples, int session_handle)
+{
+    std::shared_ptr<BoardSession> session;
+    int res = check_board_session (session_handle, session);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    std::lock_guard<std::mutex> session_lock (session->mutex);
+    if (session->released)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->get_board_data_channels (
+        data_count, preset, channels, num_channels, data_buf, returned_samples);
 }
 
 int set_log_level_board_controller (int log_level)
@@ -466,22 +722,47 @@ int java_set_jnienv (JNIEnv *java_jnienv)
 int config_board (const char *config, char *response, int *response_len, int board_id,
     const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    int session_handle = 0;
+    int res = get_session_handle (board_id, json_brainflow_input_params, &session_handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return config_board_by_handle (config, response, response_len, session_handle);
+}
+
+int config_board_by_handle (
+    const char *config, char *response, int *response_len, int session_handle)
+{
     if ((config == NULL) || (response == NULL) || (response_len == NULL))
     {
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    std::shared_ptr<BoardSession> session;
+    int res = check_board_session (session_handle, session);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
+    std::lock_guard<std::mutex> session_lock (session->mutex);
+    if (session->released)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
     std::string conf = config;
     std::string resp = "";
-    res = board_it->second->config_board (conf, resp);
+    if (Board::is_streamer_config (conf))
+    {
+        res = session->board->config_streamers (conf, resp);
+    }
+    else if (Board::is_buffer_config (conf))
+    {
+        res = session->board->config_buffers (conf, resp);
+    }
+    else
+    {
+        res = session->board->config_board (conf, resp);
+    }
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
         *response_len = (int)resp.length ();
@@ -493,69 +774,125 @@ int config_board (const char *config, char *response, int *response_len, int boa
 int config_board_with_bytes (
     const char *bytes, int len, int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    int session_handle = 0;
+    int res = get_session_handle (board_id, json_brainflow_input_params, &session_handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return config_board_with_bytes_by_handle (bytes, len, session_handle);
+}
+
+int config_board_with_bytes_by_handle (const char *bytes, int len, int session_handle)
+{
     if ((bytes == NULL) || (len < 1))
     {
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    std::shared_ptr<BoardSession> session;
+    int res = check_board_session (session_handle, session);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->config_board_with_bytes (bytes, len);
+    std::lock_guard<std::mutex> session_lock (session->mutex);
+    if (session->released)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->config_board_with_bytes (bytes, len);
 }
 
 int add_streamer (
     const char *streamer, int preset, int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    int session_handle = 0;
+    int res = get_session_handle (board_id, json_brainflow_input_params, &session_handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return add_streamer_by_handle (streamer, preset, session_handle);
+}
+
+int add_streamer_by_handle (const char *streamer, int preset, int session_handle)
+{
     if (streamer == NULL)
     {
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    std::shared_ptr<BoardSession> session;
+    int res = check_board_session (session_handle, session);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->add_streamer (streamer, preset);
+    std::lock_guard<std::mutex> session_lock (session->mutex);
+    if (session->released)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->add_streamer (streamer, preset);
 }
 
 int delete_streamer (
     const char *streamer, int preset, int board_id, const char *json_brainflow_input_params)
 {
-    std::lock_guard<std::mutex> lock (mutex);
+    int session_handle = 0;
+    int res = get_session_handle (board_id, json_brainflow_input_params, &session_handle);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    return delete_streamer_by_handle (streamer, preset, session_handle);
+}
+
+int delete_streamer_by_handle (const char *streamer, int preset, int session_handle)
+{
     if (streamer == NULL)
     {
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-
-    std::pair<int, struct BrainFlowInputParams> key;
-    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    std::shared_ptr<BoardSession> session;
+    int res = check_board_session (session_handle, session);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
-    auto board_it = boards.find (key);
-    return board_it->second->delete_streamer (streamer, preset);
+    std::lock_guard<std::mutex> session_lock (session->mutex);
+    if (session->released)
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    return session->board->delete_streamer (streamer, preset);
 }
 
 int release_all_sessions ()
 {
-    std::lock_guard<std::mutex> lock (mutex);
-
-    for (auto it = boards.begin (), next_it = it; it != boards.end (); it = next_it)
+    std::vector<std::shared_ptr<BoardSession>> released_sessions;
     {
-        ++next_it;
-        it->second->release_session ();
-        boards.erase (it);
+        std::lock_guard<std::mutex> lock (mutex);
+        for (auto it = sessions.begin (); it != sessions.end (); ++it)
+        {
+            released_sessions.push_back (it->second);
+        }
+        sessions.clear ();
+        boards.clear ();
+    }
+    for (size_t i = 0; i < released_sessions.size (); i++)
+    {
+        std::unique_lock<std::mutex> singleton_lock (singleton_boards_mutex, std::defer_lock);
+        if (is_singleton_board (released_sessions[i]->key.first))
+        {
+            singleton_lock.lock ();
+        }
+        std::lock_guard<std::mutex> session_lock (released_sessions[i]->mutex);
+        if (!released_sessions[i]->released)
+        {
+            released_sessions[i]->board->release_session ();
+            released_sessions[i]->released = true;
+            released_sessions[i]->board = NULL;
+        }
     }
 
     return (int)BrainFlowExitCodes::STATUS_OK;
@@ -579,8 +916,25 @@ std::pair<int, struct BrainFlowInputParams> get_key (
     return key;
 }
 
+bool is_singleton_board (int board_id)
+{
+    switch (static_cast<BoardIds> (board_id))
+    {
+        case BoardIds::GANGLION_BOARD:
+        case BoardIds::GFORCE_PRO_BOARD:
+        case BoardIds::GFORCE_DUAL_BOARD:
+        case BoardIds::BRAINBIT_BLED_BOARD:
+        case BoardIds::MUSE_S_BLED_BOARD:
+        case BoardIds::MUSE_2_BLED_BOARD:
+        case BoardIds::MUSE_2016_BLED_BOARD:
+            return true;
+        default:
+            return false;
+    }
+}
+
 int check_board_session (int board_id, const char *json_brainflow_input_params,
-    std::pair<int, struct BrainFlowInputParams> &key, bool log_error)
+    std::shared_ptr<BoardSession> &session, bool log_error)
 {
     struct BrainFlowInputParams params;
     int res = string_to_brainflow_input_params (json_brainflow_input_params, &params);
@@ -589,9 +943,10 @@ int check_board_session (int board_id, const char *json_brainflow_input_params,
         return res;
     }
 
-    key = get_key (board_id, params);
-
-    if (boards.find (key) == boards.end ())
+    std::pair<int, struct BrainFlowInputParams> key = get_key (board_id, params);
+    std::lock_guard<std::mutex> lock (mutex);
+    auto board_it = boards.find (key);
+    if (board_it == boards.end ())
     {
         if (log_error)
         {
@@ -600,9 +955,34 @@ int check_board_session (int board_id, const char *json_brainflow_input_params,
         }
         return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
     }
+    session = board_it->second;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int check_board_session (int session_handle, std::shared_ptr<BoardSession> &session)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    auto session_it = sessions.find (session_handle);
+    if (session_it == sessions.end ())
+    {
+        return (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR;
+    }
+    session = session_it->second;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+void remove_board_session (std::shared_ptr<BoardSession> session)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    // release_all_sessions could remove it already and the same config could be prepared again
+    auto board_it = boards.find (session->key);
+    if ((board_it != boards.end ()) && (board_it->second == session))
+    {
+        boards.erase (board_it);
+    }
+    sessions.erase (session->handle);
+}
+
 int string_to_brainflow_input_params (
     const char *json_brainflow_input_params, struct BrainFlowInputParams *params)
 {
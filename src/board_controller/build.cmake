@@ -24,13 +24,23 @@ endif (CMAKE_SIZEOF_VOID_P EQUAL 8)
 
 SET (BOARD_CONTROLLER_SRC
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/timestamp.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/base_data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/channel_major_data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/binary_file.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/lock_free_data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/mapped_file.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/numeric_parser.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/spill_data_buffer.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/os_serial.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/os_serial_ioctl.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/serial.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/serial_frame_reader.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/io_reactor.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/libftdi_serial.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/socket_client_tcp.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/socket_client_udp.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/udp_batch.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/socket_server_tcp.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/socket_server_udp.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/multicast_client.cpp
@@ -50,15 +60,19 @@ SET (BOARD_CONTROLLER_SRC
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/openbci/ganglion_native.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/openbci/cyton.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/openbci/cyton_daisy.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/openbci/openbci_exg_decoder.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/board_controller.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/board_info_getter.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/board.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/preset_layout.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/brainflow_boards.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/streaming_board.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/synthetic_board.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/dyn_lib_board.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/bt_lib_board.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/playback_file_board.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/playback_file_source.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/streamer.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/file_streamer.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/multicast_streamer.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/plotjuggler_udp_streamer.cpp
@@ -5,25 +5,52 @@
 #include "file_streamer.h"
 
 
-FileStreamer::FileStreamer (const char *file, const char *file_mode, int data_len)
+FileStreamer::FileStreamer (const char *file, const char *file_mode, int data_len, int board_id,
+    int preset, int sampling_rate)
     : Streamer (data_len, "file", file, file_mode)
 {
     strncpy (this->file, file, BRAINFLOW_FILE_NAME_LIMIT);
     strncpy (this->file_mode, file_mode, BRAINFLOW_FILE_NAME_LIMIT);
     fp = NULL;
+    binary_writer = NULL;
+    this->board_id = board_id;
+    this->preset = preset;
+    this->sampling_rate = sampling_rate;
 }
 
 FileStreamer::~FileStreamer ()
 {
+    stop_dispatching ();
     if (fp != NULL)
     {
         fclose (fp);
         fp = NULL;
     }
+    if (binary_writer != NULL)
+    {
+        binary_writer->close ();
+        delete binary_writer;
+        binary_writer = NULL;
+    }
 }
 
 int FileStreamer::init_streamer ()
 {
+    if (is_binary_file_mode (file_mode))
+    {
+        binary_writer =
+            new BinaryFileWriter (file, file_mode, len, board_id, preset, sampling_rate);
+        int res = binary_writer->open ();
+        if (res != (int)BinaryFileReturnCodes::STATUS_OK)
+        {
+            delete binary_writer;
+            binary_writer = NULL;
+            return (res == (int)BinaryFileReturnCodes::INVALID_FORMAT_ERROR) ?
+                (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR :
+                (int)BrainFlowExitCodes::GENERAL_ERROR;
+        }
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
     if ((strcmp (file_mode, "w") != 0) && (strcmp (file_mode, "w+") != 0) &&
         (strcmp (file_mode, "a") != 0) && (strcmp (file_mode, "a+") != 0))
     {
@@ -37,11 +64,20 @@ int FileStreamer::init_streamer ()
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
-void FileStreamer::stream_data (double *data)
+void FileStreamer::stream_batch (double *data, int count)
 {
-    for (int i = 0; i < len - 1; i++)
+    if (binary_writer != NULL)
+    {
+        binary_writer->write_samples (data, count);
+        return;
+    }
+    for (int package = 0; package < count; package++)
     {
-        fprintf (fp, "%lf\t", data[i]);
+        double *values = data + package * len;
+        for (int i = 0; i < len - 1; i++)
+        {
+            fprintf (fp, "%lf\t", values[i]);
+        }
+        fprintf (fp, "%lf\n", values[len - 1]);
     }
-    fprintf (fp, "%lf\n", data[len - 1]);
 }
@@ -5,6 +5,7 @@
 #include "custom_cast.h"
 #include "freeeeg.h"
 #include "serial.h"
+#include "serial_frame_reader.h"
 #include "timestamp.h"
 
 
@@ -144,23 +145,14 @@ void FreeEEG::read_thread ()
 
     std::vector<int> eeg_channels = board_descr["default"]["eeg_channels"];
 
+    // package size is unknown, package ends with end byte followed by start byte of the next one
+    SerialFrameReader reader (serial, FreeEEG::start_byte, min_package_size, max_size - 2,
+        FreeEEG::end_byte, FreeEEG::end_byte);
+
     while (keep_alive)
     {
-        int pos = 0;
-        bool complete_package = false;
-        while ((keep_alive) && (pos < max_size - 2))
-        {
-            res = serial->read_from_serial_port (b + pos, 1);
-            int prev_id = (pos <= 0) ? 0 : pos - 1;
-            if ((b[pos] == FreeEEG::start_byte) && (b[prev_id] == FreeEEG::end_byte) &&
-                (pos >= min_package_size))
-            {
-                complete_package = true;
-                break;
-            }
-            pos += res;
-        }
-        if (complete_package)
+        res = reader.read_frame (b);
+        if (res > 0)
         {
             // handle the case that we start reading in the middle of data stream
             if (!first_package_received)
@@ -178,8 +170,7 @@ void FreeEEG::read_thread ()
         }
         else
         {
-            safe_logger (
-                spdlog::level::trace, "stopped with pos: {}, keep_alive: {}", pos, keep_alive);
+            safe_logger (spdlog::level::trace, "no package received, keep_alive: {}", keep_alive);
         }
     }
     delete[] package;
@@ -11,12 +11,15 @@
 #include "brainflow_constants.h"
 #include "brainflow_input_params.h"
 #include "data_buffer.h"
+#include "preset_layout.h"
 #include "spinlock.h"
 #include "streamer.h"
 
 #include "spdlog/spdlog.h"
 
 #define MAX_CAPTURE_SAMPLES (86400 * 250) // should be enough for one day of capturing
+// float32 buffers take half of memory, so they can keep twice more samples
+#define MAX_COMPACT_CAPTURE_SAMPLES (MAX_CAPTURE_SAMPLES * 2)
 
 
 class Board
@@ -37,6 +40,7 @@ public:
     Board (int board_id, struct BrainFlowInputParams params)
     {
         skip_logs = false;
+        streamer_overflow_policy = StreamerOverflowPolicies::DROP_OLDEST;
         this->board_id = board_id;
         this->params = params;
         try
@@ -65,10 +69,26 @@ public:
         int num_samples, int preset, double *data_buf, int *returned_samples);
     int get_board_data_count (int preset, int *result);
     int get_board_data (int data_count, int preset, double *data_buf);
+    // the same as methods above but only rows from channels are returned, data_buf is
+    // [num_channels x returned samples]
+    int get_current_board_data_channels (int num_samples, int preset, const int *channels,
+        int num_channels, double *data_buf, int *returned_samples);
+    int get_board_data_channels (int data_count, int preset, const int *channels,
+        int num_channels, double *data_buf, int *returned_samples);
     int insert_marker (double value, int preset);
     int add_streamer (const char *streamer_params, int preset);
     int delete_streamer (const char *streamer_params, int preset);
 
+    // config commands supported by all boards:
+    // "streamer_overflow_policy:<block|drop_oldest|drop_newest>" - set policy for all streamers
+    // "streamer_overflow_policy:<policy>:<streamer_params>" - set policy for single streamer
+    // "get_streamer_stats" - json array with queue size and number of dropped packages
+    static bool is_streamer_config (std::string config);
+    int config_streamers (std::string config, std::string &response);
+    // "get_buffer_stats" - json array with stored, overwritten and spilled samples for each preset
+    static bool is_buffer_config (std::string config);
+    int config_buffers (std::string config, std::string &response);
+
     // Board::board_logger should not be called from destructors, to ensure that there are safe log
     // methods Board::board_logger still available but should be used only outside destructors
     template <typename Arg1, typename... Args>
@@ -98,24 +118,34 @@ public:
     }
 
 protected:
-    std::map<int, DataBuffer *> dbs;
+    std::map<int, BaseDataBuffer *> dbs;
     std::map<int, std::vector<Streamer *>> streamers;
+    StreamerOverflowPolicies streamer_overflow_policy; // for new streamers
     bool skip_logs;
     int board_id;
     struct BrainFlowInputParams params;
     json board_descr;
     SpinLock lock;
     std::map<int, std::deque<double>> marker_queues;
+    std::map<int, struct PresetLayout> preset_layouts;
 
     int prepare_for_acquisition (int buffer_size, const char *streamer_params);
     void free_packages ();
     void push_package (double *package, int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    // same as count calls of push_package for packages stored one after another, board is locked
+    // once per STREAMER_QUEUE_SIZE packages and block is passed to buffer and streamers at once,
+    // markers are written in place
+    void push_packages (
+        double *packages, int count, int preset = (int)BrainFlowPresets::DEFAULT_PRESET);
+    // locks board, waits for streamers with BLOCK policy with released lock
+    void lock_for_streamers (int preset, int count);
     std::string preset_to_string (int preset);
     int preset_to_int (std::string preset);
     int parse_streamer_params (const char *streamer_params, std::string &streamer_type,
         std::string &streamer_dest, std::string &streamer_mods);
 
 private:
-    // reshapes data from DataBuffer format where all channels are mixed to linear buffer
-    void reshape_data (int data_count, int preset, const double *buf, double *output_buf);
+    int check_channels (int preset, const int *channels, int num_channels);
+    // precision from BRAINFLOW_BUFFER_PRECISION for preset, returns BrainFlowExitCodes
+    int get_buffer_precision (int preset, DataBufferPrecision &precision);
 };
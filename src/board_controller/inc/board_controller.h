@@ -34,8 +34,49 @@ extern "C"
         const char *streamer, int preset, int board_id, const char *json_brainflow_input_params);
     SHARED_EXPORT int CALLING_CONVENTION delete_streamer (
         const char *streamer, int preset, int board_id, const char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_current_board_data_channels (int num_samples,
+        int preset, const int *channels, int num_channels, double *data_buf, int *returned_samples,
+        int board_id, const char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_board_data_channels (int data_count, int preset,
+        const int *channels, int num_channels, double *data_buf, int *returned_samples,
+        int board_id, const char *json_brainflow_input_params);
     SHARED_EXPORT int CALLING_CONVENTION release_all_sessions ();
 
+    // session handle methods, the same as methods above but board is found by handle returned from
+    // prepare_session_with_handle or get_session_handle instead of parsing json params, calls for
+    // different boards don't block each other
+    SHARED_EXPORT int CALLING_CONVENTION prepare_session_with_handle (
+        int board_id, const char *json_brainflow_input_params, int *session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION get_session_handle (
+        int board_id, const char *json_brainflow_input_params, int *session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION start_stream_by_handle (
+        int buffer_size, const char *streamer_params, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION stop_stream_by_handle (int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION release_session_by_handle (int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION get_current_board_data_by_handle (int num_samples,
+        int preset, double *data_buf, int *returned_samples, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION get_board_data_count_by_handle (
+        int preset, int *result, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION get_board_data_by_handle (
+        int data_count, int preset, double *data_buf, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION get_current_board_data_channels_by_handle (
+        int num_samples, int preset, const int *channels, int num_channels, double *data_buf,
+        int *returned_samples, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION get_board_data_channels_by_handle (int data_count,
+        int preset, const int *channels, int num_channels, double *data_buf, int *returned_samples,
+        int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION config_board_by_handle (
+        const char *config, char *response, int *response_len, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION config_board_with_bytes_by_handle (
+        const char *bytes, int len, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION is_prepared_by_handle (int *prepared, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION insert_marker_by_handle (
+        double marker_value, int preset, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION add_streamer_by_handle (
+        const char *streamer, int preset, int session_handle);
+    SHARED_EXPORT int CALLING_CONVENTION delete_streamer_by_handle (
+        const char *streamer, int preset, int session_handle);
+
     // logging methods
     SHARED_EXPORT int CALLING_CONVENTION set_log_level_board_controller (int log_level);
     SHARED_EXPORT int CALLING_CONVENTION set_log_file_board_controller (const char *log_file);
@@ -2,6 +2,7 @@
 
 #include <stdio.h>
 
+#include "binary_file.h"
 #include "streamer.h"
 
 #define BRAINFLOW_FILE_NAME_LIMIT 512
@@ -10,14 +11,22 @@ class FileStreamer : public Streamer
 {
 
 public:
-    FileStreamer (const char *file, const char *file_mode, int data_len);
+    // board_id, preset and sampling_rate are stored in header of binary files
+    FileStreamer (const char *file, const char *file_mode, int data_len, int board_id = -100,
+        int preset = 0, int sampling_rate = 0);
     ~FileStreamer ();
 
     int init_streamer ();
-    void stream_data (double *data);
+
+protected:
+    void stream_batch (double *data, int count);
 
 private:
     char file[BRAINFLOW_FILE_NAME_LIMIT];
     char file_mode[BRAINFLOW_FILE_NAME_LIMIT];
     FILE *fp;
+    BinaryFileWriter *binary_writer;
+    int board_id;
+    int preset;
+    int sampling_rate;
 };
@@ -1,8 +1,7 @@
 #pragma once
 
-#include <thread>
+#include <atomic>
 
-#include "data_buffer.h"
 #include "multicast_server.h"
 #include "streamer.h"
 
@@ -15,15 +14,26 @@ public:
     ~MultiCastStreamer ();
 
     int init_streamer ();
-    void stream_data (double *data);
+
+    static constexpr int max_transactions_per_send = 16;
+
+    // transactions dropped because they were not sent before the buffer was full
+    size_t get_dropped_transactions ()
+    {
+        return dropped_transactions;
+    }
+
+protected:
+    void stream_batch (double *data, int count);
 
 private:
     char ip[128];
     int port;
     MultiCastServer *server;
-    DataBuffer *db;
-    volatile bool is_streaming;
-    std::thread streaming_thread;
+    double *transaction;
+    int num_packages;
+    int packages_in_transaction;
+    std::atomic<size_t> dropped_transactions;
 
-    void thread_worker ();
+    void send_transactions ();
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
@@ -7,6 +8,7 @@
 
 #include "board.h"
 #include "board_controller.h"
+#include "playback_file_source.h"
 
 
 class PlaybackFileBoard : public Board
@@ -16,13 +18,19 @@ private:
     volatile bool keep_alive;
     volatile bool loopback;
     volatile bool use_new_timestamps;
+    // multiplier for recorded time, 0 means as fast as possible, set from config_board thread
+    std::atomic<double> playback_speed;
+    int buffer_size;
     std::vector<double> pos_percentage;
+    std::vector<double> pos_timestamp;
     std::vector<std::thread> streaming_threads;
     bool initialized;
-    std::vector<std::vector<long int>> file_offsets;
+    std::vector<PlaybackFileSource *> sources; // one per preset, NULL if there is no file
 
-    void read_thread (int preset, std::string filename);
-    int get_file_offsets (std::string filename, std::vector<long int> &offsets);
+    void read_thread (int preset);
+    void wait_for_consumer (BaseDataBuffer *db);
+    int open_source (int preset, std::string filename);
+    void free_sources ();
 
 public:
     PlaybackFileBoard (struct BrainFlowInputParams params);
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "binary_file.h"
+#include "mapped_file.h"
+
+#define PLAYBACK_INDEX_EXTENSION ".bfidx"
+#define PLAYBACK_INDEX_MAGIC "BFPBIDX"
+#define PLAYBACK_INDEX_VERSION 1
+#define PLAYBACK_INDEX_STRIDE 256 // lines between sparse index entries
+
+
+// source of packages for PlaybackFileBoard, position is changed only by the thread which reads
+// packages, other methods are safe to call from any thread after open
+class PlaybackFileSource
+{
+
+public:
+    // detects file format, errors are reported from open
+    static PlaybackFileSource *create (
+        const std::string &file_name, int num_rows, int timestamp_channel);
+
+    PlaybackFileSource (const std::string &file_name, int num_rows, int timestamp_channel)
+    {
+        this->file_name = file_name;
+        this->num_rows = num_rows;
+        this->timestamp_channel = timestamp_channel;
+        first_timestamp = 0.0;
+        last_timestamp = 0.0;
+    }
+    virtual ~PlaybackFileSource ()
+    {
+    }
+
+    // returns BrainFlowExitCodes
+    virtual int open () = 0;
+    // STATUS_OK, EMPTY_BUFFER_ERROR at the end of file or GENERAL_ERROR for invalid entry which
+    // is skipped
+    virtual int read_package (double *package) = 0;
+    virtual void rewind () = 0;
+    // percentage of packages in [0, 100)
+    virtual int seek_percentage (double percentage) = 0;
+    // moves to the first package with timestamp >= provided value
+    virtual int seek_timestamp (double timestamp) = 0;
+    virtual int64_t get_num_packages () = 0;
+
+    double get_first_timestamp ()
+    {
+        return first_timestamp;
+    }
+
+    double get_last_timestamp ()
+    {
+        return last_timestamp;
+    }
+
+    const std::string &get_file_name ()
+    {
+        return file_name;
+    }
+
+protected:
+    std::string file_name;
+    int num_rows;
+    int timestamp_channel;
+    double first_timestamp;
+    double last_timestamp;
+};
+
+
+// index file is PlaybackIndexHeader followed by num_entries PlaybackIndexEntry, it's rebuilt if
+// size or modification time of the recording doesnt match
+#pragma pack(push, 1)
+struct PlaybackIndexHeader
+{
+    char magic[8];
+    int32_t version;
+    int32_t stride;
+    int64_t file_size;
+    int64_t file_mtime;
+    int64_t num_lines;
+    int64_t num_entries;
+    double first_timestamp;
+    double last_timestamp;
+    int32_t separator;
+    int32_t timestamp_channel;
+};
+
+struct PlaybackIndexEntry
+{
+    int64_t offset;
+    int64_t line;
+    double timestamp;
+};
+#pragma pack(pop)
+
+// csv\tsv files written by file streamer or write_file, file is memory mapped and sparse index
+// with every PLAYBACK_INDEX_STRIDE line is cached in file_name + PLAYBACK_INDEX_EXTENSION
+class TextPlaybackFileSource : public PlaybackFileSource
+{
+
+public:
+    TextPlaybackFileSource (const std::string &file_name, int num_rows, int timestamp_channel);
+
+    int open ();
+    int read_package (double *package);
+    void rewind ();
+    int seek_percentage (double percentage);
+    int seek_timestamp (double timestamp);
+    int64_t get_num_packages ();
+
+private:
+    MappedFile mapped_file;
+    const char *data;
+    int64_t size;
+    int64_t position;
+    char separator;
+    int64_t num_lines;
+    std::vector<struct PlaybackIndexEntry> index;
+
+    int parse_line (int64_t offset, int64_t line_end, double *package);
+    bool parse_timestamp (int64_t offset, int64_t line_end, double *timestamp);
+    int64_t get_line_end (int64_t offset);
+    int64_t skip_lines (int64_t offset, int64_t count);
+    bool load_index ();
+    void build_index ();
+    void save_index ();
+};
+
+// files in binary format from binary_file.h
+class BinaryPlaybackFileSource : public PlaybackFileSource
+{
+
+public:
+    BinaryPlaybackFileSource (const std::string &file_name, int num_rows, int timestamp_channel);
+
+    int open ();
+    int read_package (double *package);
+    void rewind ();
+    int seek_percentage (double percentage);
+    int seek_timestamp (double timestamp);
+    int64_t get_num_packages ();
+
+private:
+    BinaryFileReader reader;
+    int64_t position;
+    std::vector<double> sample;
+
+    bool read_timestamp (int64_t pos, double *timestamp);
+};
@@ -1,8 +1,8 @@
 #pragma once
 
-#include <thread>
+#include <string>
+#include <vector>
 
-#include "data_buffer.h"
 #include "socket_client_udp.h"
 #include "streamer.h"
 
@@ -11,6 +11,13 @@
 using json = nlohmann::json;
 
 
+struct PlotJugglerChannel
+{
+    std::string prefix;
+    std::string channel_name; // empty for single channels like timestamp
+    int index;
+};
+
 class PlotJugglerUDPStreamer : public Streamer
 {
 
@@ -19,17 +26,19 @@ public:
     ~PlotJugglerUDPStreamer ();
 
     int init_streamer ();
-    void stream_data (double *data);
+
+protected:
+    void stream_batch (double *data, int count);
 
 private:
     char ip[128];
     int port;
     SocketClientUDP *socket;
-    DataBuffer *db;
-    volatile bool is_streaming;
-    std::thread streaming_thread;
     json preset_descr;
+    std::string name;
+    std::vector<std::string> group_names;
+    std::vector<PlotJugglerChannel> channels;
 
-    void thread_worker ();
+    void build_channels ();
     std::string remove_substr (std::string str, std::string substr);
 };
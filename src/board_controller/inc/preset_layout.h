@@ -0,0 +1,36 @@
+#pragma once
+
+#include "json.hpp"
+
+using json = nlohmann::json;
+
+#define MAX_PRESET_CHANNEL_GROUPS 32
+#define MAX_PRESET_CHANNEL_INDICES 1024
+#define PRESET_GROUP_NAME_LIMIT 32
+
+
+struct PresetChannelGroup
+{
+    char name[PRESET_GROUP_NAME_LIMIT]; // key from board description without "_channels" suffix
+    int first; // offset in PresetLayout::channel_indices
+    int count;
+};
+
+// flat copy of preset description from brainflow_boards.cpp, built once in
+// prepare_for_acquisition and used in hot paths instead of json lookups
+struct PresetLayout
+{
+    int num_rows;
+    int timestamp_channel;
+    int marker_channel;
+    int package_num_channel; // -1 if not provided
+    int battery_channel;     // -1 if not provided
+    int sampling_rate;       // -1 if not provided
+    int num_channel_groups;
+    int num_channel_indices;
+    PresetChannelGroup channel_groups[MAX_PRESET_CHANNEL_GROUPS];
+    int channel_indices[MAX_PRESET_CHANNEL_INDICES];
+};
+
+// returns BrainFlowExitCodes
+int build_preset_layout (const json &preset_descr, struct PresetLayout &layout);
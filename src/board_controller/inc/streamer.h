@@ -1,24 +1,56 @@
 #pragma once
 
+#include <atomic>
 #include <string>
+#include <thread>
 
+#include "lock_free_data_buffer.h"
+
+#define STREAMER_QUEUE_SIZE 4096 // max number of packages waiting for dispatching thread
+#define STREAMER_BATCH_SIZE 256  // max number of packages passed to stream_batch at once
+
+
+// DROP_OLDEST is the default, for BLOCK board waits for free space in queue before taking its
+// lock, so only acquisition thread waits and readers of board data are not blocked
+enum class StreamerOverflowPolicies : int
+{
+    BLOCK = 0,
+    DROP_OLDEST = 1,
+    DROP_NEWEST = 2
+};
+
+// stream_data is called from board threads and only enqueues packages, dispatching thread drains
+// the queue and passes packages to stream_batch, so slow sinks dont block data acquisition
 class Streamer
 {
 public:
-    Streamer (int data_len, std::string type, std::string dest, std::string mods)
-    {
-        len = data_len;
-        streamer_type = type;
-        streamer_dest = dest;
-        streamer_mods = mods;
-    }
+    static bool policy_from_string (std::string policy_str, StreamerOverflowPolicies &policy);
+    static std::string policy_to_string (StreamerOverflowPolicies policy);
 
-    virtual ~Streamer ()
-    {
-    }
+    Streamer (int data_len, std::string type, std::string dest, std::string mods);
+    virtual ~Streamer ();
 
     virtual int init_streamer () = 0;
-    virtual void stream_data (double *data) = 0;
+
+    // if dispatching is not started packages are passed to stream_batch directly, never waits,
+    // if queue is full oldest or newest packages are dropped
+    void stream_data (double *data);
+    // same as count calls of stream_data, data contains count packages with len values each,
+    // overflow policy is applied to the whole block
+    void stream_data_block (double *data, int count);
+    // true if policy is BLOCK and queue has no space for count packages, producer should wait
+    // without holding locks and check again
+    bool is_waiting_required (int count);
+    int start_dispatching (StreamerOverflowPolicies policy);
+    // writes all queued packages and stops dispatching thread, derived classes must call it in
+    // destructors before releasing resources used by stream_batch
+    void stop_dispatching ();
+
+    void set_overflow_policy (StreamerOverflowPolicies policy);
+    StreamerOverflowPolicies get_overflow_policy ();
+    size_t get_dropped_count ();
+    size_t get_queued_count ();
+    std::string get_streamer_params ();
 
     virtual bool check_equals (std::string type, std::string dest, std::string mods)
     {
@@ -30,4 +62,16 @@ protected:
     std::string streamer_dest;
     std::string streamer_mods;
     int len;
+
+    // called from dispatching thread, data contains count packages with len values each
+    virtual void stream_batch (double *data, int count) = 0;
+
+private:
+    LockFreeDataBuffer *queue;
+    std::atomic<int> overflow_policy;
+    std::atomic<size_t> dropped_count;
+    std::atomic<bool> keep_dispatching;
+    std::thread dispatching_thread;
+
+    void dispatch_thread ();
 };
@@ -6,6 +6,7 @@
 
 #include "board.h"
 #include "board_controller.h"
+#include "io_reactor.h"
 #include "multicast_client.h"
 
 
@@ -18,8 +19,10 @@ private:
     std::vector<std::thread> streaming_threads;
     std::vector<MultiCastClient *> clients;
     std::vector<int> presets;
+    std::vector<int> reactor_sockets;
 
     void read_thread (int num);
+    int add_to_reactor (IOReactor *reactor, int num);
     void log_socket_error (int error_code);
 
 public:
@@ -31,4 +34,6 @@ public:
     int stop_stream ();
     int release_session ();
     int config_board (std::string config, std::string &response);
+
+    static constexpr int max_transactions_per_recv = 16;
 };
@@ -9,38 +9,38 @@
 #include "multicast_streamer.h"
 
 
+constexpr int MultiCastStreamer::max_transactions_per_send;
+
 MultiCastStreamer::MultiCastStreamer (const char *ip, int port, int data_len)
     : Streamer (data_len, "streaming_board", ip, std::to_string (port))
 {
     strcpy (this->ip, ip);
     this->port = port;
     server = NULL;
-    is_streaming = false;
-    db = NULL;
+    transaction = NULL;
+    num_packages = 0;
+    packages_in_transaction = 0;
+    dropped_transactions = 0;
 }
 
 MultiCastStreamer::~MultiCastStreamer ()
 {
-    if ((streaming_thread.joinable ()) && (is_streaming))
-    {
-        is_streaming = false;
-        streaming_thread.join ();
-    }
+    stop_dispatching ();
     if (server != NULL)
     {
         delete server;
         server = NULL;
     }
-    if (db != NULL)
+    if (transaction != NULL)
     {
-        delete db;
-        db = NULL;
+        delete[] transaction;
+        transaction = NULL;
     }
 }
 
 int MultiCastStreamer::init_streamer ()
 {
-    if ((is_streaming) || (server != NULL) || (db != NULL))
+    if ((server != NULL) || (transaction != NULL))
     {
         Board::board_logger->error ("multicast streamer is running");
         return (int)BrainFlowExitCodes::GENERAL_ERROR;
@@ -56,51 +56,58 @@ int MultiCastStreamer::init_streamer ()
         return (int)BrainFlowExitCodes::GENERAL_ERROR;
     }
 
-    db = new DataBuffer (len, 1000);
-    if (!db->is_ready ())
+    num_packages = get_brainflow_batch_size ();
+    packages_in_transaction = 0;
+    int transaction_len = num_packages * len;
+    transaction = new double[transaction_len * MultiCastStreamer::max_transactions_per_send];
+    for (int i = 0; i < transaction_len * MultiCastStreamer::max_transactions_per_send; i++)
     {
-        Board::board_logger->error ("unable to prepare buffer for multicast");
-        delete db;
-        db = NULL;
-        delete server;
-        server = NULL;
-        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+        transaction[i] = 0.0;
     }
-
-    is_streaming = true;
-    streaming_thread = std::thread ([this] { this->thread_worker (); });
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
-void MultiCastStreamer::stream_data (double *data)
+// receivers expect exactly num_packages in each datagram, complete datagrams of one batch are sent
+// with one call
+void MultiCastStreamer::stream_batch (double *data, int count)
 {
-    db->add_data (data);
+    int max_packages = num_packages * MultiCastStreamer::max_transactions_per_send;
+    for (int i = 0; i < count; i++)
+    {
+        memcpy (transaction + packages_in_transaction * len, data + i * len, sizeof (double) * len);
+        packages_in_transaction++;
+        if (packages_in_transaction == max_packages)
+        {
+            send_transactions ();
+        }
+    }
+    if (packages_in_transaction >= num_packages)
+    {
+        send_transactions ();
+    }
 }
 
-void MultiCastStreamer::thread_worker ()
+// sends complete transactions, unsent and incomplete ones are moved to the beginning and sent with
+// the next batch
+void MultiCastStreamer::send_transactions ()
 {
-    int num_packages = get_brainflow_batch_size ();
     int transaction_len = num_packages * len;
-    double *transaction = new double[transaction_len];
-    for (int i = 0; i < transaction_len; i++)
+    int num_transactions = packages_in_transaction / num_packages;
+    int num_sent =
+        server->send_batch (transaction, (int)sizeof (double) * transaction_len, num_transactions);
+    if (num_sent < 0)
     {
-        transaction[i] = 0.0;
+        num_sent = 0;
     }
-    while (is_streaming)
+    if ((num_sent == 0) &&
+        (packages_in_transaction == num_packages * MultiCastStreamer::max_transactions_per_send))
     {
-        if (db->get_data_count () >= (size_t)num_packages)
-        {
-            db->get_data (num_packages, transaction);
-            server->send (transaction, sizeof (double) * transaction_len);
-        }
-        else
-        {
-#ifdef _WIN32
-            Sleep (1);
-#else
-            usleep (100);
-#endif
-        }
+        // no space for new packages, drop the oldest transaction
+        num_sent = 1;
+        dropped_transactions++;
     }
-    delete[] transaction;
+    int remaining = packages_in_transaction - num_sent * num_packages;
+    memmove (
+        transaction, transaction + num_sent * transaction_len, sizeof (double) * remaining * len);
+    packages_in_transaction = remaining;
 }
@@ -23,6 +23,7 @@ protected:
     std::vector<std::vector<double>> current_default_buf;
     std::vector<std::vector<double>> current_aux_buf;
     std::vector<std::vector<double>> current_anc_buf;
+    std::vector<double> packages_block; // packages from callback pushed at once
     std::vector<bool> new_eeg_data;
     std::vector<bool> new_ppg_data;
     double last_fifth_chan_timestamp; // used to determine 4 or 5 channels used
@@ -30,6 +31,8 @@ protected:
     double last_eeg_timestamp;        // used for timestamp correction
     double last_aux_timestamp;        // used for timestamp correction
 
+    void push_buffered_packages (std::vector<std::vector<double>> &packages, int preset);
+
 public:
     Muse (int board_id, struct BrainFlowInputParams params);
     ~Muse ();
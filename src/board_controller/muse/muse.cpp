@@ -699,8 +699,8 @@ void Muse::peripheral_on_eeg (simpleble_uuid_t service, simpleble_uuid_t charact
             {
                 current_default_buf[i][board_descr["default"]["timestamp_channel"].get<int> ()] =
                     last_eeg_timestamp + step * (i + 1);
-                push_package (&current_default_buf[i][0]);
             }
+            push_buffered_packages (current_default_buf, (int)BrainFlowPresets::DEFAULT_PRESET);
         }
         last_eeg_timestamp = current_timestamp;
         std::fill (new_eeg_data.begin (), new_eeg_data.end (), false);
@@ -764,8 +764,8 @@ void Muse::peripheral_on_gyro (
         {
             current_aux_buf[i][board_descr["auxiliary"]["timestamp_channel"].get<int> ()] =
                 last_aux_timestamp + step * (i + 1);
-            push_package (&current_aux_buf[i][0], (int)BrainFlowPresets::AUXILIARY_PRESET);
         }
+        push_buffered_packages (current_aux_buf, (int)BrainFlowPresets::AUXILIARY_PRESET);
     }
     last_aux_timestamp = current_timestamp;
 }
@@ -810,10 +810,27 @@ void Muse::peripheral_on_ppg (simpleble_uuid_t service, simpleble_uuid_t charact
             {
                 current_anc_buf[i][board_descr["ancillary"]["timestamp_channel"].get<int> ()] =
                     last_ppg_timestamp + step * (i + 1);
-                push_package (&current_anc_buf[i][0], (int)BrainFlowPresets::ANCILLARY_PRESET);
             }
+            push_buffered_packages (current_anc_buf, (int)BrainFlowPresets::ANCILLARY_PRESET);
         }
         last_ppg_timestamp = current_timestamp;
         std::fill (new_ppg_data.begin (), new_ppg_data.end (), false);
     }
 }
+
+// called under callback_lock, packages are copied to one block to lock board once
+void Muse::push_buffered_packages (std::vector<std::vector<double>> &packages, int preset)
+{
+    if (packages.empty ())
+    {
+        return;
+    }
+    size_t num_rows = packages[0].size ();
+    packages_block.resize (packages.size () * num_rows);
+    for (size_t i = 0; i < packages.size (); i++)
+    {
+        std::copy (
+            packages[i].begin (), packages[i].end (), packages_block.begin () + i * num_rows);
+    }
+    push_packages (packages_block.data (), (int)packages.size (), preset);
+}
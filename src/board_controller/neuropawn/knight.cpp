@@ -5,6 +5,7 @@
 #include "custom_cast.h"
 #include "knight.h"
 #include "serial.h"
+#include "serial_frame_reader.h"
 #include "timestamp.h"
 
 constexpr int Knight::start_byte;
@@ -148,38 +149,24 @@ void Knight::read_thread ()
     std::vector<int> eeg_channels = board_descr["default"]["eeg_channels"];
     std::vector<int> other_channels = board_descr["default"]["other_channels"];
 
+    // frames are start byte and 20 bytes of package, b contains package without start byte
+    SerialFrameReader reader (
+        serial, Knight::start_byte, 20, 20, Knight::end_byte, Knight::end_byte);
+    size_t skipped_bytes = 0;
+
     while (keep_alive)
     {
-        // checking the start byte
-        res = serial->read_from_serial_port (b, 1);
-        if (res != 1)
+        res = reader.read_frame (b);
+        if (res != 20)
         {
-            safe_logger (spdlog::level::debug, "unable to read 1 byte, {}");
+            safe_logger (spdlog::level::debug, "unable to read package");
             continue;
         }
-        if (b[0] != Knight::start_byte)
+        if (reader.get_skipped_bytes () != skipped_bytes)
         {
-            continue;
-        }
-
-        int remaining_bytes = 20;
-        int pos = 0;
-        while ((remaining_bytes > 0) && (keep_alive))
-        {
-            res = serial->read_from_serial_port (b + pos, remaining_bytes);
-            remaining_bytes -= res;
-            pos += res;
-        }
-
-        if (!keep_alive)
-        {
-            break;
-        }
-
-        if (b[19] != Knight::end_byte)
-        {
-            safe_logger (spdlog::level::warn, "Wrong end byte {}", b[19]);
-            continue;
+            safe_logger (spdlog::level::debug, "skipped {} bytes to find valid package",
+                reader.get_skipped_bytes () - skipped_bytes);
+            skipped_bytes = reader.get_skipped_bytes ();
         }
 
         // package number CHANGE TO 1 if not working
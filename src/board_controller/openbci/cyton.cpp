@@ -1,8 +1,10 @@
 #include <vector>
 
 #include "custom_cast.h"
+#include "openbci_exg_decoder.h"
 #include "cyton.h"
 #include "serial.h"
+#include "serial_frame_reader.h"
 #include "timestamp.h"
 
 #define START_BYTE 0xA0
@@ -52,49 +54,36 @@ void Cyton::read_thread ()
         package[i] = 0.0;
     }
     std::vector<int> eeg_channels = board_descr["default"]["eeg_channels"];
+    std::vector<double> eeg_values (eeg_channels.size ());
     double accel_scale = (double)(0.002 / (pow (2, 4)));
 
+    // frames are start byte and 32 bytes of package, b contains package without start byte
+    SerialFrameReader reader (serial, START_BYTE, 32, 32, END_BYTE_STANDARD, END_BYTE_MAX);
+    size_t skipped_bytes = 0;
+
     while (keep_alive)
     {
-        // check start byte
-        res = serial->read_from_serial_port (b, 1);
-        if (res != 1)
-        {
-            safe_logger (spdlog::level::debug, "unable to read 1 byte");
-            continue;
-        }
-        if (b[0] != START_BYTE)
+        res = reader.read_frame (b);
+        if (res != 32)
         {
+            safe_logger (spdlog::level::debug, "unable to read package");
             continue;
         }
-
-        int remaining_bytes = 32;
-        int pos = 0;
-        while ((remaining_bytes > 0) && (keep_alive))
+        if (reader.get_skipped_bytes () != skipped_bytes)
         {
-            res = serial->read_from_serial_port (b + pos, remaining_bytes);
-            remaining_bytes -= res;
-            pos += res;
-        }
-        if (!keep_alive)
-        {
-            break;
-        }
-
-        if ((b[31] < END_BYTE_STANDARD) || (b[31] > END_BYTE_MAX))
-        {
-            safe_logger (spdlog::level::warn, "Wrong end byte {}", b[31]);
-            continue;
+            safe_logger (spdlog::level::debug, "skipped {} bytes to find valid package",
+                reader.get_skipped_bytes () - skipped_bytes);
+            skipped_bytes = reader.get_skipped_bytes ();
         }
 
         // package num
         package[board_descr["default"]["package_num_channel"].get<int> ()] = (double)b[0];
         // eeg
+        decode_exg_channels (b + 1, (int)eeg_channels.size (), gain_tracker.get_scales (),
+            eeg_values.data ());
         for (unsigned int i = 0; i < eeg_channels.size (); i++)
         {
-            double eeg_scale = (double)(4.5 / float ((pow (2, 23) - 1)) /
-                gain_tracker.get_gain_for_channel (i) * 1000000.);
-            package[eeg_channels[i]] = eeg_scale * cast_24bit_to_int32 (b + 1 + 3 * i);
+            package[eeg_channels[i]] = eeg_values[i];
         }
         // end byte
         package[board_descr["default"]["other_channels"][0].get<int> ()] = (double)b[31];
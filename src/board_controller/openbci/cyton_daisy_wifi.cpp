@@ -1,5 +1,6 @@
 #include "cyton_daisy_wifi.h"
 #include "custom_cast.h"
+#include "openbci_exg_decoder.h"
 #include "timestamp.h"
 
 #ifndef _WIN32
@@ -113,12 +114,7 @@ void CytonDaisyWifi::read_thread ()
         {
             package[0] = (double)bytes[0];
             // eeg
-            for (int i = 0; i < 8; i++)
-            {
-                double eeg_scale = (double)(4.5 / float ((pow (2, 23) - 1)) /
-                    gain_tracker.get_gain_for_channel (i) * 1000000.);
-                package[i + 1] = eeg_scale * cast_24bit_to_int32 (bytes + 1 + 3 * i);
-            }
+            decode_exg_channels (bytes + 1, 8, gain_tracker.get_scales (), package + 1);
             // other_channels
             package[21] = (double)bytes[25];
             package[22] = (double)bytes[26];
@@ -130,12 +126,7 @@ void CytonDaisyWifi::read_thread ()
         else
         {
             // eeg
-            for (int i = 0; i < 8; i++)
-            {
-                double eeg_scale = (double)(4.5 / float ((pow (2, 23) - 1)) /
-                    gain_tracker.get_gain_for_channel (i + 8) * 1000000.);
-                package[i + 9] = eeg_scale * cast_24bit_to_int32 (bytes + 1 + 3 * i);
-            }
+            decode_exg_channels (bytes + 1, 8, gain_tracker.get_scales () + 8, package + 9);
             // need to average other_channels
             package[21] += (double)bytes[25];
             package[22] += (double)bytes[28];
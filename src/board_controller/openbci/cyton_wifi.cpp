@@ -1,6 +1,7 @@
 #include <vector>
 
 #include "custom_cast.h"
+#include "openbci_exg_decoder.h"
 #include "cyton_wifi.h"
 #include "timestamp.h"
 
@@ -67,6 +68,7 @@ void CytonWifi::read_thread ()
         package[i] = 0.0;
     }
     std::vector<int> eeg_channels = board_descr["default"]["eeg_channels"];
+    std::vector<double> eeg_values (eeg_channels.size ());
     double accel_scale = (double)(0.002 / (pow (2, 4)));
 
     while (keep_alive)
@@ -103,11 +105,11 @@ void CytonWifi::read_thread ()
         // package num
         package[board_descr["default"]["package_num_channel"].get<int> ()] = (double)bytes[0];
         // eeg
+        decode_exg_channels (bytes + 1, (int)eeg_channels.size (), gain_tracker.get_scales (),
+            eeg_values.data ());
         for (unsigned int i = 0; i < eeg_channels.size (); i++)
         {
-            double eeg_scale = (double)(4.5 / float ((pow (2, 23) - 1)) /
-                gain_tracker.get_gain_for_channel (i) * 1000000.);
-            package[eeg_channels[i]] = eeg_scale * cast_24bit_to_int32 (bytes + 1 + 3 * i);
+            package[eeg_channels[i]] = eeg_values[i];
         }
         package[board_descr["default"]["other_channels"][0].get<int> ()] =
             (double)bytes[31]; // end byte
@@ -10,6 +10,7 @@
 
 #include "custom_cast.h"
 #include "json.hpp"
+#include "openbci_exg_decoder.h"
 #include "timestamp.h"
 
 using json = nlohmann::json;
@@ -422,13 +423,8 @@ void Galea::read_thread ()
                 // exg (default preset)
                 exg_package[board_descr["default"]["package_num_channel"].get<int> ()] =
                     (double)b[0 + offset];
-                for (int i = 4, tmp_counter = 0; i < 20; i++, tmp_counter++)
-                {
-                    double exg_scale = (double)(4.5 / float ((pow (2, 23) - 1)) /
-                        gain_tracker.get_gain_for_channel (tmp_counter) * 1000000.);
-                    exg_package[i - 3] =
-                        exg_scale * (double)cast_24bit_to_int32 (b + offset + 5 + 3 * (i - 4));
-                }
+                decode_exg_channels (
+                    b + offset + 5, 16, gain_tracker.get_scales (), exg_package + 1);
                 double timestamp_device = 0.0;
                 memcpy (&timestamp_device, b + 64 + offset, 8);
                 timestamp_device /= 1000; // from ms to seconds
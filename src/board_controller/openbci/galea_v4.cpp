@@ -7,9 +7,11 @@
 #include <numeric>
 #include <regex>
 #include <sstream>
+#include <vector>
 
 #include "custom_cast.h"
 #include "json.hpp"
+#include "openbci_exg_decoder.h"
 #include "timestamp.h"
 
 using json = nlohmann::json;
@@ -22,6 +24,7 @@ constexpr int GaleaV4::package_size;
 constexpr int GaleaV4::max_num_packages;
 constexpr int GaleaV4::max_transaction_size;
 constexpr int GaleaV4::socket_timeout;
+constexpr int GaleaV4::max_transactions_per_recv;
 
 GaleaV4::GaleaV4 (struct BrainFlowInputParams params)
     : Board ((int)BoardIds::GALEA_BOARD_V4, params)
@@ -32,6 +35,8 @@ GaleaV4::GaleaV4 (struct BrainFlowInputParams params)
     initialized = false;
     state = (int)BrainFlowExitCodes::SYNC_TIMEOUT_ERROR;
     half_rtt = 0.0;
+    decode_state = NULL;
+    use_reactor = false;
 }
 
 GaleaV4::~GaleaV4 ()
@@ -259,7 +264,23 @@ int GaleaV4::start_stream (int buffer_size, const char *streamer_params)
     }
 
     keep_alive = true;
-    streaming_thread = std::thread ([this] { this->read_thread (); });
+    decode_state = new DecodeState (board_descr);
+    // shared reactor threads are used instead of own thread if enabled
+    IOReactor *reactor = IOReactor::get_instance ();
+    if (reactor != NULL)
+    {
+        res = reactor->add_socket (socket->get_socket_fd (), GaleaV4::max_transaction_size,
+            [this] (unsigned char *data, int size) { this->process_transaction (data, size); });
+        use_reactor = (res == (int)IOReactorReturnCodes::STATUS_OK);
+        if (!use_reactor)
+        {
+            safe_logger (spdlog::level::warn, "failed to add socket to io reactor: {}", res);
+        }
+    }
+    if (!use_reactor)
+    {
+        streaming_thread = std::thread ([this] { this->read_thread (); });
+    }
     // wait for data to ensure that everything is okay
     std::unique_lock<std::mutex> lk (this->m);
     auto sec = std::chrono::seconds (1);
@@ -284,7 +305,17 @@ int GaleaV4::stop_stream ()
     {
         keep_alive = false;
         is_streaming = false;
-        streaming_thread.join ();
+        if (use_reactor)
+        {
+            IOReactor::get_instance ()->remove_socket (socket->get_socket_fd ());
+            use_reactor = false;
+        }
+        else
+        {
+            streaming_thread.join ();
+        }
+        delete decode_state;
+        decode_state = NULL;
         this->state = (int)BrainFlowExitCodes::SYNC_TIMEOUT_ERROR;
         int res = socket->send ("s", 1);
         if (res != 1)
@@ -355,33 +386,58 @@ int GaleaV4::release_session ()
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
-void GaleaV4::read_thread ()
+GaleaV4::DecodeState::DecodeState (json &board_descr) : time_buffer (1, 11)
 {
-    int res;
-    unsigned char b[GaleaV4::max_transaction_size];
-    DataBuffer time_buffer (1, 11);
-    double latest_times[10];
-    for (int i = 0; i < GaleaV4::max_transaction_size; i++)
-    {
-        b[i] = 0;
-    }
+    for (int i = 0; i < 10; i++)
+    {
+        latest_times[i] = 0.0;
+    }
+    json exg_descr = board_descr["default"];
+    json aux_descr = board_descr["auxiliary"];
+    num_exg_rows = exg_descr["num_rows"];
+    num_aux_rows = aux_descr["num_rows"];
+    exg_block = new double[num_exg_rows * GaleaV4::max_num_packages];
+    aux_block = new double[num_aux_rows * GaleaV4::max_num_packages];
+    for (int i = 0; i < num_exg_rows * GaleaV4::max_num_packages; i++)
+    {
+        exg_block[i] = 0.0;
+    }
+    for (int i = 0; i < num_aux_rows * GaleaV4::max_num_packages; i++)
+    {
+        aux_block[i] = 0.0;
+    }
+    exg_package_num_channel = exg_descr["package_num_channel"];
+    exg_timestamp_channel = exg_descr["timestamp_channel"];
+    exg_other_channels = exg_descr["other_channels"].get<std::vector<int>> ();
+    aux_package_num_channel = aux_descr["package_num_channel"];
+    aux_timestamp_channel = aux_descr["timestamp_channel"];
+    aux_battery_channel = aux_descr["battery_channel"];
+    aux_other_channels = aux_descr["other_channels"].get<std::vector<int>> ();
+    ppg_channels = aux_descr["ppg_channels"].get<std::vector<int>> ();
+    eda_channel = aux_descr["eda_channels"][0];
+    temperature_channel = aux_descr["temperature_channels"][0];
+    accel_channels = aux_descr["accel_channels"].get<std::vector<int>> ();
+    gyro_channels = aux_descr["gyro_channels"].get<std::vector<int>> ();
+    magnetometer_channels = aux_descr["magnetometer_channels"].get<std::vector<int>> ();
+}
 
-    int num_exg_rows = board_descr["default"]["num_rows"];
-    int num_aux_rows = board_descr["auxiliary"]["num_rows"];
-    double *exg_package = new double[num_exg_rows];
-    double *aux_package = new double[num_aux_rows];
-    for (int i = 0; i < num_exg_rows; i++)
-    {
-        exg_package[i] = 0.0;
-    }
-    for (int i = 0; i < num_aux_rows; i++)
-    {
-        aux_package[i] = 0.0;
-    }
+GaleaV4::DecodeState::~DecodeState ()
+{
+    delete[] exg_block;
+    delete[] aux_block;
+}
+
+void GaleaV4::read_thread ()
+{
+    // all datagrams queued in socket are taken at once
+    std::vector<unsigned char> b (
+        GaleaV4::max_transaction_size * GaleaV4::max_transactions_per_recv, 0);
+    int sizes[GaleaV4::max_transactions_per_recv];
 
     while (keep_alive)
     {
-        res = socket->recv (b, GaleaV4::max_transaction_size);
+        int res = socket->recv_batch (
+            b.data (), GaleaV4::max_transaction_size, GaleaV4::max_transactions_per_recv, sizes);
         if (res == -1)
         {
 #ifdef _WIN32
@@ -391,149 +447,142 @@ void GaleaV4::read_thread ()
 #endif
             continue;
         }
-        if (res % GaleaV4::package_size != 0)
+        for (int i = 0; i < res; i++)
         {
-            if (res > 0)
+            if (sizes[i] > GaleaV4::max_transaction_size)
             {
-                // more likely its a string received, try to print it
-                b[res] = '\0';
-                safe_logger (spdlog::level::warn, "Received: {}", b);
+                safe_logger (spdlog::level::warn, "transaction with {} bytes is truncated to {}",
+                    sizes[i], GaleaV4::max_transaction_size);
+                continue;
             }
-            continue;
+            process_transaction (b.data () + i * GaleaV4::max_transaction_size, sizes[i]);
         }
-        else
+    }
+}
+
+void GaleaV4::process_transaction (unsigned char *b, int res)
+{
+    DecodeState &ds = *decode_state;
+    double accel_scale = (double)(8.0 / static_cast<double> (pow (2, 16) - 1));
+    double gyro_scale = (double)(1000.0 / static_cast<double> (pow (2, 16) - 1));
+    double magnetometer_scale_xy = (double)(2.6 / static_cast<double> (pow (2, 13) - 1));
+    double magnetometer_scale_z = (double)(5.0 / static_cast<double> (pow (2, 15) - 1));
+
+    if (res % GaleaV4::package_size != 0)
+    {
+        if (res > 0)
         {
-            int num_packages = res / GaleaV4::package_size;
-            int offset_last_package = GaleaV4::package_size * (num_packages - 1);
-            // calc delta between PC timestamp and device timestamp in last 10 packages,
-            // use this delta later on to assign timestamps
-            double pc_timestamp = get_timestamp ();
-            unsigned long long timestamp_last_package = 0.0;
-            memcpy (&timestamp_last_package, b + 88 + offset_last_package,
-                sizeof (unsigned long long)); // microseconds
-            double timestamp_last_package_converted =
-                static_cast<double> (timestamp_last_package) / 1000000.0; // convert to seconds
-            double time_delta = pc_timestamp - timestamp_last_package_converted;
-            time_buffer.add_data (&time_delta);
-            int num_time_deltas = (int)time_buffer.get_current_data (10, latest_times);
-            time_delta = 0.0;
-            for (int i = 0; i < num_time_deltas; i++)
-            {
-                time_delta += latest_times[i];
-            }
-            time_delta /= num_time_deltas;
+            // more likely its a string received, try to print it
+            b[res] = '\0';
+            safe_logger (spdlog::level::warn, "Received: {}", b);
+        }
+        return;
+    }
+
+    int num_packages = res / GaleaV4::package_size;
+    int offset_last_package = GaleaV4::package_size * (num_packages - 1);
+    // calc delta between PC timestamp and device timestamp in last 10 packages,
+    // use this delta later on to assign timestamps
+    double pc_timestamp = get_timestamp ();
+    unsigned long long timestamp_last_package = 0.0;
+    memcpy (&timestamp_last_package, b + 88 + offset_last_package,
+        sizeof (unsigned long long)); // microseconds
+    double timestamp_last_package_converted =
+        static_cast<double> (timestamp_last_package) / 1000000.0; // convert to seconds
+    double time_delta = pc_timestamp - timestamp_last_package_converted;
+    ds.time_buffer.add_data (&time_delta);
+    int num_time_deltas = (int)ds.time_buffer.get_current_data (10, ds.latest_times);
+    time_delta = 0.0;
+    for (int i = 0; i < num_time_deltas; i++)
+    {
+        time_delta += ds.latest_times[i];
+    }
+    time_delta /= num_time_deltas;
+
+    // inform main thread that everything is ok and first package was received
+    if (this->state != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        safe_logger (spdlog::level::info,
+            "received first package with {} bytes streaming is started", res);
+        {
+            std::lock_guard<std::mutex> lk (this->m);
+            this->state = (int)BrainFlowExitCodes::STATUS_OK;
+        }
+        this->cv.notify_one ();
+        safe_logger (spdlog::level::debug, "start streaming");
+    }
 
-            // inform main thread that everything is ok and first package was received
-            if (this->state != (int)BrainFlowExitCodes::STATUS_OK)
-            {
-                safe_logger (spdlog::level::info,
-                    "received first package with {} bytes streaming is started", res);
-                {
-                    std::lock_guard<std::mutex> lk (this->m);
-                    this->state = (int)BrainFlowExitCodes::STATUS_OK;
-                }
-                this->cv.notify_one ();
-                safe_logger (spdlog::level::debug, "start streaming");
-            }
+    int num_aux_packages = 0;
+    for (int cur_package = 0; cur_package < num_packages; cur_package++)
+    {
+        int offset = cur_package * GaleaV4::package_size;
+        // exg (default preset)
+        double *exg_package = ds.exg_block + cur_package * ds.num_exg_rows;
+        exg_package[ds.exg_package_num_channel] = (double)b[0 + offset];
+        decode_exg_channels (b + offset + 5, 24, gain_tracker.get_scales (), exg_package + 1);
+        unsigned long long timestamp_device = 0.0;
+        memcpy (&timestamp_device, b + 88 + offset,
+            sizeof (unsigned long long)); // reports microseconds
 
-            for (int cur_package = 0; cur_package < num_packages; cur_package++)
-            {
-                int offset = cur_package * GaleaV4::package_size;
-                // exg (default preset)
-                exg_package[board_descr["default"]["package_num_channel"].get<int> ()] =
-                    (double)b[0 + offset];
-                for (int i = 4, tmp_counter = 0; i < 28; i++, tmp_counter++)
-                {
-                    double exg_scale = (double)(4.5 / float ((pow (2, 23) - 1)) /
-                        gain_tracker.get_gain_for_channel (tmp_counter) * 1000000.);
-                    exg_package[i - 3] =
-                        exg_scale * (double)cast_24bit_to_int32 (b + offset + 5 + 3 * (i - 4));
-                }
-                unsigned long long timestamp_device = 0.0;
-                memcpy (&timestamp_device, b + 88 + offset,
-                    sizeof (unsigned long long)); // reports microseconds
-
-                double timestamp_device_converted = static_cast<double> (timestamp_device);
-                timestamp_device_converted /= 1000000.0; // convert to seconds
-
-                exg_package[board_descr["default"]["timestamp_channel"].get<int> ()] =
-                    timestamp_device_converted + time_delta - half_rtt;
-                exg_package[board_descr["default"]["other_channels"][0].get<int> ()] = pc_timestamp;
-                exg_package[board_descr["default"]["other_channels"][1].get<int> ()] =
-                    timestamp_device_converted;
-                push_package (exg_package);
-
-                // aux, 5 times smaller sampling rate
-                if (((int)b[0 + offset]) % 5 == 0)
-                {
-                    double accel_scale = (double)(8.0 / static_cast<double> (pow (2, 16) - 1));
-                    double gyro_scale = (double)(1000.0 / static_cast<double> (pow (2, 16) - 1));
-                    double magnetometer_scale_xy =
-                        (double)(2.6 / static_cast<double> (pow (2, 13) - 1));
-                    double magnetometer_scale_z =
-                        (double)(5.0 / static_cast<double> (pow (2, 15) - 1));
-                    aux_package[board_descr["auxiliary"]["package_num_channel"].get<int> ()] =
-                        (double)b[0 + offset];
-                    uint16_t temperature = 0;
-                    int32_t ppg_ir = 0;
-                    int32_t ppg_red = 0;
-                    float eda;
-                    memcpy (&temperature, b + 78 + offset, 2);
-                    memcpy (&eda, b + 1 + offset, 4);
-                    memcpy (&ppg_red, b + 80 + offset, 4);
-                    memcpy (&ppg_ir, b + 84 + offset, 4);
-                    // ppg
-                    aux_package[board_descr["auxiliary"]["ppg_channels"][0].get<int> ()] =
-                        (double)ppg_red;
-                    aux_package[board_descr["auxiliary"]["ppg_channels"][1].get<int> ()] =
-                        (double)ppg_ir;
-                    // eda
-                    aux_package[board_descr["auxiliary"]["eda_channels"][0].get<int> ()] =
-                        (double)eda;
-                    // temperature
-                    aux_package[board_descr["auxiliary"]["temperature_channels"][0].get<int> ()] =
-                        temperature / 100.0;
-                    // battery
-                    aux_package[board_descr["auxiliary"]["battery_channel"].get<int> ()] =
-                        (double)b[77 + offset];
-                    aux_package[board_descr["auxiliary"]["timestamp_channel"].get<int> ()] =
-                        timestamp_device_converted + time_delta - half_rtt;
-                    aux_package[board_descr["auxiliary"]["other_channels"][0].get<int> ()] =
-                        pc_timestamp;
-                    aux_package[board_descr["auxiliary"]["other_channels"][1].get<int> ()] =
-                        timestamp_device_converted;
-                    // accel
-                    aux_package[board_descr["auxiliary"]["accel_channels"][0].get<int> ()] =
-                        accel_scale * (double)cast_16bit_to_int32_swap_order (b + 96 + offset);
-                    aux_package[board_descr["auxiliary"]["accel_channels"][1].get<int> ()] =
-                        accel_scale * (double)cast_16bit_to_int32_swap_order (b + 98 + offset);
-                    aux_package[board_descr["auxiliary"]["accel_channels"][2].get<int> ()] =
-                        accel_scale * (double)cast_16bit_to_int32_swap_order (b + 100 + offset);
-                    // gyro
-                    aux_package[board_descr["auxiliary"]["gyro_channels"][0].get<int> ()] =
-                        gyro_scale * (double)cast_16bit_to_int32_swap_order (b + 102 + offset);
-                    aux_package[board_descr["auxiliary"]["gyro_channels"][1].get<int> ()] =
-                        gyro_scale * (double)cast_16bit_to_int32_swap_order (b + 104 + offset);
-                    aux_package[board_descr["auxiliary"]["gyro_channels"][2].get<int> ()] =
-                        gyro_scale * (double)cast_16bit_to_int32_swap_order (b + 106 + offset);
-                    // magnetometer
-                    aux_package[board_descr["auxiliary"]["magnetometer_channels"][0].get<int> ()] =
-                        magnetometer_scale_xy *
-                        (double)cast_13bit_to_int32_swap_order (b + 108 + offset);
-                    aux_package[board_descr["auxiliary"]["magnetometer_channels"][1].get<int> ()] =
-                        magnetometer_scale_xy *
-                        (double)cast_13bit_to_int32_swap_order (b + 110 + offset);
-                    aux_package[board_descr["auxiliary"]["magnetometer_channels"][2].get<int> ()] =
-                        magnetometer_scale_z *
-                        (double)cast_15bit_to_int32_swap_order (b + 112 + offset);
-
-                    push_package (aux_package, (int)BrainFlowPresets::AUXILIARY_PRESET);
-                }
-            }
+        double timestamp_device_converted = static_cast<double> (timestamp_device);
+        timestamp_device_converted /= 1000000.0; // convert to seconds
+
+        exg_package[ds.exg_timestamp_channel] = timestamp_device_converted + time_delta - half_rtt;
+        exg_package[ds.exg_other_channels[0]] = pc_timestamp;
+        exg_package[ds.exg_other_channels[1]] = timestamp_device_converted;
+
+        // aux, 5 times smaller sampling rate
+        if (((int)b[0 + offset]) % 5 == 0)
+        {
+            double *aux_package = ds.aux_block + num_aux_packages * ds.num_aux_rows;
+            num_aux_packages++;
+            aux_package[ds.aux_package_num_channel] = (double)b[0 + offset];
+            uint16_t temperature = 0;
+            int32_t ppg_ir = 0;
+            int32_t ppg_red = 0;
+            float eda;
+            memcpy (&temperature, b + 78 + offset, 2);
+            memcpy (&eda, b + 1 + offset, 4);
+            memcpy (&ppg_red, b + 80 + offset, 4);
+            memcpy (&ppg_ir, b + 84 + offset, 4);
+            // ppg
+            aux_package[ds.ppg_channels[0]] = (double)ppg_red;
+            aux_package[ds.ppg_channels[1]] = (double)ppg_ir;
+            // eda
+            aux_package[ds.eda_channel] = (double)eda;
+            // temperature
+            aux_package[ds.temperature_channel] = temperature / 100.0;
+            // battery
+            aux_package[ds.aux_battery_channel] = (double)b[77 + offset];
+            aux_package[ds.aux_timestamp_channel] =
+                timestamp_device_converted + time_delta - half_rtt;
+            aux_package[ds.aux_other_channels[0]] = pc_timestamp;
+            aux_package[ds.aux_other_channels[1]] = timestamp_device_converted;
+            // accel
+            aux_package[ds.accel_channels[0]] =
+                accel_scale * (double)cast_16bit_to_int32_swap_order (b + 96 + offset);
+            aux_package[ds.accel_channels[1]] =
+                accel_scale * (double)cast_16bit_to_int32_swap_order (b + 98 + offset);
+            aux_package[ds.accel_channels[2]] =
+                accel_scale * (double)cast_16bit_to_int32_swap_order (b + 100 + offset);
+            // gyro
+            aux_package[ds.gyro_channels[0]] =
+                gyro_scale * (double)cast_16bit_to_int32_swap_order (b + 102 + offset);
+            aux_package[ds.gyro_channels[1]] =
+                gyro_scale * (double)cast_16bit_to_int32_swap_order (b + 104 + offset);
+            aux_package[ds.gyro_channels[2]] =
+                gyro_scale * (double)cast_16bit_to_int32_swap_order (b + 106 + offset);
+            // magnetometer
+            aux_package[ds.magnetometer_channels[0]] = magnetometer_scale_xy *
+                (double)cast_13bit_to_int32_swap_order (b + 108 + offset);
+            aux_package[ds.magnetometer_channels[1]] = magnetometer_scale_xy *
+                (double)cast_13bit_to_int32_swap_order (b + 110 + offset);
+            aux_package[ds.magnetometer_channels[2]] = magnetometer_scale_z *
+                (double)cast_15bit_to_int32_swap_order (b + 112 + offset);
         }
     }
-    delete[] exg_package;
-    delete[] aux_package;
+    push_packages (ds.exg_block, num_packages);
+    push_packages (ds.aux_block, num_aux_packages, (int)BrainFlowPresets::AUXILIARY_PRESET);
 }
 
 int GaleaV4::calc_time (std::string &resp)
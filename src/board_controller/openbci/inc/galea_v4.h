@@ -8,6 +8,7 @@
 
 #include "board.h"
 #include "board_controller.h"
+#include "io_reactor.h"
 #include "openbci_gain_tracker.h"
 #include "socket_client_udp.h"
 
@@ -16,6 +17,35 @@ class GaleaV4 : public Board
 {
 
 private:
+    // parser state shared by read_thread and io reactor handler, json lookups are too slow for
+    // per sample decoding so channel indexes are cached
+    struct DecodeState
+    {
+        DataBuffer time_buffer;
+        double latest_times[10];
+        int num_exg_rows;
+        int num_aux_rows;
+        // packages decoded from one datagram are pushed at once, rows of blocks are filled in place
+        double *exg_block;
+        double *aux_block;
+        int exg_package_num_channel;
+        int exg_timestamp_channel;
+        std::vector<int> exg_other_channels;
+        int aux_package_num_channel;
+        int aux_timestamp_channel;
+        int aux_battery_channel;
+        std::vector<int> aux_other_channels;
+        std::vector<int> ppg_channels;
+        int eda_channel;
+        int temperature_channel;
+        std::vector<int> accel_channels;
+        std::vector<int> gyro_channels;
+        std::vector<int> magnetometer_channels;
+
+        DecodeState (json &board_descr);
+        ~DecodeState ();
+    };
+
     volatile bool keep_alive;
     volatile int state;
     volatile double half_rtt;
@@ -26,9 +56,12 @@ private:
     std::mutex m;
     std::condition_variable cv;
     GaleaV4GainTracker gain_tracker;
+    DecodeState *decode_state;
+    bool use_reactor;
 
     std::string find_device ();
     void read_thread ();
+    void process_transaction (unsigned char *b, int res);
     int calc_time (std::string &resp);
 
 
@@ -46,4 +79,5 @@ public:
     static constexpr int max_num_packages = 25;
     static constexpr int max_transaction_size = package_size * max_num_packages;
     static constexpr int socket_timeout = 2;
+    static constexpr int max_transactions_per_recv = 8;
 };
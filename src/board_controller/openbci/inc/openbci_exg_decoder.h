@@ -0,0 +1,10 @@
+#pragma once
+
+#define OPENBCI_EXG_BYTES_PER_CHANNEL 3
+
+
+// converts num_channels big endian 24 bit ADC values stored one after another to doubles, i-th
+// value is multiplied by scales[i] (see OpenBCIGainTracker::get_scales), result is the same as
+// scales[i] * cast_24bit_to_int32 (bytes + 3 * i)
+void decode_exg_channels (
+    const unsigned char *bytes, int num_channels, const double *scales, double *values);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <math.h>
 #include <stdlib.h>
 #include <string>
 #include <vector>
@@ -22,6 +23,17 @@ protected:
     std::vector<int> current_gains;
     std::vector<int> old_gains;
     std::vector<int> available_gain_values;
+    std::vector<double> scales; // microvolts per ADC count for current gains
+
+    // must be called after any change of current_gains
+    void update_scales ()
+    {
+        scales.resize (current_gains.size ());
+        for (size_t i = 0; i < current_gains.size (); i++)
+        {
+            scales[i] = get_scale_for_gain (current_gains[i]);
+        }
+    }
 
     int apply_single_command (std::string command)
     {
@@ -77,6 +89,13 @@ public:
         channel_letters = std::vector<char> {
             '1', '2', '3', '4', '5', '6', '7', '8', 'Q', 'W', 'E', 'R', 'T', 'Y', 'U', 'I'};
         available_gain_values = std::vector<int> {1, 2, 4, 6, 8, 12, 24};
+        update_scales ();
+    }
+
+    // scale for 24 bit ADC values of ADS1299
+    static double get_scale_for_gain (int gain)
+    {
+        return (double)(4.5 / float ((pow (2, 23) - 1)) / gain * 1000000.);
     }
 
     virtual ~OpenBCIGainTracker ()
@@ -110,6 +129,8 @@ public:
                 i++;
             }
         }
+        // derived classes call it after their own changes of gains
+        update_scales ();
         return res;
     }
 
@@ -122,9 +143,16 @@ public:
         return current_gains[channel];
     }
 
+    // scales for all channels, updated in place on gain changes, pointer stays valid
+    const double *get_scales ()
+    {
+        return scales.data ();
+    }
+
     virtual void revert_config ()
     {
         std::copy (old_gains.begin (), old_gains.end (), current_gains.begin ());
+        update_scales ();
     }
 };
 
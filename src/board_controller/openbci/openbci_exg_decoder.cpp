@@ -0,0 +1,45 @@
+#include <stdint.h>
+
+#include "openbci_exg_decoder.h"
+
+// 4 channels are unpacked with one shuffle, SSSE3 is used only if it is enabled for the compiler
+#if defined(__SSSE3__) || defined(__AVX__)
+#include <tmmintrin.h>
+#define EXG_DECODER_SSSE3
+#endif
+
+
+static inline int32_t unpack_24bit (const unsigned char *bytes)
+{
+    // value is placed into the upper bytes and shifted back to extend the sign without branches
+    uint32_t value = ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) |
+        ((uint32_t)bytes[2] << 8);
+    return (int32_t)value >> 8;
+}
+
+void decode_exg_channels (
+    const unsigned char *bytes, int num_channels, const double *scales, double *values)
+{
+    int i = 0;
+#ifdef EXG_DECODER_SSSE3
+    // reverses byte order of each 3 byte value and puts it into upper bytes of 32 bit lane
+    const __m128i shuffle = _mm_setr_epi8 (
+        (char)0x80, 2, 1, 0, (char)0x80, 5, 4, 3, (char)0x80, 8, 7, 6, (char)0x80, 11, 10, 9);
+    int num_bytes = num_channels * OPENBCI_EXG_BYTES_PER_CHANNEL;
+    // 16 bytes are loaded for 12 bytes of 4 channels, dont read beyond channel data
+    for (; i * OPENBCI_EXG_BYTES_PER_CHANNEL + 16 <= num_bytes; i += 4)
+    {
+        const unsigned char *ptr = bytes + i * OPENBCI_EXG_BYTES_PER_CHANNEL;
+        __m128i raw = _mm_loadu_si128 ((const __m128i *)ptr);
+        __m128i ints = _mm_srai_epi32 (_mm_shuffle_epi8 (raw, shuffle), 8);
+        __m128d low = _mm_cvtepi32_pd (ints);
+        __m128d high = _mm_cvtepi32_pd (_mm_shuffle_epi32 (ints, _MM_SHUFFLE (1, 0, 3, 2)));
+        _mm_storeu_pd (values + i, _mm_mul_pd (low, _mm_loadu_pd (scales + i)));
+        _mm_storeu_pd (values + i + 2, _mm_mul_pd (high, _mm_loadu_pd (scales + i + 2)));
+    }
+#endif
+    for (; i < num_channels; i++)
+    {
+        values[i] = scales[i] * (double)unpack_24bit (bytes + i * OPENBCI_EXG_BYTES_PER_CHANNEL);
+    }
+}
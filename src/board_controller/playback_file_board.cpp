@@ -19,7 +19,10 @@
 #define NEW_TIMESTAMPS "new_timestamps"
 #define OLD_TIMESTAMPS "old_timestamps"
 #define SET_INDEX_PREFIX "set_index_percentage:"
-#define MAX_LINE_LENGTH 8192
+#define SET_TIMESTAMP_PREFIX "set_index_timestamp:"
+#define SET_SPEED_PREFIX "playback_speed:"
+#define MAX_SPEED "max"
+#define MAX_PLAYBACK_SPEED 1000.0
 
 
 PlaybackFileBoard::PlaybackFileBoard (struct BrainFlowInputParams params)
@@ -32,8 +35,14 @@ PlaybackFileBoard::PlaybackFileBoard (struct BrainFlowInputParams params)
     loopback = false;
     initialized = false;
     use_new_timestamps = true;
+    playback_speed = 1.0;
+    buffer_size = 0;
     pos_percentage.resize (3);
     std::fill (pos_percentage.begin (), pos_percentage.end (), -1);
+    pos_timestamp.resize (3);
+    std::fill (pos_timestamp.begin (), pos_timestamp.end (), -1);
+    sources.resize (3);
+    std::fill (sources.begin (), sources.end (), (PlaybackFileSource *)NULL);
 }
 
 PlaybackFileBoard::~PlaybackFileBoard ()
@@ -74,44 +83,19 @@ int PlaybackFileBoard::prepare_session ()
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
 
-    if (!params.file.empty ())
+    std::string files[3] = {params.file, params.file_aux, params.file_anc};
+    for (int preset = 0; preset < 3; preset++)
     {
-        std::vector<long int> offsets;
-        int res = get_file_offsets (params.file, offsets);
-        if (res != (int)BrainFlowExitCodes::STATUS_OK)
-        {
-            return res;
-        }
-        else
-        {
-            file_offsets.push_back (offsets);
-        }
-    }
-    if (!params.file_aux.empty ())
-    {
-        std::vector<long int> offsets;
-        int res = get_file_offsets (params.file_aux, offsets);
-        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        if (files[preset].empty ())
         {
-            return res;
-        }
-        else
-        {
-            file_offsets.push_back (offsets);
+            continue;
         }
-    }
-    if (!params.file_anc.empty ())
-    {
-        std::vector<long int> offsets;
-        int res = get_file_offsets (params.file_anc, offsets);
+        int res = open_source (preset, files[preset]);
         if (res != (int)BrainFlowExitCodes::STATUS_OK)
         {
+            free_sources ();
             return res;
         }
-        else
-        {
-            file_offsets.push_back (offsets);
-        }
     }
 
     initialized = true;
@@ -132,22 +116,16 @@ int PlaybackFileBoard::start_stream (int buffer_size, const char *streamer_param
     {
         return res;
     }
+    this->buffer_size = buffer_size;
 
     keep_alive = true;
-    if (!params.file.empty ())
-    {
-        streaming_threads.push_back (std::thread (
-            [this] { this->read_thread ((int)BrainFlowPresets::DEFAULT_PRESET, params.file); }));
-    }
-    if (!params.file_aux.empty ())
-    {
-        streaming_threads.push_back (std::thread ([this]
-            { this->read_thread ((int)BrainFlowPresets::AUXILIARY_PRESET, params.file_aux); }));
-    }
-    if (!params.file_anc.empty ())
+    for (int preset = 0; preset < (int)sources.size (); preset++)
     {
-        streaming_threads.push_back (std::thread ([this]
-            { this->read_thread ((int)BrainFlowPresets::ANCILLARY_PRESET, params.file_anc); }));
+        if (sources[preset] != NULL)
+        {
+            streaming_threads.push_back (
+                std::thread ([this, preset] { this->read_thread (preset); }));
+        }
     }
 
     return (int)BrainFlowExitCodes::STATUS_OK;
@@ -179,11 +157,11 @@ int PlaybackFileBoard::release_session ()
         free_packages ();
         initialized = false;
     }
-    file_offsets.clear ();
+    free_sources ();
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
-void PlaybackFileBoard::read_thread (int preset, std::string file)
+void PlaybackFileBoard::read_thread (int preset)
 {
     std::string preset_str = preset_to_string (preset);
     if (board_descr.find (preset_str) == board_descr.end ())
@@ -192,14 +170,7 @@ void PlaybackFileBoard::read_thread (int preset, std::string file)
         return;
     }
 
-    FILE *fp;
-    fp = fopen (file.c_str (), "rb");
-    if (fp == NULL)
-    {
-        safe_logger (spdlog::level::err, "failed to open file in thread");
-        return;
-    }
-
+    PlaybackFileSource *source = sources[preset];
     json board_preset = board_descr[preset_str];
     int num_rows = board_preset["num_rows"];
     double *package = new double[num_rows];
@@ -207,11 +178,22 @@ void PlaybackFileBoard::read_thread (int preset, std::string file)
     {
         package[i] = 0.0;
     }
-    char buf[MAX_LINE_LENGTH];
     double last_timestamp = -1.0;
     bool new_timestamps = use_new_timestamps; // to prevent changing during streaming
     int timestamp_channel = board_preset["timestamp_channel"];
     double accumulated_time_delta = 0.0;
+    double sampling_rate = board_preset["sampling_rate"];
+    // new timestamps keep recorded intervals for any speed: generated = recorded + offset
+    double timestamp_offset = 0.0;
+    bool offset_valid = false;
+    double last_generated_timestamp = -1.0;
+    BaseDataBuffer *db = NULL;
+    lock.lock ();
+    if (dbs.find (preset) != dbs.end ())
+    {
+        db = dbs[preset];
+    }
+    lock.unlock ();
 
     bool reached_end = false;
     while (keep_alive)
@@ -220,31 +202,43 @@ void PlaybackFileBoard::read_thread (int preset, std::string file)
         // prevent race condition with another config_board method call
         lock.lock ();
         double cur_index = pos_percentage[preset];
+        double cur_timestamp = pos_timestamp[preset];
+        pos_percentage[preset] = -1;
+        pos_timestamp[preset] = -1;
+        lock.unlock ();
         if ((int)cur_index >= 0)
         {
-            int new_pos = (int)(cur_index * (file_offsets[preset].size () / 100.0));
-            try
+            if (source->seek_percentage (cur_index) == (int)BrainFlowExitCodes::STATUS_OK)
             {
-                fseek (fp, file_offsets[preset][new_pos], SEEK_SET);
-                safe_logger (spdlog::level::trace, "set position in a file to {}", new_pos);
+                safe_logger (spdlog::level::trace, "set position in a file to {}%", cur_index);
             }
-            catch (...)
+            else
             {
                 // should never happen since input is already validated
                 safe_logger (spdlog::level::warn, "invalid position in a file");
             }
             last_timestamp = -1;
-            pos_percentage[preset] = -1;
+            offset_valid = false;
+            reached_end = false;
         }
-        lock.unlock ();
-        char *res = fgets (buf, sizeof (buf), fp);
-        if ((loopback) && (res == NULL))
+        if (cur_timestamp >= 0)
+        {
+            source->seek_timestamp (cur_timestamp);
+            safe_logger (spdlog::level::trace, "set position in a file to timestamp {:.6f}",
+                cur_timestamp);
+            last_timestamp = -1;
+            offset_valid = false;
+            reached_end = false;
+        }
+        int res = source->read_package (package);
+        if ((loopback) && (res == (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR))
         {
-            fseek (fp, 0, SEEK_SET); // go to beginning'
+            source->rewind (); // go to beginning
             last_timestamp = -1.0;
+            offset_valid = false;
             continue;
         }
-        if ((!loopback) && (res == NULL))
+        if ((!loopback) && (res == (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR))
         {
             if (!reached_end)
             {
@@ -263,44 +257,23 @@ void PlaybackFileBoard::read_thread (int preset, std::string file)
 #endif
             continue;
         }
-        // res not NULL
-        std::string tsv_string (buf);
-        std::stringstream ss (tsv_string);
-        std::vector<std::string> splitted;
-        std::string tmp;
-        char sep = '\t';
-        if (tsv_string.find ('\t') == std::string::npos)
-        {
-            sep = ',';
-        }
-        while (std::getline (ss, tmp, sep))
-        {
-            if (tmp != "\n")
-            {
-                splitted.push_back (tmp);
-            }
-        }
-        if (splitted.size () != num_rows)
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
         {
             safe_logger (spdlog::level::err,
-                "invalid string in file, check provided board id. String size {}, expected size {}",
-                splitted.size (), num_rows);
+                "invalid string in file, check provided board id. Expected size {}", num_rows);
             continue;
         }
-        for (int i = 0; i < num_rows; i++)
+        double speed = playback_speed;
+        if (speed <= 0)
         {
-            try
-            {
-                package[i] = std::stod (splitted[i]);
-            }
-            catch (...)
-            {
-                safe_logger (spdlog::level::err, "failed to parse value: {}", splitted[i].c_str ());
-            }
+            // no sleeps, wait only if DataBuffer has no space for new package
+            wait_for_consumer (db);
+            accumulated_time_delta = 0.0;
         }
-        if (last_timestamp > 0)
+        else if (last_timestamp > 0)
         {
-            double time_wait = (package[timestamp_channel] - last_timestamp) * 1000; // in ms
+            double time_wait =
+                (package[timestamp_channel] - last_timestamp) * 1000 / speed; // in ms
             if (time_wait - accumulated_time_delta > 1)
             {
 #ifdef _WIN32
@@ -319,11 +292,26 @@ void PlaybackFileBoard::read_thread (int preset, std::string file)
 
         if (new_timestamps)
         {
-            package[timestamp_channel] = get_timestamp ();
+            double min_timestamp = -1.0;
+            if ((last_generated_timestamp > 0) && (sampling_rate > 0))
+            {
+                min_timestamp = last_generated_timestamp + 1.0 / sampling_rate;
+            }
+            if (!offset_valid)
+            {
+                // after start, seek or loop continue from current time, after faster playback
+                // generated time can be ahead of wall clock
+                double next_timestamp = std::max (get_timestamp (), min_timestamp);
+                timestamp_offset = next_timestamp - package[timestamp_channel];
+                offset_valid = true;
+            }
+            // timestamps never go back even if recorded ones do
+            package[timestamp_channel] =
+                std::max (package[timestamp_channel] + timestamp_offset, min_timestamp);
         }
+        last_generated_timestamp = package[timestamp_channel];
         push_package (package, preset);
     }
-    fclose (fp);
     delete[] package;
 }
 
@@ -370,6 +358,65 @@ int PlaybackFileBoard::config_board (std::string config, std::string &response)
             return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
         }
     }
+    else if (strncmp (config.c_str (), SET_SPEED_PREFIX, strlen (SET_SPEED_PREFIX)) == 0)
+    {
+        std::string speed_str = config.substr (strlen (SET_SPEED_PREFIX));
+        if (speed_str == MAX_SPEED)
+        {
+            playback_speed = 0.0;
+            return (int)BrainFlowExitCodes::STATUS_OK;
+        }
+        double new_speed = 0.0;
+        try
+        {
+            new_speed = std::stod (speed_str);
+        }
+        catch (const std::exception &e)
+        {
+            safe_logger (spdlog::level::err, "need to write a number or {} after {}, exception: {}",
+                MAX_SPEED, SET_SPEED_PREFIX, e.what ());
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        if ((new_speed <= 0) || (new_speed > MAX_PLAYBACK_SPEED))
+        {
+            safe_logger (spdlog::level::err, "playback speed should be in range (0, {}]",
+                MAX_PLAYBACK_SPEED);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        playback_speed = new_speed;
+    }
+    else if (strncmp (config.c_str (), SET_TIMESTAMP_PREFIX, strlen (SET_TIMESTAMP_PREFIX)) == 0)
+    {
+        double new_timestamp = 0.0;
+        try
+        {
+            new_timestamp = std::stod (config.substr (strlen (SET_TIMESTAMP_PREFIX)));
+        }
+        catch (const std::exception &e)
+        {
+            safe_logger (spdlog::level::err, "need to write a number after {}, exception is: {}",
+                SET_TIMESTAMP_PREFIX, e.what ());
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        // timestamps are recorded timestamps from the file, at least one file should contain it
+        bool in_range = false;
+        for (PlaybackFileSource *source : sources)
+        {
+            if ((source != NULL) && (new_timestamp <= source->get_last_timestamp ()))
+            {
+                in_range = true;
+            }
+        }
+        if ((!in_range) || (new_timestamp < 0))
+        {
+            safe_logger (spdlog::level::err, "timestamp {:.6f} is out of recorded range",
+                new_timestamp);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        lock.lock ();
+        std::fill (pos_timestamp.begin (), pos_timestamp.end (), new_timestamp);
+        lock.unlock ();
+    }
     else
     {
         safe_logger (spdlog::level::warn, "invalid config string {}", config);
@@ -378,36 +425,57 @@ int PlaybackFileBoard::config_board (std::string config, std::string &response)
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
-int PlaybackFileBoard::get_file_offsets (std::string filename, std::vector<long int> &offsets)
+void PlaybackFileBoard::wait_for_consumer (BaseDataBuffer *db)
 {
-    offsets.clear ();
-
-    FILE *fp = fopen (filename.c_str (), "rb");
-    if (fp == NULL)
+    if (db == NULL)
     {
-        safe_logger (spdlog::level::err, "failed to open file: {}", filename.c_str ());
-        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        return;
     }
-
-    char buf[MAX_LINE_LENGTH];
-    long int bytes_read = 0;
-    while (true)
+    // unread samples are never overwritten, streamers have their own overflow policies
+    while ((keep_alive) && (playback_speed <= 0) && (db->get_data_count () >= (size_t)buffer_size))
     {
-        offsets.push_back (bytes_read);
-        char *res = fgets (buf, sizeof (buf), fp);
-        bytes_read += (long int)strlen (buf);
-        if (res == NULL)
-        {
-            break;
-        }
+#ifdef _WIN32
+        Sleep (1);
+#else
+        usleep (1000);
+#endif
     }
+}
 
-    fclose (fp);
-    if (offsets.size () < 2)
+int PlaybackFileBoard::open_source (int preset, std::string filename)
+{
+    std::string preset_str = preset_to_string (preset);
+    if (board_descr.find (preset_str) == board_descr.end ())
     {
-        safe_logger (spdlog::level::err, "empty file: {}", filename);
-        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        // file is ignored, the same as if there is no preset in streaming board
+        safe_logger (spdlog::level::err, "no preset {} for board {}", preset, board_id);
+        return (int)BrainFlowExitCodes::STATUS_OK;
     }
-
+    int num_rows = board_descr[preset_str]["num_rows"];
+    int timestamp_channel = board_descr[preset_str]["timestamp_channel"];
+    PlaybackFileSource *source =
+        PlaybackFileSource::create (filename, num_rows, timestamp_channel);
+    auto start = std::chrono::high_resolution_clock::now ();
+    int res = source->open ();
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        safe_logger (spdlog::level::err, "failed to open file or file is empty: {}", filename);
+        delete source;
+        return res;
+    }
+    auto stop = std::chrono::high_resolution_clock::now ();
+    safe_logger (spdlog::level::debug, "opened {} with {} packages in {} ms", filename,
+        source->get_num_packages (),
+        std::chrono::duration_cast<std::chrono::milliseconds> (stop - start).count ());
+    sources[preset] = source;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
+
+void PlaybackFileBoard::free_sources ()
+{
+    for (size_t i = 0; i < sources.size (); i++)
+    {
+        delete sources[i];
+        sources[i] = NULL;
+    }
+}
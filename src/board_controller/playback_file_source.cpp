@@ -0,0 +1,410 @@
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+
+#include "brainflow_constants.h"
+#include "numeric_parser.h"
+#include "playback_file_source.h"
+
+
+PlaybackFileSource *PlaybackFileSource::create (
+    const std::string &file_name, int num_rows, int timestamp_channel)
+{
+    if (is_binary_file (file_name.c_str ()))
+    {
+        return new BinaryPlaybackFileSource (file_name, num_rows, timestamp_channel);
+    }
+    return new TextPlaybackFileSource (file_name, num_rows, timestamp_channel);
+}
+
+
+///////////////////////////////
+///////// Text Files //////////
+///////////////////////////////
+
+TextPlaybackFileSource::TextPlaybackFileSource (
+    const std::string &file_name, int num_rows, int timestamp_channel)
+    : PlaybackFileSource (file_name, num_rows, timestamp_channel), mapped_file (file_name.c_str ())
+{
+    data = NULL;
+    size = 0;
+    position = 0;
+    separator = '\t';
+    num_lines = 0;
+}
+
+int TextPlaybackFileSource::open ()
+{
+    if (mapped_file.open () != (int)MappedFileReturnCodes::STATUS_OK)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    data = mapped_file.get_data ();
+    size = mapped_file.get_size ();
+    if (size == 0)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int64_t first_line_end = get_line_end (0);
+    separator = (memchr (data, '\t', (size_t)first_line_end) != NULL) ? '\t' : ',';
+    if (!load_index ())
+    {
+        build_index ();
+        save_index ();
+    }
+    position = 0;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int64_t TextPlaybackFileSource::get_line_end (int64_t offset)
+{
+    const char *line_end = (const char *)memchr (data + offset, '\n', (size_t)(size - offset));
+    return (line_end == NULL) ? size : (int64_t)(line_end - data);
+}
+
+int64_t TextPlaybackFileSource::skip_lines (int64_t offset, int64_t count)
+{
+    for (int64_t i = 0; (i < count) && (offset < size); i++)
+    {
+        offset = get_line_end (offset) + 1;
+    }
+    return std::min (offset, size);
+}
+
+bool TextPlaybackFileSource::parse_timestamp (int64_t offset, int64_t line_end, double *timestamp)
+{
+    const char *pos = data + offset;
+    const char *end = data + line_end;
+    for (int i = 0; i < timestamp_channel; i++)
+    {
+        const char *next = (const char *)memchr (pos, separator, (size_t)(end - pos));
+        if (next == NULL)
+        {
+            return false;
+        }
+        pos = next + 1;
+    }
+    return parse_double (&pos, end, timestamp);
+}
+
+int TextPlaybackFileSource::parse_line (int64_t offset, int64_t line_end, double *package)
+{
+    const char *pos = data + offset;
+    const char *end = data + line_end;
+    // trailing separator is allowed
+    while ((end > pos) && ((end[-1] == '\r') || (end[-1] == ' ') || (end[-1] == separator)))
+    {
+        end--;
+    }
+    for (int i = 0; i < num_rows; i++)
+    {
+        if (!parse_double (&pos, end, &package[i]))
+        {
+            return (int)BrainFlowExitCodes::GENERAL_ERROR;
+        }
+        while ((pos < end) && (*pos == ' '))
+        {
+            pos++;
+        }
+        if (i != num_rows - 1)
+        {
+            if ((pos == end) || (*pos != separator))
+            {
+                return (int)BrainFlowExitCodes::GENERAL_ERROR;
+            }
+            pos++;
+        }
+    }
+    return (pos == end) ? (int)BrainFlowExitCodes::STATUS_OK :
+                          (int)BrainFlowExitCodes::GENERAL_ERROR;
+}
+
+int TextPlaybackFileSource::read_package (double *package)
+{
+    while (position < size)
+    {
+        int64_t offset = position;
+        int64_t line_end = get_line_end (offset);
+        position = std::min (line_end + 1, size);
+        const char *pos = data + offset;
+        while ((pos < data + line_end) && ((*pos == ' ') || (*pos == '\r')))
+        {
+            pos++;
+        }
+        if (pos == data + line_end)
+        {
+            continue; // skip empty lines
+        }
+        return parse_line (offset, line_end, package);
+    }
+    return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+}
+
+void TextPlaybackFileSource::rewind ()
+{
+    position = 0;
+}
+
+int TextPlaybackFileSource::seek_percentage (double percentage)
+{
+    if ((percentage < 0) || (percentage >= 100) || (index.empty ()))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int64_t line = (int64_t)(percentage * num_lines / 100.0);
+    line = std::min (line, num_lines - 1);
+    const struct PlaybackIndexEntry &entry = index[(size_t)(line / PLAYBACK_INDEX_STRIDE)];
+    position = skip_lines (entry.offset, line - entry.line);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int TextPlaybackFileSource::seek_timestamp (double timestamp)
+{
+    if (index.empty ())
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // last entry with timestamp <= requested one, timestamps in recordings are not decreasing
+    std::vector<struct PlaybackIndexEntry>::iterator it = std::upper_bound (index.begin (),
+        index.end (), timestamp,
+        [] (double value, const struct PlaybackIndexEntry &entry)
+        { return value < entry.timestamp; });
+    if (it != index.begin ())
+    {
+        --it;
+    }
+    int64_t offset = it->offset;
+    while (offset < size)
+    {
+        int64_t line_end = get_line_end (offset);
+        double line_timestamp = 0.0;
+        if ((parse_timestamp (offset, line_end, &line_timestamp)) && (line_timestamp >= timestamp))
+        {
+            break;
+        }
+        offset = line_end + 1;
+    }
+    position = std::min (offset, size);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int64_t TextPlaybackFileSource::get_num_packages ()
+{
+    return num_lines;
+}
+
+void TextPlaybackFileSource::build_index ()
+{
+    index.clear ();
+    num_lines = 0;
+    double timestamp = 0.0;
+    bool timestamp_found = false;
+    int64_t last_line = -1;
+    int64_t last_line_end = 0;
+    int64_t offset = 0;
+    while (offset < size)
+    {
+        int64_t line_end = get_line_end (offset);
+        if (num_lines % PLAYBACK_INDEX_STRIDE == 0)
+        {
+            // invalid lines keep timestamp from previous entry to keep index sorted
+            double line_timestamp = 0.0;
+            if (parse_timestamp (offset, line_end, &line_timestamp))
+            {
+                timestamp = line_timestamp;
+                if (!timestamp_found)
+                {
+                    first_timestamp = timestamp;
+                    timestamp_found = true;
+                }
+            }
+            struct PlaybackIndexEntry entry;
+            entry.offset = offset;
+            entry.line = num_lines;
+            entry.timestamp = timestamp;
+            index.push_back (entry);
+        }
+        if (line_end > offset)
+        {
+            last_line = offset;
+            last_line_end = line_end;
+        }
+        num_lines++;
+        offset = line_end + 1;
+    }
+    last_timestamp = first_timestamp;
+    if (last_line >= 0)
+    {
+        double line_timestamp = 0.0;
+        if (parse_timestamp (last_line, last_line_end, &line_timestamp))
+        {
+            last_timestamp = line_timestamp;
+        }
+    }
+}
+
+bool TextPlaybackFileSource::load_index ()
+{
+    std::string index_file = file_name + PLAYBACK_INDEX_EXTENSION;
+    FILE *fp = fopen (index_file.c_str (), "rb");
+    if (fp == NULL)
+    {
+        return false;
+    }
+    struct PlaybackIndexHeader header;
+    bool res = (fread (&header, sizeof (header), 1, fp) == 1) &&
+        (memcmp (header.magic, PLAYBACK_INDEX_MAGIC, sizeof (PLAYBACK_INDEX_MAGIC)) == 0) &&
+        (header.version == PLAYBACK_INDEX_VERSION) && (header.stride == PLAYBACK_INDEX_STRIDE) &&
+        (header.file_size == size) && (header.file_mtime == mapped_file.get_mtime ()) &&
+        (header.separator == (int32_t)separator) &&
+        (header.timestamp_channel == (int32_t)timestamp_channel) &&
+        (header.num_entries ==
+            (header.num_lines + PLAYBACK_INDEX_STRIDE - 1) / PLAYBACK_INDEX_STRIDE);
+    if (res)
+    {
+        index.resize ((size_t)header.num_entries);
+        res = (fread (index.data (), sizeof (struct PlaybackIndexEntry), index.size (), fp) ==
+            index.size ());
+    }
+    fclose (fp);
+    if (!res)
+    {
+        index.clear ();
+        return false;
+    }
+    num_lines = header.num_lines;
+    first_timestamp = header.first_timestamp;
+    last_timestamp = header.last_timestamp;
+    return true;
+}
+
+void TextPlaybackFileSource::save_index ()
+{
+    struct PlaybackIndexHeader header;
+    memset (&header, 0, sizeof (header));
+    memcpy (header.magic, PLAYBACK_INDEX_MAGIC, sizeof (PLAYBACK_INDEX_MAGIC));
+    header.version = PLAYBACK_INDEX_VERSION;
+    header.stride = PLAYBACK_INDEX_STRIDE;
+    header.file_size = size;
+    header.file_mtime = mapped_file.get_mtime ();
+    header.num_lines = num_lines;
+    header.num_entries = (int64_t)index.size ();
+    header.first_timestamp = first_timestamp;
+    header.last_timestamp = last_timestamp;
+    header.separator = (int32_t)separator;
+    header.timestamp_channel = (int32_t)timestamp_channel;
+
+    // cache is optional, folder with recording may be read only
+    std::string index_file = file_name + PLAYBACK_INDEX_EXTENSION;
+    FILE *fp = fopen (index_file.c_str (), "wb");
+    if (fp == NULL)
+    {
+        return;
+    }
+    bool res = (fwrite (&header, sizeof (header), 1, fp) == 1) &&
+        (fwrite (index.data (), sizeof (struct PlaybackIndexEntry), index.size (), fp) ==
+            index.size ());
+    fclose (fp);
+    if (!res)
+    {
+        remove (index_file.c_str ());
+    }
+}
+
+
+///////////////////////////////
+//////// Binary Files /////////
+///////////////////////////////
+
+BinaryPlaybackFileSource::BinaryPlaybackFileSource (
+    const std::string &file_name, int num_rows, int timestamp_channel)
+    : PlaybackFileSource (file_name, num_rows, timestamp_channel), reader (file_name.c_str ())
+{
+    position = 0;
+}
+
+int BinaryPlaybackFileSource::open ()
+{
+    if ((reader.open () != (int)BinaryFileReturnCodes::STATUS_OK) ||
+        (reader.get_header ().num_rows != num_rows) || (reader.get_total_samples () == 0))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    sample.resize (num_rows);
+    if ((!read_timestamp (0, &first_timestamp)) ||
+        (!read_timestamp (reader.get_total_samples () - 1, &last_timestamp)))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    position = 0;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+bool BinaryPlaybackFileSource::read_timestamp (int64_t pos, double *timestamp)
+{
+    // one sample in get_board_data layout is the same as in DataBuffer layout
+    if (reader.read_rows (pos, 1, sample.data (), 1) != (int)BinaryFileReturnCodes::STATUS_OK)
+    {
+        return false;
+    }
+    *timestamp = sample[timestamp_channel];
+    return true;
+}
+
+int BinaryPlaybackFileSource::read_package (double *package)
+{
+    if (position >= reader.get_total_samples ())
+    {
+        return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+    }
+    int res = reader.read_rows (position, 1, package, 1);
+    position++;
+    return (res == (int)BinaryFileReturnCodes::STATUS_OK) ? (int)BrainFlowExitCodes::STATUS_OK :
+                                                            (int)BrainFlowExitCodes::GENERAL_ERROR;
+}
+
+void BinaryPlaybackFileSource::rewind ()
+{
+    position = 0;
+}
+
+int BinaryPlaybackFileSource::seek_percentage (double percentage)
+{
+    if ((percentage < 0) || (percentage >= 100))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    position = (int64_t)(percentage * reader.get_total_samples () / 100.0);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int BinaryPlaybackFileSource::seek_timestamp (double timestamp)
+{
+    // blocks are cached, so it reads only log2 (num_blocks) blocks from disk
+    int64_t left = 0;
+    int64_t right = reader.get_total_samples ();
+    while (left < right)
+    {
+        int64_t mid = left + (right - left) / 2;
+        double mid_timestamp = 0.0;
+        if (!read_timestamp (mid, &mid_timestamp))
+        {
+            return (int)BrainFlowExitCodes::GENERAL_ERROR;
+        }
+        if (mid_timestamp < timestamp)
+        {
+            left = mid + 1;
+        }
+        else
+        {
+            right = mid;
+        }
+    }
+    position = left;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int64_t BinaryPlaybackFileSource::get_num_packages ()
+{
+    return reader.get_total_samples ();
+}
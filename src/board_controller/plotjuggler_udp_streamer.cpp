@@ -16,37 +16,36 @@ PlotJugglerUDPStreamer::PlotJugglerUDPStreamer (const char *ip, int port, json p
     this->port = port;
     this->preset_descr = preset_descr;
     socket = NULL;
-    is_streaming = false;
-    db = NULL;
 }
 
 PlotJugglerUDPStreamer::~PlotJugglerUDPStreamer ()
 {
-    if ((streaming_thread.joinable ()) && (is_streaming))
-    {
-        is_streaming = false;
-        streaming_thread.join ();
-    }
+    stop_dispatching ();
     if (socket != NULL)
     {
         delete socket;
         socket = NULL;
     }
-    if (db != NULL)
-    {
-        delete db;
-        db = NULL;
-    }
 }
 
 int PlotJugglerUDPStreamer::init_streamer ()
 {
-    if ((is_streaming) || (socket != NULL) || (db != NULL))
+    if (socket != NULL)
     {
         Board::board_logger->error ("plotjuggler streamer is running");
         return (int)BrainFlowExitCodes::GENERAL_ERROR;
     }
 
+    try
+    {
+        build_channels ();
+    }
+    catch (json::exception &e)
+    {
+        Board::board_logger->error ("invalid preset description: {}", e.what ());
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+
     socket = new SocketClientUDP (ip, port);
     int res = socket->connect ();
     if (res != (int)SocketClientUDPReturnCodes::STATUS_OK)
@@ -57,107 +56,91 @@ int PlotJugglerUDPStreamer::init_streamer ()
         return (int)BrainFlowExitCodes::GENERAL_ERROR;
     }
 
-    db = new DataBuffer (len, 1000);
-    if (!db->is_ready ())
-    {
-        Board::board_logger->error ("unable to prepare buffer for streaming");
-        delete db;
-        db = NULL;
-        delete socket;
-        socket = NULL;
-        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
-    }
-
-    is_streaming = true;
-    streaming_thread = std::thread ([this] { this->thread_worker (); });
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
-void PlotJugglerUDPStreamer::stream_data (double *data)
+void PlotJugglerUDPStreamer::stream_batch (double *data, int count)
 {
-    db->add_data (data);
+    for (int package = 0; package < count; package++)
+    {
+        double *transaction = data + package * len;
+        json j;
+        j[name] = json::object ();
+        for (const std::string &prefix : group_names)
+        {
+            j[name][prefix] = json::object ();
+        }
+        for (const PlotJugglerChannel &channel : channels)
+        {
+            if (channel.channel_name.empty ())
+            {
+                j[name][channel.prefix] = transaction[channel.index];
+            }
+            else
+            {
+                j[name][channel.prefix][channel.channel_name] = transaction[channel.index];
+            }
+        }
+        std::string s = j.dump ();
+        socket->send (s.c_str (), (int)s.size ());
+    }
 }
 
-void PlotJugglerUDPStreamer::thread_worker ()
+// resolve channel names once instead of parsing preset description for each package
+void PlotJugglerUDPStreamer::build_channels ()
 {
-    double *transaction = new double[len];
-    for (int i = 0; i < len; i++)
+    group_names.clear ();
+    channels.clear ();
+    name = preset_descr["name"];
+    for (auto &el : preset_descr.items ())
     {
-        transaction[i] = 0.0;
-    }
-    std::string name = preset_descr["name"];
-    while (is_streaming)
-    {
-        if (db->get_data_count () >= 1)
+        std::string key = el.key ();
+        if (key.find ("_channels") != std::string::npos)
         {
-            db->get_data (1, transaction);
-            json j;
-            j[name] = json::object ();
-            for (auto &el : preset_descr.items ())
+            std::string prefix = remove_substr (key, "_channels");
+            group_names.push_back (prefix);
+            std::vector<int> values = el.value ();
+            std::vector<std::string> names_vec;
+            if ((key == "eeg_channels") && (preset_descr.find ("eeg_names") != preset_descr.end ()))
+            {
+                std::string eeg_names = preset_descr["eeg_names"];
+                std::stringstream ss (eeg_names);
+                while (ss.good ())
+                {
+                    std::string substr;
+                    std::getline (ss, substr, ',');
+                    names_vec.push_back (substr);
+                }
+            }
+            for (int i = 0; i < (int)values.size (); i++)
             {
-                std::string key = el.key ();
-                if (key.find ("_channels") != std::string::npos)
+                std::string channel_name = "channel " + std::to_string (i);
+                if ((key == "accel_channels") && (i == 0))
+                    channel_name = "accel X";
+                if ((key == "accel_channels") && (i == 1))
+                    channel_name = "accel Y";
+                if ((key == "accel_channels") && (i == 2))
+                    channel_name = "accel Z";
+                if (i < (int)names_vec.size ())
                 {
-                    std::string prefix = remove_substr (key, "_channels");
-                    j[name][prefix] = json::object ();
-                    std::vector<int> values = el.value ();
-                    for (int i = 0; i < (int)values.size (); i++)
-                    {
-                        std::string channel_name = "channel " + std::to_string (i);
-                        if ((key == "accel_channels") && (i == 0))
-                            channel_name = "accel X";
-                        if ((key == "accel_channels") && (i == 1))
-                            channel_name = "accel Y";
-                        if ((key == "accel_channels") && (i == 2))
-                            channel_name = "accel Z";
-                        if (key == "eeg_channels")
-                        {
-                            try
-                            {
-                                std::string eeg_names = preset_descr["eeg_names"];
-                                std::vector<std::string> names_vec;
-                                std::stringstream ss (eeg_names);
-                                while (ss.good ())
-                                {
-                                    std::string substr;
-                                    std::getline (ss, substr, ',');
-                                    names_vec.push_back (substr);
-                                }
-                                channel_name = names_vec[i];
-                            }
-                            catch (...)
-                            {
-                            }
-                        }
-                        if ((values[i] >= 0) && (values[i] <= len))
-                        {
-                            j[name][prefix][channel_name] = transaction[values[i]];
-                        }
-                    }
+                    channel_name = names_vec[i];
                 }
-                else if (key.find ("_channel") != std::string::npos)
+                if ((values[i] >= 0) && (values[i] < len))
                 {
-                    int pos = el.value ();
-                    std::string prefix = remove_substr (key, "_channel");
-                    if ((pos >= 0) && (pos < len))
-                    {
-                        j[name][prefix] = transaction[pos];
-                    }
+                    channels.push_back ({prefix, channel_name, values[i]});
                 }
             }
-            std::string s = j.dump ();
-            socket->send (s.c_str (), (int)s.size ());
         }
-        else
+        else if (key.find ("_channel") != std::string::npos)
         {
-#ifdef _WIN32
-            Sleep (1);
-#else
-            usleep (10);
-#endif
+            int pos = el.value ();
+            std::string prefix = remove_substr (key, "_channel");
+            if ((pos >= 0) && (pos < len))
+            {
+                channels.push_back ({prefix, "", pos});
+            }
         }
     }
-    delete[] transaction;
 }
 
 std::string PlotJugglerUDPStreamer::remove_substr (std::string str, std::string substr)
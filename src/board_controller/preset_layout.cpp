@@ -0,0 +1,68 @@
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "brainflow_constants.h"
+#include "preset_layout.h"
+
+
+static int get_optional_channel (const json &preset_descr, const char *key)
+{
+    if (preset_descr.find (key) == preset_descr.end ())
+    {
+        return -1;
+    }
+    return (int)preset_descr.at (key);
+}
+
+int build_preset_layout (const json &preset_descr, struct PresetLayout &layout)
+{
+    memset (&layout, 0, sizeof (layout));
+    try
+    {
+        layout.num_rows = (int)preset_descr.at ("num_rows");
+        layout.timestamp_channel = (int)preset_descr.at ("timestamp_channel");
+        layout.marker_channel = (int)preset_descr.at ("marker_channel");
+        layout.package_num_channel = get_optional_channel (preset_descr, "package_num_channel");
+        layout.battery_channel = get_optional_channel (preset_descr, "battery_channel");
+        layout.sampling_rate = get_optional_channel (preset_descr, "sampling_rate");
+
+        for (auto &el : preset_descr.items ())
+        {
+            std::string key = el.key ();
+            size_t pos = key.rfind ("_channels");
+            if ((pos == std::string::npos) || (pos + strlen ("_channels") != key.size ()))
+            {
+                continue;
+            }
+            std::vector<int> channels = el.value ();
+            if ((layout.num_channel_groups >= MAX_PRESET_CHANNEL_GROUPS) ||
+                (layout.num_channel_indices + (int)channels.size () > MAX_PRESET_CHANNEL_INDICES) ||
+                (pos >= PRESET_GROUP_NAME_LIMIT))
+            {
+                return (int)BrainFlowExitCodes::GENERAL_ERROR;
+            }
+            PresetChannelGroup &group = layout.channel_groups[layout.num_channel_groups++];
+            strncpy (group.name, key.c_str (), pos);
+            group.name[pos] = '\0';
+            group.first = layout.num_channel_indices;
+            group.count = (int)channels.size ();
+            for (int channel : channels)
+            {
+                layout.channel_indices[layout.num_channel_indices++] = channel;
+            }
+        }
+    }
+    catch (json::exception &)
+    {
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+
+    if ((layout.num_rows <= 0) || (layout.marker_channel < 0) ||
+        (layout.marker_channel >= layout.num_rows) || (layout.timestamp_channel < 0) ||
+        (layout.timestamp_channel >= layout.num_rows))
+    {
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <chrono>
+
+#include "brainflow_constants.h"
+#include "streamer.h"
+
+
+Streamer::Streamer (int data_len, std::string type, std::string dest, std::string mods)
+{
+    len = data_len;
+    streamer_type = type;
+    streamer_dest = dest;
+    streamer_mods = mods;
+    queue = NULL;
+    overflow_policy = (int)StreamerOverflowPolicies::DROP_OLDEST;
+    dropped_count = 0;
+    keep_dispatching = false;
+}
+
+Streamer::~Streamer ()
+{
+    stop_dispatching ();
+}
+
+bool Streamer::policy_from_string (std::string policy_str, StreamerOverflowPolicies &policy)
+{
+    if (policy_str == "block")
+    {
+        policy = StreamerOverflowPolicies::BLOCK;
+        return true;
+    }
+    if (policy_str == "drop_oldest")
+    {
+        policy = StreamerOverflowPolicies::DROP_OLDEST;
+        return true;
+    }
+    if (policy_str == "drop_newest")
+    {
+        policy = StreamerOverflowPolicies::DROP_NEWEST;
+        return true;
+    }
+    return false;
+}
+
+std::string Streamer::policy_to_string (StreamerOverflowPolicies policy)
+{
+    switch (policy)
+    {
+        case StreamerOverflowPolicies::BLOCK:
+            return "block";
+        case StreamerOverflowPolicies::DROP_OLDEST:
+            return "drop_oldest";
+        case StreamerOverflowPolicies::DROP_NEWEST:
+            return "drop_newest";
+        default:
+            return "";
+    }
+}
+
+int Streamer::start_dispatching (StreamerOverflowPolicies policy)
+{
+    if (queue != NULL)
+    {
+        return (int)BrainFlowExitCodes::STREAM_ALREADY_RUN_ERROR;
+    }
+    queue = new LockFreeDataBuffer (len, STREAMER_QUEUE_SIZE);
+    if (!queue->is_ready ())
+    {
+        delete queue;
+        queue = NULL;
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+    set_overflow_policy (policy);
+    keep_dispatching = true;
+    dispatching_thread = std::thread ([this] { this->dispatch_thread (); });
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+void Streamer::stop_dispatching ()
+{
+    if (keep_dispatching)
+    {
+        keep_dispatching = false;
+        dispatching_thread.join ();
+    }
+    if (queue != NULL)
+    {
+        delete queue;
+        queue = NULL;
+    }
+}
+
+void Streamer::stream_data (double *data)
+{
+    if (queue == NULL)
+    {
+        stream_batch (data, 1);
+        return;
+    }
+
+    // single producer, packages are pushed under board lock
+    if (queue->get_data_count () >= STREAMER_QUEUE_SIZE)
+    {
+        dropped_count++;
+        if (get_overflow_policy () == StreamerOverflowPolicies::DROP_NEWEST)
+        {
+            return;
+        }
+    }
+    // queue overwrites the oldest package if it's full
+    queue->add_data (data);
+}
+
+void Streamer::stream_data_block (double *data, int count)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+    if (queue == NULL)
+    {
+        stream_batch (data, count);
+        return;
+    }
+
+    size_t total = (size_t)count;
+    size_t queued = queue->get_data_count ();
+    size_t free_space = (queued < STREAMER_QUEUE_SIZE) ? STREAMER_QUEUE_SIZE - queued : 0;
+    if (total > free_space)
+    {
+        dropped_count += total - free_space;
+        if (get_overflow_policy () == StreamerOverflowPolicies::DROP_NEWEST)
+        {
+            total = free_space;
+        }
+    }
+    queue->add_data_block (data, total);
+}
+
+bool Streamer::is_waiting_required (int count)
+{
+    if ((queue == NULL) || (!keep_dispatching) ||
+        (get_overflow_policy () != StreamerOverflowPolicies::BLOCK))
+    {
+        return false;
+    }
+    // block larger than queue waits until queue is empty
+    size_t required = std::min ((size_t)count, (size_t)STREAMER_QUEUE_SIZE);
+    return queue->get_data_count () + required > STREAMER_QUEUE_SIZE;
+}
+
+void Streamer::dispatch_thread ()
+{
+    double *batch = new double[STREAMER_BATCH_SIZE * len];
+    while (keep_dispatching)
+    {
+        size_t count = queue->get_data (STREAMER_BATCH_SIZE, batch);
+        if (count > 0)
+        {
+            stream_batch (batch, (int)count);
+        }
+        else
+        {
+            std::this_thread::sleep_for (std::chrono::milliseconds (1));
+        }
+    }
+    // flush packages pushed before stop
+    size_t count = 0;
+    while ((count = queue->get_data (STREAMER_BATCH_SIZE, batch)) > 0)
+    {
+        stream_batch (batch, (int)count);
+    }
+    delete[] batch;
+}
+
+void Streamer::set_overflow_policy (StreamerOverflowPolicies policy)
+{
+    overflow_policy = (int)policy;
+}
+
+StreamerOverflowPolicies Streamer::get_overflow_policy ()
+{
+    return (StreamerOverflowPolicies)overflow_policy.load ();
+}
+
+size_t Streamer::get_dropped_count ()
+{
+    return dropped_count.load ();
+}
+
+size_t Streamer::get_queued_count ()
+{
+    if (queue == NULL)
+    {
+        return 0;
+    }
+    return queue->get_data_count ();
+}
+
+std::string Streamer::get_streamer_params ()
+{
+    return streamer_type + "://" + streamer_dest + ":" + streamer_mods;
+}
@@ -10,6 +10,8 @@
 #endif
 
 
+constexpr int StreamingBoard::max_transactions_per_recv;
+
 StreamingBoard::StreamingBoard (struct BrainFlowInputParams params)
     : Board ((int)BoardIds::STREAMING_BOARD,
           params) // its a hack - set board_id for streaming board here temporary and override it
@@ -146,8 +148,15 @@ int StreamingBoard::start_stream (int buffer_size, const char *streamer_params)
     }
 
     keep_alive = true;
+    // shared reactor threads are used instead of thread per preset if enabled
+    IOReactor *reactor = IOReactor::get_instance ();
     for (int i = 0; i < (int)clients.size (); i++)
     {
+        if ((reactor != NULL) &&
+            (add_to_reactor (reactor, i) == (int)BrainFlowExitCodes::STATUS_OK))
+        {
+            continue;
+        }
         streaming_threads.push_back (std::thread ([this, i] { this->read_thread (i); }));
     }
     return (int)BrainFlowExitCodes::STATUS_OK;
@@ -163,6 +172,11 @@ int StreamingBoard::stop_stream ()
             streaming_thread.join ();
         }
         streaming_threads.clear ();
+        for (int fd : reactor_sockets)
+        {
+            IOReactor::get_instance ()->remove_socket (fd);
+        }
+        reactor_sockets.clear ();
         return (int)BrainFlowExitCodes::STATUS_OK;
     }
     else
@@ -205,28 +219,71 @@ void StreamingBoard::read_thread (int num)
     int num_packages = get_brainflow_batch_size ();
     int transaction_len = num_rows * num_packages;
     int bytes_per_recv = sizeof (double) * transaction_len;
-    double *transaction = new double[transaction_len];
-    for (int i = 0; i < num_rows; i++)
+    // all datagrams queued in socket are taken at once
+    int max_transactions = StreamingBoard::max_transactions_per_recv;
+    double *transactions = new double[transaction_len * max_transactions];
+    int sizes[StreamingBoard::max_transactions_per_recv];
+    for (int i = 0; i < transaction_len * max_transactions; i++)
     {
-        transaction[i] = 0.0;
+        transactions[i] = 0.0;
     }
 
     while (keep_alive)
     {
-        int res = clients[num]->recv (transaction, bytes_per_recv);
-        if (res != bytes_per_recv)
+        int res = clients[num]->recv_batch (transactions, bytes_per_recv, max_transactions, sizes);
+        if (res < 1)
         {
-            safe_logger (
-                spdlog::level::trace, "unable to read {} bytes, read {}", bytes_per_recv, res);
+            safe_logger (spdlog::level::trace, "unable to read {} bytes", bytes_per_recv);
             log_socket_error (-1);
             continue;
         }
-        for (int i = 0; i < num_packages; i++)
+        for (int i = 0; i < res; i++)
         {
-            push_package (transaction + i * num_rows, presets[num]);
+            if (sizes[i] != bytes_per_recv)
+            {
+                safe_logger (spdlog::level::trace, "unable to read {} bytes, read {}",
+                    bytes_per_recv, sizes[i]);
+                continue;
+            }
+            push_packages (transactions + i * transaction_len, num_packages, presets[num]);
         }
     }
-    delete[] transaction;
+    delete[] transactions;
+}
+
+int StreamingBoard::add_to_reactor (IOReactor *reactor, int num)
+{
+    std::string preset_str = preset_to_string (presets[num]);
+    if (board_descr.find (preset_str) == board_descr.end ())
+    {
+        // read_thread reports the error
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+
+    int num_rows = board_descr[preset_str]["num_rows"];
+    int num_packages = get_brainflow_batch_size ();
+    int bytes_per_recv = sizeof (double) * num_rows * num_packages;
+    int preset = presets[num];
+    int fd = clients[num]->get_socket_fd ();
+    int res = reactor->add_socket (fd, bytes_per_recv,
+        [this, preset, num_packages, bytes_per_recv] (unsigned char *data, int size)
+        {
+            if (size != bytes_per_recv)
+            {
+                safe_logger (spdlog::level::trace, "unable to read {} bytes, read {}",
+                    bytes_per_recv, size);
+                return;
+            }
+            push_packages ((double *)data, num_packages, preset);
+        });
+    if (res != (int)IOReactorReturnCodes::STATUS_OK)
+    {
+        safe_logger (spdlog::level::warn, "failed to add socket to io reactor: {}", res);
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    safe_logger (spdlog::level::trace, "preset {} is handled by io reactor", preset_str);
+    reactor_sockets.push_back (fd);
+    return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
 void StreamingBoard::log_socket_error (int error_code)
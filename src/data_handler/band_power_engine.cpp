@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <new>
+#include <string.h>
+
+#include "band_power_engine.h"
+#include "brainflow_constants.h"
+#include "common_data_handler_helpers.h"
+
+
+BandPowerEngine::BandPowerEngine (
+    int num_channels, int sampling_rate, int window_len, bool apply_filters)
+{
+    this->num_channels = num_channels;
+    this->sampling_rate = sampling_rate;
+    this->window_len = window_len;
+    this->apply_filters = apply_filters;
+    nfft = 0;
+    step = 0;
+    max_segments = 0;
+    num_bins = 0;
+    total_samples = 0;
+    samples_since_segment = 0;
+    segment_pos = 0;
+    num_segments = 0;
+}
+
+int BandPowerEngine::prepare ()
+{
+    if ((num_channels < 1) || (sampling_rate < 1) || (window_len < 1))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // the same as in get_custom_band_powers: resolution ~0.5 Hz but not more than window
+    nfft = nearest_power_of_two (sampling_rate) * 2;
+    while (nfft > window_len)
+    {
+        nfft /= 2;
+    }
+    if (nfft < 8)
+    {
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+    step = nfft - 4 * nfft / 5;
+    max_segments = (window_len - nfft) / step + 1;
+    num_bins = nfft / 2 + 1;
+
+    if (apply_filters)
+    {
+        // notch filters for 50 and 60 Hz and bandpass 2-45 Hz
+        double start_freqs[3] = {48.0, 58.0, 2.0};
+        double stop_freqs[3] = {52.0, 62.0, 45.0};
+        int operations[3] = {(int)FilterOperations::BANDSTOP, (int)FilterOperations::BANDSTOP,
+            (int)FilterOperations::BANDPASS};
+        for (int i = 0; i < 3; i++)
+        {
+            std::vector<struct BiquadCoeffs> stages;
+            int res = design_biquads (operations[i], sampling_rate, start_freqs[i], stop_freqs[i],
+                4, (int)FilterTypes::BUTTERWORTH, 0.0, stages);
+            if (res != (int)BrainFlowExitCodes::STATUS_OK)
+            {
+                return res;
+            }
+            filters.push_back (
+                std::unique_ptr<StreamingFilter> (new StreamingFilter (stages, num_channels)));
+        }
+    }
+    window = FFTCache::get_window ((int)WindowOperations::HANNING, nfft);
+    plan.reset (new FFTPlan (nfft, false));
+    if ((!window) || (!plan->is_valid ()))
+    {
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    samples.resize ((size_t)num_channels * nfft);
+    spectra.resize ((size_t)num_channels * max_segments * num_bins);
+    spectra_sum.resize ((size_t)num_channels * num_bins);
+    reset ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+void BandPowerEngine::reset ()
+{
+    for (size_t i = 0; i < filters.size (); i++)
+    {
+        filters[i]->reset ();
+    }
+    std::fill (samples.begin (), samples.end (), 0.0);
+    std::fill (spectra.begin (), spectra.end (), 0.0);
+    std::fill (spectra_sum.begin (), spectra_sum.end (), 0.0);
+    total_samples = 0;
+    samples_since_segment = 0;
+    segment_pos = 0;
+    num_segments = 0;
+}
+
+void BandPowerEngine::update (const double *data, int data_len)
+{
+    if (data_len <= 0)
+    {
+        return;
+    }
+    const double *rows = data;
+    if (apply_filters)
+    {
+        input.resize ((size_t)num_channels * data_len);
+        memcpy (input.data (), data, sizeof (double) * input.size ());
+        for (size_t i = 0; i < filters.size (); i++)
+        {
+            filters[i]->process (input.data (), data_len);
+        }
+        rows = input.data ();
+    }
+
+    int pos = 0;
+    while (pos < data_len)
+    {
+        // copy samples until the next segment is complete
+        int count = data_len - pos;
+        bool segment_ready = false;
+        if (total_samples + count >= nfft)
+        {
+            int64_t to_first_segment = nfft - total_samples;
+            int to_segment = (to_first_segment > 0) ? (int)to_first_segment :
+                                                      step - samples_since_segment;
+            if (count >= to_segment)
+            {
+                count = to_segment;
+                segment_ready = true;
+            }
+        }
+        for (int channel = 0; channel < num_channels; channel++)
+        {
+            const double *src = rows + (size_t)channel * data_len + pos;
+            double *ring = samples.data () + (size_t)channel * nfft;
+            int ring_pos = (int)(total_samples % nfft);
+            for (int i = 0; i < count; i++)
+            {
+                ring[ring_pos] = src[i];
+                ring_pos = (ring_pos + 1 == nfft) ? 0 : ring_pos + 1;
+            }
+        }
+        total_samples += count;
+        samples_since_segment += count;
+        pos += count;
+        if (segment_ready)
+        {
+            for (int channel = 0; channel < num_channels; channel++)
+            {
+                add_segment (channel);
+            }
+            samples_since_segment = 0;
+            segment_pos = (segment_pos + 1) % max_segments;
+            if (num_segments < max_segments)
+            {
+                num_segments++;
+            }
+        }
+    }
+}
+
+void BandPowerEngine::add_segment (int channel)
+{
+    const double *ring = samples.data () + (size_t)channel * nfft;
+    double *windowed_data = plan->get_real_buffer ();
+    const double *window_data = window->data ();
+    // the oldest sample is at the current ring position since ring is full
+    int start = (int)(total_samples % nfft);
+    double mean = 0.0;
+    if (apply_filters)
+    {
+        for (int i = 0; i < nfft; i++)
+        {
+            mean += ring[i];
+        }
+        mean /= nfft;
+    }
+    for (int i = 0; i < nfft; i++)
+    {
+        int ring_pos = start + i;
+        if (ring_pos >= nfft)
+        {
+            ring_pos -= nfft;
+        }
+        windowed_data[i] = window_data[i] * (ring[ring_pos] - mean);
+    }
+    kiss_fftr (plan->get_cfg (), windowed_data, plan->get_complex_buffer ());
+
+    double *segment =
+        spectra.data () + ((size_t)channel * max_segments + segment_pos) * num_bins;
+    double *sum = spectra_sum.data () + (size_t)channel * num_bins;
+    bool expired = (num_segments == max_segments);
+    for (int i = 0; i < num_bins; i++)
+    {
+        if (expired)
+        {
+            sum[i] -= segment[i];
+        }
+    }
+    fill_one_sided_psd (plan->get_complex_buffer (), nfft, sampling_rate, segment, NULL);
+    for (int i = 0; i < num_bins; i++)
+    {
+        sum[i] += segment[i];
+    }
+    // add and subtract accumulate rounding errors, recalc sum once per ring cycle
+    if (segment_pos == max_segments - 1)
+    {
+        recalc_sum (channel);
+    }
+}
+
+void BandPowerEngine::recalc_sum (int channel)
+{
+    double *sum = spectra_sum.data () + (size_t)channel * num_bins;
+    std::fill (sum, sum + num_bins, 0.0);
+    for (int segment_num = 0; segment_num < max_segments; segment_num++)
+    {
+        const double *segment =
+            spectra.data () + ((size_t)channel * max_segments + segment_num) * num_bins;
+        for (int i = 0; i < num_bins; i++)
+        {
+            sum[i] += segment[i];
+        }
+    }
+}
+
+bool BandPowerEngine::get_psd (int channel, double *ampl, double *freq)
+{
+    if ((num_segments == 0) || (channel < 0) || (channel >= num_channels))
+    {
+        return false;
+    }
+    const double *sum = spectra_sum.data () + (size_t)channel * num_bins;
+    double freq_res = (double)sampling_rate / (double)nfft;
+    for (int i = 0; i < num_bins; i++)
+    {
+        ampl[i] = sum[i] / num_segments;
+        freq[i] = i * freq_res;
+    }
+    return true;
+}
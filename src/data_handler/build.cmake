@@ -27,8 +27,15 @@ else (CMAKE_SIZEOF_VOID_P EQUAL 8)
 endif (CMAKE_SIZEOF_VOID_P EQUAL 8)
 
 SET (DATA_HANDLER_SRC
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/data_handler/band_power_engine.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/data_handler/data_handler.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/data_handler/fastica.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/data_handler/fft_cache.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/data_handler/peak_detector.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/data_handler/resampler.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/data_handler/streaming_filter.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/data_handler/wavelet_cache.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/binary_file.cpp
 )
 
 add_library (
@@ -1,5 +1,7 @@
 #include <algorithm>
+#include <map>
 #include <math.h>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <stdexcept>
@@ -10,12 +12,19 @@
 #include <thread>
 #include <vector>
 
+#include "band_power_engine.h"
+#include "binary_file.h"
 #include "brainflow_constants.h"
 #include "brainflow_version.h"
 #include "common_data_handler_helpers.h"
 #include "data_handler.h"
 #include "downsample_operators.h"
+#include "fft_cache.h"
+#include "peak_detector.h"
+#include "resampler.h"
 #include "rolling_filter.h"
+#include "streaming_filter.h"
+#include "wavelet_cache.h"
 #include "wavelet_helpers.h"
 #include "window_functions.h"
 
@@ -38,7 +47,8 @@
 #endif
 
 #define LOGGER_NAME "data_logger"
-#define MAX_FILTER_ORDER 8
+// denoise channels in parallel only if there is enough work to pay for threads
+#define PARALLEL_WAVELET_MIN_VALUES 16384
 
 #ifdef __ANDROID__
 #include "spdlog/sinks/android_sink.h"
@@ -51,6 +61,93 @@ std::shared_ptr<spdlog::logger> data_logger = spdlog::stderr_logger_mt (LOGGER_N
 // its only for logging methods, other methods can be executed simultaneously
 std::mutex data_mutex;
 
+// filter is kept alive by shared_ptr if it's released during processing from another thread
+std::map<int, std::shared_ptr<StreamingFilter>> streaming_filters;
+std::mutex streaming_filters_mutex;
+int streaming_filters_counter = 0;
+std::map<int, std::shared_ptr<BandPowerEngine>> band_power_engines;
+std::mutex band_power_engines_mutex;
+int band_power_engines_counter = 0;
+std::map<int, std::shared_ptr<StreamingRollingFilter>> rolling_filters;
+std::mutex rolling_filters_mutex;
+int rolling_filters_counter = 0;
+std::map<int, std::shared_ptr<StreamingPeakDetector>> peak_detectors;
+std::mutex peak_detectors_mutex;
+int peak_detectors_counter = 0;
+std::map<int, std::shared_ptr<StreamingResampler>> resamplers;
+std::mutex resamplers_mutex;
+int resamplers_counter = 0;
+std::map<int, std::shared_ptr<FastICA>> ica_engines;
+std::mutex ica_engines_mutex;
+int ica_engines_counter = 0;
+
+
+static std::shared_ptr<StreamingFilter> get_streaming_filter (int filter_id)
+{
+    std::lock_guard<std::mutex> lock (streaming_filters_mutex);
+    auto filter = streaming_filters.find (filter_id);
+    if (filter == streaming_filters.end ())
+    {
+        return std::shared_ptr<StreamingFilter> ();
+    }
+    return filter->second;
+}
+
+static std::shared_ptr<StreamingRollingFilter> get_rolling_filter (int filter_id)
+{
+    std::lock_guard<std::mutex> lock (rolling_filters_mutex);
+    auto filter = rolling_filters.find (filter_id);
+    if (filter == rolling_filters.end ())
+    {
+        return std::shared_ptr<StreamingRollingFilter> ();
+    }
+    return filter->second;
+}
+
+static std::shared_ptr<StreamingPeakDetector> get_peak_detector (int detector_id)
+{
+    std::lock_guard<std::mutex> lock (peak_detectors_mutex);
+    auto detector = peak_detectors.find (detector_id);
+    if (detector == peak_detectors.end ())
+    {
+        return std::shared_ptr<StreamingPeakDetector> ();
+    }
+    return detector->second;
+}
+
+static std::shared_ptr<StreamingResampler> get_resampler (int resampler_id)
+{
+    std::lock_guard<std::mutex> lock (resamplers_mutex);
+    auto resampler = resamplers.find (resampler_id);
+    if (resampler == resamplers.end ())
+    {
+        return std::shared_ptr<StreamingResampler> ();
+    }
+    return resampler->second;
+}
+
+static std::shared_ptr<FastICA> get_ica_engine (int engine_id)
+{
+    std::lock_guard<std::mutex> lock (ica_engines_mutex);
+    auto engine = ica_engines.find (engine_id);
+    if (engine == ica_engines.end ())
+    {
+        return std::shared_ptr<FastICA> ();
+    }
+    return engine->second;
+}
+
+static std::shared_ptr<BandPowerEngine> get_band_power_engine (int engine_id)
+{
+    std::lock_guard<std::mutex> lock (band_power_engines_mutex);
+    auto engine = band_power_engines.find (engine_id);
+    if (engine == band_power_engines.end ())
+    {
+        return std::shared_ptr<BandPowerEngine> ();
+    }
+    return engine->second;
+}
+
 
 int log_message_data_handler (int log_level, char *log_message)
 {
@@ -301,7 +398,7 @@ int perform_bandpass (double *data, int data_len, int sampling_rate, double star
     if ((filter_type == (int)FilterTypes::CHEBYSHEV_TYPE_1) ||
         (filter_type == (int)FilterTypes::CHEBYSHEV_TYPE_1_ZERO_PHASE))
     {
-        params[3] = ripple; // ripple
+        params[4] = ripple; // ripple
     }
     f->setParams (params);
     f->process (data_len, filter_data);
@@ -369,7 +466,7 @@ int perform_bandstop (double *data, int data_len, int sampling_rate, double star
     if ((filter_type == (int)FilterTypes::CHEBYSHEV_TYPE_1) ||
         (filter_type == (int)FilterTypes::CHEBYSHEV_TYPE_1_ZERO_PHASE))
     {
-        params[3] = ripple; // ripple
+        params[4] = ripple; // ripple
     }
     f->setParams (params);
     f->process (data_len, filter_data);
@@ -386,6 +483,179 @@ int perform_bandstop (double *data, int data_len, int sampling_rate, double star
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+// rows from channels of row-major data are processed in-place, rows must not repeat
+static int validate_channels (double *data, int rows, int cols, int *channels, int num_channels)
+{
+    if ((data == NULL) || (channels == NULL) || (rows < 1) || (cols < 1) || (num_channels < 1) ||
+        (num_channels > rows))
+    {
+        data_logger->error ("Data and channels cannot be empty. Rows:{}, Cols:{}, Channels:{}",
+            rows, cols, num_channels);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::vector<bool> used_rows (rows, false);
+    for (int i = 0; i < num_channels; i++)
+    {
+        if ((channels[i] < 0) || (channels[i] >= rows) || (used_rows[channels[i]]))
+        {
+            data_logger->error ("Invalid or repeated channel {}, rows: {}", channels[i], rows);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        used_rows[channels[i]] = true;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+static int perform_filter_multichannel (double *data, int rows, int cols, int *channels,
+    int num_channels, int filter_operation, int sampling_rate, double start_freq, double stop_freq,
+    int order, int filter_type, double ripple)
+{
+    int res = validate_channels (data, rows, cols, channels, num_channels);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    std::vector<struct BiquadCoeffs> stages;
+    res = design_biquads (filter_operation, sampling_rate, start_freq, stop_freq, order,
+        filter_type, ripple, stages);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        data_logger->error ("Invalid filter params. Operation:{}, Type:{}, Order:{}, "
+                            "Start Freq:{}, Stop Freq:{}, Sampling Rate:{}",
+            filter_operation, filter_type, order, start_freq, stop_freq, sampling_rate);
+        return res;
+    }
+
+    // coefficients are designed once for all channels, state is kept between passes as in
+    // single channel methods
+    StreamingFilter filter (stages, num_channels);
+    filter.process_rows (data, cols, channels);
+    if ((filter_type == (int)FilterTypes::BUTTERWORTH_ZERO_PHASE) ||
+        (filter_type == (int)FilterTypes::CHEBYSHEV_TYPE_1_ZERO_PHASE) ||
+        (filter_type == (int)FilterTypes::BESSEL_ZERO_PHASE))
+    {
+        for (int i = 0; i < num_channels; i++)
+        {
+            reverse_array (data + (size_t)channels[i] * cols, cols);
+        }
+        filter.process_rows (data, cols, channels);
+        for (int i = 0; i < num_channels; i++)
+        {
+            reverse_array (data + (size_t)channels[i] * cols, cols);
+        }
+    }
+
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int perform_lowpass_multichannel (double *data, int rows, int cols, int *channels,
+    int num_channels, int sampling_rate, double cutoff, int order, int filter_type, double ripple)
+{
+    return perform_filter_multichannel (data, rows, cols, channels, num_channels,
+        (int)FilterOperations::LOWPASS, sampling_rate, cutoff, 0.0, order, filter_type, ripple);
+}
+
+int perform_highpass_multichannel (double *data, int rows, int cols, int *channels,
+    int num_channels, int sampling_rate, double cutoff, int order, int filter_type, double ripple)
+{
+    return perform_filter_multichannel (data, rows, cols, channels, num_channels,
+        (int)FilterOperations::HIGHPASS, sampling_rate, cutoff, 0.0, order, filter_type, ripple);
+}
+
+int perform_bandpass_multichannel (double *data, int rows, int cols, int *channels,
+    int num_channels, int sampling_rate, double start_freq, double stop_freq, int order,
+    int filter_type, double ripple)
+{
+    return perform_filter_multichannel (data, rows, cols, channels, num_channels,
+        (int)FilterOperations::BANDPASS, sampling_rate, start_freq, stop_freq, order, filter_type,
+        ripple);
+}
+
+int perform_bandstop_multichannel (double *data, int rows, int cols, int *channels,
+    int num_channels, int sampling_rate, double start_freq, double stop_freq, int order,
+    int filter_type, double ripple)
+{
+    return perform_filter_multichannel (data, rows, cols, channels, num_channels,
+        (int)FilterOperations::BANDSTOP, sampling_rate, start_freq, stop_freq, order, filter_type,
+        ripple);
+}
+
+int create_streaming_filter (int filter_operation, int num_channels, int sampling_rate,
+    double start_freq, double stop_freq, int order, int filter_type, double ripple, int *filter_id)
+{
+    if ((num_channels < 1) || (filter_id == NULL))
+    {
+        data_logger->error ("Number of channels must be positive and filter_id cannot be NULL");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if ((filter_type == (int)FilterTypes::BUTTERWORTH_ZERO_PHASE) ||
+        (filter_type == (int)FilterTypes::CHEBYSHEV_TYPE_1_ZERO_PHASE) ||
+        (filter_type == (int)FilterTypes::BESSEL_ZERO_PHASE))
+    {
+        data_logger->error ("Zero phase filters need the whole signal and can not be streamed");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::vector<struct BiquadCoeffs> stages;
+    int res = design_biquads (filter_operation, sampling_rate, start_freq, stop_freq, order,
+        filter_type, ripple, stages);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        data_logger->error ("Invalid filter params. Operation:{}, Type:{}, Order:{}, "
+                            "Start Freq:{}, Stop Freq:{}, Sampling Rate:{}",
+            filter_operation, filter_type, order, start_freq, stop_freq, sampling_rate);
+        return res;
+    }
+
+    std::lock_guard<std::mutex> lock (streaming_filters_mutex);
+    streaming_filters_counter++;
+    streaming_filters[streaming_filters_counter] =
+        std::make_shared<StreamingFilter> (stages, num_channels);
+    *filter_id = streaming_filters_counter;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int process_streaming_filter (int filter_id, double *data, int data_len)
+{
+    if ((data == NULL) || (data_len < 0))
+    {
+        data_logger->error ("Data cannot be empty");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<StreamingFilter> filter = get_streaming_filter (filter_id);
+    if (!filter)
+    {
+        data_logger->error ("No streaming filter with id {}", filter_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (filter->get_mutex ());
+    filter->process (data, data_len);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int reset_streaming_filter (int filter_id)
+{
+    std::shared_ptr<StreamingFilter> filter = get_streaming_filter (filter_id);
+    if (!filter)
+    {
+        data_logger->error ("No streaming filter with id {}", filter_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (filter->get_mutex ());
+    filter->reset ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int release_streaming_filter (int filter_id)
+{
+    std::lock_guard<std::mutex> lock (streaming_filters_mutex);
+    if (streaming_filters.erase (filter_id) == 0)
+    {
+        data_logger->error ("No streaming filter with id {}", filter_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
 int remove_environmental_noise (double *data, int data_len, int sampling_rate, int noise_type)
 {
     if ((data_len < 1) || (sampling_rate < 1) || (!data))
@@ -431,27 +701,92 @@ int perform_rolling_filter (double *data, int data_len, int period, int agg_oper
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
 
-    RollingFilter<double> *filter = NULL;
     switch (static_cast<AggOperations> (agg_operation))
     {
         case AggOperations::MEAN:
-            filter = new RollingAverage<double> (period);
+        {
+            RollingMean<double> filter (period);
+            apply_rolling_filter (filter, data, data_len);
             break;
+        }
         case AggOperations::MEDIAN:
-            filter = new RollingMedian<double> (period);
+        {
+            RollingMedian<double> filter (period);
+            apply_rolling_filter (filter, data, data_len);
             break;
+        }
         case AggOperations::EACH:
             return (int)BrainFlowExitCodes::STATUS_OK;
         default:
             data_logger->error ("Invalid aggregate opteration:{}", agg_operation);
             return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    for (int i = 0; i < data_len; i++)
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int create_rolling_filter (int period, int agg_operation, int num_channels, int *filter_id)
+{
+    if ((period <= 0) || (num_channels < 1) || (filter_id == NULL))
     {
-        filter->add_data (data[i]);
-        data[i] = filter->get_value ();
+        data_logger->error ("Period and number of channels must be positive and filter_id cannot "
+                            "be NULL. Period:{}, Channels:{}",
+            period, num_channels);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if ((agg_operation != (int)AggOperations::MEAN) &&
+        (agg_operation != (int)AggOperations::MEDIAN))
+    {
+        data_logger->error ("Invalid aggregate opteration:{}", agg_operation);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    std::lock_guard<std::mutex> lock (rolling_filters_mutex);
+    rolling_filters_counter++;
+    rolling_filters[rolling_filters_counter] =
+        std::make_shared<StreamingRollingFilter> (period, agg_operation, num_channels);
+    *filter_id = rolling_filters_counter;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int process_rolling_filter (int filter_id, double *data, int data_len)
+{
+    if ((data == NULL) || (data_len < 0))
+    {
+        data_logger->error ("Data cannot be empty");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<StreamingRollingFilter> filter = get_rolling_filter (filter_id);
+    if (!filter)
+    {
+        data_logger->error ("No rolling filter with id {}", filter_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (filter->get_mutex ());
+    filter->process (data, data_len);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int reset_rolling_filter (int filter_id)
+{
+    std::shared_ptr<StreamingRollingFilter> filter = get_rolling_filter (filter_id);
+    if (!filter)
+    {
+        data_logger->error ("No rolling filter with id {}", filter_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (filter->get_mutex ());
+    filter->reset ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int release_rolling_filter (int filter_id)
+{
+    std::lock_guard<std::mutex> lock (rolling_filters_mutex);
+    if (rolling_filters.erase (filter_id) == 0)
+    {
+        data_logger->error ("No rolling filter with id {}", filter_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    delete filter;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
@@ -488,59 +823,150 @@ int perform_downsampling (
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+int perform_resampling (double *data, int data_len, int input_rate, int output_rate,
+    double *output_data, int *output_len)
+{
+    int up = 0;
+    int down = 0;
+    if ((data == NULL) || (data_len <= 0) || (output_data == NULL) || (output_len == NULL) ||
+        (get_resampling_factors (input_rate, output_rate, &up, &down) !=
+            (int)BrainFlowExitCodes::STATUS_OK))
+    {
+        data_logger->error ("Invalid resampling params. Input Rate:{}, Output Rate:{}", input_rate,
+            output_rate);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<const PolyphaseFilter> filter = PolyphaseFilterCache::get_filter (up, down);
+    if (!filter)
+    {
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    resample (*filter, data, data_len, output_data);
+    *output_len = get_resampled_len (data_len, up, down);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int create_resampler (int input_rate, int output_rate, int num_channels, int *resampler_id)
+{
+    int up = 0;
+    int down = 0;
+    if ((num_channels < 1) || (resampler_id == NULL) ||
+        (get_resampling_factors (input_rate, output_rate, &up, &down) !=
+            (int)BrainFlowExitCodes::STATUS_OK))
+    {
+        data_logger->error ("Invalid resampling params. Input Rate:{}, Output Rate:{}, "
+                            "Channels:{}",
+            input_rate, output_rate, num_channels);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<const PolyphaseFilter> filter = PolyphaseFilterCache::get_filter (up, down);
+    if (!filter)
+    {
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+
+    std::lock_guard<std::mutex> lock (resamplers_mutex);
+    resamplers_counter++;
+    resamplers[resamplers_counter] = std::make_shared<StreamingResampler> (filter, num_channels);
+    *resampler_id = resamplers_counter;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int process_resampler (
+    int resampler_id, double *data, int data_len, double *output_data, int *output_len)
+{
+    if ((data == NULL) || (data_len < 0) || (output_data == NULL) || (output_len == NULL))
+    {
+        data_logger->error ("Data and output cannot be empty");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<StreamingResampler> resampler = get_resampler (resampler_id);
+    if (!resampler)
+    {
+        data_logger->error ("No resampler with id {}", resampler_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (resampler->get_mutex ());
+    *output_len = resampler->process (data, data_len, output_data);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int get_resampler_output_len (int resampler_id, int data_len, int *output_len)
+{
+    if ((data_len < 0) || (output_len == NULL))
+    {
+        data_logger->error ("Data len must be >= 0 and output_len cannot be NULL");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<StreamingResampler> resampler = get_resampler (resampler_id);
+    if (!resampler)
+    {
+        data_logger->error ("No resampler with id {}", resampler_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *output_len = resampler->get_max_output_len (data_len);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int reset_resampler (int resampler_id)
+{
+    std::shared_ptr<StreamingResampler> resampler = get_resampler (resampler_id);
+    if (!resampler)
+    {
+        data_logger->error ("No resampler with id {}", resampler_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (resampler->get_mutex ());
+    resampler->reset ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int release_resampler (int resampler_id)
+{
+    std::lock_guard<std::mutex> lock (resamplers_mutex);
+    if (resamplers.erase (resampler_id) == 0)
+    {
+        data_logger->error ("No resampler with id {}", resampler_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
 // https://github.com/rafat/wavelib/wiki/DWT-Example-Code
 int perform_wavelet_transform (double *data, int data_len, int wavelet, int decomposition_level,
     int extension, double *output_data, int *decomposition_lengths)
 {
-    std::string wavelet_str = get_wavelet_name (wavelet);
-    std::string extension_str = get_extension_type (extension);
-    if ((data == NULL) || (data_len <= 0) || (wavelet_str.empty ()) || (output_data == NULL) ||
-        (extension_str.empty ()) || (decomposition_lengths == NULL) || (decomposition_level <= 0))
+    if ((data == NULL) || (data_len <= 0) || (get_wavelet_name (wavelet) == NULL) ||
+        (output_data == NULL) || (get_extension_type (extension) == NULL) ||
+        (decomposition_lengths == NULL) || (decomposition_level <= 0))
     {
         data_logger->error ("Please review arguments.");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
 
-    wave_object obj = NULL;
-    wt_object wt = NULL;
-
+    WaveletContextGuard guard (wavelet, data_len, decomposition_level, extension);
+    if (guard.get () == NULL)
+    {
+        // more likely wavelib failed because input buffer is to small to perform wavelet transform
+        data_logger->error ("Failed to create wavelet object, data len: {}, level: {}", data_len,
+            decomposition_level);
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+    wt_object wt = guard.get ()->get_wt ();
     try
     {
-        obj = wave_init (wavelet_str.c_str ());
-        wt = wt_init (obj, "dwt", data_len, decomposition_level);
-        setDWTExtension (wt, extension_str.c_str ());
-        setWTConv (wt, "direct");
         dwt (wt, data);
-        for (int i = 0; i < wt->outlength; i++)
-        {
-            output_data[i] = wt->output[i];
-        }
-        for (int i = 0; i < decomposition_level + 1; i++)
-        {
-            decomposition_lengths[i] = wt->length[i];
-        }
-        wave_free (obj);
-        obj = NULL;
-        wt_free (wt);
-        wt = NULL;
     }
     catch (const std::exception &e)
     {
-        if (obj)
-        {
-            wave_free (obj);
-            obj = NULL;
-        }
-        if (wt)
-        {
-            wt_free (wt);
-            wt = NULL;
-        }
-        // more likely exception here occured because input buffer is to small to perform wavelet
-        // transform
         data_logger->error ("Exception in wavelib: {}", e.what ());
         return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
     }
+    memcpy (output_data, wt->output, sizeof (double) * wt->outlength);
+    for (int i = 0; i < decomposition_level + 1; i++)
+    {
+        decomposition_lengths[i] = wt->length[i];
+    }
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
@@ -549,112 +975,132 @@ int perform_wavelet_transform (double *data, int data_len, int wavelet, int deco
 int perform_inverse_wavelet_transform (double *wavelet_coeffs, int original_data_len, int wavelet,
     int decomposition_level, int extension, int *decomposition_lengths, double *output_data)
 {
-    std::string wavelet_str = get_wavelet_name (wavelet);
-    std::string extension_str = get_extension_type (extension);
     if ((wavelet_coeffs == NULL) || (decomposition_level <= 0) || (original_data_len <= 0) ||
-        (output_data == NULL) || (wavelet_str.empty ()) || (extension_str.empty ()) ||
-        (decomposition_lengths == NULL))
+        (output_data == NULL) || (get_wavelet_name (wavelet) == NULL) ||
+        (get_extension_type (extension) == NULL) || (decomposition_lengths == NULL))
     {
         data_logger->error ("Please review arguments.");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
 
-    wave_object obj = NULL;
-    wt_object wt = NULL;
-
+    WaveletContextGuard guard (wavelet, original_data_len, decomposition_level, extension);
+    if (guard.get () == NULL)
+    {
+        data_logger->error ("Failed to create wavelet object, data len: {}, level: {}",
+            original_data_len, decomposition_level);
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+    wt_object wt = guard.get ()->get_wt ();
+    int total_len = 0;
+    for (int i = 0; i < decomposition_level + 1; i++)
+    {
+        wt->length[i] = decomposition_lengths[i];
+        total_len += decomposition_lengths[i];
+    }
+    memcpy (wt->output, wavelet_coeffs, sizeof (double) * total_len);
     try
     {
-        obj = wave_init (wavelet_str.c_str ());
-        wt = wt_init (obj, "dwt", original_data_len, decomposition_level);
-        setDWTExtension (wt, extension_str.c_str ());
-        setWTConv (wt, "direct");
-        int total_len = 0;
-        for (int i = 0; i < decomposition_level + 1; i++)
-        {
-            wt->length[i] = decomposition_lengths[i];
-            total_len += decomposition_lengths[i];
-        }
-        for (int i = 0; i < total_len; i++)
-        {
-            wt->output[i] = wavelet_coeffs[i];
-        }
         idwt (wt, output_data);
-        wave_free (obj);
-        obj = NULL;
-        wt_free (wt);
-        wt = NULL;
     }
     catch (const std::exception &e)
     {
-        if (obj)
+        data_logger->error ("Exception in wavelib: {}", e.what ());
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// params are validated by caller
+static int perform_wavelet_denoising_row (double *data, int data_len, int wavelet,
+    int decomposition_level, const char *denoising, const char *threshold, int extension,
+    const char *noise)
+{
+    WaveletContextGuard guard (wavelet, data_len, decomposition_level, extension);
+    if (guard.get () == NULL)
+    {
+        data_logger->error ("Failed to create wavelet object, data len: {}, level: {}", data_len,
+            decomposition_level);
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+    WaveletContext *context = guard.get ();
+    try
+    {
+        if (strcmp (denoising, "visushrink") == 0)
         {
-            wave_free (obj);
-            obj = NULL;
+            visushrink_wt (context->get_wt (), data, threshold, noise, context->get_buffer ());
         }
-        if (wt)
+        else
         {
-            wt_free (wt);
-            wt = NULL;
+            sureshrink_wt (context->get_wt (), data, threshold, noise, context->get_buffer ());
         }
-        data_logger->error ("Exception in wavelib: {}", e.what ());
+    }
+    catch (const std::exception &e)
+    {
         // more likely exception here occured because input buffer is to small to perform wavelet
         // transform
+        data_logger->error ("Exception in wavelib: {}", e.what ());
         return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
     }
+    memcpy (data, context->get_buffer (), sizeof (double) * data_len);
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
 int perform_wavelet_denoising (double *data, int data_len, int wavelet, int decomposition_level,
     int wavelet_denoising, int threshold, int extenstion_type, int noise_level)
 {
-    std::string wavelet_str = get_wavelet_name (wavelet);
-    std::string denoising_str = get_wavelet_denoising_type (wavelet_denoising);
-    std::string threshold_str = get_threshold_type (threshold);
-    std::string extension_str = get_extension_type (extenstion_type);
-    std::string noise_str = get_noise_estimation_type (noise_level);
-    if ((data == NULL) || (data_len <= 0) || (decomposition_level <= 0) || (wavelet_str.empty ()) ||
-        (denoising_str.empty ()) || (threshold_str.empty ()) || (extension_str.empty ()) ||
-        (noise_str.empty ()))
+    const char *denoising_str = get_wavelet_denoising_type (wavelet_denoising);
+    const char *threshold_str = get_threshold_type (threshold);
+    const char *noise_str = get_noise_estimation_type (noise_level);
+    if ((data == NULL) || (data_len <= 0) || (decomposition_level <= 0) ||
+        (get_wavelet_name (wavelet) == NULL) || (denoising_str == NULL) ||
+        (threshold_str == NULL) || (get_extension_type (extenstion_type) == NULL) ||
+        (noise_str == NULL))
     {
         data_logger->error ("Please review arguments.");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
+    return perform_wavelet_denoising_row (data, data_len, wavelet, decomposition_level,
+        denoising_str, threshold_str, extenstion_type, noise_str);
+}
 
-    denoise_object obj = NULL;
-    double *temp = new double[data_len];
-    try
+int perform_wavelet_denoising_multichannel (double *data, int rows, int cols, int *channels,
+    int num_channels, int wavelet, int decomposition_level, int wavelet_denoising, int threshold,
+    int extenstion_type, int noise_level)
+{
+    const char *denoising_str = get_wavelet_denoising_type (wavelet_denoising);
+    const char *threshold_str = get_threshold_type (threshold);
+    const char *noise_str = get_noise_estimation_type (noise_level);
+    if ((decomposition_level <= 0) || (get_wavelet_name (wavelet) == NULL) ||
+        (denoising_str == NULL) || (threshold_str == NULL) ||
+        (get_extension_type (extenstion_type) == NULL) || (noise_str == NULL))
     {
-        obj = denoise_init (data_len, decomposition_level, wavelet_str.c_str ());
-        setDenoiseMethod (obj, denoising_str.c_str ());
-        setDenoiseWTMethod (obj, "dwt");
-        setDenoiseWTExtension (obj, extension_str.c_str ());
-        setDenoiseParameters (obj, threshold_str.c_str (), noise_str.c_str ());
-        denoise (obj, data, temp);
-        for (int i = 0; i < data_len; i++)
-        {
-            data[i] = temp[i];
-        }
-        delete[] temp;
-        temp = NULL;
-        denoise_free (obj);
-        obj = NULL;
+        data_logger->error ("Please review arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    catch (const std::exception &e)
+    int res = validate_channels (data, rows, cols, channels, num_channels);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
-        if (temp)
-        {
-            delete[] temp;
-            temp = NULL;
-        }
-        if (obj)
+        return res;
+    }
+
+    // each thread takes its own context from cache
+    std::vector<int> results (num_channels, (int)BrainFlowExitCodes::STATUS_OK);
+    bool parallel = (num_channels > 1) &&
+        ((double)cols * num_channels >= (double)PARALLEL_WAVELET_MIN_VALUES);
+    (void)parallel;
+#pragma omp parallel for if (parallel)
+    for (int i = 0; i < num_channels; i++)
+    {
+        results[i] = perform_wavelet_denoising_row (data + (size_t)channels[i] * cols, cols,
+            wavelet, decomposition_level, denoising_str, threshold_str, extenstion_type,
+            noise_str);
+    }
+    for (int i = 0; i < num_channels; i++)
+    {
+        if (results[i] != (int)BrainFlowExitCodes::STATUS_OK)
         {
-            denoise_free (obj);
-            obj = NULL;
+            return results[i];
         }
-        // more likely exception here occured because input buffer is to small to perform wavelet
-        // transform
-        data_logger->error ("Exception in wavelib: {}", e.what ());
-        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
     }
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
@@ -755,28 +1201,36 @@ int get_window (int window_function, int window_len, double *output_window)
                             "0 and output_window cannot be empty.");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    // from https://www.edn.com/windowing-functions-improve-fft-results-part-i/
-    switch (static_cast<WindowOperations> (window_function))
+    std::shared_ptr<const std::vector<double>> window =
+        FFTCache::get_window (window_function, window_len);
+    if (!window)
     {
-        case WindowOperations::NO_WINDOW:
-            no_window_function (window_len, output_window);
-            break;
-        case WindowOperations::HAMMING:
-            hamming_function (window_len, output_window);
-            break;
-        case WindowOperations::HANNING:
-            hanning_function (window_len, output_window);
-            break;
-        case WindowOperations::BLACKMAN_HARRIS:
-            blackman_harris_function (window_len, output_window);
-            break;
-        default:
-            data_logger->error ("Invalid Window function. Window function:{}", window_function);
-            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        data_logger->error ("Invalid Window function. Window function:{}", window_function);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
+    memcpy (output_window, window->data (), sizeof (double) * window_len);
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+// result is stored in complex buffer of the plan
+static void perform_windowed_fft (FFTPlan *plan, const double *data, const double *window)
+{
+    int data_len = plan->get_nfft ();
+    double *windowed_data = plan->get_real_buffer ();
+    for (int i = 0; i < data_len; i++)
+    {
+        windowed_data[i] = window[i] * data[i];
+    }
+    kiss_fftr (plan->get_cfg (), windowed_data, plan->get_complex_buffer ());
+}
+
+// one sided psd from complex buffer of the plan
+static void fill_psd (FFTPlan *plan, int sampling_rate, double *output_ampl, double *output_freq)
+{
+    fill_one_sided_psd (plan->get_complex_buffer (), plan->get_nfft (), sampling_rate, output_ampl,
+        output_freq);
+}
+
 int perform_fft (
     double *data, int data_len, int window_function, double *output_re, double *output_im)
 {
@@ -786,47 +1240,26 @@ int perform_fft (
             "Please check to make sure all arguments aren't empty and data_len is even.");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-
-    double *windowed_data = new double[data_len];
-    get_window (window_function, data_len, windowed_data);
-    for (int i = 0; i < data_len; i++)
-    {
-        windowed_data[i] *= data[i];
-    }
-    kiss_fft_cpx *sout = new kiss_fft_cpx[data_len];
-    kiss_fftr_cfg cfg = NULL;
-    try
+    std::shared_ptr<const std::vector<double>> window =
+        FFTCache::get_window (window_function, data_len);
+    if (!window)
     {
-        cfg = kiss_fftr_alloc (data_len, 0, 0, 0);
-        kiss_fftr (cfg, windowed_data, sout);
-        for (int i = 0; i < data_len / 2 + 1; i++)
-        {
-            output_re[i] = sout[i].r;
-            output_im[i] = sout[i].i;
-        }
-        delete[] sout;
-        delete[] windowed_data;
-        windowed_data = NULL;
-        sout = NULL;
-        kiss_fftr_free (cfg);
+        data_logger->error ("Invalid Window function. Window function:{}", window_function);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    catch (...)
+    FFTPlanGuard plan (data_len, false);
+    if (plan.get () == NULL)
     {
-        if (sout)
-        {
-            delete[] sout;
-        }
-        if (windowed_data)
-        {
-            delete[] windowed_data;
-        }
-        if (cfg)
-        {
-            kiss_fftr_free (cfg);
-        }
         data_logger->error ("Error with doing FFT processing.");
         return (int)BrainFlowExitCodes::GENERAL_ERROR;
     }
+    perform_windowed_fft (plan.get (), data, window->data ());
+    const kiss_fft_cpx *sout = plan.get ()->get_complex_buffer ();
+    for (int i = 0; i < data_len / 2 + 1; i++)
+    {
+        output_re[i] = sout[i].r;
+        output_im[i] = sout[i].i;
+    }
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
@@ -839,44 +1272,23 @@ int perform_ifft (double *input_re, double *input_im, int data_len, double *rest
             "Please check to make sure all arguments aren't empty and data_len is even.");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    double *temp = new double[data_len];
-    kiss_fft_cpx *cin = new kiss_fft_cpx[data_len];
+    FFTPlanGuard plan (data_len, true);
+    if (plan.get () == NULL)
+    {
+        data_logger->error ("Error with doing inverse FFT.");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    kiss_fft_cpx *cin = plan.get ()->get_complex_buffer ();
+    double *temp = plan.get ()->get_real_buffer ();
     for (int i = 0; i < data_len / 2 + 1; i++)
     {
         cin[i].r = input_re[i];
         cin[i].i = input_im[i];
     }
-    kiss_fftr_cfg cfg = NULL;
-    try
-    {
-        cfg = kiss_fftr_alloc (data_len, 1, 0, 0);
-        kiss_fftri (cfg, cin, temp);
-        for (int i = 0; i < data_len; i++)
-        {
-            restored_data[i] = temp[i] / data_len;
-        }
-        delete[] cin;
-        cin = NULL;
-        delete[] temp;
-        temp = NULL;
-        kiss_fftr_free (cfg);
-    }
-    catch (...)
+    kiss_fftri (plan.get ()->get_cfg (), cin, temp);
+    for (int i = 0; i < data_len; i++)
     {
-        if (temp)
-        {
-            delete[] temp;
-        }
-        if (cin)
-        {
-            delete[] cin;
-        }
-        if (cfg)
-        {
-            kiss_fftr_free (cfg);
-        }
-        data_logger->error ("Error with doing inverse FFT.");
-        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+        restored_data[i] = temp[i] / data_len;
     }
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
@@ -891,28 +1303,21 @@ int get_psd (double *data, int data_len, int sampling_rate, int window_function,
                             "is >=1 and data_len is even.");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    double *re = new double[data_len / 2 + 1];
-    double *im = new double[data_len / 2 + 1];
-    int res = perform_fft (data, data_len, window_function, re, im);
-    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    std::shared_ptr<const std::vector<double>> window =
+        FFTCache::get_window (window_function, data_len);
+    if (!window)
     {
-        delete[] re;
-        delete[] im;
-        return res;
+        data_logger->error ("Invalid Window function. Window function:{}", window_function);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    double freq_res = (double)sampling_rate / (double)data_len;
-    for (int i = 0; i < data_len / 2 + 1; i++)
+    FFTPlanGuard plan (data_len, false);
+    if (plan.get () == NULL)
     {
-        // https://www.mathworks.com/help/signal/ug/power-spectral-density-estimates-using-fft.html
-        output_ampl[i] = (re[i] * re[i] + im[i] * im[i]) / ((double)(sampling_rate * data_len));
-        if ((i != 0) && (i != data_len / 2))
-        {
-            output_ampl[i] *= 2;
-        }
-        output_freq[i] = i * freq_res;
+        data_logger->error ("Error with doing FFT processing.");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
     }
-    delete[] re;
-    delete[] im;
+    perform_windowed_fft (plan.get (), data, window->data ());
+    fill_psd (plan.get (), sampling_rate, output_ampl, output_freq);
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
@@ -941,44 +1346,94 @@ int get_band_power (double *ampl, double *freq, int data_len, double freq_start,
             counter++;
         }
     }
-    if (counter == 0)
+    if (counter == 0)
+    {
+        data_logger->error ("No data between freq_end and freq_start.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *band_power = res;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int get_nearest_power_of_two (int value, int *output)
+{
+    if (value < 0)
+    {
+        data_logger->error ("Value must be postive. Value:{}", value);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *output = nearest_power_of_two (value);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+static int write_binary_file (
+    const double *data, int num_rows, int num_cols, const char *file_name, const char *file_mode)
+{
+    if ((data == NULL) || (num_rows <= 0) || (num_cols < 0))
+    {
+        data_logger->error ("invalid data for binary file");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // board id and sampling rate are unknown here
+    BinaryFileWriter writer (file_name, file_mode, num_rows, (int)BoardIds::NO_BOARD,
+        (int)BrainFlowPresets::DEFAULT_PRESET, 0);
+    int res = writer.open ();
+    if (res == (int)BinaryFileReturnCodes::STATUS_OK)
     {
-        data_logger->error ("No data between freq_end and freq_start.");
+        res = writer.write_rows (data, num_cols);
+    }
+    if (res == (int)BinaryFileReturnCodes::STATUS_OK)
+    {
+        res = writer.close ();
+    }
+    if (res != (int)BinaryFileReturnCodes::STATUS_OK)
+    {
+        data_logger->error ("failed to write binary file {}, mode {}, error {}", file_name,
+            file_mode, res);
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    *band_power = res;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
-int get_nearest_power_of_two (int value, int *output)
+static int read_binary_file (
+    double *data, int *num_rows, int *num_cols, const char *file_name, int num_elements)
 {
-    if (value < 0)
+    BinaryFileReader reader (file_name);
+    int res = reader.open ();
+    if (res != (int)BinaryFileReturnCodes::STATUS_OK)
     {
-        data_logger->error ("Value must be postive. Value:{}", value);
+        data_logger->error ("failed to open binary file {}, error {}", file_name, res);
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    if (value == 1)
+    int rows = reader.get_header ().num_rows;
+    int64_t cols = reader.get_total_samples ();
+    if (cols > num_elements / rows)
     {
-        *output = 2;
-        return (int)BrainFlowExitCodes::STATUS_OK;
+        cols = num_elements / rows;
     }
-
-    int32_t v = (int32_t)value;
-    v--;
-    v |= v >> 1;
-    v |= v >> 2;
-    v |= v >> 4;
-    v |= v >> 8;
-    v |= v >> 16;
-    v++;            // next power of 2
-    int x = v >> 1; // previous power of 2
-    *output = (v - value) > (value - x) ? x : v;
+    if (cols == 0)
+    {
+        data_logger->error ("no samples in binary file {} or num_elements is too small", file_name);
+        return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+    }
+    res = reader.read_rows (0, cols, data, cols);
+    if (res != (int)BinaryFileReturnCodes::STATUS_OK)
+    {
+        data_logger->error ("failed to read binary file {}, error {}", file_name, res);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *num_rows = rows;
+    *num_cols = (int)cols;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
 int write_file (
     const double *data, int num_rows, int num_cols, const char *file_name, const char *file_mode)
 {
+    if (is_binary_file_mode (file_mode))
+    {
+        return write_binary_file (data, num_rows, num_cols, file_name, file_mode);
+    }
     if ((strcmp (file_mode, "w") != 0) && (strcmp (file_mode, "w+") != 0) &&
         (strcmp (file_mode, "a") != 0) && (strcmp (file_mode, "a+") != 0))
     {
@@ -1015,6 +1470,10 @@ int read_file (double *data, int *num_rows, int *num_cols, const char *file_name
         data_logger->error ("Nummber or elements must be greater than 0.");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
+    if (is_binary_file (file_name))
+    {
+        return read_binary_file (data, num_rows, num_cols, file_name, num_elements);
+    }
     FILE *fp;
     fp = fopen (file_name, "r");
     if (fp == NULL)
@@ -1120,6 +1579,23 @@ int calc_stddev (double *data, int start_pos, int end_pos, double *output)
 
 int get_num_elements_in_file (const char *file_name, int *num_elements)
 {
+    if (is_binary_file (file_name))
+    {
+        // no need to parse the whole file, sample count is stored in index
+        BinaryFileReader reader (file_name);
+        if (reader.open () != (int)BinaryFileReturnCodes::STATUS_OK)
+        {
+            data_logger->error ("Invalid binary file {}", file_name);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        *num_elements = (int)(reader.get_header ().num_rows * reader.get_total_samples ());
+        if (*num_elements == 0)
+        {
+            data_logger->error ("Empty file {}", file_name);
+            return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+        }
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
     FILE *fp;
     fp = fopen (file_name, "r");
     if (fp == NULL)
@@ -1238,13 +1714,28 @@ int detrend (double *data, int data_len, int detrend_operation)
 int get_psd_welch (double *data, int data_len, int nfft, int overlap, int sampling_rate,
     int window_function, double *output_ampl, double *output_freq)
 {
-    if ((data == NULL) || (data_len < 1) || (nfft & (nfft - 1)) || (output_ampl == NULL) ||
-        (output_freq == NULL) || (sampling_rate < 1) || (overlap < 0) || (overlap > nfft))
+    if ((data == NULL) || (data_len < 1) || (nfft < 2) || (nfft & (nfft - 1)) ||
+        (output_ampl == NULL) || (output_freq == NULL) || (sampling_rate < 1) || (overlap < 0) ||
+        (overlap > nfft))
     {
         data_logger->error ("Please review your arguments.");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    double *ampls = new double[nfft / 2 + 1];
+    // the same plan and window are used for all segments
+    std::shared_ptr<const std::vector<double>> window =
+        FFTCache::get_window (window_function, nfft);
+    if (!window)
+    {
+        data_logger->error ("Invalid Window function. Window function:{}", window_function);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    FFTPlanGuard plan (nfft, false);
+    if (plan.get () == NULL)
+    {
+        data_logger->error ("Error with doing FFT processing.");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    double *ampls = plan.get ()->get_spectrum_buffer ();
     int counter = 0;
     for (int i = 0; i < nfft / 2 + 1; i++)
     {
@@ -1252,18 +1743,13 @@ int get_psd_welch (double *data, int data_len, int nfft, int overlap, int sampli
     }
     for (int pos = 0; (pos + nfft) <= data_len; pos += (nfft - overlap), counter++)
     {
-        int res = get_psd (data + pos, nfft, sampling_rate, window_function, ampls, output_freq);
-        if (res != (int)BrainFlowExitCodes::STATUS_OK)
-        {
-            delete[] ampls;
-            return res;
-        }
+        perform_windowed_fft (plan.get (), data + pos, window->data ());
+        fill_psd (plan.get (), sampling_rate, ampls, output_freq);
         for (int i = 0; i < nfft / 2 + 1; i++)
         {
             output_ampl[i] += ampls[i];
         }
     }
-    delete[] ampls;
     if (counter == 0)
     {
         data_logger->error ("Nfft must be less than data_len.");
@@ -1278,6 +1764,47 @@ int get_psd_welch (double *data, int data_len, int nfft, int overlap, int sampli
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+// bands contain num_bands arrays with band powers for each row
+static void calc_relative_band_powers (
+    double **bands, int num_bands, int rows, double *avg_band_powers, double *stddev_band_powers)
+{
+    // find average and stddev
+    double *avg_bands = new double[num_bands];
+    double *std_bands = new double[num_bands];
+    memset (avg_bands, 0, sizeof (double) * num_bands);
+    memset (std_bands, 0, sizeof (double) * num_bands);
+    for (int i = 0; i < num_bands; i++)
+    {
+        for (int j = 0; j < rows; j++)
+        {
+            avg_bands[i] += bands[i][j];
+        }
+        avg_bands[i] /= rows;
+        for (int j = 0; j < rows; j++)
+        {
+            std_bands[i] += (bands[i][j] - avg_bands[i]) * (bands[i][j] - avg_bands[i]);
+        }
+        std_bands[i] /= rows;
+        std_bands[i] = sqrt (std_bands[i]);
+    }
+    // use relative band powers
+    double sum = 0.0;
+    for (int i = 0; i < num_bands; i++)
+    {
+        sum += avg_bands[i];
+    }
+    for (int i = 0; i < num_bands; i++)
+    {
+        avg_band_powers[i] = avg_bands[i] / sum;
+        // use relative stddev to 'normalize'(doesnt ensure range between 0 and 1) it and keep
+        // information about variance, division by max doesnt make any sense for stddev, it will
+        // lose information about ratio between mean and deviation
+        stddev_band_powers[i] = std_bands[i] / avg_bands[i];
+    }
+    delete[] avg_bands;
+    delete[] std_bands;
+}
+
 int get_custom_band_powers (double *raw_data, int rows, int cols, double *start_freqs,
     double *stop_freqs, int num_bands, int sampling_rate, int apply_filters,
     double *avg_band_powers, double *stddev_band_powers)
@@ -1382,49 +1909,132 @@ int get_custom_band_powers (double *raw_data, int rows, int cols, double *start_
         }
     }
 
-    // find average and stddev
-    double *avg_bands = new double[num_bands];
-    double *std_bands = new double[num_bands];
-    memset (avg_bands, 0, sizeof (double) * num_bands);
-    memset (std_bands, 0, sizeof (double) * num_bands);
+    calc_relative_band_powers (bands, num_bands, rows, avg_band_powers, stddev_band_powers);
+
+    delete[] exit_codes;
+    for (int j = 0; j < num_bands; j++)
+    {
+        delete[] bands[j];
+    }
+    delete[] bands;
+
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int create_band_power_engine (
+    int num_channels, int sampling_rate, int window_len, int apply_filters, int *engine_id)
+{
+    if (engine_id == NULL)
+    {
+        data_logger->error ("engine_id cannot be NULL");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<BandPowerEngine> engine = std::make_shared<BandPowerEngine> (
+        num_channels, sampling_rate, window_len, (bool)apply_filters);
+    int res = engine->prepare ();
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        data_logger->error ("Failed to create band power engine. Channels:{}, Sampling Rate:{}, "
+                            "Window Len:{}",
+            num_channels, sampling_rate, window_len);
+        return res;
+    }
+
+    std::lock_guard<std::mutex> lock (band_power_engines_mutex);
+    band_power_engines_counter++;
+    band_power_engines[band_power_engines_counter] = engine;
+    *engine_id = band_power_engines_counter;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int update_band_power_engine (int engine_id, double *data, int data_len)
+{
+    if ((data == NULL) || (data_len < 0))
+    {
+        data_logger->error ("Data cannot be empty");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<BandPowerEngine> engine = get_band_power_engine (engine_id);
+    if (!engine)
+    {
+        data_logger->error ("No band power engine with id {}", engine_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (engine->get_mutex ());
+    engine->update (data, data_len);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int get_band_power_engine_powers (int engine_id, double *start_freqs, double *stop_freqs,
+    int num_bands, double *avg_band_powers, double *stddev_band_powers)
+{
+    if ((avg_band_powers == NULL) || (stddev_band_powers == NULL) || (start_freqs == NULL) ||
+        (stop_freqs == NULL) || (num_bands < 1))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<BandPowerEngine> engine = get_band_power_engine (engine_id);
+    if (!engine)
+    {
+        data_logger->error ("No band power engine with id {}", engine_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    std::lock_guard<std::mutex> lock (engine->get_mutex ());
+    int rows = engine->get_num_channels ();
+    int num_bins = engine->get_nfft () / 2 + 1;
+    std::vector<double> ampls (num_bins);
+    std::vector<double> freqs (num_bins);
+    std::vector<double> band_values ((size_t)num_bands * rows);
+    std::vector<double *> bands (num_bands);
     for (int i = 0; i < num_bands; i++)
     {
-        for (int j = 0; j < rows; j++)
+        bands[i] = band_values.data () + (size_t)i * rows;
+    }
+    for (int i = 0; i < rows; i++)
+    {
+        if (!engine->get_psd (i, ampls.data (), freqs.data ()))
         {
-            avg_bands[i] += bands[i][j];
+            data_logger->error ("Not enough data for calculation.");
+            return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
         }
-        avg_bands[i] /= rows;
-        for (int j = 0; j < rows; j++)
+        for (int band_num = 0; band_num < num_bands; band_num++)
         {
-            std_bands[i] += (bands[i][j] - avg_bands[i]) * (bands[i][j] - avg_bands[i]);
+            int res = get_band_power (ampls.data (), freqs.data (), num_bins,
+                start_freqs[band_num], stop_freqs[band_num], &bands[band_num][i]);
+            if (res != (int)BrainFlowExitCodes::STATUS_OK)
+            {
+                return res;
+            }
         }
-        std_bands[i] /= rows;
-        std_bands[i] = sqrt (std_bands[i]);
-    }
-    // use relative band powers
-    double sum = 0.0;
-    for (int i = 0; i < num_bands; i++)
-    {
-        sum += avg_bands[i];
     }
-    for (int i = 0; i < num_bands; i++)
+    calc_relative_band_powers (
+        bands.data (), num_bands, rows, avg_band_powers, stddev_band_powers);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int reset_band_power_engine (int engine_id)
+{
+    std::shared_ptr<BandPowerEngine> engine = get_band_power_engine (engine_id);
+    if (!engine)
     {
-        avg_band_powers[i] = avg_bands[i] / sum;
-        // use relative stddev to 'normalize'(doesnt ensure range between 0 and 1) it and keep
-        // information about variance, division by max doesnt make any sense for stddev, it will
-        // lose information about ratio between mean and deviation
-        stddev_band_powers[i] = std_bands[i] / avg_bands[i];
+        data_logger->error ("No band power engine with id {}", engine_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
+    std::lock_guard<std::mutex> lock (engine->get_mutex ());
+    engine->reset ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
 
-    delete[] exit_codes;
-    for (int j = 0; j < num_bands; j++)
+int release_band_power_engine (int engine_id)
+{
+    std::lock_guard<std::mutex> lock (band_power_engines_mutex);
+    if (band_power_engines.erase (engine_id) == 0)
     {
-        delete[] bands[j];
+        data_logger->error ("No band power engine with id {}", engine_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    delete[] bands;
-    delete[] avg_bands;
-    delete[] std_bands;
-
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
@@ -1542,47 +2152,52 @@ int restore_data_from_wavelet_detailed_coeffs (double *data, int data_len, int w
 {
     int extension = (int)WaveletExtensionTypes::SYMMETRIC;
     if ((data == NULL) || (data_len <= 20) || (output == NULL) || (decomposition_level <= 0) ||
-        (level_to_restore <= 0) || (level_to_restore > decomposition_level))
+        (level_to_restore <= 0) || (level_to_restore > decomposition_level) ||
+        (get_wavelet_name (wavelet) == NULL))
     {
         data_logger->error ("Invalid input for restore_data_from_wavelet_detailed_coeffs.");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
 
-    int max_wavelet_output_len = data_len + 2 * decomposition_level * (40 + 1);
-    double *wavelet_output = new double[max_wavelet_output_len];
-    int *decomposition_lengths = new int[decomposition_level + 1];
-
-    int res = perform_wavelet_transform (data, data_len, wavelet, decomposition_level, extension,
-        wavelet_output, decomposition_lengths);
-    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    // forward and inverse transforms use the same context, coefficients are zeroed in place
+    WaveletContextGuard guard (wavelet, data_len, decomposition_level, extension);
+    if (guard.get () == NULL)
     {
+        data_logger->error ("Failed to create wavelet object, data len: {}, level: {}", data_len,
+            decomposition_level);
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+    wt_object wt = guard.get ()->get_wt ();
+    try
+    {
+        dwt (wt, data);
         // zero approx coefs
-        for (int j = 0; j < decomposition_lengths[0]; j++)
+        int cur_sum = wt->length[0];
+        for (int j = 0; j < cur_sum; j++)
         {
-            wavelet_output[j] = 0.0;
+            wt->output[j] = 0.0;
         }
-        int cur_sum = decomposition_lengths[0];
         // zero detailed coefs not from level_to_restore
         for (int i = 1; i < decomposition_level + 1; i++)
         {
             int cur_level = decomposition_level + 1 - i;
             if (cur_level != level_to_restore)
             {
-                for (int j = cur_sum; j < cur_sum + decomposition_lengths[i]; j++)
+                for (int j = cur_sum; j < cur_sum + wt->length[i]; j++)
                 {
-                    wavelet_output[j] = 0.0;
+                    wt->output[j] = 0.0;
                 }
             }
-            cur_sum += decomposition_lengths[i];
+            cur_sum += wt->length[i];
         }
-        res = perform_inverse_wavelet_transform (wavelet_output, data_len, wavelet,
-            decomposition_level, extension, decomposition_lengths, output);
+        idwt (wt, output);
     }
-
-    delete[] wavelet_output;
-    delete[] decomposition_lengths;
-
-    return res;
+    catch (const std::exception &e)
+    {
+        data_logger->error ("Exception in wavelib: {}", e.what ());
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
 // https://stackoverflow.com/a/22640362
@@ -1595,41 +2210,68 @@ int detect_peaks_z_score (
         data_logger->error ("invalid inputs for detect_peaks_z_score");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    memset (output, 0, sizeof (double) * data_len);
-    double *filtered_data = new double[data_len];
-    double *avg_filter = new double[data_len];
-    double *std_filter = new double[data_len];
-    memcpy (filtered_data, data, sizeof (double) * data_len);
+    ZScorePeakDetector detector (lag, threshold, influence);
+    detector.process (data, output, data_len);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int create_peak_detector (
+    int lag, double threshold, double influence, int num_channels, int *detector_id)
+{
+    if ((lag < 2) || (threshold < 0) || (influence < 0) || (num_channels < 1) ||
+        (detector_id == NULL))
+    {
+        data_logger->error ("invalid inputs for create_peak_detector");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
 
-    avg_filter[lag - 1] = mean (data, lag);
-    std_filter[lag - 1] = stddev (data, lag);
+    std::lock_guard<std::mutex> lock (peak_detectors_mutex);
+    peak_detectors_counter++;
+    peak_detectors[peak_detectors_counter] =
+        std::make_shared<StreamingPeakDetector> (lag, threshold, influence, num_channels);
+    *detector_id = peak_detectors_counter;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
 
-    for (int i = lag; i < data_len; i++)
+int process_peak_detector (int detector_id, double *data, int data_len, double *output)
+{
+    if ((data == NULL) || (output == NULL) || (data_len < 0))
     {
-        if (abs (data[i] - avg_filter[i - 1]) > threshold * std_filter[i - 1])
-        {
-            if (data[i] > avg_filter[i - 1])
-            {
-                output[i] = 1;
-            }
-            else
-            {
-                output[i] = -1;
-            }
-            filtered_data[i] = influence * data[i] + (1 - influence) * filtered_data[i - 1];
-        }
-        else
-        {
-            output[i] = 0;
-        }
-        avg_filter[i] = mean (filtered_data + i - lag, lag);
-        std_filter[i] = stddev (filtered_data + i - lag, lag);
+        data_logger->error ("Data and output cannot be empty");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<StreamingPeakDetector> detector = get_peak_detector (detector_id);
+    if (!detector)
+    {
+        data_logger->error ("No peak detector with id {}", detector_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
+    std::lock_guard<std::mutex> lock (detector->get_mutex ());
+    detector->process (data, output, data_len);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
 
-    delete[] filtered_data;
-    delete[] avg_filter;
-    delete[] std_filter;
+int reset_peak_detector (int detector_id)
+{
+    std::shared_ptr<StreamingPeakDetector> detector = get_peak_detector (detector_id);
+    if (!detector)
+    {
+        data_logger->error ("No peak detector with id {}", detector_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (detector->get_mutex ());
+    detector->reset ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
 
+int release_peak_detector (int detector_id)
+{
+    std::lock_guard<std::mutex> lock (peak_detectors_mutex);
+    if (peak_detectors.erase (detector_id) == 0)
+    {
+        data_logger->error ("No peak detector with id {}", detector_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
@@ -1702,12 +2344,8 @@ int perform_ica (double *data, int rows, int cols, int num_components, double *w
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
 
-    Eigen::MatrixXd input_matrix =
-        Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>> (
-            data, rows, cols);
-
     FastICA ica (num_components);
-    int res = ica.compute (input_matrix);
+    int res = ica.compute (data, rows, cols);
     if (res == (int)BrainFlowExitCodes::STATUS_OK)
     {
         res = ica.get_matrixes (w_mat, k_mat, a_mat, s_mat);
@@ -1715,6 +2353,78 @@ int perform_ica (double *data, int rows, int cols, int num_components, double *w
     return res;
 }
 
+int create_ica_engine (int num_components, int max_it, double tol, int seed, int *engine_id)
+{
+    if ((num_components < 2) || (max_it < 1) || (tol <= 0) || (engine_id == NULL))
+    {
+        data_logger->error ("invalid inputs for create_ica_engine.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<FastICA> engine = std::make_shared<FastICA> (num_components, max_it, tol, seed);
+    engine->set_warm_start (true);
+
+    std::lock_guard<std::mutex> lock (ica_engines_mutex);
+    ica_engines_counter++;
+    ica_engines[ica_engines_counter] = engine;
+    *engine_id = ica_engines_counter;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int process_ica_engine (int engine_id, double *data, int rows, int cols, int num_components,
+    double *w_mat, double *k_mat, double *a_mat, double *s_mat)
+{
+    if ((data == NULL) || (rows < 2) || (cols < 2) || (w_mat == NULL) || (k_mat == NULL) ||
+        (a_mat == NULL) || (s_mat == NULL))
+    {
+        data_logger->error ("invalid inputs for process_ica_engine.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<FastICA> engine = get_ica_engine (engine_id);
+    if (!engine)
+    {
+        data_logger->error ("No ica engine with id {}", engine_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (engine->get_num_components () != num_components)
+    {
+        data_logger->error ("ica engine {} was created for {} components", engine_id,
+            engine->get_num_components ());
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (engine->get_mutex ());
+    int res = engine->compute (data, rows, cols);
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        data_logger->trace ("ica converged in {} iterations", engine->get_num_iterations ());
+        res = engine->get_matrixes (w_mat, k_mat, a_mat, s_mat);
+    }
+    return res;
+}
+
+int reset_ica_engine (int engine_id)
+{
+    std::shared_ptr<FastICA> engine = get_ica_engine (engine_id);
+    if (!engine)
+    {
+        data_logger->error ("No ica engine with id {}", engine_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (engine->get_mutex ());
+    engine->reset ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int release_ica_engine (int engine_id)
+{
+    std::lock_guard<std::mutex> lock (ica_engines_mutex);
+    if (ica_engines.erase (engine_id) == 0)
+    {
+        data_logger->error ("No ica engine with id {}", engine_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
 int get_version_data_handler (char *version, int *num_chars, int max_chars)
 {
     strncpy (version, BRAINFLOW_VERSION_STRING, max_chars);
@@ -1,142 +1,198 @@
 #include "fastica.h"
 
+#include <algorithm>
 #include <cmath>
-#include <random>
+#include <limits>
+
+
+FastICA::FastICA (int num_components, int max_it, double tol, int seed)
+{
+    this->max_it = max_it;
+    this->num_components = num_components;
+    this->tol = tol;
+    this->seed = seed;
+    warm_start = false;
+    reset ();
+}
+
+void FastICA::set_warm_start (bool warm_start)
+{
+    this->warm_start = warm_start;
+}
+
+void FastICA::reset ()
+{
+    if (seed < 0)
+    {
+        std::random_device rd {};
+        gen.seed (rd ());
+    }
+    else
+    {
+        gen.seed ((unsigned int)seed);
+    }
+    unmixing.resize (0, 0);
+    num_iterations = 0;
+}
 
 // https://en.wikipedia.org/wiki/FastICA
 // https://arnauddelorme.com/ica_for_dummies/
-int FastICA::compute (Eigen::MatrixXd &X)
+int FastICA::compute (const double *data, int rows, int cols)
 {
-    int rows = (int)X.rows ();
-    int cols = (int)X.cols ();
     int min_rows_cols = rows < cols ? rows : cols;
-    if ((num_components < 2) || (max_it < 1) || (rows < 2) || (cols < 2) ||
+    if ((data == NULL) || (num_components < 2) || (max_it < 1) || (rows < 2) || (cols < 2) ||
         (num_components > min_rows_cols))
     {
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
 
-    W.resize (num_components, num_components);
-    A.resize (rows, num_components);
-    K.resize (num_components, rows);
-    S.resize (num_components, cols);
-
-    scale (X, true, row_norm);
-
-    // Whitening
-    // X %*% t(X)/rows
-    Eigen::MatrixXd V = X * (X.array () / cols).matrix ().transpose ();
-    // s <- La.svd(V)
-    Eigen::BDCSVD<Eigen::MatrixXd> s (V, Eigen::ComputeThinU | Eigen::ComputeThinV);
-    // D <- diag(c(1/sqrt(s$d)))
-    Eigen::MatrixXd D = s.singularValues ().array ().sqrt ().inverse ().matrix ().asDiagonal ();
-    // K <- D %*% t(s$u)
-    Eigen::MatrixXd K_temp = D * s.matrixU ().transpose ();
-    // K <- matrix( K[1:rows.comp, ], rows.comp, cols)
-    Eigen::MatrixXd K_temp2 = K_temp.block (0, 0, num_components, rows);
-    // X1 <- K %*% X
-    Eigen::MatrixXd X1 = K_temp2 * X;
-    Eigen::MatrixXd a = fast_ica_parallel_compute (X1);
+    ConstRowMajorMap X (data, rows, cols);
+    int res = whiten (X);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    init_unmixing (rows);
+    fast_ica_parallel_compute ();
     // w <- a %*% K
-    Eigen::MatrixXd w = a * K_temp2;
+    unmixing.noalias () = W * K;
     // S <- w %*% X
-    S = w * X;
-    // A <- t(w) %*% solve(w %*% t(w))
-    A = w.transpose () * (w * w.transpose ()).inverse ();
-    A.transposeInPlace ();
-    K = K_temp2;
-    W = a;
+    multiply_centered (unmixing, X, S);
+    // A <- t(w) %*% solve(w %*% t(w)), stored transposed
+    A.noalias () = (unmixing * unmixing.transpose ()).inverse () * unmixing;
 
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
-Eigen::MatrixXd FastICA::fast_ica_parallel_compute (const Eigen::MatrixXd &X)
+int FastICA::whiten (const ConstRowMajorMap &X)
 {
+    int rows = (int)X.rows ();
     int cols = (int)X.cols ();
-    Eigen::MatrixXd W (num_components, num_components);
-    random_normal (W);
+    means.noalias () = X.rowwise ().mean ();
+    block.resize (rows, std::min (cols, FASTICA_BLOCK_SIZE));
 
-    //  sW <- La.svd(W)
-    Eigen::BDCSVD<Eigen::MatrixXd> sW (W, Eigen::ComputeThinU | Eigen::ComputeThinV);
+    // X %*% t(X)/cols for centered X, only lower triangle is filled
+    cov.setZero (rows, rows);
+    for (int start = 0; start < cols; start += FASTICA_BLOCK_SIZE)
+    {
+        int len = std::min (FASTICA_BLOCK_SIZE, cols - start);
+        block.leftCols (len) = X.middleCols (start, len).colwise () - means;
+        cov.selfadjointView<Eigen::Lower> ().rankUpdate (block.leftCols (len), 1.0 / cols);
+    }
+    // s <- La.svd(V), for symmetric V singular vectors are eigenvectors
+    cov_solver.compute (cov);
+    const Eigen::VectorXd &values = cov_solver.eigenvalues ();
+    if ((cov_solver.info () != Eigen::Success) ||
+        (values (rows - num_components) <=
+            values (rows - 1) * std::numeric_limits<double>::epsilon ()))
+    {
+        // rank of data is less than num_components
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // D <- diag(c(1/sqrt(s$d))), K <- D %*% t(s$u), K <- matrix( K[1:rows.comp, ], rows.comp, cols)
+    // eigenvalues are sorted in increasing order
+    K.resize (num_components, rows);
+    for (int i = 0; i < num_components; i++)
+    {
+        int index = rows - 1 - i;
+        K.row (i) = cov_solver.eigenvectors ().col (index).transpose () / sqrt (values (index));
+    }
+    // X1 <- K %*% X
+    multiply_centered (K, X, X1);
+
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+void FastICA::init_unmixing (int rows)
+{
+    W.resize (num_components, num_components);
+    if ((warm_start) && (unmixing.rows () == num_components) && (unmixing.cols () == rows))
+    {
+        // previous unmixing matrix in current whitened space: w %*% pinv(K)
+        const Eigen::VectorXd &values = cov_solver.eigenvalues ();
+        for (int i = 0; i < num_components; i++)
+        {
+            int index = rows - 1 - i;
+            W.col (i).noalias () =
+                unmixing * cov_solver.eigenvectors ().col (index) * sqrt (values (index));
+        }
+    }
+    else
+    {
+        random_normal (W);
+    }
     // W <- sW$u %*% Diag(1/sW$d) %*% t(sW$u) %*% W
-    W = sW.matrixU () * (sW.singularValues ().array ().inverse ()).matrix ().asDiagonal () *
-        sW.matrixU ().transpose () * W;
-    Eigen::MatrixXd W1 = W;
+    symmetric_decorrelation (W);
+}
+
+void FastICA::fast_ica_parallel_compute ()
+{
+    int cols = (int)X1.cols ();
+    W1.resize (num_components, num_components);
+    gwx.resize (num_components, cols);
+    bool parallel = ((double)num_components * cols >= (double)PARALLEL_FASTICA_MIN_VALUES);
+    (void)parallel;
     // lim <- rep(1000, maxit)
-    std::vector<double> lim (max_it, 1000);
-    // iteration counter
-    int it = 0;
+    double lim = 1000;
+    num_iterations = 0;
 
-    while (lim[it] > tol && it < (max_it - 1))
+    while ((lim > tol) && (num_iterations < (max_it - 1)))
     {
         //  wx <- W %*% X
+        gwx.noalias () = W * X1;
         // gwx <- tanh(alpha * wx)
         // alpha = 1 , so ignore
-        Eigen::MatrixXd gwx = (W * X).array ().tanh ().matrix ();
+#pragma omp parallel for if (parallel)
+        for (int c = 0; c < cols; c++)
+        {
+            gwx.col (c).array () = gwx.col (c).array ().tanh ();
+        }
         // v1 <- gwx %*% t(X)/cols
-        Eigen::MatrixXd v1 = gwx * (X.array () / cols).matrix ().transpose ();
+        W1.noalias () = gwx * X1.transpose ();
+        W1 /= cols;
         // g.wx <- alpha * (1 - (gwx)^2)
-        // nb alpha == 1
-        gwx = 1 - gwx.array ().square ();
         // v2 <- Diag(apply(g.wx, 1, FUN = mean)) %*% W
-        Eigen::MatrixXd v2 = gwx.array ().rowwise ().mean ().matrix ().asDiagonal () * W;
+        g_mean = ((1.0 - gwx.array ().square ()).rowwise ().sum () / cols).matrix ();
         // W1 <- v1 - v2
-        W1 = v1 - v2;
-        // sW1 <- La.svd(W1)
-        Eigen::BDCSVD<Eigen::MatrixXd> sW1 (W1, Eigen::ComputeThinU | Eigen::ComputeThinV);
+        W1.array () -= W.array ().colwise () * g_mean.array ();
         // W1 <- sW1$u %*% Diag(1/sW1$d) %*% t(sW1$u) %*% W1
-        W1 = sW1.matrixU () * (sW1.singularValues ().array ().inverse ()).matrix ().asDiagonal () *
-            sW1.matrixU ().transpose () * W1;
+        symmetric_decorrelation (W1);
         // lim[it + 1] <- max( Mod(   Mod(  diag(W1 %*% t(W) )  )  - 1 ) )
-        lim[it + 1] = ((W1 * W.transpose ()).diagonal ().array ().abs () - 1).abs ().maxCoeff ();
+        lim_diag = (W1.array () * W.array ()).rowwise ().sum ().matrix ();
+        lim = (lim_diag.array ().abs () - 1).abs ().maxCoeff ();
         // W <- W1
-        W = W1;
-        ++it;
+        W.swap (W1);
+        num_iterations++;
     }
-
-    return W;
 }
 
-void FastICA::scale (Eigen::Ref<Eigen::MatrixXd> M, bool center, bool normalize,
-    bool ignore_invariants, std::vector<int> *zeros)
+void FastICA::symmetric_decorrelation (Eigen::MatrixXd &M)
 {
-    int rows = (int)M.rows ();
-    Eigen::Array<double, 1, Eigen::Dynamic> means = M.rowwise ().mean ();
-
-    if (normalize)
-    {
-        // TODO: This block has not been tested yet
-        Eigen::Array<double, 1, Eigen::Dynamic> sds =
-            ((M.array ().rowwise () - means).square ().colwise ().sum () / (rows - 1)).sqrt ();
-
-        for (int i = 0; i < sds.size (); i++)
-        {
-            if (sds[i] == 0)
-            {
-                if (!ignore_invariants)
-                    return;
-                if (zeros != NULL)
-                    zeros->push_back (i);
-                sds[i] = 1.0;
-            }
-        }
+    // singular values of M are square roots of eigenvalues of M %*% t(M) and left singular vectors
+    // are its eigenvectors, it's cheaper than svd of M
+    decorr_temp.noalias () = M * M.transpose ();
+    decorr_solver.compute (decorr_temp);
+    inv_sqrt_values = decorr_solver.eigenvalues ().array ().sqrt ().inverse ().matrix ();
+    decorr_temp.noalias () = decorr_solver.eigenvectors ().transpose () * M;
+    decorr_temp.array ().colwise () *= inv_sqrt_values.array ();
+    M.noalias () = decorr_solver.eigenvectors () * decorr_temp;
+}
 
-        if (center)
-        {
-            M.array ().rowwise () -= means;
-        }
-        M.array ().rowwise () /= sds;
-    }
-    else
+void FastICA::multiply_centered (
+    const Eigen::MatrixXd &m, const ConstRowMajorMap &X, Eigen::MatrixXd &M)
+{
+    int cols = (int)X.cols ();
+    M.resize (m.rows (), cols);
+    for (int start = 0; start < cols; start += FASTICA_BLOCK_SIZE)
     {
-        M.array ().transpose ().rowwise () -= means;
+        int len = std::min (FASTICA_BLOCK_SIZE, cols - start);
+        block.leftCols (len) = X.middleCols (start, len).colwise () - means;
+        M.middleCols (start, len).noalias () = m * block.leftCols (len);
     }
 }
 
 void FastICA::random_normal (Eigen::MatrixXd &M)
 {
-    std::random_device rd {};
-    std::mt19937 gen {rd ()};
     std::normal_distribution<double> d {0, 1};
 
     for (int r = 0; r < M.rows (); r++)
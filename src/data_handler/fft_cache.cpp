@@ -0,0 +1,141 @@
+#include <new>
+
+#include "brainflow_constants.h"
+#include "fft_cache.h"
+#include "window_functions.h"
+
+
+std::mutex FFTCache::mutex;
+std::map<std::pair<int, bool>, std::vector<std::unique_ptr<FFTPlan>>> FFTCache::free_plans;
+std::map<std::pair<int, int>, std::shared_ptr<const std::vector<double>>> FFTCache::windows;
+
+
+FFTPlan::FFTPlan (int nfft, bool inverse)
+{
+    this->nfft = nfft;
+    this->inverse = inverse;
+    cfg = kiss_fftr_alloc (nfft, inverse ? 1 : 0, NULL, NULL);
+    real_buffer.resize (nfft);
+    complex_buffer.resize (nfft / 2 + 1);
+    spectrum_buffer.resize (nfft / 2 + 1);
+}
+
+FFTPlan::~FFTPlan ()
+{
+    if (cfg != NULL)
+    {
+        kiss_fftr_free (cfg);
+        cfg = NULL;
+    }
+}
+
+FFTPlan *FFTCache::acquire_plan (int nfft, bool inverse)
+{
+    if ((nfft <= 0) || (nfft % 2 == 1))
+    {
+        return NULL;
+    }
+    std::pair<int, bool> key (nfft, inverse);
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        auto it = free_plans.find (key);
+        if ((it != free_plans.end ()) && (!it->second.empty ()))
+        {
+            FFTPlan *plan = it->second.back ().release ();
+            it->second.pop_back ();
+            return plan;
+        }
+    }
+    // plan creation is slow, dont hold the lock
+    FFTPlan *plan = NULL;
+    try
+    {
+        plan = new FFTPlan (nfft, inverse);
+    }
+    catch (const std::bad_alloc &)
+    {
+        return NULL;
+    }
+    if (!plan->is_valid ())
+    {
+        delete plan;
+        return NULL;
+    }
+    return plan;
+}
+
+void FFTCache::release_plan (FFTPlan *plan)
+{
+    if (plan == NULL)
+    {
+        return;
+    }
+    std::pair<int, bool> key (plan->get_nfft (), plan->is_inverse ());
+    std::lock_guard<std::mutex> lock (mutex);
+    auto it = free_plans.find (key);
+    if (it == free_plans.end ())
+    {
+        if (free_plans.size () >= FFT_CACHE_MAX_ENTRIES)
+        {
+            // many different sizes are not expected, start from scratch
+            free_plans.clear ();
+        }
+        it = free_plans.insert (std::make_pair (key, std::vector<std::unique_ptr<FFTPlan>> ()))
+                 .first;
+    }
+    it->second.push_back (std::unique_ptr<FFTPlan> (plan));
+}
+
+std::shared_ptr<const std::vector<double>> FFTCache::get_window (
+    int window_function, int window_len)
+{
+    if (window_len <= 0)
+    {
+        return std::shared_ptr<const std::vector<double>> ();
+    }
+    std::pair<int, int> key (window_function, window_len);
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        auto it = windows.find (key);
+        if (it != windows.end ())
+        {
+            return it->second;
+        }
+    }
+
+    std::shared_ptr<std::vector<double>> window = std::make_shared<std::vector<double>> ();
+    window->resize (window_len);
+    // from https://www.edn.com/windowing-functions-improve-fft-results-part-i/
+    switch (static_cast<WindowOperations> (window_function))
+    {
+        case WindowOperations::NO_WINDOW:
+            no_window_function (window_len, window->data ());
+            break;
+        case WindowOperations::HAMMING:
+            hamming_function (window_len, window->data ());
+            break;
+        case WindowOperations::HANNING:
+            hanning_function (window_len, window->data ());
+            break;
+        case WindowOperations::BLACKMAN_HARRIS:
+            blackman_harris_function (window_len, window->data ());
+            break;
+        default:
+            return std::shared_ptr<const std::vector<double>> ();
+    }
+
+    std::lock_guard<std::mutex> lock (mutex);
+    if (windows.size () >= FFT_CACHE_MAX_ENTRIES)
+    {
+        windows.clear ();
+    }
+    // another thread could add the same window, keep the first one
+    return windows.insert (std::make_pair (key, window)).first->second;
+}
+
+void FFTCache::clear ()
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    free_plans.clear ();
+    windows.clear ();
+}
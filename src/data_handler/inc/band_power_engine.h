@@ -0,0 +1,72 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+
+#include "fft_cache.h"
+#include "streaming_filter.h"
+
+
+// sliding window Welch psd for several channels, new samples are added with update and only
+// segments which were completed by them are transformed. Average is updated incrementally by
+// adding new segment and subtracting expired one, segment length and 80% overlap are the same
+// as in get_custom_band_powers
+class BandPowerEngine
+{
+
+public:
+    BandPowerEngine (int num_channels, int sampling_rate, int window_len, bool apply_filters);
+
+    // returns BrainFlowExitCodes, should be called before other methods
+    int prepare ();
+    // data contains num_channels rows with data_len values each, input is not modified
+    void update (const double *data, int data_len);
+    void reset ();
+    // averaged psd over segments in the window, ampl and freq have get_nfft () / 2 + 1 values,
+    // returns false if there are no complete segments yet
+    bool get_psd (int channel, double *ampl, double *freq);
+
+    int get_nfft ()
+    {
+        return nfft;
+    }
+
+    int get_num_channels ()
+    {
+        return num_channels;
+    }
+
+    std::mutex &get_mutex ()
+    {
+        return mutex;
+    }
+
+private:
+    int num_channels;
+    int sampling_rate;
+    int window_len;
+    bool apply_filters;
+    int nfft;
+    int step;         // samples between segments
+    int max_segments; // segments in the window
+    int num_bins;
+
+    // causal versions of filters from get_custom_band_powers, applied one after another
+    std::vector<std::unique_ptr<StreamingFilter>> filters;
+    std::unique_ptr<FFTPlan> plan;
+    std::shared_ptr<const std::vector<double>> window;
+    std::vector<double> input;         // [num_channels x data_len] copy of the latest update
+    std::vector<double> samples;       // [num_channels x nfft] ring of last samples
+    int64_t total_samples;             // samples added since reset
+    int samples_since_segment;         // the same for all channels
+    std::vector<double> spectra;       // [num_channels x max_segments x num_bins] ring
+    std::vector<double> spectra_sum;   // [num_channels x num_bins]
+    int segment_pos;                   // position in spectra ring for the next segment
+    int num_segments;                  // valid segments in spectra ring
+    std::mutex mutex;
+
+    void add_segment (int channel);
+    void recalc_sum (int channel);
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <math.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 inline double rms (double x[], int n)
@@ -48,4 +49,23 @@ inline void reverse_array (double data[], int len)
         data[i] = data[len - i - 1];
         data[len - i - 1] = temp;
     }
-}
\ No newline at end of file
+}
+
+// nearest power of two, if distances are equal the larger one, value should be positive
+inline int nearest_power_of_two (int value)
+{
+    if (value == 1)
+    {
+        return 2;
+    }
+    int32_t v = (int32_t)value;
+    v--;
+    v |= v >> 1;
+    v |= v >> 2;
+    v |= v >> 4;
+    v |= v >> 8;
+    v |= v >> 16;
+    v++;            // next power of 2
+    int x = v >> 1; // previous power of 2
+    return (v - value) > (value - x) ? x : v;
+}
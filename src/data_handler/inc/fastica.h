@@ -1,42 +1,93 @@
 #pragma once
 
+#include <mutex>
+#include <random>
 #include <stdlib.h>
 #include <vector>
 
 #include "Eigen/Dense"
 #include "brainflow_constants.h"
 
+// number of samples centered at once, data is never copied as a whole
+#define FASTICA_BLOCK_SIZE 4096
+// min num_components * cols to evaluate nonlinearity in parallel
+#define PARALLEL_FASTICA_MIN_VALUES 65536
 
+
+// all matrixes are kept between calls, so repeated compute with the same data size doesnt
+// allocate memory in iterations, object can be used only by one thread at a time
 class FastICA
 {
 
 public:
-    FastICA (int num_components, int max_it = 300, double tol = 0.0001)
+    // seed < 0 means seed from std::random_device
+    FastICA (int num_components, int max_it = 300, double tol = 0.0001, int seed = -1);
+
+    // data is row major rows x cols array, it's not modified
+    int compute (const double *data, int rows, int cols);
+    int get_matrixes (double *w_mat, double *k_mat, double *a_mat, double *s_mat);
+    // if enabled and number of rows is the same, next compute starts from unmixing matrix of the
+    // previous one instead of random matrix and converges faster for overlapping windows
+    void set_warm_start (bool warm_start);
+    // drops previous solution and restarts random generator
+    void reset ();
+
+    int get_num_components ()
     {
-        this->max_it = max_it;
-        this->num_components = num_components;
-        this->tol = tol;
-        alpha = 1;
-        row_norm = false;
+        return num_components;
     }
 
-    int compute (Eigen::MatrixXd &X);
-    int get_matrixes (double *w_mat, double *k_mat, double *a_mat, double *s_mat);
+    int get_num_iterations ()
+    {
+        return num_iterations;
+    }
+
+    std::mutex &get_mutex ()
+    {
+        return mutex;
+    }
 
 private:
+    typedef Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
+        ConstRowMajorMap;
+
     Eigen::MatrixXd K;
     Eigen::MatrixXd W;
     Eigen::MatrixXd A;
     Eigen::MatrixXd S;
+    // W * K from the last compute, unmixing matrix for centered data
+    Eigen::MatrixXd unmixing;
+
+    // workspaces
+    Eigen::VectorXd means;
+    Eigen::MatrixXd block;
+    Eigen::MatrixXd cov;
+    Eigen::MatrixXd X1;
+    Eigen::MatrixXd gwx;
+    Eigen::VectorXd g_mean;
+    Eigen::VectorXd lim_diag;
+    Eigen::MatrixXd W1;
+    Eigen::MatrixXd decorr_temp;
+    Eigen::VectorXd inv_sqrt_values;
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> cov_solver;
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> decorr_solver;
+
+    std::mt19937 gen;
+    std::mutex mutex;
 
-    Eigen::MatrixXd fast_ica_parallel_compute (const Eigen::MatrixXd &X);
-    void scale (Eigen::Ref<Eigen::MatrixXd> m, bool, bool, bool ignore_invariants = false,
-        std::vector<int> *zeros = NULL);
+    int whiten (const ConstRowMajorMap &X);
+    void init_unmixing (int rows);
+    void fast_ica_parallel_compute ();
+    void symmetric_decorrelation (Eigen::MatrixXd &M);
+    // M = m * (X - means), by blocks
+    void multiply_centered (
+        const Eigen::MatrixXd &m, const ConstRowMajorMap &X, Eigen::MatrixXd &M);
     void random_normal (Eigen::MatrixXd &m);
 
     int max_it;
     int num_components;
     double tol;
-    int alpha;
-    bool row_norm;
+    int seed;
+    bool warm_start;
+    int num_iterations;
 };
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "kiss_fftr.h"
+
+// one sided power spectral density from nfft / 2 + 1 bins of real fft
+inline void fill_one_sided_psd (const kiss_fft_cpx *fft, int nfft, int sampling_rate,
+    double *output_ampl, double *output_freq)
+{
+    double freq_res = (double)sampling_rate / (double)nfft;
+    for (int i = 0; i < nfft / 2 + 1; i++)
+    {
+        // https://www.mathworks.com/help/signal/ug/power-spectral-density-estimates-using-fft.html
+        output_ampl[i] =
+            (fft[i].r * fft[i].r + fft[i].i * fft[i].i) / ((double)(sampling_rate * nfft));
+        if ((i != 0) && (i != nfft / 2))
+        {
+            output_ampl[i] *= 2;
+        }
+        if (output_freq != NULL)
+        {
+            output_freq[i] = i * freq_res;
+        }
+    }
+}
+
+// max number of different (nfft, direction) and (window, len) pairs kept in cache
+#define FFT_CACHE_MAX_ENTRIES 64
+
+
+// kiss_fftr config with buffers for one transform, kiss_fftr uses scratch memory inside config
+// so plan can be used only by one thread at a time
+class FFTPlan
+{
+
+public:
+    FFTPlan (int nfft, bool inverse);
+    ~FFTPlan ();
+
+    // false if config allocation failed
+    bool is_valid ()
+    {
+        return cfg != NULL;
+    }
+
+    int get_nfft ()
+    {
+        return nfft;
+    }
+
+    bool is_inverse ()
+    {
+        return inverse;
+    }
+
+    kiss_fftr_cfg get_cfg ()
+    {
+        return cfg;
+    }
+
+    // nfft values
+    double *get_real_buffer ()
+    {
+        return real_buffer.data ();
+    }
+
+    // nfft / 2 + 1 values
+    kiss_fft_cpx *get_complex_buffer ()
+    {
+        return complex_buffer.data ();
+    }
+
+    // nfft / 2 + 1 values
+    double *get_spectrum_buffer ()
+    {
+        return spectrum_buffer.data ();
+    }
+
+private:
+    int nfft;
+    bool inverse;
+    kiss_fftr_cfg cfg;
+    std::vector<double> real_buffer;
+    std::vector<kiss_fft_cpx> complex_buffer;
+    std::vector<double> spectrum_buffer;
+};
+
+
+// thread safe cache of fft plans and window tables, repeated calls with the same sizes don't
+// allocate memory after warm up
+class FFTCache
+{
+
+public:
+    // returns NULL if plan can not be created, plan is used exclusively by caller until release
+    static FFTPlan *acquire_plan (int nfft, bool inverse);
+    static void release_plan (FFTPlan *plan);
+    // returns empty pointer for invalid window function, window is shared and immutable
+    static std::shared_ptr<const std::vector<double>> get_window (
+        int window_function, int window_len);
+    static void clear ();
+
+private:
+    static std::mutex mutex;
+    static std::map<std::pair<int, bool>, std::vector<std::unique_ptr<FFTPlan>>> free_plans;
+    static std::map<std::pair<int, int>, std::shared_ptr<const std::vector<double>>> windows;
+};
+
+
+// acquires plan in constructor and returns it to cache in destructor
+class FFTPlanGuard
+{
+
+public:
+    FFTPlanGuard (int nfft, bool inverse)
+    {
+        plan = FFTCache::acquire_plan (nfft, inverse);
+    }
+
+    ~FFTPlanGuard ()
+    {
+        if (plan != NULL)
+        {
+            FFTCache::release_plan (plan);
+        }
+    }
+
+    FFTPlan *get ()
+    {
+        return plan;
+    }
+
+private:
+    FFTPlan *plan;
+
+    FFTPlanGuard (const FFTPlanGuard &) = delete;
+    FFTPlanGuard &operator= (const FFTPlanGuard &) = delete;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "rolling_filter.h"
+
+
+// z-score peak detection, https://stackoverflow.com/a/22640362
+// Mean and stddev of the last lag filtered values are updated per sample instead of recalculated,
+// so whole signal is O(n). Output is the same as in the original implementation of
+// detect_peaks_z_score: window used for sample i is filtered_data[i - 1 - lag ... i - 2], except
+// sample lag which uses the first lag values, and there are zeros while the first lag values are
+// collected.
+class ZScorePeakDetector
+{
+
+public:
+    ZScorePeakDetector (int lag, double threshold, double influence);
+
+    // output[i] is 1, -1 or 0 for data[i], output can be the same array as data
+    void process (const double *data, double *output, int data_len);
+    void reset ();
+
+private:
+    int lag;
+    double threshold;
+    double influence;
+    long long count;
+    double prev_filtered; // filtered_data[i - 2]
+    double last_filtered; // filtered_data[i - 1]
+    double avg;
+    double std;
+    RollingVariance<double> variance;
+};
+
+// peak detectors for several channels which keep state between calls
+class StreamingPeakDetector
+{
+
+public:
+    StreamingPeakDetector (int lag, double threshold, double influence, int num_channels);
+
+    // data and output contain num_channels rows with data_len values each, output can be data
+    void process (const double *data, double *output, int data_len);
+    void reset ();
+
+    int get_num_channels ()
+    {
+        return (int)detectors.size ();
+    }
+
+    std::mutex &get_mutex ()
+    {
+        return mutex;
+    }
+
+private:
+    std::vector<ZScorePeakDetector> detectors;
+    std::mutex mutex;
+};
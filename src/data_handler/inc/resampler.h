@@ -0,0 +1,90 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// max value of reduced up and down factors, filter length grows linearly with them
+#define RESAMPLER_MAX_FACTOR 1000
+// max number of different (up, down) pairs kept in cache
+#define RESAMPLER_CACHE_MAX_ENTRIES 64
+
+
+// windowed sinc lowpass for upsampling by up and downsampling by down, split into up phases,
+// the same design as in scipy.signal.resample_poly (kaiser window with beta 5, half length is
+// 10 * max (up, down)), delay is a multiple of down
+struct PolyphaseFilter
+{
+    int up;
+    int down;
+    int taps_per_phase;
+    // delay of filter in output samples
+    int delay;
+    // [up x taps_per_phase], coefficients of each phase are reversed to be used as dot product
+    // with the last taps_per_phase input values
+    std::vector<double> coeffs;
+};
+
+// reduces output_rate / input_rate to up / down, returns BrainFlowExitCodes
+int get_resampling_factors (int input_rate, int output_rate, int *up, int *down);
+// number of output values for data_len input values for one shot resampling
+int get_resampled_len (int data_len, int up, int down);
+
+// thread safe cache of filters, designed once for each (up, down) pair
+class PolyphaseFilterCache
+{
+
+public:
+    // returns empty pointer for invalid factors, filter is shared and immutable
+    static std::shared_ptr<const PolyphaseFilter> get_filter (int up, int down);
+    static void clear ();
+
+private:
+    static std::mutex mutex;
+    static std::map<std::pair<int, int>, std::shared_ptr<const PolyphaseFilter>> filters;
+};
+
+// one shot resampling, signal is zero outside of data and filter delay is compensated, output
+// contains get_resampled_len (data_len, up, down) values
+void resample (const PolyphaseFilter &filter, const double *data, int data_len, double *output);
+
+
+// causal resampler for several channels which keeps history between calls, chunks produce the same
+// output as the whole signal, output is delayed by filter->delay samples compared with resample
+class StreamingResampler
+{
+
+public:
+    StreamingResampler (std::shared_ptr<const PolyphaseFilter> filter, int num_channels);
+
+    // data contains num_channels rows with data_len values each, output contains num_channels
+    // rows with returned number of values each, it is at most get_max_output_len (data_len)
+    int process (const double *data, int data_len, double *output);
+    void reset ();
+
+    int get_max_output_len (int data_len)
+    {
+        return (int)(((long long)data_len * filter->up) / filter->down) + 1;
+    }
+
+    int get_num_channels ()
+    {
+        return num_channels;
+    }
+
+    std::mutex &get_mutex ()
+    {
+        return mutex;
+    }
+
+private:
+    std::shared_ptr<const PolyphaseFilter> filter;
+    int num_channels;
+    long long num_inputs;
+    long long num_outputs;
+    std::vector<double> history; // [num_channels x (taps_per_phase - 1)] last input values
+    std::vector<double> buffer;  // history with the current chunk of one channel
+    std::mutex mutex;
+};
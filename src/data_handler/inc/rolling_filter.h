@@ -1,103 +1,349 @@
 #pragma once
 
 #include <deque>
+#include <functional>
+#include <iterator>
+#include <mutex>
 #include <set>
+#include <utility>
+#include <vector>
 
+#include "brainflow_constants.h"
+
+
+// Rolling statistics over the last period values. Filters are not virtual, loops over samples are
+// instantiated per filter type with apply_rolling_filter. process adds value and returns the
+// statistic for the window which ends with this value.
+
+// median of two balanced multisets, O(log period) per sample
+// https://leetcode.com/problems/sliding-window-median/
 template <typename T>
-class RollingFilter
+class RollingMedian
 {
 
-protected:
+private:
     int period;
+    std::multiset<T> low;  // smaller half, its size is equal or bigger by one
+    std::multiset<T> high; // bigger half
+    std::deque<T> window;
+
+    void rebalance ()
+    {
+        if (low.size () > high.size () + 1)
+        {
+            auto it = std::prev (low.end ());
+            high.insert (*it);
+            low.erase (it);
+        }
+        else if (high.size () > low.size ())
+        {
+            auto it = high.begin ();
+            low.insert (*it);
+            high.erase (it);
+        }
+    }
+
+    void insert (T num)
+    {
+        if ((low.empty ()) || (num <= *low.rbegin ()))
+        {
+            low.insert (num);
+        }
+        else
+        {
+            high.insert (num);
+        }
+        rebalance ();
+    }
+
+    void erase (T num)
+    {
+        // values equal to max of low half can be in both halves, any of them can be removed
+        if (num <= *low.rbegin ())
+        {
+            low.erase (low.find (num));
+        }
+        else
+        {
+            high.erase (high.find (num));
+        }
+        rebalance ();
+    }
 
 public:
-    RollingFilter (int period)
+    RollingMedian (int period)
     {
         this->period = period;
     }
 
-    virtual ~RollingFilter ()
+    T process (T num)
     {
+        window.push_back (num);
+        insert (num);
+        if ((int)window.size () < period)
+        {
+            // to simplify algorithm if there are less data just return the last value
+            return num;
+        }
+        T first = *low.rbegin ();
+        T second = ((period & 1) == 0) ? *high.begin () : first;
+        T res = (first + second) / 2.0;
+        erase (window.front ());
+        window.pop_front ();
+        return res;
     }
 
-    virtual void add_data (T num) = 0;
-    virtual T get_value () = 0;
+    void reset ()
+    {
+        low.clear ();
+        high.clear ();
+        window.clear ();
+    }
 };
 
+// mean of available values if there are less than period values
 template <typename T>
-class RollingMedian : public RollingFilter<T>
+class RollingMean
 {
 
 private:
-    std::multiset<T> dataset;
-    std::deque<T> deque;
+    int period;
+    std::deque<T> window;
+    T sum;
 
 public:
-    RollingMedian (int period) : RollingFilter<T> (period)
+    RollingMean (int period)
     {
+        this->period = period;
+        sum = 0;
     }
 
-    void add_data (T num)
+    T process (T num)
     {
-        this->deque.push_back (num);
-        this->dataset.insert (num);
+        sum += num;
+        window.push_back (num);
+        if ((int)window.size () > period)
+        {
+            sum -= window.front ();
+            window.pop_front ();
+        }
+        return sum / window.size ();
     }
 
-    // https://leetcode.com/problems/sliding-window-median/
-    T get_value ()
+    T get_mean ()
     {
-        if ((int)this->dataset.size () < this->period)
-        {
-            // to simplify algorithm if there are less data just return the last value
-            return this->deque.back ();
-        }
-        auto it1 = this->dataset.begin ();
-        auto it2 = it1;
-        std::advance (it1, (this->period - 1) / 2);
-        it2 = it1;
-        std::advance (it2, (int)((this->period & 1) == 0));
-        T res = (*it1 + *it2) / 2.0;
-        T val = deque.front ();
-        deque.pop_front ();
-        this->dataset.erase (this->dataset.find (val));
-        return res;
+        return window.empty () ? 0 : sum / window.size ();
+    }
+
+    void reset ()
+    {
+        window.clear ();
+        sum = 0;
     }
 };
 
+// population variance of available values, Welford updates for added and removed values, mean and
+// m2 are recalculated from the window after each period removals to bound rounding errors
 template <typename T>
-class RollingAverage : public RollingFilter<T>
+class RollingVariance
 {
 
 private:
-    std::deque<T> dataset;
-    T sum;
+    int period;
+    int num_removed;
+    std::deque<T> window;
+    T mean;
+    T m2;
+
+    void recalculate ()
+    {
+        T sum = 0;
+        for (T value : window)
+        {
+            sum += value;
+        }
+        mean = sum / window.size ();
+        m2 = 0;
+        for (T value : window)
+        {
+            m2 += (value - mean) * (value - mean);
+        }
+        num_removed = 0;
+    }
 
 public:
-    RollingAverage (int period) : RollingFilter<T> (period)
+    RollingVariance (int period)
     {
-        this->sum = 0;
+        this->period = period;
+        num_removed = 0;
+        mean = 0;
+        m2 = 0;
     }
 
-    void add_data (T num)
+    T process (T num)
     {
-        this->sum += num;
-        this->dataset.push_back (num);
-        if ((int)this->dataset.size () > this->period)
+        window.push_back (num);
+        T delta = num - mean;
+        mean += delta / window.size ();
+        m2 += delta * (num - mean);
+        if ((int)window.size () > period)
         {
-            this->sum -= this->dataset.front ();
-            this->dataset.pop_front ();
+            T old = window.front ();
+            window.pop_front ();
+            if (++num_removed >= period)
+            {
+                recalculate ();
+            }
+            else
+            {
+                delta = old - mean;
+                mean -= delta / window.size ();
+                m2 -= delta * (old - mean);
+            }
         }
+        if (m2 < 0)
+        {
+            // rounding errors after many updates
+            m2 = 0;
+        }
+        return m2 / window.size ();
     }
 
-    T get_value ()
+    T get_mean ()
     {
-        if ((int)this->dataset.size () < this->period)
+        return mean;
+    }
+
+    void reset ()
+    {
+        window.clear ();
+        num_removed = 0;
+        mean = 0;
+        m2 = 0;
+    }
+};
+
+// min (Compare is std::less) or max (std::greater) with monotonic deque, amortized O(1)
+template <typename T, typename Compare>
+class RollingExtremum
+{
+
+private:
+    int period;
+    long long count;
+    std::deque<std::pair<long long, T>> candidates; // index and value, front is the answer
+    Compare compare;
+
+public:
+    RollingExtremum (int period)
+    {
+        this->period = period;
+        count = 0;
+    }
+
+    T process (T num)
+    {
+        while ((!candidates.empty ()) && (!compare (candidates.back ().second, num)))
         {
-            return this->sum / this->dataset.size ();
+            candidates.pop_back ();
         }
-        else
+        candidates.push_back (std::make_pair (count, num));
+        if (candidates.front ().first <= count - period)
+        {
+            candidates.pop_front ();
+        }
+        count++;
+        return candidates.front ().second;
+    }
+
+    void reset ()
+    {
+        candidates.clear ();
+        count = 0;
+    }
+};
+
+template <typename T>
+using RollingMin = RollingExtremum<T, std::less<T>>;
+template <typename T>
+using RollingMax = RollingExtremum<T, std::greater<T>>;
+
+// replaces data with rolling statistic in-place
+template <typename Filter, typename T>
+void apply_rolling_filter (Filter &filter, T *data, int data_len)
+{
+    for (int i = 0; i < data_len; i++)
+    {
+        data[i] = filter.process (data[i]);
+    }
+}
+
+// rolling filter for several channels which keeps windows between calls, chunks produce the same
+// output as perform_rolling_filter for the whole signal
+class StreamingRollingFilter
+{
+
+public:
+    // agg_operation is MEAN or MEDIAN from AggOperations
+    StreamingRollingFilter (int period, int agg_operation, int num_channels)
+    {
+        this->agg_operation = agg_operation;
+        this->num_channels = num_channels;
+        for (int i = 0; i < num_channels; i++)
+        {
+            if (agg_operation == (int)AggOperations::MEDIAN)
+            {
+                medians.push_back (RollingMedian<double> (period));
+            }
+            else
+            {
+                means.push_back (RollingMean<double> (period));
+            }
+        }
+    }
+
+    // data contains num_channels rows with data_len values each, processed in-place
+    void process (double *data, int data_len)
+    {
+        for (int i = 0; i < num_channels; i++)
+        {
+            if (agg_operation == (int)AggOperations::MEDIAN)
+            {
+                apply_rolling_filter (medians[i], data + i * data_len, data_len);
+            }
+            else
+            {
+                apply_rolling_filter (means[i], data + i * data_len, data_len);
+            }
+        }
+    }
+
+    void reset ()
+    {
+        for (auto &median : medians)
         {
-            return this->sum / this->period;
+            median.reset ();
         }
+        for (auto &mean : means)
+        {
+            mean.reset ();
+        }
+    }
+
+    int get_num_channels ()
+    {
+        return num_channels;
     }
+
+    std::mutex &get_mutex ()
+    {
+        return mutex;
+    }
+
+private:
+    int agg_operation;
+    int num_channels;
+    std::vector<RollingMedian<double>> medians;
+    std::vector<RollingMean<double>> means;
+    std::mutex mutex;
 };
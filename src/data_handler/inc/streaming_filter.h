@@ -0,0 +1,62 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#define MAX_FILTER_ORDER 8
+
+
+// coefficients of second order section normalized by a0, the same as in DSPFilters
+struct BiquadCoeffs
+{
+    double b0;
+    double b1;
+    double b2;
+    double a1;
+    double a2;
+};
+
+// designs cascade of second order sections for FilterOperations and FilterTypes, for lowpass and
+// highpass start_freq is a cutoff, zero phase types are designed as their causal versions,
+// returns BrainFlowExitCodes
+int design_biquads (int filter_operation, int sampling_rate, double start_freq, double stop_freq,
+    int order, int filter_type, double ripple, std::vector<struct BiquadCoeffs> &stages);
+
+
+// IIR filter for several channels which keeps state between calls, coefficients are designed once
+// processing matches DSPFilters DirectFormII, so chunks produce the same output as whole signal.
+// Channels are processed in groups of FILTER_LANES with one channel per SIMD lane
+class StreamingFilter
+{
+
+public:
+    StreamingFilter (const std::vector<struct BiquadCoeffs> &stages, int num_channels);
+
+    // data contains num_channels rows with data_len values each, filtered in-place
+    void process (double *data, int data_len);
+    // data is row-major with cols values per row, rows from channels are filtered in-place,
+    // i-th row from channels uses state of i-th filter channel, rows must not repeat
+    void process_rows (double *data, int cols, const int *channels);
+    void reset ();
+
+    int get_num_channels ()
+    {
+        return num_channels;
+    }
+
+    std::mutex &get_mutex ()
+    {
+        return mutex;
+    }
+
+private:
+    std::vector<struct BiquadCoeffs> stages;
+    int num_channels;
+    std::vector<double> state;       // [num_channels x num_stages x 2]
+    std::vector<double> denormal_ac; // alternating value added to the first stage
+    std::vector<int> contiguous_channels;
+    std::mutex mutex;
+
+    void process_channel (double *data, int data_len, int channel);
+    void process_lanes (double *data, int cols, const int *channels, int first_channel);
+};
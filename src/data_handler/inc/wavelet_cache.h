@@ -0,0 +1,121 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "wavelib.h"
+
+// max number of different (wavelet, data_len, decomposition_level, extension) keys kept in cache
+#define WAVELET_CACHE_MAX_ENTRIES 64
+// wavelib convolves with fft instead of direct sum if filter is at least this long
+#define WAVELET_FFT_MIN_FILTER_LEN 64
+
+
+// wavelib wave and dwt objects for one signal length, wt object keeps coefficients of the last
+// transform, so context can be used only by one thread at a time
+class WaveletContext
+{
+
+public:
+    // throws std::runtime_error from wavelib for invalid params or too small data_len
+    WaveletContext (int wavelet, int data_len, int decomposition_level, int extension);
+    ~WaveletContext ();
+
+    int get_wavelet ()
+    {
+        return wavelet;
+    }
+
+    int get_data_len ()
+    {
+        return data_len;
+    }
+
+    int get_decomposition_level ()
+    {
+        return decomposition_level;
+    }
+
+    int get_extension ()
+    {
+        return extension;
+    }
+
+    wt_object get_wt ()
+    {
+        return wt;
+    }
+
+    // data_len values
+    double *get_buffer ()
+    {
+        return buffer.data ();
+    }
+
+private:
+    int wavelet;
+    int data_len;
+    int decomposition_level;
+    int extension;
+    wave_object wave;
+    wt_object wt;
+    std::vector<double> buffer;
+
+    WaveletContext (const WaveletContext &) = delete;
+    WaveletContext &operator= (const WaveletContext &) = delete;
+};
+
+
+// thread safe cache of wavelet contexts, repeated calls with the same params don't allocate memory
+// after warm up
+class WaveletCache
+{
+
+public:
+    // returns NULL if context can not be created, context is used exclusively by caller until
+    // release
+    static WaveletContext *acquire_context (
+        int wavelet, int data_len, int decomposition_level, int extension);
+    static void release_context (WaveletContext *context);
+    static void clear ();
+
+private:
+    static std::mutex mutex;
+    static std::map<std::tuple<int, int, int, int>, std::vector<std::unique_ptr<WaveletContext>>>
+        free_contexts;
+};
+
+
+// acquires context in constructor and returns it to cache in destructor
+class WaveletContextGuard
+{
+
+public:
+    WaveletContextGuard (int wavelet, int data_len, int decomposition_level, int extension)
+    {
+        context =
+            WaveletCache::acquire_context (wavelet, data_len, decomposition_level, extension);
+    }
+
+    ~WaveletContextGuard ()
+    {
+        if (context != NULL)
+        {
+            WaveletCache::release_context (context);
+        }
+    }
+
+    WaveletContext *get ()
+    {
+        return context;
+    }
+
+private:
+    WaveletContext *context;
+
+    WaveletContextGuard (const WaveletContextGuard &) = delete;
+    WaveletContextGuard &operator= (const WaveletContextGuard &) = delete;
+};
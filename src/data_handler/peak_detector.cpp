@@ -0,0 +1,86 @@
+#include <math.h>
+
+#include "peak_detector.h"
+
+
+ZScorePeakDetector::ZScorePeakDetector (int lag, double threshold, double influence)
+    : variance (lag)
+{
+    this->lag = lag;
+    this->threshold = threshold;
+    this->influence = influence;
+    reset ();
+}
+
+void ZScorePeakDetector::reset ()
+{
+    count = 0;
+    prev_filtered = 0.0;
+    last_filtered = 0.0;
+    avg = 0.0;
+    std = 0.0;
+    variance.reset ();
+}
+
+void ZScorePeakDetector::process (const double *data, double *output, int data_len)
+{
+    for (int i = 0; i < data_len; i++, count++)
+    {
+        double value = data[i];
+        if (count < lag)
+        {
+            prev_filtered = last_filtered;
+            last_filtered = value;
+            double var = variance.process (value);
+            if (count == lag - 1)
+            {
+                avg = variance.get_mean ();
+                std = sqrt (var);
+            }
+            output[i] = 0.0;
+            continue;
+        }
+        // window is two samples behind, the first one is added for sample lag + 2
+        if (count > lag + 1)
+        {
+            double var = variance.process (prev_filtered);
+            avg = variance.get_mean ();
+            std = sqrt (var);
+        }
+        double filtered = value;
+        double res = 0.0;
+        if (fabs (value - avg) > threshold * std)
+        {
+            res = (value > avg) ? 1.0 : -1.0;
+            filtered = influence * value + (1 - influence) * last_filtered;
+        }
+        prev_filtered = last_filtered;
+        last_filtered = filtered;
+        output[i] = res;
+    }
+}
+
+StreamingPeakDetector::StreamingPeakDetector (
+    int lag, double threshold, double influence, int num_channels)
+{
+    for (int i = 0; i < num_channels; i++)
+    {
+        detectors.push_back (ZScorePeakDetector (lag, threshold, influence));
+    }
+}
+
+void StreamingPeakDetector::process (const double *data, double *output, int data_len)
+{
+    for (size_t i = 0; i < detectors.size (); i++)
+    {
+        detectors[i].process (data + i * data_len, output + i * data_len, data_len);
+    }
+}
+
+void StreamingPeakDetector::reset ()
+{
+    for (auto &detector : detectors)
+    {
+        detector.reset ();
+    }
+}
@@ -0,0 +1,278 @@
+#include <algorithm>
+#include <math.h>
+#include <new>
+
+#include "brainflow_constants.h"
+#include "resampler.h"
+
+// the same lanes as in streaming filter, AVX is used only if it is enabled for the compiler
+#if defined(__AVX__)
+#include <immintrin.h>
+#define RESAMPLER_LANES 4
+typedef __m256d lanes_t;
+#define lanes_load(ptr) _mm256_loadu_pd (ptr)
+#define lanes_store(ptr, val) _mm256_storeu_pd (ptr, val)
+#define lanes_set1(val) _mm256_set1_pd (val)
+#define lanes_add(a, b) _mm256_add_pd (a, b)
+#define lanes_mul(a, b) _mm256_mul_pd (a, b)
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define RESAMPLER_LANES 2
+typedef __m128d lanes_t;
+#define lanes_load(ptr) _mm_loadu_pd (ptr)
+#define lanes_store(ptr, val) _mm_storeu_pd (ptr, val)
+#define lanes_set1(val) _mm_set1_pd (val)
+#define lanes_add(a, b) _mm_add_pd (a, b)
+#define lanes_mul(a, b) _mm_mul_pd (a, b)
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define RESAMPLER_LANES 2
+typedef float64x2_t lanes_t;
+#define lanes_load(ptr) vld1q_f64 (ptr)
+#define lanes_store(ptr, val) vst1q_f64 (ptr, val)
+#define lanes_set1(val) vdupq_n_f64 (val)
+#define lanes_add(a, b) vaddq_f64 (a, b)
+#define lanes_mul(a, b) vmulq_f64 (a, b)
+#else
+#define RESAMPLER_LANES 1
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define RESAMPLER_KAISER_BETA 5.0
+#define RESAMPLER_HALF_LEN_FACTOR 10
+
+
+std::mutex PolyphaseFilterCache::mutex;
+std::map<std::pair<int, int>, std::shared_ptr<const PolyphaseFilter>>
+    PolyphaseFilterCache::filters;
+
+
+static int gcd (int a, int b)
+{
+    while (b != 0)
+    {
+        int tmp = a % b;
+        a = b;
+        b = tmp;
+    }
+    return a;
+}
+
+// modified bessel function of the first kind, order 0
+static double bessel_i0 (double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 100; k++)
+    {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if (term < sum * 1e-17)
+        {
+            break;
+        }
+    }
+    return sum;
+}
+
+static inline double dot (const double *a, const double *b, int len)
+{
+    double res = 0.0;
+    int i = 0;
+#if RESAMPLER_LANES > 1
+    lanes_t acc = lanes_set1 (0.0);
+    for (; i + RESAMPLER_LANES <= len; i += RESAMPLER_LANES)
+    {
+        acc = lanes_add (acc, lanes_mul (lanes_load (a + i), lanes_load (b + i)));
+    }
+    double values[RESAMPLER_LANES];
+    lanes_store (values, acc);
+    for (int lane = 0; lane < RESAMPLER_LANES; lane++)
+    {
+        res += values[lane];
+    }
+#endif
+    for (; i < len; i++)
+    {
+        res += a[i] * b[i];
+    }
+    return res;
+}
+
+static PolyphaseFilter *design_polyphase_filter (int up, int down)
+{
+    int max_factor = (up > down) ? up : down;
+    int half_len = RESAMPLER_HALF_LEN_FACTOR * max_factor;
+    int num_taps = 2 * half_len + 1;
+    // zeros in front make delay a multiple of down, so delayed output is aligned with input
+    int pre_pad = (down - half_len % down) % down;
+    // cutoff relative to nyquist of upsampled signal, like in scipy.signal.firwin
+    double cutoff = 1.0 / max_factor;
+    std::vector<double> taps (pre_pad + num_taps, 0.0);
+    double sum = 0.0;
+    for (int i = 0; i < num_taps; i++)
+    {
+        double x = cutoff * (i - half_len);
+        double sinc = (x == 0.0) ? 1.0 : sin (M_PI * x) / (M_PI * x);
+        double ratio = 2.0 * i / (num_taps - 1) - 1.0;
+        double window = bessel_i0 (RESAMPLER_KAISER_BETA * sqrt (1.0 - ratio * ratio)) /
+            bessel_i0 (RESAMPLER_KAISER_BETA);
+        taps[pre_pad + i] = cutoff * sinc * window;
+        sum += taps[pre_pad + i];
+    }
+
+    PolyphaseFilter *filter = new PolyphaseFilter ();
+    filter->up = up;
+    filter->down = down;
+    filter->taps_per_phase = ((int)taps.size () + up - 1) / up;
+    filter->delay = (half_len + pre_pad) / down;
+    filter->coeffs.resize ((size_t)up * filter->taps_per_phase, 0.0);
+    for (int phase = 0; phase < up; phase++)
+    {
+        for (int j = 0; j < filter->taps_per_phase; j++)
+        {
+            size_t idx = (size_t)phase + (size_t)(filter->taps_per_phase - 1 - j) * up;
+            if (idx < taps.size ())
+            {
+                // unit gain at DC after zero stuffing
+                filter->coeffs[(size_t)phase * filter->taps_per_phase + j] = taps[idx] * up / sum;
+            }
+        }
+    }
+    return filter;
+}
+
+int get_resampling_factors (int input_rate, int output_rate, int *up, int *down)
+{
+    if ((input_rate < 1) || (output_rate < 1) || (up == NULL) || (down == NULL))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int divisor = gcd (input_rate, output_rate);
+    *up = output_rate / divisor;
+    *down = input_rate / divisor;
+    if ((*up > RESAMPLER_MAX_FACTOR) || (*down > RESAMPLER_MAX_FACTOR))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int get_resampled_len (int data_len, int up, int down)
+{
+    return (int)(((long long)data_len * up + down - 1) / down);
+}
+
+std::shared_ptr<const PolyphaseFilter> PolyphaseFilterCache::get_filter (int up, int down)
+{
+    if ((up < 1) || (down < 1) || (up > RESAMPLER_MAX_FACTOR) || (down > RESAMPLER_MAX_FACTOR))
+    {
+        return std::shared_ptr<const PolyphaseFilter> ();
+    }
+    std::pair<int, int> key (up, down);
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        auto it = filters.find (key);
+        if (it != filters.end ())
+        {
+            return it->second;
+        }
+    }
+    // design is slow, dont hold the lock
+    std::shared_ptr<const PolyphaseFilter> filter;
+    try
+    {
+        filter.reset (design_polyphase_filter (up, down));
+    }
+    catch (const std::bad_alloc &)
+    {
+        return std::shared_ptr<const PolyphaseFilter> ();
+    }
+    std::lock_guard<std::mutex> lock (mutex);
+    if (filters.size () >= RESAMPLER_CACHE_MAX_ENTRIES)
+    {
+        // many different ratios are not expected, start from scratch
+        filters.clear ();
+    }
+    filters[key] = filter;
+    return filter;
+}
+
+void PolyphaseFilterCache::clear ()
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    filters.clear ();
+}
+
+void resample (const PolyphaseFilter &filter, const double *data, int data_len, double *output)
+{
+    int output_len = get_resampled_len (data_len, filter.up, filter.down);
+    if (output_len < 1)
+    {
+        return;
+    }
+    int history_len = filter.taps_per_phase - 1;
+    long long last_base = ((long long)(output_len - 1 + filter.delay) * filter.down) / filter.up;
+    long long tail_len = (last_base > data_len - 1) ? last_base - (data_len - 1) : 0;
+    // input value i is at index i + history_len, zeros before and after the signal
+    std::vector<double> padded ((size_t)(history_len + data_len + tail_len), 0.0);
+    std::copy (data, data + data_len, padded.begin () + history_len);
+    for (int i = 0; i < output_len; i++)
+    {
+        long long t = (long long)(i + filter.delay) * filter.down;
+        long long base = t / filter.up;
+        int phase = (int)(t % filter.up);
+        output[i] = dot (filter.coeffs.data () + (size_t)phase * filter.taps_per_phase,
+            padded.data () + base, filter.taps_per_phase);
+    }
+}
+
+StreamingResampler::StreamingResampler (
+    std::shared_ptr<const PolyphaseFilter> filter, int num_channels)
+{
+    this->filter = filter;
+    this->num_channels = num_channels;
+    history.resize ((size_t)num_channels * (filter->taps_per_phase - 1), 0.0);
+    reset ();
+}
+
+void StreamingResampler::reset ()
+{
+    num_inputs = 0;
+    num_outputs = 0;
+    std::fill (history.begin (), history.end (), 0.0);
+}
+
+int StreamingResampler::process (const double *data, int data_len, double *output)
+{
+    int history_len = filter->taps_per_phase - 1;
+    long long first_input = num_inputs;
+    long long end_input = num_inputs + data_len;
+    // output m uses inputs up to (m * down) / up, all outputs for available inputs are calculated
+    long long end_output = (end_input * filter->up + filter->down - 1) / filter->down;
+    int count = (int)(end_output - num_outputs);
+    buffer.resize ((size_t)(history_len + data_len));
+    for (int channel = 0; channel < num_channels; channel++)
+    {
+        double *channel_history = history.data () + (size_t)channel * history_len;
+        std::copy (channel_history, channel_history + history_len, buffer.begin ());
+        std::copy (data + (size_t)channel * data_len, data + (size_t)(channel + 1) * data_len,
+            buffer.begin () + history_len);
+        for (int i = 0; i < count; i++)
+        {
+            long long t = (num_outputs + i) * filter->down;
+            long long base = t / filter->up;
+            int phase = (int)(t % filter->up);
+            output[(size_t)channel * count + i] =
+                dot (filter->coeffs.data () + (size_t)phase * filter->taps_per_phase,
+                    buffer.data () + (base - first_input), filter->taps_per_phase);
+        }
+        std::copy (buffer.end () - history_len, buffer.end (), channel_history);
+    }
+    num_inputs = end_input;
+    num_outputs = end_output;
+    return count;
+}
@@ -0,0 +1,313 @@
+#include <algorithm>
+
+#include "brainflow_constants.h"
+#include "streaming_filter.h"
+
+#include "DspFilters/Dsp.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// DSPFilters adds small alternating current to prevent denormals
+#define DENORMAL_AC Dsp::anti_denormal_vsa
+// run channels in parallel only if there is enough work to pay for threads
+#define PARALLEL_FILTER_MIN_VALUES 65536
+
+// one channel per lane, only separate mul and add are used to keep results the same as in scalar
+// DirectFormII, AVX is used only if it is enabled for the compiler
+#if defined(__AVX__)
+#include <immintrin.h>
+#define FILTER_LANES 4
+typedef __m256d lanes_t;
+#define lanes_load(ptr) _mm256_loadu_pd (ptr)
+#define lanes_store(ptr, val) _mm256_storeu_pd (ptr, val)
+#define lanes_set1(val) _mm256_set1_pd (val)
+#define lanes_add(a, b) _mm256_add_pd (a, b)
+#define lanes_sub(a, b) _mm256_sub_pd (a, b)
+#define lanes_mul(a, b) _mm256_mul_pd (a, b)
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define FILTER_LANES 2
+typedef __m128d lanes_t;
+#define lanes_load(ptr) _mm_loadu_pd (ptr)
+#define lanes_store(ptr, val) _mm_storeu_pd (ptr, val)
+#define lanes_set1(val) _mm_set1_pd (val)
+#define lanes_add(a, b) _mm_add_pd (a, b)
+#define lanes_sub(a, b) _mm_sub_pd (a, b)
+#define lanes_mul(a, b) _mm_mul_pd (a, b)
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define FILTER_LANES 2
+typedef float64x2_t lanes_t;
+#define lanes_load(ptr) vld1q_f64 (ptr)
+#define lanes_store(ptr, val) vst1q_f64 (ptr, val)
+#define lanes_set1(val) vdupq_n_f64 (val)
+#define lanes_add(a, b) vaddq_f64 (a, b)
+#define lanes_sub(a, b) vsubq_f64 (a, b)
+#define lanes_mul(a, b) vmulq_f64 (a, b)
+#else
+#define FILTER_LANES 1
+#endif
+
+
+template <class DesignClass>
+static void get_stages (const Dsp::Params &params, std::vector<struct BiquadCoeffs> &stages)
+{
+    DesignClass *design = new DesignClass ();
+    design->setParams (params);
+    stages.clear ();
+    for (int i = 0; i < design->getNumStages (); i++)
+    {
+        const Dsp::Cascade::Stage &stage = (*design)[i];
+        struct BiquadCoeffs coeffs;
+        coeffs.b0 = stage.m_b0;
+        coeffs.b1 = stage.m_b1;
+        coeffs.b2 = stage.m_b2;
+        coeffs.a1 = stage.m_a1;
+        coeffs.a2 = stage.m_a2;
+        stages.push_back (coeffs);
+    }
+    delete design;
+}
+
+template <template <int> class Butterworth, template <int> class ChebyshevI,
+    template <int> class Bessel>
+static int get_stages_for_type (
+    int filter_type, const Dsp::Params &params, std::vector<struct BiquadCoeffs> &stages)
+{
+    switch (static_cast<FilterTypes> (filter_type))
+    {
+        case FilterTypes::BUTTERWORTH:
+        case FilterTypes::BUTTERWORTH_ZERO_PHASE:
+            get_stages<Butterworth<MAX_FILTER_ORDER>> (params, stages);
+            break;
+        case FilterTypes::CHEBYSHEV_TYPE_1:
+        case FilterTypes::CHEBYSHEV_TYPE_1_ZERO_PHASE:
+            get_stages<ChebyshevI<MAX_FILTER_ORDER>> (params, stages);
+            break;
+        case FilterTypes::BESSEL:
+        case FilterTypes::BESSEL_ZERO_PHASE:
+            get_stages<Bessel<MAX_FILTER_ORDER>> (params, stages);
+            break;
+        default:
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int design_biquads (int filter_operation, int sampling_rate, double start_freq, double stop_freq,
+    int order, int filter_type, double ripple, std::vector<struct BiquadCoeffs> &stages)
+{
+    if ((order < 1) || (order > MAX_FILTER_ORDER) || (sampling_rate < 1) || (start_freq < 0))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    bool is_chebyshev = (filter_type == (int)FilterTypes::CHEBYSHEV_TYPE_1) ||
+        (filter_type == (int)FilterTypes::CHEBYSHEV_TYPE_1_ZERO_PHASE);
+    Dsp::Params params;
+    params[0] = sampling_rate;
+    params[1] = order;
+    switch (static_cast<FilterOperations> (filter_operation))
+    {
+        case FilterOperations::LOWPASS:
+            params[2] = start_freq;
+            params[3] = ripple;
+            return get_stages_for_type<Dsp::Butterworth::Design::LowPass,
+                Dsp::ChebyshevI::Design::LowPass, Dsp::Bessel::Design::LowPass> (
+                filter_type, params, stages);
+        case FilterOperations::HIGHPASS:
+            params[2] = start_freq;
+            params[3] = ripple;
+            return get_stages_for_type<Dsp::Butterworth::Design::HighPass,
+                Dsp::ChebyshevI::Design::HighPass, Dsp::Bessel::Design::HighPass> (
+                filter_type, params, stages);
+        case FilterOperations::BANDPASS:
+        case FilterOperations::BANDSTOP:
+            if (stop_freq <= start_freq)
+            {
+                return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+            }
+            params[2] = (start_freq + stop_freq) / 2.0; // center freq
+            params[3] = stop_freq - start_freq;         // band width
+            params[4] = is_chebyshev ? ripple : 0.0;
+            if (filter_operation == (int)FilterOperations::BANDPASS)
+            {
+                return get_stages_for_type<Dsp::Butterworth::Design::BandPass,
+                    Dsp::ChebyshevI::Design::BandPass, Dsp::Bessel::Design::BandPass> (
+                    filter_type, params, stages);
+            }
+            return get_stages_for_type<Dsp::Butterworth::Design::BandStop,
+                Dsp::ChebyshevI::Design::BandStop, Dsp::Bessel::Design::BandStop> (
+                filter_type, params, stages);
+        default:
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+}
+
+
+StreamingFilter::StreamingFilter (const std::vector<struct BiquadCoeffs> &stages, int num_channels)
+{
+    this->stages = stages;
+    this->num_channels = num_channels;
+    state.resize ((size_t)num_channels * stages.size () * 2);
+    denormal_ac.resize (num_channels);
+    for (int i = 0; i < num_channels; i++)
+    {
+        contiguous_channels.push_back (i);
+    }
+    reset ();
+}
+
+void StreamingFilter::reset ()
+{
+    std::fill (state.begin (), state.end (), 0.0);
+    std::fill (denormal_ac.begin (), denormal_ac.end (), DENORMAL_AC);
+}
+
+void StreamingFilter::process (double *data, int data_len)
+{
+    process_rows (data, data_len, contiguous_channels.data ());
+}
+
+void StreamingFilter::process_rows (double *data, int cols, const int *channels)
+{
+    int num_groups = (FILTER_LANES > 1) ? num_channels / FILTER_LANES : 0;
+    int num_tasks = num_groups + num_channels - num_groups * FILTER_LANES;
+    bool parallel =
+        (num_tasks > 1) && ((double)cols * num_channels >= (double)PARALLEL_FILTER_MIN_VALUES);
+    (void)parallel;
+    // groups and tail channels use disjoint parts of state
+#pragma omp parallel for if (parallel)
+    for (int task = 0; task < num_tasks; task++)
+    {
+        if (task < num_groups)
+        {
+            process_lanes (data, cols, channels, task * FILTER_LANES);
+        }
+        else
+        {
+            int channel = num_groups * FILTER_LANES + task - num_groups;
+            process_channel (data + (size_t)channels[channel] * cols, cols, channel);
+        }
+    }
+}
+
+void StreamingFilter::process_channel (double *data, int data_len, int channel)
+{
+    int num_stages = (int)stages.size ();
+    double *channel_state = state.data () + (size_t)channel * num_stages * 2;
+    const struct BiquadCoeffs *coeffs = stages.data ();
+    double ac = denormal_ac[channel];
+    for (int i = 0; i < data_len; i++)
+    {
+        ac = -ac;
+        double out = data[i];
+        for (int j = 0; j < num_stages; j++)
+        {
+            double *v = channel_state + j * 2;
+            double vsa = (j == 0) ? ac : 0.0;
+            double w = out - coeffs[j].a1 * v[0] - coeffs[j].a2 * v[1] + vsa;
+            out = coeffs[j].b0 * w + coeffs[j].b1 * v[0] + coeffs[j].b2 * v[1];
+            v[1] = v[0];
+            v[0] = w;
+        }
+        data[i] = out;
+    }
+    denormal_ac[channel] = ac;
+}
+
+#if FILTER_LANES > 1
+void StreamingFilter::process_lanes (
+    double *data, int cols, const int *channels, int first_channel)
+{
+    int num_stages = (int)stages.size ();
+    double *rows[FILTER_LANES];
+    double values[FILTER_LANES];
+    // coefficients are the same for all lanes, state is moved from [channel x stage x 2] layout
+    // to lanes for the whole call
+    lanes_t b0[2 * MAX_FILTER_ORDER], b1[2 * MAX_FILTER_ORDER], b2[2 * MAX_FILTER_ORDER];
+    lanes_t a1[2 * MAX_FILTER_ORDER], a2[2 * MAX_FILTER_ORDER];
+    lanes_t v0[2 * MAX_FILTER_ORDER], v1[2 * MAX_FILTER_ORDER];
+    for (int j = 0; j < num_stages; j++)
+    {
+        b0[j] = lanes_set1 (stages[j].b0);
+        b1[j] = lanes_set1 (stages[j].b1);
+        b2[j] = lanes_set1 (stages[j].b2);
+        a1[j] = lanes_set1 (stages[j].a1);
+        a2[j] = lanes_set1 (stages[j].a2);
+        for (int lane = 0; lane < FILTER_LANES; lane++)
+        {
+            values[lane] = state[((size_t)(first_channel + lane) * num_stages + j) * 2];
+        }
+        v0[j] = lanes_load (values);
+        for (int lane = 0; lane < FILTER_LANES; lane++)
+        {
+            values[lane] = state[((size_t)(first_channel + lane) * num_stages + j) * 2 + 1];
+        }
+        v1[j] = lanes_load (values);
+    }
+    for (int lane = 0; lane < FILTER_LANES; lane++)
+    {
+        rows[lane] = data + (size_t)channels[first_channel + lane] * cols;
+        values[lane] = denormal_ac[first_channel + lane];
+    }
+    lanes_t ac = lanes_load (values);
+    lanes_t zero = lanes_set1 (0.0);
+
+    for (int i = 0; i < cols; i++)
+    {
+        ac = lanes_sub (zero, ac);
+        for (int lane = 0; lane < FILTER_LANES; lane++)
+        {
+            values[lane] = rows[lane][i];
+        }
+        lanes_t out = lanes_load (values);
+        // the first stage gets denormal ac, order of operations is the same as in process_channel
+        lanes_t w = lanes_add (
+            lanes_sub (lanes_sub (out, lanes_mul (a1[0], v0[0])), lanes_mul (a2[0], v1[0])), ac);
+        out = lanes_add (
+            lanes_add (lanes_mul (b0[0], w), lanes_mul (b1[0], v0[0])), lanes_mul (b2[0], v1[0]));
+        v1[0] = v0[0];
+        v0[0] = w;
+        for (int j = 1; j < num_stages; j++)
+        {
+            w = lanes_sub (lanes_sub (out, lanes_mul (a1[j], v0[j])), lanes_mul (a2[j], v1[j]));
+            out = lanes_add (lanes_add (lanes_mul (b0[j], w), lanes_mul (b1[j], v0[j])),
+                lanes_mul (b2[j], v1[j]));
+            v1[j] = v0[j];
+            v0[j] = w;
+        }
+        lanes_store (values, out);
+        for (int lane = 0; lane < FILTER_LANES; lane++)
+        {
+            rows[lane][i] = values[lane];
+        }
+    }
+
+    lanes_store (values, ac);
+    for (int lane = 0; lane < FILTER_LANES; lane++)
+    {
+        denormal_ac[first_channel + lane] = values[lane];
+    }
+    for (int j = 0; j < num_stages; j++)
+    {
+        lanes_store (values, v0[j]);
+        for (int lane = 0; lane < FILTER_LANES; lane++)
+        {
+            state[((size_t)(first_channel + lane) * num_stages + j) * 2] = values[lane];
+        }
+        lanes_store (values, v1[j]);
+        for (int lane = 0; lane < FILTER_LANES; lane++)
+        {
+            state[((size_t)(first_channel + lane) * num_stages + j) * 2 + 1] = values[lane];
+        }
+    }
+}
+#else
+void StreamingFilter::process_lanes (
+    double *data, int cols, const int *channels, int first_channel)
+{
+    process_channel (data + (size_t)channels[first_channel] * cols, cols, first_channel);
+}
+#endif
@@ -0,0 +1,115 @@
+#include <new>
+#include <stdexcept>
+
+#include "wavelet_cache.h"
+#include "wavelet_helpers.h"
+
+
+std::mutex WaveletCache::mutex;
+std::map<std::tuple<int, int, int, int>, std::vector<std::unique_ptr<WaveletContext>>>
+    WaveletCache::free_contexts;
+
+
+WaveletContext::WaveletContext (int wavelet, int data_len, int decomposition_level, int extension)
+{
+    this->wavelet = wavelet;
+    this->data_len = data_len;
+    this->decomposition_level = decomposition_level;
+    this->extension = extension;
+    wave = NULL;
+    wt = NULL;
+    const char *wavelet_name = get_wavelet_name (wavelet);
+    const char *extension_name = get_extension_type (extension);
+    if ((wavelet_name == NULL) || (extension_name == NULL) || (data_len <= 0) ||
+        (decomposition_level <= 0))
+    {
+        throw std::runtime_error ("invalid wavelet params");
+    }
+    wave = wave_init (wavelet_name);
+    try
+    {
+        wt = wt_init (wave, "dwt", data_len, decomposition_level);
+        buffer.resize (data_len);
+    }
+    catch (...)
+    {
+        if (wt != NULL)
+        {
+            wt_free (wt);
+        }
+        wave_free (wave);
+        throw;
+    }
+    setDWTExtension (wt, extension_name);
+    // all wavelets from WaveletTypes are shorter, direct convolution is faster for them
+    setWTConv (wt, (wave->filtlength >= WAVELET_FFT_MIN_FILTER_LEN) ? "fft" : "direct");
+}
+
+WaveletContext::~WaveletContext ()
+{
+    if (wt != NULL)
+    {
+        wt_free (wt);
+        wt = NULL;
+    }
+    if (wave != NULL)
+    {
+        wave_free (wave);
+        wave = NULL;
+    }
+}
+
+WaveletContext *WaveletCache::acquire_context (
+    int wavelet, int data_len, int decomposition_level, int extension)
+{
+    std::tuple<int, int, int, int> key (wavelet, data_len, decomposition_level, extension);
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        auto it = free_contexts.find (key);
+        if ((it != free_contexts.end ()) && (!it->second.empty ()))
+        {
+            WaveletContext *context = it->second.back ().release ();
+            it->second.pop_back ();
+            return context;
+        }
+    }
+    // wavelib allocates memory for objects, dont hold the lock
+    try
+    {
+        return new WaveletContext (wavelet, data_len, decomposition_level, extension);
+    }
+    catch (const std::exception &)
+    {
+        return NULL;
+    }
+}
+
+void WaveletCache::release_context (WaveletContext *context)
+{
+    if (context == NULL)
+    {
+        return;
+    }
+    std::tuple<int, int, int, int> key (context->get_wavelet (), context->get_data_len (),
+        context->get_decomposition_level (), context->get_extension ());
+    std::lock_guard<std::mutex> lock (mutex);
+    auto it = free_contexts.find (key);
+    if (it == free_contexts.end ())
+    {
+        if (free_contexts.size () >= WAVELET_CACHE_MAX_ENTRIES)
+        {
+            // many different sizes are not expected, start from scratch
+            free_contexts.clear ();
+        }
+        it = free_contexts
+                 .insert (std::make_pair (key, std::vector<std::unique_ptr<WaveletContext>> ()))
+                 .first;
+    }
+    it->second.push_back (std::unique_ptr<WaveletContext> (context));
+}
+
+void WaveletCache::clear ()
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    free_contexts.clear ();
+}
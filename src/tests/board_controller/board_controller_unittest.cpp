@@ -0,0 +1,170 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "board_controller.h"
+#include "brainflow_constants.h"
+#include "input_params_json.h"
+
+using namespace testing;
+
+
+#define NUM_PREPARE_THREADS 8
+
+
+static std::string get_params (const std::string &other_info)
+{
+    struct BrainFlowInputParams params;
+    params.other_info = other_info;
+    return params_to_json (params);
+}
+
+class BoardControllerTest : public Test
+{
+protected:
+    void TearDown () override
+    {
+        release_all_sessions ();
+    }
+};
+
+TEST_F (BoardControllerTest, PrepareSession_SameConfig_Rejected)
+{
+    std::string params = get_params ("");
+    int handle = 0;
+    ASSERT_EQ (
+        prepare_session_with_handle ((int)BoardIds::SYNTHETIC_BOARD, params.c_str (), &handle),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    int another_handle = 0;
+    EXPECT_EQ (prepare_session_with_handle (
+                   (int)BoardIds::SYNTHETIC_BOARD, params.c_str (), &another_handle),
+        (int)BrainFlowExitCodes::ANOTHER_BOARD_IS_CREATED_ERROR);
+    EXPECT_EQ (another_handle, 0);
+
+    // existing session is not affected
+    int found_handle = 0;
+    ASSERT_EQ (
+        get_session_handle ((int)BoardIds::SYNTHETIC_BOARD, params.c_str (), &found_handle),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (found_handle, handle);
+    int prepared = 0;
+    ASSERT_EQ (is_prepared_by_handle (&prepared, handle), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (prepared, 1);
+}
+
+TEST_F (BoardControllerTest, PrepareSession_SameConfigFromThreads_OnlyOneCreated)
+{
+    std::string params = get_params ("");
+    std::atomic<int> num_created (0);
+    std::atomic<int> num_rejected (0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_PREPARE_THREADS; i++)
+    {
+        threads.push_back (std::thread ([&] {
+            int handle = 0;
+            int res = prepare_session_with_handle (
+                (int)BoardIds::SYNTHETIC_BOARD, params.c_str (), &handle);
+            if (res == (int)BrainFlowExitCodes::STATUS_OK)
+            {
+                num_created++;
+            }
+            else if (res == (int)BrainFlowExitCodes::ANOTHER_BOARD_IS_CREATED_ERROR)
+            {
+                num_rejected++;
+            }
+        }));
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join ();
+    }
+    EXPECT_EQ (num_created.load (), 1);
+    EXPECT_EQ (num_rejected.load (), NUM_PREPARE_THREADS - 1);
+}
+
+TEST_F (BoardControllerTest, ReleaseSession_StaleHandle_NotCreatedError)
+{
+    std::string params = get_params ("");
+    int handle = 0;
+    ASSERT_EQ (
+        prepare_session_with_handle ((int)BoardIds::SYNTHETIC_BOARD, params.c_str (), &handle),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (release_session_by_handle (handle), (int)BrainFlowExitCodes::STATUS_OK);
+
+    EXPECT_EQ (
+        release_session_by_handle (handle), (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR);
+    EXPECT_EQ (start_stream_by_handle (45000, "", handle),
+        (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR);
+    int count = 0;
+    EXPECT_EQ (
+        get_board_data_count_by_handle ((int)BrainFlowPresets::DEFAULT_PRESET, &count, handle),
+        (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR);
+    int prepared = 1;
+    ASSERT_EQ (is_prepared_by_handle (&prepared, handle), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (prepared, 0);
+    int found_handle = 0;
+    EXPECT_EQ (
+        get_session_handle ((int)BoardIds::SYNTHETIC_BOARD, params.c_str (), &found_handle),
+        (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR);
+
+    // the same config can be prepared again, old handle is not reused
+    int new_handle = 0;
+    ASSERT_EQ (
+        prepare_session_with_handle ((int)BoardIds::SYNTHETIC_BOARD, params.c_str (), &new_handle),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_NE (new_handle, handle);
+    EXPECT_EQ (start_stream_by_handle (45000, "", handle),
+        (int)BrainFlowExitCodes::BOARD_NOT_CREATED_ERROR);
+    ASSERT_EQ (is_prepared_by_handle (&prepared, new_handle), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (prepared, 1);
+}
+
+TEST_F (BoardControllerTest, TwoSessions_StreamAtOnce_Independent)
+{
+    std::string first_params = get_params ("first");
+    std::string second_params = get_params ("second");
+    int first_handle = 0;
+    int second_handle = 0;
+    ASSERT_EQ (prepare_session_with_handle (
+                   (int)BoardIds::SYNTHETIC_BOARD, first_params.c_str (), &first_handle),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (prepare_session_with_handle (
+                   (int)BoardIds::SYNTHETIC_BOARD, second_params.c_str (), &second_handle),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_NE (first_handle, second_handle);
+
+    ASSERT_EQ (
+        start_stream_by_handle (45000, "", first_handle), (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (
+        start_stream_by_handle (45000, "", second_handle), (int)BrainFlowExitCodes::STATUS_OK);
+    int preset = (int)BrainFlowPresets::DEFAULT_PRESET;
+    int first_count = 0;
+    int second_count = 0;
+    for (int i = 0; (i < 200) && ((first_count == 0) || (second_count == 0)); i++)
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (10));
+        ASSERT_EQ (get_board_data_count_by_handle (preset, &first_count, first_handle),
+            (int)BrainFlowExitCodes::STATUS_OK);
+        ASSERT_EQ (get_board_data_count_by_handle (preset, &second_count, second_handle),
+            (int)BrainFlowExitCodes::STATUS_OK);
+    }
+    EXPECT_GT (first_count, 0);
+    EXPECT_GT (second_count, 0);
+
+    // releasing one session doesnt stop another one
+    ASSERT_EQ (release_session_by_handle (first_handle), (int)BrainFlowExitCodes::STATUS_OK);
+    int count_after_release = 0;
+    ASSERT_EQ (get_board_data_count_by_handle (preset, &count_after_release, second_handle),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    std::this_thread::sleep_for (std::chrono::milliseconds (50));
+    int count = 0;
+    ASSERT_EQ (get_board_data_count_by_handle (preset, &count, second_handle),
+        (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_GT (count, count_after_release);
+    EXPECT_EQ (stop_stream_by_handle (second_handle), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (release_session_by_handle (second_handle), (int)BrainFlowExitCodes::STATUS_OK);
+}
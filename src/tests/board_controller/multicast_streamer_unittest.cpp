@@ -0,0 +1,138 @@
+#ifndef _WIN32
+
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+#include "brainflow_constants.h"
+#include "brainflow_env_vars.h"
+#include "multicast_streamer.h"
+
+using namespace testing;
+
+
+#define PACKAGE_LEN 4
+
+
+class TestMultiCastStreamer : public MultiCastStreamer
+{
+public:
+    TestMultiCastStreamer (const char *ip, int port) : MultiCastStreamer (ip, port, PACKAGE_LEN)
+    {
+    }
+
+    using MultiCastStreamer::stream_batch;
+};
+
+// package i has values i * PACKAGE_LEN + j
+static std::vector<double> make_packages (int first, int count)
+{
+    std::vector<double> packages ((size_t)count * PACKAGE_LEN);
+    for (size_t i = 0; i < packages.size (); i++)
+    {
+        packages[i] = (double)first * PACKAGE_LEN + i;
+    }
+    return packages;
+}
+
+// server sends to any address, plain udp socket on loopback receives it without multicast routes
+static int create_receiver (int *port)
+{
+    int fd = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    struct sockaddr_in addr;
+    memset (&addr, 0, sizeof (addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+    socklen_t len = (socklen_t)sizeof (addr);
+    if ((fd < 0) || (bind (fd, (struct sockaddr *)&addr, len) != 0) ||
+        (getsockname (fd, (struct sockaddr *)&addr, &len) != 0))
+    {
+        return -1;
+    }
+    *port = ntohs (addr.sin_port);
+    struct timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 200000;
+    setsockopt (fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof (timeout));
+    return fd;
+}
+
+// receives transactions until timeout, checks that packages are numbered from first
+static int recv_packages (int fd, int num_packages, int first)
+{
+    int transaction_size = num_packages * PACKAGE_LEN * (int)sizeof (double);
+    std::vector<double> transaction (num_packages * PACKAGE_LEN + 1);
+    int next = first;
+    while (true)
+    {
+        int res = (int)recv (fd, transaction.data (), transaction.size () * sizeof (double), 0);
+        if (res < 0)
+        {
+            break;
+        }
+        EXPECT_EQ (res, transaction_size);
+        std::vector<double> expected = make_packages (next, num_packages);
+        for (int i = 0; i < num_packages * PACKAGE_LEN; i++)
+        {
+            EXPECT_EQ (transaction[i], expected[i]);
+        }
+        next += num_packages;
+    }
+    return next - first;
+}
+
+TEST (MultiCastStreamerTest, StreamBatch_UnevenBatches_IncompleteTransactionCarriedOver)
+{
+    int port = 0;
+    int receiver = create_receiver (&port);
+    ASSERT_GE (receiver, 0);
+    TestMultiCastStreamer streamer ("127.0.0.1", port);
+    ASSERT_EQ (streamer.init_streamer (), (int)BrainFlowExitCodes::STATUS_OK);
+    int num_packages = get_brainflow_batch_size ();
+
+    // the largest batch is longer than transactions sent at once
+    int batch_sizes[] = {1, 2, num_packages + 2,
+        num_packages * MultiCastStreamer::max_transactions_per_send + 1, 1, 4};
+    int num_streamed = 0;
+    for (int batch_size : batch_sizes)
+    {
+        std::vector<double> packages = make_packages (num_streamed, batch_size);
+        streamer.stream_batch (packages.data (), batch_size);
+        num_streamed += batch_size;
+    }
+    int num_sent = num_streamed - num_streamed % num_packages;
+    EXPECT_EQ (recv_packages (receiver, num_packages, 0), num_sent);
+
+    // the next batch completes the pending transaction
+    int tail = num_packages - num_streamed % num_packages;
+    std::vector<double> packages = make_packages (num_streamed, tail);
+    streamer.stream_batch (packages.data (), tail);
+    EXPECT_EQ (recv_packages (receiver, num_packages, num_sent), num_packages);
+    EXPECT_EQ (streamer.get_dropped_transactions (), (size_t)0);
+    close (receiver);
+}
+
+TEST (MultiCastStreamerTest, StreamBatch_SendFails_OldestTransactionsDropped)
+{
+    // broadcast without SO_BROADCAST is rejected by kernel, so nothing is sent
+    TestMultiCastStreamer streamer ("255.255.255.255", 45111);
+    ASSERT_EQ (streamer.init_streamer (), (int)BrainFlowExitCodes::STATUS_OK);
+    int num_packages = get_brainflow_batch_size ();
+    int max_packages = num_packages * MultiCastStreamer::max_transactions_per_send;
+
+    // unsent transactions are kept until buffer is full, after that one is dropped per new one
+    int count = max_packages + num_packages * 5;
+    std::vector<double> packages = make_packages (0, count);
+    streamer.stream_batch (packages.data (), max_packages - 1);
+    EXPECT_EQ (streamer.get_dropped_transactions (), (size_t)0);
+    streamer.stream_batch (
+        packages.data () + (max_packages - 1) * PACKAGE_LEN, count - max_packages + 1);
+    EXPECT_EQ (streamer.get_dropped_transactions (), (size_t)6);
+}
+
+#endif
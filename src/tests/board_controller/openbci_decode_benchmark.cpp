@@ -0,0 +1,110 @@
+// Measures decoding of exg channels from Galea V4 packages, compares per channel conversion with
+// gain lookup and pow against decode_exg_channels with precomputed scales.
+// Usage: openbci_decode_benchmark [raw_packages_file] [num_iterations]
+// raw_packages_file contains packages as received from the board, one after another without
+// separators, if it is not provided random packages are generated
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "custom_cast.h"
+#include "openbci_exg_decoder.h"
+#include "openbci_gain_tracker.h"
+
+#define GALEA_V4_PACKAGE_SIZE 114
+#define GALEA_V4_EXG_OFFSET 5
+#define GALEA_V4_NUM_EXG_CHANNELS 24
+
+
+static bool read_packages (const char *file_name, std::vector<unsigned char> &packages)
+{
+    FILE *fp = fopen (file_name, "rb");
+    if (fp == NULL)
+    {
+        return false;
+    }
+    unsigned char package[GALEA_V4_PACKAGE_SIZE];
+    while (fread (package, 1, GALEA_V4_PACKAGE_SIZE, fp) == GALEA_V4_PACKAGE_SIZE)
+    {
+        packages.insert (packages.end (), package, package + GALEA_V4_PACKAGE_SIZE);
+    }
+    fclose (fp);
+    return !packages.empty ();
+}
+
+int main (int argc, char *argv[])
+{
+    std::vector<unsigned char> packages;
+    if (argc > 1)
+    {
+        if (!read_packages (argv[1], packages))
+        {
+            printf ("failed to read packages from %s\n", argv[1]);
+            return 1;
+        }
+    }
+    else
+    {
+        packages.resize (GALEA_V4_PACKAGE_SIZE * 1000);
+        srand (42);
+        for (size_t i = 0; i < packages.size (); i++)
+        {
+            packages[i] = (unsigned char)(rand () & 0xFF);
+        }
+    }
+    int num_iterations = (argc > 2) ? atoi (argv[2]) : 2000;
+    int num_packages = (int)(packages.size () / GALEA_V4_PACKAGE_SIZE);
+
+    GaleaV4GainTracker gain_tracker;
+    std::vector<double> legacy (num_packages * GALEA_V4_NUM_EXG_CHANNELS);
+    std::vector<double> decoded (num_packages * GALEA_V4_NUM_EXG_CHANNELS);
+
+    auto start = std::chrono::high_resolution_clock::now ();
+    for (int iteration = 0; iteration < num_iterations; iteration++)
+    {
+        for (int p = 0; p < num_packages; p++)
+        {
+            unsigned char *b = packages.data () + p * GALEA_V4_PACKAGE_SIZE;
+            double *exg = legacy.data () + p * GALEA_V4_NUM_EXG_CHANNELS;
+            for (int i = 0; i < GALEA_V4_NUM_EXG_CHANNELS; i++)
+            {
+                double exg_scale = (double)(4.5 / float ((pow (2, 23) - 1)) /
+                    gain_tracker.get_gain_for_channel (i) * 1000000.);
+                exg[i] = exg_scale * (double)cast_24bit_to_int32 (b + GALEA_V4_EXG_OFFSET + 3 * i);
+            }
+        }
+    }
+    double legacy_time =
+        std::chrono::duration<double> (std::chrono::high_resolution_clock::now () - start)
+            .count ();
+
+    start = std::chrono::high_resolution_clock::now ();
+    for (int iteration = 0; iteration < num_iterations; iteration++)
+    {
+        for (int p = 0; p < num_packages; p++)
+        {
+            decode_exg_channels (
+                packages.data () + p * GALEA_V4_PACKAGE_SIZE + GALEA_V4_EXG_OFFSET,
+                GALEA_V4_NUM_EXG_CHANNELS, gain_tracker.get_scales (),
+                decoded.data () + p * GALEA_V4_NUM_EXG_CHANNELS);
+        }
+    }
+    double decoder_time =
+        std::chrono::duration<double> (std::chrono::high_resolution_clock::now () - start)
+            .count ();
+
+    int num_diffs = 0;
+    for (size_t i = 0; i < legacy.size (); i++)
+    {
+        num_diffs += (legacy[i] != decoded[i]) ? 1 : 0;
+    }
+    double total = (double)num_packages * num_iterations;
+    printf ("packages: %d, iterations: %d, mismatches: %d\n", num_packages, num_iterations,
+        num_diffs);
+    printf ("per channel: %.1lf ns/package\n", legacy_time * 1e9 / total);
+    printf ("decode_exg_channels: %.1lf ns/package\n", decoder_time * 1e9 / total);
+    return (num_diffs == 0) ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <math.h>
+#include <vector>
+
+#include "custom_cast.h"
+#include "openbci_exg_decoder.h"
+#include "openbci_gain_tracker.h"
+
+using namespace testing;
+
+
+static double legacy_decode (unsigned char *bytes, int gain)
+{
+    double exg_scale = (double)(4.5 / float ((pow (2, 23) - 1)) / gain * 1000000.);
+    return exg_scale * (double)cast_24bit_to_int32 (bytes);
+}
+
+TEST (OpenBCIExgDecoderTest, DecodeExgChannels_AnyChannelCount_SameAsCast24Bit)
+{
+    // edge values of 24 bit range and values with high bit set in middle bytes
+    const unsigned char patterns[][3] = {{0x00, 0x00, 0x00}, {0x7F, 0xFF, 0xFF},
+        {0x80, 0x00, 0x00}, {0xFF, 0xFF, 0xFF}, {0x00, 0x80, 0x01}, {0x12, 0x34, 0x56},
+        {0xA5, 0x5A, 0xC3}, {0x01, 0xFF, 0x80}};
+    const int num_patterns = sizeof (patterns) / sizeof (patterns[0]);
+    GaleaV4GainTracker tracker;
+    for (int num_channels = 1; num_channels <= 24; num_channels++)
+    {
+        // extra bytes after channel data must not be used
+        std::vector<unsigned char> bytes (3 * num_channels + 16, 0xEE);
+        for (int i = 0; i < num_channels; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                bytes[3 * i + j] = patterns[(i + num_channels) % num_patterns][j];
+            }
+        }
+        std::vector<double> values (num_channels + 1, -1.0);
+        decode_exg_channels (bytes.data (), num_channels, tracker.get_scales (), values.data ());
+        for (int i = 0; i < num_channels; i++)
+        {
+            EXPECT_EQ (values[i],
+                legacy_decode (bytes.data () + 3 * i, tracker.get_gain_for_channel (i)))
+                << num_channels << " " << i;
+        }
+        EXPECT_EQ (values[num_channels], -1.0);
+    }
+}
+
+TEST (OpenBCIExgDecoderTest, GetScales_GainChanged_ScalesUpdated)
+{
+    CytonDaisyGainTracker tracker;
+    const double *scales = tracker.get_scales ();
+    EXPECT_EQ (scales[1], OpenBCIGainTracker::get_scale_for_gain (24));
+
+    // channel 2 gain 2, channel Q gain 1
+    EXPECT_EQ (
+        tracker.apply_config ("x2010000XxQ000000X"), (int)OpenBCICommandTypes::VALID_COMMAND);
+    EXPECT_EQ (tracker.get_scales (), scales);
+    EXPECT_EQ (scales[1], OpenBCIGainTracker::get_scale_for_gain (2));
+    EXPECT_EQ (scales[8], OpenBCIGainTracker::get_scale_for_gain (1));
+    EXPECT_EQ (scales[0], OpenBCIGainTracker::get_scale_for_gain (24));
+
+    tracker.revert_config ();
+    EXPECT_EQ (scales[8], OpenBCIGainTracker::get_scale_for_gain (24));
+
+    tracker.apply_config ("d");
+    for (int i = 0; i < 16; i++)
+    {
+        EXPECT_EQ (scales[i], OpenBCIGainTracker::get_scale_for_gain (24));
+    }
+}
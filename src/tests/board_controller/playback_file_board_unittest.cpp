@@ -0,0 +1,182 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "board_controller.h"
+#include "board_info_getter.h"
+#include "brainflow_constants.h"
+#include "input_params_json.h"
+
+using namespace testing;
+
+
+#define RECORDED_SAMPLES 5000
+#define FIRST_RECORDED_TIMESTAMP 1000.0
+
+
+// playback board with synthetic board as master board, package num channel has sample index
+class PlaybackFileBoardTest : public Test
+{
+protected:
+    int num_rows;
+    int timestamp_channel;
+    int package_num_channel;
+    int sampling_rate;
+    int handle;
+    std::string file_name;
+
+    void SetUp () override
+    {
+        int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+        int preset = (int)BrainFlowPresets::DEFAULT_PRESET;
+        ASSERT_EQ (get_num_rows (board_id, preset, &num_rows), (int)BrainFlowExitCodes::STATUS_OK);
+        ASSERT_EQ (get_timestamp_channel (board_id, preset, &timestamp_channel),
+            (int)BrainFlowExitCodes::STATUS_OK);
+        ASSERT_EQ (get_package_num_channel (board_id, preset, &package_num_channel),
+            (int)BrainFlowExitCodes::STATUS_OK);
+        ASSERT_EQ (get_sampling_rate (board_id, preset, &sampling_rate),
+            (int)BrainFlowExitCodes::STATUS_OK);
+        handle = 0;
+
+        file_name = std::string ("playback_file_board_unittest_") +
+            UnitTest::GetInstance ()->current_test_info ()->name () + ".csv";
+        FILE *fp = fopen (file_name.c_str (), "w");
+        ASSERT_NE (fp, (FILE *)NULL);
+        for (int i = 0; i < RECORDED_SAMPLES; i++)
+        {
+            for (int j = 0; j < num_rows; j++)
+            {
+                double value = 0.0;
+                if (j == package_num_channel)
+                {
+                    value = i;
+                }
+                else if (j == timestamp_channel)
+                {
+                    value = FIRST_RECORDED_TIMESTAMP + (double)i / sampling_rate;
+                }
+                fprintf (fp, (j == num_rows - 1) ? "%.6f\n" : "%.6f\t", value);
+            }
+        }
+        fclose (fp);
+
+        struct BrainFlowInputParams params;
+        params.file = file_name;
+        params.master_board = board_id;
+        std::string json_params = params_to_json (params);
+        ASSERT_EQ (prepare_session_with_handle (
+                       (int)BoardIds::PLAYBACK_FILE_BOARD, json_params.c_str (), &handle),
+            (int)BrainFlowExitCodes::STATUS_OK);
+    }
+
+    void TearDown () override
+    {
+        release_all_sessions ();
+        remove (file_name.c_str ());
+        remove ((file_name + ".bfidx").c_str ());
+    }
+
+    void config (const char *config)
+    {
+        char response[1024];
+        int response_len = 0;
+        ASSERT_EQ (config_board_by_handle (config, response, &response_len, handle),
+            (int)BrainFlowExitCodes::STATUS_OK);
+    }
+
+    int get_count ()
+    {
+        int count = 0;
+        EXPECT_EQ (get_board_data_count_by_handle (
+                       (int)BrainFlowPresets::DEFAULT_PRESET, &count, handle),
+            (int)BrainFlowExitCodes::STATUS_OK);
+        return count;
+    }
+
+    // appends values of row from all samples in buffer
+    void read_row (int row, std::vector<double> &values)
+    {
+        int count = get_count ();
+        std::vector<double> data ((size_t)num_rows * count);
+        ASSERT_EQ (get_board_data_by_handle (
+                       count, (int)BrainFlowPresets::DEFAULT_PRESET, data.data (), handle),
+            (int)BrainFlowExitCodes::STATUS_OK);
+        values.insert (values.end (), data.begin () + (size_t)row * count,
+            data.begin () + (size_t)(row + 1) * count);
+    }
+
+    // samples per second received during duration_ms
+    double measure_rate (int duration_ms)
+    {
+        int start_count = get_count ();
+        auto start = std::chrono::steady_clock::now ();
+        std::this_thread::sleep_for (std::chrono::milliseconds (duration_ms));
+        int stop_count = get_count ();
+        auto stop = std::chrono::steady_clock::now ();
+        double seconds =
+            std::chrono::duration_cast<std::chrono::microseconds> (stop - start).count () / 1e6;
+        return (stop_count - start_count) / seconds;
+    }
+};
+
+TEST_F (PlaybackFileBoardTest, PlaybackSpeed_Multiplier_ChangesRate)
+{
+    ASSERT_EQ (start_stream_by_handle (45000, "", handle), (int)BrainFlowExitCodes::STATUS_OK);
+    std::this_thread::sleep_for (std::chrono::milliseconds (50));
+    double normal_rate = measure_rate (400);
+    config ("playback_speed:4");
+    std::this_thread::sleep_for (std::chrono::milliseconds (50));
+    double fast_rate = measure_rate (400);
+    EXPECT_GT (normal_rate, sampling_rate * 0.6);
+    EXPECT_LT (normal_rate, sampling_rate * 1.4);
+    EXPECT_GT (fast_rate, sampling_rate * 4 * 0.6);
+    EXPECT_LT (fast_rate, sampling_rate * 4 * 1.4);
+}
+
+TEST_F (PlaybackFileBoardTest, MaxSpeed_ConsumerIsSlow_SamplesNotOverwritten)
+{
+    int buffer_size = 500;
+    config ("playback_speed:max");
+    ASSERT_EQ (
+        start_stream_by_handle (buffer_size, "", handle), (int)BrainFlowExitCodes::STATUS_OK);
+    std::vector<double> indexes;
+    for (int i = 0; i < 4; i++)
+    {
+        // file is replayed much faster than it's read, reader waits for free space
+        std::this_thread::sleep_for (std::chrono::milliseconds (100));
+        EXPECT_EQ (get_count (), buffer_size);
+        read_row (package_num_channel, indexes);
+    }
+    ASSERT_EQ (indexes.size (), (size_t)buffer_size * 4);
+    for (size_t i = 0; i < indexes.size (); i++)
+    {
+        ASSERT_EQ (indexes[i], (double)i);
+    }
+}
+
+TEST_F (PlaybackFileBoardTest, NewTimestamps_SpeedChanges_Monotonic)
+{
+    config ("playback_speed:10");
+    ASSERT_EQ (start_stream_by_handle (45000, "", handle), (int)BrainFlowExitCodes::STATUS_OK);
+    std::this_thread::sleep_for (std::chrono::milliseconds (200));
+    config ("playback_speed:1");
+    std::this_thread::sleep_for (std::chrono::milliseconds (200));
+    config ("playback_speed:max");
+    std::this_thread::sleep_for (std::chrono::milliseconds (20));
+    config ("playback_speed:1");
+    config ("set_index_percentage:0");
+    std::this_thread::sleep_for (std::chrono::milliseconds (200));
+    ASSERT_EQ (stop_stream_by_handle (handle), (int)BrainFlowExitCodes::STATUS_OK);
+
+    std::vector<double> timestamps;
+    read_row (timestamp_channel, timestamps);
+    ASSERT_GT (timestamps.size (), (size_t)100);
+    for (size_t i = 1; i < timestamps.size (); i++)
+    {
+        ASSERT_GT (timestamps[i], timestamps[i - 1]) << i;
+    }
+}
@@ -0,0 +1,301 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "binary_file.h"
+#include "brainflow_constants.h"
+#include "playback_file_source.h"
+
+using namespace testing;
+
+
+#define NUM_ROWS 4
+#define TIMESTAMP_CHANNEL 3
+#define NUM_SAMPLES 1000
+#define FIRST_TIMESTAMP 100.0
+#define TIMESTAMP_STEP 0.25
+
+
+// all values are exact in text with 6 digits after the point, so text and binary files match
+static double get_value (int sample, int row)
+{
+    switch (row)
+    {
+        case 0:
+            return sample;
+        case 1:
+            return sample * 0.25;
+        case 2:
+            return -sample * 0.5;
+        default:
+            return FIRST_TIMESTAMP + sample * TIMESTAMP_STEP;
+    }
+}
+
+static std::string write_text_file (const char *name, int num_samples)
+{
+    std::string file_name = std::string ("playback_file_source_unittest_") + name + ".csv";
+    remove ((file_name + PLAYBACK_INDEX_EXTENSION).c_str ());
+    FILE *fp = fopen (file_name.c_str (), "w");
+    for (int i = 0; (fp != NULL) && (i < num_samples); i++)
+    {
+        for (int j = 0; j < NUM_ROWS; j++)
+        {
+            fprintf (fp, (j == NUM_ROWS - 1) ? "%.6f\n" : "%.6f\t", get_value (i, j));
+        }
+    }
+    if (fp != NULL)
+    {
+        fclose (fp);
+    }
+    return file_name;
+}
+
+static std::string write_binary_file (const char *name, int num_samples)
+{
+    std::string file_name = std::string ("playback_file_source_unittest_") + name + ".bin";
+    std::vector<double> samples ((size_t)num_samples * NUM_ROWS);
+    for (int i = 0; i < num_samples; i++)
+    {
+        for (int j = 0; j < NUM_ROWS; j++)
+        {
+            samples[(size_t)i * NUM_ROWS + j] = get_value (i, j);
+        }
+    }
+    BinaryFileWriter writer (file_name.c_str (), "wb", NUM_ROWS, -1, 0, 4);
+    writer.open ();
+    writer.write_samples (samples.data (), num_samples);
+    writer.close ();
+    return file_name;
+}
+
+static void remove_files (const std::string &file_name)
+{
+    remove (file_name.c_str ());
+    remove ((file_name + PLAYBACK_INDEX_EXTENSION).c_str ());
+}
+
+// value of the first row is sample index, -1 if there are no packages left
+static double read_sample_num (PlaybackFileSource *source)
+{
+    double package[NUM_ROWS];
+    int res = source->read_package (package);
+    if (res == (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR)
+    {
+        return -1;
+    }
+    EXPECT_EQ (res, (int)BrainFlowExitCodes::STATUS_OK);
+    return package[0];
+}
+
+static struct PlaybackIndexHeader read_index_header (const std::string &file_name)
+{
+    struct PlaybackIndexHeader header;
+    memset (&header, 0, sizeof (header));
+    FILE *fp = fopen ((file_name + PLAYBACK_INDEX_EXTENSION).c_str (), "rb");
+    if (fp != NULL)
+    {
+        EXPECT_EQ (fread (&header, sizeof (header), 1, fp), (size_t)1);
+        fclose (fp);
+    }
+    return header;
+}
+
+static void write_index_header (const std::string &file_name, struct PlaybackIndexHeader &header)
+{
+    FILE *fp = fopen ((file_name + PLAYBACK_INDEX_EXTENSION).c_str (), "r+b");
+    ASSERT_NE (fp, (FILE *)NULL);
+    EXPECT_EQ (fwrite (&header, sizeof (header), 1, fp), (size_t)1);
+    fclose (fp);
+}
+
+TEST (PlaybackFileSourceTest, Open_TextFile_IndexBuiltAndSaved)
+{
+    std::string file_name = write_text_file ("index", NUM_SAMPLES);
+    PlaybackFileSource *source =
+        PlaybackFileSource::create (file_name, NUM_ROWS, TIMESTAMP_CHANNEL);
+    ASSERT_EQ (source->open (), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (source->get_num_packages (), NUM_SAMPLES);
+    EXPECT_EQ (source->get_first_timestamp (), FIRST_TIMESTAMP);
+    EXPECT_EQ (
+        source->get_last_timestamp (), FIRST_TIMESTAMP + (NUM_SAMPLES - 1) * TIMESTAMP_STEP);
+    delete source;
+
+    struct PlaybackIndexHeader header = read_index_header (file_name);
+    EXPECT_EQ (memcmp (header.magic, PLAYBACK_INDEX_MAGIC, sizeof (PLAYBACK_INDEX_MAGIC)), 0);
+    EXPECT_EQ (header.version, PLAYBACK_INDEX_VERSION);
+    EXPECT_EQ (header.stride, PLAYBACK_INDEX_STRIDE);
+    EXPECT_EQ (header.num_lines, NUM_SAMPLES);
+    EXPECT_EQ (header.num_entries,
+        (int64_t)((NUM_SAMPLES + PLAYBACK_INDEX_STRIDE - 1) / PLAYBACK_INDEX_STRIDE));
+    EXPECT_EQ (header.separator, (int32_t)'\t');
+    EXPECT_EQ (header.timestamp_channel, TIMESTAMP_CHANNEL);
+    remove_files (file_name);
+}
+
+TEST (PlaybackFileSourceTest, Open_CachedIndex_ReusedOrRebuilt)
+{
+    std::string file_name = write_text_file ("cache", NUM_SAMPLES);
+    double last_timestamp = FIRST_TIMESTAMP + (NUM_SAMPLES - 1) * TIMESTAMP_STEP;
+    {
+        TextPlaybackFileSource source (file_name, NUM_ROWS, TIMESTAMP_CHANNEL);
+        ASSERT_EQ (source.open (), (int)BrainFlowExitCodes::STATUS_OK);
+    }
+
+    // index from file is used if it matches the recording, fake value is loaded from it
+    struct PlaybackIndexHeader header = read_index_header (file_name);
+    header.last_timestamp = -1.0;
+    write_index_header (file_name, header);
+    {
+        TextPlaybackFileSource source (file_name, NUM_ROWS, TIMESTAMP_CHANNEL);
+        ASSERT_EQ (source.open (), (int)BrainFlowExitCodes::STATUS_OK);
+        EXPECT_EQ (source.get_last_timestamp (), -1.0);
+    }
+
+    // modification time doesnt match
+    header.file_mtime -= 10;
+    write_index_header (file_name, header);
+    {
+        TextPlaybackFileSource source (file_name, NUM_ROWS, TIMESTAMP_CHANNEL);
+        ASSERT_EQ (source.open (), (int)BrainFlowExitCodes::STATUS_OK);
+        EXPECT_EQ (source.get_last_timestamp (), last_timestamp);
+    }
+    EXPECT_EQ (read_index_header (file_name).last_timestamp, last_timestamp);
+
+    // another timestamp channel
+    {
+        TextPlaybackFileSource source (file_name, NUM_ROWS, 0);
+        ASSERT_EQ (source.open (), (int)BrainFlowExitCodes::STATUS_OK);
+        EXPECT_EQ (source.get_last_timestamp (), NUM_SAMPLES - 1);
+    }
+
+    // recording is overwritten, size doesnt match
+    {
+        TextPlaybackFileSource source (file_name, NUM_ROWS, TIMESTAMP_CHANNEL);
+        ASSERT_EQ (source.open (), (int)BrainFlowExitCodes::STATUS_OK);
+    }
+    header = read_index_header (file_name);
+    header.last_timestamp = -1.0;
+    write_index_header (file_name, header);
+    write_text_file ("cache", NUM_SAMPLES * 2);
+    {
+        TextPlaybackFileSource source (file_name, NUM_ROWS, TIMESTAMP_CHANNEL);
+        ASSERT_EQ (source.open (), (int)BrainFlowExitCodes::STATUS_OK);
+        EXPECT_EQ (source.get_num_packages (), NUM_SAMPLES * 2);
+        EXPECT_EQ (source.get_last_timestamp (),
+            FIRST_TIMESTAMP + (NUM_SAMPLES * 2 - 1) * TIMESTAMP_STEP);
+    }
+    EXPECT_EQ (read_index_header (file_name).num_lines, NUM_SAMPLES * 2);
+    remove_files (file_name);
+}
+
+TEST (PlaybackFileSourceTest, SeekTimestamp_TextAndBinary_FirstNotEarlierPackage)
+{
+    std::string file_names[2] = {
+        write_text_file ("seek_timestamp", NUM_SAMPLES),
+        write_binary_file ("seek_timestamp", NUM_SAMPLES)};
+    for (const std::string &file_name : file_names)
+    {
+        PlaybackFileSource *source =
+            PlaybackFileSource::create (file_name, NUM_ROWS, TIMESTAMP_CHANNEL);
+        ASSERT_EQ (source->open (), (int)BrainFlowExitCodes::STATUS_OK) << file_name;
+
+        // before the first sample
+        EXPECT_EQ (
+            source->seek_timestamp (FIRST_TIMESTAMP - 10), (int)BrainFlowExitCodes::STATUS_OK);
+        EXPECT_EQ (read_sample_num (source), 0) << file_name;
+        // exactly at samples, in the first index entry and after few entries
+        int samples[] = {0, 5, PLAYBACK_INDEX_STRIDE - 1, PLAYBACK_INDEX_STRIDE, 700};
+        for (int sample : samples)
+        {
+            source->seek_timestamp (FIRST_TIMESTAMP + sample * TIMESTAMP_STEP);
+            EXPECT_EQ (read_sample_num (source), sample) << file_name;
+            // between samples
+            source->seek_timestamp (FIRST_TIMESTAMP + (sample + 0.5) * TIMESTAMP_STEP);
+            EXPECT_EQ (read_sample_num (source), sample + 1) << file_name;
+            EXPECT_EQ (read_sample_num (source), sample + 2) << file_name;
+        }
+        // last one and after it
+        source->seek_timestamp (FIRST_TIMESTAMP + (NUM_SAMPLES - 1) * TIMESTAMP_STEP);
+        EXPECT_EQ (read_sample_num (source), NUM_SAMPLES - 1) << file_name;
+        EXPECT_EQ (read_sample_num (source), -1) << file_name;
+        source->seek_timestamp (FIRST_TIMESTAMP + NUM_SAMPLES * TIMESTAMP_STEP);
+        EXPECT_EQ (read_sample_num (source), -1) << file_name;
+        // seek works after the end is reached
+        source->seek_timestamp (FIRST_TIMESTAMP + 3 * TIMESTAMP_STEP);
+        EXPECT_EQ (read_sample_num (source), 3) << file_name;
+        delete source;
+        remove_files (file_name);
+    }
+}
+
+TEST (PlaybackFileSourceTest, SeekPercentage_TextAndBinary_MovedToSample)
+{
+    std::string file_names[2] = {
+        write_text_file ("seek_percentage", NUM_SAMPLES),
+        write_binary_file ("seek_percentage", NUM_SAMPLES)};
+    for (const std::string &file_name : file_names)
+    {
+        PlaybackFileSource *source =
+            PlaybackFileSource::create (file_name, NUM_ROWS, TIMESTAMP_CHANNEL);
+        ASSERT_EQ (source->open (), (int)BrainFlowExitCodes::STATUS_OK) << file_name;
+        double percentages[] = {0.0, 25.6, 50.0, 99.95};
+        for (double percentage : percentages)
+        {
+            EXPECT_EQ (source->seek_percentage (percentage), (int)BrainFlowExitCodes::STATUS_OK);
+            EXPECT_EQ (read_sample_num (source), (int)(percentage * NUM_SAMPLES / 100.0))
+                << file_name << " " << percentage;
+        }
+        // position is not changed by invalid seek
+        source->seek_percentage (50.0);
+        EXPECT_EQ (source->seek_percentage (-1), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+        EXPECT_EQ (source->seek_percentage (100), (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+        EXPECT_EQ (read_sample_num (source), NUM_SAMPLES / 2) << file_name;
+        source->rewind ();
+        EXPECT_EQ (read_sample_num (source), 0) << file_name;
+        delete source;
+        remove_files (file_name);
+    }
+}
+
+TEST (PlaybackFileSourceTest, ReadPackage_TextAndBinary_SameRows)
+{
+    std::string text_file = write_text_file ("same_rows", NUM_SAMPLES);
+    std::string binary_file = write_binary_file ("same_rows", NUM_SAMPLES);
+    EXPECT_FALSE (is_binary_file (text_file.c_str ()));
+    EXPECT_TRUE (is_binary_file (binary_file.c_str ()));
+    PlaybackFileSource *text_source =
+        PlaybackFileSource::create (text_file, NUM_ROWS, TIMESTAMP_CHANNEL);
+    PlaybackFileSource *binary_source =
+        PlaybackFileSource::create (binary_file, NUM_ROWS, TIMESTAMP_CHANNEL);
+    ASSERT_EQ (text_source->open (), (int)BrainFlowExitCodes::STATUS_OK);
+    ASSERT_EQ (binary_source->open (), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (text_source->get_num_packages (), binary_source->get_num_packages ());
+    EXPECT_EQ (text_source->get_first_timestamp (), binary_source->get_first_timestamp ());
+    EXPECT_EQ (text_source->get_last_timestamp (), binary_source->get_last_timestamp ());
+
+    double text_package[NUM_ROWS];
+    double binary_package[NUM_ROWS];
+    for (int i = 0; i < NUM_SAMPLES; i++)
+    {
+        ASSERT_EQ (text_source->read_package (text_package), (int)BrainFlowExitCodes::STATUS_OK);
+        ASSERT_EQ (
+            binary_source->read_package (binary_package), (int)BrainFlowExitCodes::STATUS_OK);
+        for (int j = 0; j < NUM_ROWS; j++)
+        {
+            ASSERT_EQ (text_package[j], binary_package[j]) << i << " " << j;
+            ASSERT_EQ (text_package[j], get_value (i, j)) << i << " " << j;
+        }
+    }
+    EXPECT_EQ (
+        text_source->read_package (text_package), (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR);
+    EXPECT_EQ (binary_source->read_package (binary_package),
+        (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR);
+    delete text_source;
+    delete binary_source;
+    remove_files (text_file);
+    remove_files (binary_file);
+}
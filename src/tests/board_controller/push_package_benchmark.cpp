@@ -0,0 +1,103 @@
+// Measures Board::push_package and Board::push_packages throughput for SyntheticBoard layout
+// without streaming thread.
+// Usage: push_package_benchmark [num_samples] [batch_size]
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "brainflow_boards.h"
+#include "synthetic_board.h"
+
+
+class PushPackageBenchmarkBoard : public SyntheticBoard
+{
+public:
+    PushPackageBenchmarkBoard (struct BrainFlowInputParams params) : SyntheticBoard (params)
+    {
+    }
+
+    int prepare (int buffer_size)
+    {
+        return prepare_for_acquisition (buffer_size, "");
+    }
+
+    void push (double *package)
+    {
+        push_package (package);
+    }
+
+    void push_block (double *packages, int count)
+    {
+        push_packages (packages, count);
+    }
+};
+
+static void print_result (const char *name, int num_samples, double elapsed)
+{
+    printf ("%s: %.0lf samples/s, %.1lf ns/sample\n", name, (double)num_samples / elapsed,
+        elapsed * 1e9 / (double)num_samples);
+}
+
+int main (int argc, char *argv[])
+{
+    int num_samples = (argc > 1) ? atoi (argv[1]) : 2000000;
+    int batch_size = (argc > 2) ? atoi (argv[2]) : 25;
+    if (batch_size <= 0)
+    {
+        printf ("invalid batch size\n");
+        return 1;
+    }
+    struct BrainFlowInputParams params;
+    PushPackageBenchmarkBoard board (params);
+    board.prepare_session ();
+    int res = board.prepare (45000);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        printf ("failed to prepare board: %d\n", res);
+        return res;
+    }
+
+    int num_rows = (int)boards_struct.brainflow_boards_json["boards"][std::to_string (
+        (int)BoardIds::SYNTHETIC_BOARD)]["default"]["num_rows"];
+    std::vector<double> package (num_rows, 1.0);
+    auto start = std::chrono::high_resolution_clock::now ();
+    for (int i = 0; i < num_samples; i++)
+    {
+        if (i % 1000 == 0)
+        {
+            board.insert_marker (1.0, (int)BrainFlowPresets::DEFAULT_PRESET);
+        }
+        package[0] = (double)i;
+        board.push (package.data ());
+    }
+    double elapsed =
+        std::chrono::duration<double> (std::chrono::high_resolution_clock::now () - start)
+            .count ();
+
+    printf ("num_rows: %d, samples: %d, batch_size: %d\n", num_rows, num_samples, batch_size);
+    print_result ("push_package", num_samples, elapsed);
+
+    std::vector<double> block (num_rows * batch_size, 1.0);
+    start = std::chrono::high_resolution_clock::now ();
+    for (int i = 0; i < num_samples; i += batch_size)
+    {
+        int count = std::min (batch_size, num_samples - i);
+        for (int j = 0; j < count; j++)
+        {
+            if ((i + j) % 1000 == 0)
+            {
+                board.insert_marker (1.0, (int)BrainFlowPresets::DEFAULT_PRESET);
+            }
+            block[j * num_rows] = (double)(i + j);
+        }
+        board.push_block (block.data (), count);
+    }
+    elapsed = std::chrono::duration<double> (std::chrono::high_resolution_clock::now () - start)
+                  .count ();
+    print_result ("push_packages", num_samples, elapsed);
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "brainflow_constants.h"
+#include "streamer.h"
+
+using namespace testing;
+
+
+#define NUM_EXTRA_PACKAGES 100
+
+
+// sink which doesnt return from stream_batch until it's released
+class BlockingStreamer : public Streamer
+{
+public:
+    std::vector<double> received;
+    std::atomic<int> num_batches;
+
+    BlockingStreamer () : Streamer (1, "test", "test", "")
+    {
+        num_batches = 0;
+        released = false;
+    }
+
+    ~BlockingStreamer ()
+    {
+        release ();
+        stop_dispatching ();
+    }
+
+    int init_streamer ()
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    void release ()
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        released = true;
+        cv.notify_all ();
+    }
+
+    // starts dispatching and waits until dispatching thread is stuck in sink with package 0
+    void start_stuck (StreamerOverflowPolicies policy)
+    {
+        ASSERT_EQ (start_dispatching (policy), (int)BrainFlowExitCodes::STATUS_OK);
+        double value = 0.0;
+        stream_data (&value);
+        while (num_batches == 0)
+        {
+            std::this_thread::sleep_for (std::chrono::milliseconds (1));
+        }
+    }
+
+protected:
+    void stream_batch (double *data, int count)
+    {
+        num_batches++;
+        std::unique_lock<std::mutex> lock (mutex);
+        cv.wait (lock, [this] { return released; });
+        received.insert (received.end (), data, data + count);
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool released;
+};
+
+// pushes packages first, ..., last - 1 one by one or in blocks of 4
+static void push_range (Streamer &streamer, int first, int last, bool use_blocks)
+{
+    std::vector<double> values;
+    for (int i = first; i < last; i++)
+    {
+        values.push_back (i);
+    }
+    if (!use_blocks)
+    {
+        for (double &value : values)
+        {
+            streamer.stream_data (&value);
+        }
+        return;
+    }
+    for (size_t i = 0; i < values.size (); i += 4)
+    {
+        int count = (int)std::min ((size_t)4, values.size () - i);
+        streamer.stream_data_block (values.data () + i, count);
+    }
+}
+
+TEST (StreamerTest, DefaultPolicy_DropOldest)
+{
+    BlockingStreamer streamer;
+    EXPECT_EQ (streamer.get_overflow_policy (), StreamerOverflowPolicies::DROP_OLDEST);
+}
+
+TEST (StreamerTest, DropOldest_SinkNeverDrains_OldestDropped)
+{
+    for (bool use_blocks : {false, true})
+    {
+        BlockingStreamer streamer;
+        streamer.start_stuck (StreamerOverflowPolicies::DROP_OLDEST);
+        int last = 1 + STREAMER_QUEUE_SIZE + NUM_EXTRA_PACKAGES;
+        push_range (streamer, 1, last, use_blocks);
+        EXPECT_EQ (streamer.get_dropped_count (), (size_t)NUM_EXTRA_PACKAGES);
+        EXPECT_EQ (streamer.get_queued_count (), (size_t)STREAMER_QUEUE_SIZE);
+        EXPECT_FALSE (streamer.is_waiting_required (1));
+        streamer.release ();
+        streamer.stop_dispatching ();
+
+        ASSERT_EQ (streamer.received.size (), (size_t)STREAMER_QUEUE_SIZE + 1);
+        EXPECT_EQ (streamer.received[0], 0.0);
+        for (int i = 1; i <= STREAMER_QUEUE_SIZE; i++)
+        {
+            ASSERT_EQ (streamer.received[i], (double)(i + NUM_EXTRA_PACKAGES));
+        }
+    }
+}
+
+TEST (StreamerTest, DropNewest_SinkNeverDrains_NewestDropped)
+{
+    for (bool use_blocks : {false, true})
+    {
+        BlockingStreamer streamer;
+        streamer.start_stuck (StreamerOverflowPolicies::DROP_NEWEST);
+        int last = 1 + STREAMER_QUEUE_SIZE + NUM_EXTRA_PACKAGES;
+        push_range (streamer, 1, last, use_blocks);
+        EXPECT_EQ (streamer.get_dropped_count (), (size_t)NUM_EXTRA_PACKAGES);
+        EXPECT_EQ (streamer.get_queued_count (), (size_t)STREAMER_QUEUE_SIZE);
+        EXPECT_FALSE (streamer.is_waiting_required (1));
+        streamer.release ();
+        streamer.stop_dispatching ();
+
+        ASSERT_EQ (streamer.received.size (), (size_t)STREAMER_QUEUE_SIZE + 1);
+        for (int i = 0; i <= STREAMER_QUEUE_SIZE; i++)
+        {
+            ASSERT_EQ (streamer.received[i], (double)i);
+        }
+    }
+}
+
+TEST (StreamerTest, Block_SinkNeverDrains_ProducerWaitsWithoutDrops)
+{
+    BlockingStreamer streamer;
+    streamer.start_stuck (StreamerOverflowPolicies::BLOCK);
+    int last = 1 + STREAMER_QUEUE_SIZE + NUM_EXTRA_PACKAGES;
+    std::atomic<int> num_pushed (1);
+    // same as Board::lock_for_streamers
+    std::thread producer ([&] {
+        for (int i = 1; i < last; i++)
+        {
+            while (streamer.is_waiting_required (1))
+            {
+                std::this_thread::sleep_for (std::chrono::microseconds (100));
+            }
+            double value = i;
+            streamer.stream_data (&value);
+            num_pushed++;
+        }
+    });
+    while (streamer.get_queued_count () < STREAMER_QUEUE_SIZE)
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (1));
+    }
+    std::this_thread::sleep_for (std::chrono::milliseconds (20));
+    EXPECT_EQ (num_pushed.load (), 1 + STREAMER_QUEUE_SIZE);
+    EXPECT_TRUE (streamer.is_waiting_required (1));
+    EXPECT_EQ (streamer.get_dropped_count (), (size_t)0);
+
+    streamer.release ();
+    producer.join ();
+    streamer.stop_dispatching ();
+    EXPECT_EQ (streamer.get_dropped_count (), (size_t)0);
+    ASSERT_EQ (streamer.received.size (), (size_t)last);
+    for (int i = 0; i < last; i++)
+    {
+        ASSERT_EQ (streamer.received[i], (double)i);
+    }
+}
@@ -29,10 +29,66 @@ enable_testing()
 
 SET (TESTS_SRC
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/bluetooth/bluetooth_functions.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/base_data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/channel_major_data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/binary_file.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/io_reactor.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/lock_free_data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/libftdi_serial.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/mapped_file.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/multicast_server.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/numeric_parser.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/os_serial.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/os_serial_ioctl.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/serial.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/serial_frame_reader.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/socket_client_udp.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/spill_data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/timestamp.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/udp_batch.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/board.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/brainflow_boards.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/file_streamer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/multicast_streamer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/openbci/openbci_exg_decoder.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/playback_file_source.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/plotjuggler_udp_streamer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/preset_layout.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/streamer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/data_handler/band_power_engine.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/data_handler/fastica.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/data_handler/fft_cache.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/data_handler/peak_detector.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/data_handler/resampler.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/data_handler/streaming_filter.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/data_handler/wavelet_cache.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/board_controller/board_controller_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/board_controller/multicast_streamer_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/board_controller/openbci_exg_decoder_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/board_controller/playback_file_board_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/board_controller/playback_file_source_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/board_controller/streamer_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/data_handler/band_power_engine_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/data_handler/fastica_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/data_handler/fft_cache_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/data_handler/peak_detector_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/data_handler/resampler_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/data_handler/rolling_filter_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/data_handler/streaming_filter_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/data_handler/wavelet_cache_unittest.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/bluetooth/socket_bluetooth_test.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/bluetooth/bluetooth_functions_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/binary_file_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/channel_major_data_buffer_unittest.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/data_buffer_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/io_reactor_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/lock_free_data_buffer_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/mapped_file_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/numeric_parser_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/serial_frame_reader_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/spill_data_buffer_unittest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/udp_batch_unittest.cpp
 )
 
 add_executable(
@@ -42,15 +98,28 @@ add_executable(
 
 target_include_directories (
     ${TESTS_EXE_NAME} PRIVATE
+    ${CMAKE_CURRENT_SOURCE_DIR}/third_party/
+    ${CMAKE_CURRENT_SOURCE_DIR}/third_party/json
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/inc
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/inc
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/openbci/inc
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/data_handler/inc
+    ${CMAKE_CURRENT_SOURCE_DIR}/third_party/DSPFilters/include
+    ${CMAKE_CURRENT_SOURCE_DIR}/third_party/kissfft
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/bluetooth/inc
     ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/bluetooth/inc
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/board_controller/inc
     ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/bluetooth/macos_third_party
 )
 
 target_link_libraries(
     ${TESTS_EXE_NAME} PRIVATE
     gmock_main
+    ${BOARD_CONTROLLER_NAME}
+    ${DATA_HANDLER_NAME}
+    ${DSPFILTERS}
+    kissfft
+    ${WAVELIB}
 )
 
 set_target_properties (${TESTS_EXE_NAME}
@@ -61,4 +130,115 @@ set_target_properties (${TESTS_EXE_NAME}
 )
 
 include(GoogleTest)
-gtest_discover_tests(${TESTS_EXE_NAME})
\ No newline at end of file
+gtest_discover_tests(${TESTS_EXE_NAME})
+
+# benchmarks are not registered in ctest, run them manually from build/tests
+SET (DATA_BUFFER_BENCHMARK_NAME "data_buffer_benchmark")
+
+add_executable (
+    ${DATA_BUFFER_BENCHMARK_NAME}
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/base_data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/channel_major_data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/lock_free_data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/spill_data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/data_buffer_benchmark.cpp
+)
+
+target_include_directories (
+    ${DATA_BUFFER_BENCHMARK_NAME} PRIVATE
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/inc
+)
+
+if (UNIX)
+    target_link_libraries (${DATA_BUFFER_BENCHMARK_NAME} PRIVATE pthread)
+endif (UNIX)
+
+set_target_properties (${DATA_BUFFER_BENCHMARK_NAME}
+    PROPERTIES
+    RUNTIME_OUTPUT_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}/build/tests
+)
+
+SET (PUSH_PACKAGE_BENCHMARK_NAME "push_package_benchmark")
+
+add_executable (
+    ${PUSH_PACKAGE_BENCHMARK_NAME}
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/timestamp.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/base_data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/channel_major_data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/binary_file.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/lock_free_data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/spill_data_buffer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/socket_client_udp.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/udp_batch.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/multicast_server.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/board.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/preset_layout.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/brainflow_boards.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/synthetic_board.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/streamer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/file_streamer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/multicast_streamer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/plotjuggler_udp_streamer.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/board_controller/push_package_benchmark.cpp
+)
+
+target_include_directories (
+    ${PUSH_PACKAGE_BENCHMARK_NAME} PRIVATE
+    ${CMAKE_CURRENT_SOURCE_DIR}/third_party/
+    ${CMAKE_CURRENT_SOURCE_DIR}/third_party/json
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/inc
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/inc
+)
+
+if (UNIX)
+    target_link_libraries (${PUSH_PACKAGE_BENCHMARK_NAME} PRIVATE pthread)
+endif (UNIX)
+
+set_target_properties (${PUSH_PACKAGE_BENCHMARK_NAME}
+    PROPERTIES
+    RUNTIME_OUTPUT_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}/build/tests
+)
+
+SET (OPENBCI_DECODE_BENCHMARK_NAME "openbci_decode_benchmark")
+
+add_executable (
+    ${OPENBCI_DECODE_BENCHMARK_NAME}
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/openbci/openbci_exg_decoder.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/board_controller/openbci_decode_benchmark.cpp
+)
+
+target_include_directories (
+    ${OPENBCI_DECODE_BENCHMARK_NAME} PRIVATE
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/inc
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/board_controller/openbci/inc
+)
+
+set_target_properties (${OPENBCI_DECODE_BENCHMARK_NAME}
+    PROPERTIES
+    RUNTIME_OUTPUT_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}/build/tests
+)
+
+SET (UDP_BATCH_BENCHMARK_NAME "udp_batch_benchmark")
+
+add_executable (
+    ${UDP_BATCH_BENCHMARK_NAME}
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/socket_client_udp.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/udp_batch.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/tests/utils/udp_batch_benchmark.cpp
+)
+
+target_include_directories (
+    ${UDP_BATCH_BENCHMARK_NAME} PRIVATE
+    ${CMAKE_CURRENT_SOURCE_DIR}/src/utils/inc
+)
+
+if (UNIX)
+    target_link_libraries (${UDP_BATCH_BENCHMARK_NAME} PRIVATE pthread)
+endif (UNIX)
+
+set_target_properties (${UDP_BATCH_BENCHMARK_NAME}
+    PROPERTIES
+    RUNTIME_OUTPUT_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}/build/tests
+)
@@ -0,0 +1,155 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <math.h>
+#include <vector>
+
+#include "band_power_engine.h"
+#include "brainflow_constants.h"
+#include "data_handler.h"
+
+using namespace testing;
+
+
+static double get_value (int channel, int sample, int sampling_rate)
+{
+    return sin (2 * M_PI * 10.0 * (channel + 1) * sample / sampling_rate) + 0.1 * (sample % 3);
+}
+
+// psd of segment which ends at end_sample, computed from scratch
+static std::vector<double> get_segment_psd (
+    int channel, int end_sample, int nfft, int sampling_rate)
+{
+    FFTPlan plan (nfft, false);
+    std::shared_ptr<const std::vector<double>> window =
+        FFTCache::get_window ((int)WindowOperations::HANNING, nfft);
+    for (int i = 0; i < nfft; i++)
+    {
+        plan.get_real_buffer ()[i] =
+            (*window)[i] * get_value (channel, end_sample - nfft + i, sampling_rate);
+    }
+    kiss_fftr (plan.get_cfg (), plan.get_real_buffer (), plan.get_complex_buffer ());
+    std::vector<double> psd (nfft / 2 + 1);
+    fill_one_sided_psd (plan.get_complex_buffer (), nfft, sampling_rate, psd.data (), NULL);
+    return psd;
+}
+
+TEST (BandPowerEngineTest, Update_RandomChunks_SameAsWelchOverLastSegments)
+{
+    int sampling_rate = 250;
+    int num_channels = 2;
+    BandPowerEngine engine (num_channels, sampling_rate, 1000, false);
+    ASSERT_EQ ((int)BrainFlowExitCodes::STATUS_OK, engine.prepare ());
+    int nfft = engine.get_nfft ();
+    ASSERT_EQ (nfft, 512);
+    int step = nfft - 4 * nfft / 5;
+    int max_segments = (1000 - nfft) / step + 1;
+
+    std::vector<double> ampl (nfft / 2 + 1);
+    std::vector<double> freq (nfft / 2 + 1);
+    EXPECT_FALSE (engine.get_psd (0, ampl.data (), freq.data ()));
+
+    int chunk_sizes[] = {1, 17, 250, 64, 3};
+    int total = 0;
+    for (int iter = 0; iter < 60; iter++)
+    {
+        int chunk = chunk_sizes[iter % 5];
+        std::vector<double> data (num_channels * chunk);
+        for (int channel = 0; channel < num_channels; channel++)
+        {
+            for (int i = 0; i < chunk; i++)
+            {
+                data[channel * chunk + i] = get_value (channel, total + i, sampling_rate);
+            }
+        }
+        engine.update (data.data (), chunk);
+        total += chunk;
+    }
+    // segments end at nfft + k * step
+    int last_end = nfft + ((total - nfft) / step) * step;
+    int num_segments = std::min ((total - nfft) / step + 1, max_segments);
+    for (int channel = 0; channel < num_channels; channel++)
+    {
+        std::vector<double> expected (nfft / 2 + 1, 0.0);
+        for (int segment = 0; segment < num_segments; segment++)
+        {
+            std::vector<double> psd =
+                get_segment_psd (channel, last_end - segment * step, nfft, sampling_rate);
+            for (int i = 0; i < nfft / 2 + 1; i++)
+            {
+                expected[i] += psd[i] / num_segments;
+            }
+        }
+        ASSERT_TRUE (engine.get_psd (channel, ampl.data (), freq.data ()));
+        int peak = 0;
+        for (int i = 0; i < nfft / 2 + 1; i++)
+        {
+            EXPECT_NEAR (ampl[i], expected[i], 1e-9 * (1.0 + expected[i])) << i;
+            if (ampl[i] > ampl[peak])
+            {
+                peak = i;
+            }
+        }
+        EXPECT_NEAR (freq[peak], 10.0 * (channel + 1), 0.5);
+    }
+
+    engine.reset ();
+    EXPECT_FALSE (engine.get_psd (0, ampl.data (), freq.data ()));
+}
+
+TEST (BandPowerEngineTest, GetPowers_NotPowerOfTwoRates_SameAsGetCustomBandPowers)
+{
+    // nearest power of two is less than sampling rate for 300 and 160
+    int rates[] = {250, 300, 160};
+    int expected_nfft[] = {512, 512, 256};
+    double start_freqs[] = {2.0, 4.0, 8.0, 13.0, 30.0};
+    double stop_freqs[] = {4.0, 8.0, 13.0, 30.0, 45.0};
+    int num_bands = 5;
+    int num_channels = 3;
+    for (int r = 0; r < 3; r++)
+    {
+        int sampling_rate = rates[r];
+        int cols = sampling_rate * 10;
+        std::vector<double> data ((size_t)num_channels * cols);
+        for (int channel = 0; channel < num_channels; channel++)
+        {
+            for (int i = 0; i < cols; i++)
+            {
+                data[channel * cols + i] = get_value (channel, i, sampling_rate);
+            }
+        }
+        std::vector<double> expected_avg (num_bands);
+        std::vector<double> expected_stddev (num_bands);
+        ASSERT_EQ ((int)BrainFlowExitCodes::STATUS_OK,
+            get_custom_band_powers (data.data (), num_channels, cols, start_freqs, stop_freqs,
+                num_bands, sampling_rate, 0, expected_avg.data (), expected_stddev.data ()));
+
+        BandPowerEngine engine (num_channels, sampling_rate, cols, false);
+        ASSERT_EQ ((int)BrainFlowExitCodes::STATUS_OK, engine.prepare ());
+        EXPECT_EQ (engine.get_nfft (), expected_nfft[r]);
+        int engine_id = 0;
+        ASSERT_EQ ((int)BrainFlowExitCodes::STATUS_OK,
+            create_band_power_engine (num_channels, sampling_rate, cols, 0, &engine_id));
+        ASSERT_EQ ((int)BrainFlowExitCodes::STATUS_OK,
+            update_band_power_engine (engine_id, data.data (), cols));
+        std::vector<double> avg (num_bands);
+        std::vector<double> stddev (num_bands);
+        ASSERT_EQ ((int)BrainFlowExitCodes::STATUS_OK,
+            get_band_power_engine_powers (
+                engine_id, start_freqs, stop_freqs, num_bands, avg.data (), stddev.data ()));
+        release_band_power_engine (engine_id);
+        for (int i = 0; i < num_bands; i++)
+        {
+            EXPECT_NEAR (avg[i], expected_avg[i], 1e-9) << sampling_rate << " " << i;
+            EXPECT_NEAR (stddev[i], expected_stddev[i], 1e-9) << sampling_rate << " " << i;
+        }
+    }
+}
+
+TEST (BandPowerEngineTest, Prepare_InvalidParams)
+{
+    BandPowerEngine small_window (1, 250, 7, true);
+    EXPECT_EQ ((int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR, small_window.prepare ());
+    BandPowerEngine no_channels (0, 250, 1000, true);
+    EXPECT_EQ ((int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR, no_channels.prepare ());
+}
@@ -0,0 +1,203 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "brainflow_constants.h"
+#include "fastica.h"
+
+using namespace testing;
+
+
+#define NUM_SOURCES 3
+
+
+static double get_source (int source, int sample)
+{
+    double t = sample * 0.01;
+    switch (source)
+    {
+        case 0:
+            return sin (2 * M_PI * 1.3 * t);
+        case 1:
+            return (sin (2 * M_PI * 0.7 * t) > 0) ? 1.0 : -1.0;
+        default:
+            return fmod (0.9 * t, 1.0) * 2 - 1;
+    }
+}
+
+// row major NUM_SOURCES x cols mixed signal with offsets, first sample is start
+static std::vector<double> generate_mixed_data (int start, int cols)
+{
+    double mixing[NUM_SOURCES][NUM_SOURCES] = {{1.0, 0.5, 0.3}, {0.4, 1.0, 0.6}, {0.2, 0.7, 1.0}};
+    std::vector<double> data (NUM_SOURCES * cols);
+    for (int r = 0; r < NUM_SOURCES; r++)
+    {
+        for (int c = 0; c < cols; c++)
+        {
+            double value = 100.0 * (r + 1);
+            for (int source = 0; source < NUM_SOURCES; source++)
+            {
+                value += mixing[r][source] * get_source (source, start + c);
+            }
+            data[r * cols + c] = value;
+        }
+    }
+    return data;
+}
+
+// max abs correlation of each source with any component
+static double min_source_correlation (const std::vector<double> &s_mat, int start, int cols)
+{
+    double min_corr = 1.0;
+    for (int source = 0; source < NUM_SOURCES; source++)
+    {
+        double max_corr = 0.0;
+        for (int component = 0; component < NUM_SOURCES; component++)
+        {
+            double sum_xy = 0, sum_x = 0, sum_y = 0, sum_xx = 0, sum_yy = 0;
+            for (int c = 0; c < cols; c++)
+            {
+                double x = get_source (source, start + c);
+                double y = s_mat[component * cols + c];
+                sum_xy += x * y;
+                sum_x += x;
+                sum_y += y;
+                sum_xx += x * x;
+                sum_yy += y * y;
+            }
+            double cov = sum_xy - sum_x * sum_y / cols;
+            double corr =
+                cov / sqrt ((sum_xx - sum_x * sum_x / cols) * (sum_yy - sum_y * sum_y / cols));
+            max_corr = std::max (max_corr, fabs (corr));
+        }
+        min_corr = std::min (min_corr, max_corr);
+    }
+    return min_corr;
+}
+
+TEST (FastICATest, Compute_MixedSources_Separated)
+{
+    int cols = 5000;
+    std::vector<double> data = generate_mixed_data (0, cols);
+    std::vector<double> data_copy (data);
+    FastICA ica (NUM_SOURCES, 300, 0.0001, 42);
+    ASSERT_EQ (ica.compute (data.data (), NUM_SOURCES, cols), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (data, data_copy);
+
+    std::vector<double> w (NUM_SOURCES * NUM_SOURCES);
+    std::vector<double> k (NUM_SOURCES * NUM_SOURCES);
+    std::vector<double> a (NUM_SOURCES * NUM_SOURCES);
+    std::vector<double> s (NUM_SOURCES * cols);
+    ica.get_matrixes (w.data (), k.data (), a.data (), s.data ());
+    EXPECT_GT (min_source_correlation (s, 0, cols), 0.99);
+
+    // S is W %*% K %*% centered X
+    std::vector<double> means (NUM_SOURCES, 0.0);
+    for (int r = 0; r < NUM_SOURCES; r++)
+    {
+        for (int c = 0; c < cols; c++)
+        {
+            means[r] += data[r * cols + c] / cols;
+        }
+    }
+    for (int c = 0; c < cols; c += 97)
+    {
+        for (int component = 0; component < NUM_SOURCES; component++)
+        {
+            double value = 0.0;
+            for (int r = 0; r < NUM_SOURCES; r++)
+            {
+                double wk = 0.0;
+                for (int i = 0; i < NUM_SOURCES; i++)
+                {
+                    wk += w[component * NUM_SOURCES + i] * k[i * NUM_SOURCES + r];
+                }
+                value += wk * (data[r * cols + c] - means[r]);
+            }
+            EXPECT_NEAR (s[component * cols + c], value, 1e-6);
+        }
+    }
+}
+
+TEST (FastICATest, Compute_SameSeed_SameResult)
+{
+    int cols = 2000;
+    std::vector<double> data = generate_mixed_data (0, cols);
+    std::vector<std::vector<double>> results;
+    for (int attempt = 0; attempt < 3; attempt++)
+    {
+        FastICA ica (NUM_SOURCES, 300, 0.0001, 7);
+        ASSERT_EQ (
+            ica.compute (data.data (), NUM_SOURCES, cols), (int)BrainFlowExitCodes::STATUS_OK);
+        std::vector<double> w (NUM_SOURCES * NUM_SOURCES);
+        std::vector<double> k (NUM_SOURCES * NUM_SOURCES);
+        std::vector<double> a (NUM_SOURCES * NUM_SOURCES);
+        std::vector<double> s (NUM_SOURCES * cols);
+        ica.get_matrixes (w.data (), k.data (), a.data (), s.data ());
+        results.push_back (w);
+        if (attempt == 2)
+        {
+            // reset restarts random generator
+            ica.reset ();
+            ASSERT_EQ (
+                ica.compute (data.data (), NUM_SOURCES, cols), (int)BrainFlowExitCodes::STATUS_OK);
+            ica.get_matrixes (w.data (), k.data (), a.data (), s.data ());
+            results.push_back (w);
+        }
+    }
+    for (size_t i = 1; i < results.size (); i++)
+    {
+        EXPECT_EQ (results[i], results[0]);
+    }
+}
+
+TEST (FastICATest, Compute_WarmStart_FewerIterations)
+{
+    int cols = 4000;
+    int step = 200;
+    FastICA warm_ica (NUM_SOURCES, 300, 0.0001, 1);
+    warm_ica.set_warm_start (true);
+    FastICA cold_ica (NUM_SOURCES, 300, 0.0001, 1);
+    int warm_iterations = 0;
+    int cold_iterations = 0;
+    std::vector<double> w (NUM_SOURCES * NUM_SOURCES);
+    std::vector<double> k (NUM_SOURCES * NUM_SOURCES);
+    std::vector<double> a (NUM_SOURCES * NUM_SOURCES);
+    std::vector<double> s (NUM_SOURCES * cols);
+    for (int window = 0; window < 10; window++)
+    {
+        std::vector<double> data = generate_mixed_data (window * step, cols);
+        ASSERT_EQ (warm_ica.compute (data.data (), NUM_SOURCES, cols),
+            (int)BrainFlowExitCodes::STATUS_OK);
+        ASSERT_EQ (cold_ica.compute (data.data (), NUM_SOURCES, cols),
+            (int)BrainFlowExitCodes::STATUS_OK);
+        warm_ica.get_matrixes (w.data (), k.data (), a.data (), s.data ());
+        EXPECT_GT (min_source_correlation (s, window * step, cols), 0.99);
+        if (window > 0)
+        {
+            warm_iterations += warm_ica.get_num_iterations ();
+            cold_iterations += cold_ica.get_num_iterations ();
+        }
+    }
+    EXPECT_LT (warm_iterations * 2, cold_iterations);
+}
+
+TEST (FastICATest, Compute_InvalidData_Error)
+{
+    int cols = 100;
+    std::vector<double> data = generate_mixed_data (0, cols);
+    FastICA too_many_components (NUM_SOURCES + 1, 300, 0.0001, 1);
+    EXPECT_EQ (too_many_components.compute (data.data (), NUM_SOURCES, cols),
+        (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    // rows are linearly dependent
+    for (int c = 0; c < cols; c++)
+    {
+        data[2 * cols + c] = data[c] + data[cols + c];
+    }
+    FastICA ica (NUM_SOURCES, 300, 0.0001, 1);
+    EXPECT_EQ (ica.compute (data.data (), NUM_SOURCES, cols),
+        (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+}
@@ -0,0 +1,76 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <math.h>
+#include <vector>
+
+#include "brainflow_constants.h"
+#include "fft_cache.h"
+
+using namespace testing;
+
+
+TEST (FFTCacheTest, AcquirePlan_AfterRelease_ReuseSamePlan)
+{
+    FFTCache::clear ();
+    FFTPlan *plan = FFTCache::acquire_plan (256, false);
+    ASSERT_TRUE (plan != NULL);
+    EXPECT_EQ (plan->get_nfft (), 256);
+    EXPECT_FALSE (plan->is_inverse ());
+    // plan is in use, another caller gets a new one
+    FFTPlan *second_plan = FFTCache::acquire_plan (256, false);
+    ASSERT_TRUE (second_plan != NULL);
+    EXPECT_NE (plan, second_plan);
+    FFTCache::release_plan (second_plan);
+    FFTCache::release_plan (plan);
+
+    FFTPlan *cached_plan = FFTCache::acquire_plan (256, false);
+    EXPECT_TRUE ((cached_plan == plan) || (cached_plan == second_plan));
+    FFTPlan *inverse_plan = FFTCache::acquire_plan (256, true);
+    ASSERT_TRUE (inverse_plan != NULL);
+    EXPECT_TRUE (inverse_plan->is_inverse ());
+    FFTCache::release_plan (cached_plan);
+    FFTCache::release_plan (inverse_plan);
+    FFTCache::clear ();
+}
+
+TEST (FFTCacheTest, AcquirePlan_InvalidSize_ReturnNull)
+{
+    EXPECT_TRUE (FFTCache::acquire_plan (0, false) == NULL);
+    EXPECT_TRUE (FFTCache::acquire_plan (15, false) == NULL);
+    FFTPlanGuard guard (-2, true);
+    EXPECT_TRUE (guard.get () == NULL);
+}
+
+TEST (FFTCacheTest, GetWindow_SameTableForSameParams)
+{
+    std::shared_ptr<const std::vector<double>> window =
+        FFTCache::get_window ((int)WindowOperations::HANNING, 128);
+    ASSERT_TRUE ((bool)window);
+    ASSERT_EQ ((int)window->size (), 128);
+    EXPECT_EQ ((*window)[0], 0.0);
+    EXPECT_NEAR ((*window)[64], 1.0, 1e-12);
+    EXPECT_EQ (window, FFTCache::get_window ((int)WindowOperations::HANNING, 128));
+    EXPECT_NE (window, FFTCache::get_window ((int)WindowOperations::HAMMING, 128));
+    EXPECT_FALSE ((bool)FFTCache::get_window (100, 128));
+    EXPECT_FALSE ((bool)FFTCache::get_window ((int)WindowOperations::HANNING, 0));
+}
+
+TEST (FFTCacheTest, Plan_ForwardAndInverse_RestoreSignal)
+{
+    int nfft = 64;
+    std::vector<double> signal (nfft);
+    for (int i = 0; i < nfft; i++)
+    {
+        signal[i] = sin (i * 0.3) + 0.25 * i;
+    }
+    FFTPlanGuard forward (nfft, false);
+    FFTPlanGuard inverse (nfft, true);
+    ASSERT_TRUE ((forward.get () != NULL) && (inverse.get () != NULL));
+    kiss_fftr (forward.get ()->get_cfg (), signal.data (), forward.get ()->get_complex_buffer ());
+    kiss_fftri (inverse.get ()->get_cfg (), forward.get ()->get_complex_buffer (),
+        inverse.get ()->get_real_buffer ());
+    for (int i = 0; i < nfft; i++)
+    {
+        EXPECT_NEAR (inverse.get ()->get_real_buffer ()[i] / nfft, signal[i], 1e-9);
+    }
+}
@@ -0,0 +1,120 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "common_data_handler_helpers.h"
+#include "peak_detector.h"
+
+using namespace testing;
+
+
+// sine with noise and spikes
+static std::vector<double> generate_signal (int len)
+{
+    srand (7);
+    std::vector<double> signal (len);
+    for (int i = 0; i < len; i++)
+    {
+        signal[i] = sin (i * 0.05) + 0.2 * ((double)rand () / RAND_MAX);
+        if (rand () % 50 == 0)
+        {
+            signal[i] += ((rand () % 2) ? 3.0 : -3.0);
+        }
+    }
+    return signal;
+}
+
+// previous implementation of detect_peaks_z_score which recalculates stats for each sample
+static std::vector<double> naive_z_score (
+    const std::vector<double> &data, int lag, double threshold, double influence)
+{
+    int data_len = (int)data.size ();
+    std::vector<double> output (data_len, 0.0);
+    std::vector<double> filtered_data (data);
+    std::vector<double> avg_filter (data_len);
+    std::vector<double> std_filter (data_len);
+    avg_filter[lag - 1] = mean (filtered_data.data (), lag);
+    std_filter[lag - 1] = stddev (filtered_data.data (), lag);
+    for (int i = lag; i < data_len; i++)
+    {
+        if (fabs (data[i] - avg_filter[i - 1]) > threshold * std_filter[i - 1])
+        {
+            output[i] = (data[i] > avg_filter[i - 1]) ? 1 : -1;
+            filtered_data[i] = influence * data[i] + (1 - influence) * filtered_data[i - 1];
+        }
+        avg_filter[i] = mean (filtered_data.data () + i - lag, lag);
+        std_filter[i] = stddev (filtered_data.data () + i - lag, lag);
+    }
+    return output;
+}
+
+TEST (ZScorePeakDetectorTest, Process_WholeSignal_SameAsNaive)
+{
+    std::vector<double> data = generate_signal (5000);
+    int lags[] = {2, 5, 30, 300};
+    double influences[] = {0.0, 0.3, 1.0};
+    for (int lag : lags)
+    {
+        for (double influence : influences)
+        {
+            std::vector<double> expected = naive_z_score (data, lag, 2.5, influence);
+            std::vector<double> actual (data.size ());
+            ZScorePeakDetector detector (lag, 2.5, influence);
+            detector.process (data.data (), actual.data (), (int)data.size ());
+            int num_peaks = 0;
+            for (size_t i = 0; i < data.size (); i++)
+            {
+                ASSERT_EQ (actual[i], expected[i])
+                    << "lag " << lag << " influence " << influence << " index " << i;
+                num_peaks += (actual[i] != 0.0);
+            }
+            EXPECT_GT (num_peaks, 0);
+        }
+    }
+}
+
+TEST (StreamingPeakDetectorTest, Process_ChunksInPlace_SameAsWholeSignal)
+{
+    int len = 2000;
+    int num_channels = 3;
+    std::vector<double> data = generate_signal (len * num_channels);
+    std::vector<double> expected (data.size ());
+    for (int channel = 0; channel < num_channels; channel++)
+    {
+        ZScorePeakDetector detector (20, 3.0, 0.5);
+        detector.process (data.data () + channel * len, expected.data () + channel * len, len);
+    }
+
+    StreamingPeakDetector detector (20, 3.0, 0.5, num_channels);
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        int chunk_sizes[] = {1, 7, 64, 250};
+        int pos = 0;
+        int chunk_id = 0;
+        while (pos < len)
+        {
+            int chunk = std::min (chunk_sizes[chunk_id++ % 4], len - pos);
+            std::vector<double> buf (chunk * num_channels);
+            for (int channel = 0; channel < num_channels; channel++)
+            {
+                std::copy (data.begin () + channel * len + pos,
+                    data.begin () + channel * len + pos + chunk, buf.begin () + channel * chunk);
+            }
+            detector.process (buf.data (), buf.data (), chunk);
+            for (int channel = 0; channel < num_channels; channel++)
+            {
+                for (int i = 0; i < chunk; i++)
+                {
+                    ASSERT_EQ (buf[channel * chunk + i], expected[channel * len + pos + i]);
+                }
+            }
+            pos += chunk;
+        }
+        // after reset output is the same as for a new detector
+        detector.reset ();
+    }
+}
@@ -0,0 +1,161 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "brainflow_constants.h"
+#include "downsample_operators.h"
+#include "resampler.h"
+
+using namespace testing;
+
+
+static std::vector<double> generate_sine (int len, int sampling_rate, double freq)
+{
+    std::vector<double> signal (len);
+    for (int i = 0; i < len; i++)
+    {
+        signal[i] = sin (2 * M_PI * freq * i / sampling_rate);
+    }
+    return signal;
+}
+
+// max abs difference with expected sine, edges are skipped because signal is zero outside
+static double max_error (const std::vector<double> &data, int sampling_rate, double freq, int skip)
+{
+    double error = 0.0;
+    for (int i = skip; i < (int)data.size () - skip; i++)
+    {
+        error = std::max (error, fabs (data[i] - sin (2 * M_PI * freq * i / sampling_rate)));
+    }
+    return error;
+}
+
+TEST (ResamplerTest, GetResamplingFactors_Rates_Reduced)
+{
+    int up = 0;
+    int down = 0;
+    EXPECT_EQ (get_resampling_factors (1000, 250, &up, &down), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (up, 1);
+    EXPECT_EQ (down, 4);
+    EXPECT_EQ (get_resampling_factors (64, 250, &up, &down), (int)BrainFlowExitCodes::STATUS_OK);
+    EXPECT_EQ (up, 125);
+    EXPECT_EQ (down, 32);
+    EXPECT_EQ (get_resampling_factors (1009, 1013, &up, &down),
+        (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    EXPECT_EQ (get_resampling_factors (0, 250, &up, &down),
+        (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    EXPECT_EQ (get_resampled_len (1000, 1, 4), 250);
+    EXPECT_EQ (get_resampled_len (1001, 1, 4), 251);
+    EXPECT_EQ (PolyphaseFilterCache::get_filter (1, 4), PolyphaseFilterCache::get_filter (1, 4));
+}
+
+TEST (ResamplerTest, Resample_Sine_SameAsContinuousSignal)
+{
+    int rates[][2] = {{1000, 250}, {250, 1000}, {64, 250}, {250, 64}, {200, 300}};
+    for (auto &rate : rates)
+    {
+        int up = 0;
+        int down = 0;
+        ASSERT_EQ (get_resampling_factors (rate[0], rate[1], &up, &down),
+            (int)BrainFlowExitCodes::STATUS_OK);
+        std::shared_ptr<const PolyphaseFilter> filter = PolyphaseFilterCache::get_filter (up, down);
+        ASSERT_TRUE ((bool)filter);
+        // low frequency is kept without delay
+        std::vector<double> data = generate_sine (rate[0] * 4, rate[0], 3.0);
+        std::vector<double> output (get_resampled_len ((int)data.size (), up, down));
+        resample (*filter, data.data (), (int)data.size (), output.data ());
+        EXPECT_LT (max_error (output, rate[1], 3.0, rate[1]), 0.01)
+            << rate[0] << " -> " << rate[1];
+    }
+}
+
+TEST (ResamplerTest, Resample_AboveNewNyquist_Attenuated)
+{
+    std::shared_ptr<const PolyphaseFilter> filter = PolyphaseFilterCache::get_filter (1, 4);
+    std::vector<double> data = generate_sine (4000, 1000, 200.0);
+    std::vector<double> output (get_resampled_len ((int)data.size (), 1, 4));
+    resample (*filter, data.data (), (int)data.size (), output.data ());
+    // without anti-aliasing it would be a sine with 50 Hz and amplitude 1
+    for (size_t i = 100; i < output.size () - 100; i++)
+    {
+        EXPECT_LT (fabs (output[i]), 0.01);
+    }
+}
+
+TEST (StreamingResamplerTest, Process_Chunks_SameAsDelayedOneShot)
+{
+    int up = 0;
+    int down = 0;
+    ASSERT_EQ (get_resampling_factors (250, 64, &up, &down), (int)BrainFlowExitCodes::STATUS_OK);
+    std::shared_ptr<const PolyphaseFilter> filter = PolyphaseFilterCache::get_filter (up, down);
+    int len = 3000;
+    int num_channels = 2;
+    srand (3);
+    std::vector<double> data (len * num_channels);
+    for (double &value : data)
+    {
+        value = (double)rand () / RAND_MAX - 0.5;
+    }
+    std::vector<std::vector<double>> expected (num_channels);
+    for (int channel = 0; channel < num_channels; channel++)
+    {
+        expected[channel].resize (get_resampled_len (len, up, down));
+        resample (*filter, data.data () + channel * len, len, expected[channel].data ());
+    }
+
+    StreamingResampler resampler (filter, num_channels);
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        std::vector<std::vector<double>> streamed (num_channels);
+        int chunk_sizes[] = {1, 5, 33, 250};
+        int pos = 0;
+        int chunk_id = 0;
+        while (pos < len)
+        {
+            int chunk = std::min (chunk_sizes[chunk_id++ % 4], len - pos);
+            std::vector<double> buf (chunk * num_channels);
+            for (int channel = 0; channel < num_channels; channel++)
+            {
+                std::copy (data.begin () + channel * len + pos,
+                    data.begin () + channel * len + pos + chunk, buf.begin () + channel * chunk);
+            }
+            std::vector<double> out (num_channels * resampler.get_max_output_len (chunk));
+            int count = resampler.process (buf.data (), chunk, out.data ());
+            ASSERT_LE (count, resampler.get_max_output_len (chunk));
+            for (int channel = 0; channel < num_channels; channel++)
+            {
+                streamed[channel].insert (streamed[channel].end (),
+                    out.begin () + channel * count, out.begin () + (channel + 1) * count);
+            }
+            pos += chunk;
+        }
+        for (int channel = 0; channel < num_channels; channel++)
+        {
+            ASSERT_EQ (streamed[channel].size (), expected[channel].size ());
+            for (size_t i = filter->delay; i < streamed[channel].size (); i++)
+            {
+                ASSERT_EQ (streamed[channel][i], expected[channel][i - filter->delay]);
+            }
+        }
+        resampler.reset ();
+    }
+}
+
+TEST (DownsampleOperatorsTest, Median_OddLen_SameAsSort)
+{
+    srand (5);
+    for (int len = 1; len < 50; len += 2)
+    {
+        std::vector<double> data (len);
+        for (double &value : data)
+        {
+            value = rand () % 10;
+        }
+        std::vector<double> sorted (data);
+        std::sort (sorted.begin (), sorted.end ());
+        EXPECT_EQ (downsample_median (data.data (), len), sorted[len / 2]);
+    }
+}
@@ -0,0 +1,159 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "brainflow_constants.h"
+#include "rolling_filter.h"
+
+using namespace testing;
+
+
+// small integer range to have many equal values in windows
+static std::vector<double> generate_signal (int len, int max_value)
+{
+    srand (42);
+    std::vector<double> signal (len);
+    for (int i = 0; i < len; i++)
+    {
+        signal[i] = (double)(rand () % max_value) - max_value / 2;
+    }
+    return signal;
+}
+
+static std::vector<double> get_window (const std::vector<double> &data, int end, int period)
+{
+    int start = std::max (0, end - period + 1);
+    return std::vector<double> (data.begin () + start, data.begin () + end + 1);
+}
+
+// previous implementation: sorted window, last value is returned until window is full
+static std::vector<double> naive_median (const std::vector<double> &data, int period)
+{
+    std::vector<double> res (data.size ());
+    for (int i = 0; i < (int)data.size (); i++)
+    {
+        std::vector<double> window = get_window (data, i, period);
+        if ((int)window.size () < period)
+        {
+            res[i] = data[i];
+            continue;
+        }
+        std::sort (window.begin (), window.end ());
+        int idx = (period - 1) / 2;
+        res[i] = (window[idx] + window[idx + (int)((period & 1) == 0)]) / 2.0;
+    }
+    return res;
+}
+
+TEST (RollingFilterTest, Median_RandomData_SameAsSortedWindow)
+{
+    std::vector<double> data = generate_signal (2000, 10);
+    int periods[] = {1, 2, 3, 4, 5, 8, 25, 100};
+    for (int period : periods)
+    {
+        std::vector<double> expected = naive_median (data, period);
+        std::vector<double> actual = data;
+        RollingMedian<double> filter (period);
+        apply_rolling_filter (filter, actual.data (), (int)actual.size ());
+        for (size_t i = 0; i < data.size (); i++)
+        {
+            ASSERT_EQ (actual[i], expected[i]) << "period " << period << " index " << i;
+        }
+    }
+}
+
+TEST (RollingFilterTest, Statistics_RandomData_SameAsWindow)
+{
+    std::vector<double> data = generate_signal (1000, 1000);
+    int periods[] = {1, 2, 7, 50};
+    for (int period : periods)
+    {
+        RollingMean<double> mean (period);
+        RollingVariance<double> variance (period);
+        RollingMin<double> min (period);
+        RollingMax<double> max (period);
+        for (int i = 0; i < (int)data.size (); i++)
+        {
+            std::vector<double> window = get_window (data, i, period);
+            double sum = 0;
+            for (double v : window)
+            {
+                sum += v;
+            }
+            double expected_mean = sum / window.size ();
+            double expected_variance = 0;
+            for (double v : window)
+            {
+                expected_variance += (v - expected_mean) * (v - expected_mean);
+            }
+            expected_variance /= window.size ();
+            EXPECT_NEAR (mean.process (data[i]), expected_mean, 1e-9);
+            EXPECT_NEAR (variance.process (data[i]), expected_variance, 1e-6);
+            EXPECT_NEAR (variance.get_mean (), expected_mean, 1e-9);
+            EXPECT_EQ (min.process (data[i]), *std::min_element (window.begin (), window.end ()));
+            EXPECT_EQ (max.process (data[i]), *std::max_element (window.begin (), window.end ()));
+        }
+    }
+}
+
+TEST (StreamingRollingFilterTest, Process_Chunks_SameAsWholeSignal)
+{
+    int len = 500;
+    int num_channels = 2;
+    int aggs[] = {(int)AggOperations::MEAN, (int)AggOperations::MEDIAN};
+    for (int agg : aggs)
+    {
+        std::vector<double> reference = generate_signal (len * num_channels, 20);
+        std::vector<double> data = reference;
+        for (int channel = 0; channel < num_channels; channel++)
+        {
+            double *row = reference.data () + channel * len;
+            if (agg == (int)AggOperations::MEDIAN)
+            {
+                RollingMedian<double> filter (10);
+                apply_rolling_filter (filter, row, len);
+            }
+            else
+            {
+                RollingMean<double> filter (10);
+                apply_rolling_filter (filter, row, len);
+            }
+        }
+
+        StreamingRollingFilter filter (10, agg, num_channels);
+        int chunk_sizes[] = {1, 3, 17, 100};
+        int pos = 0;
+        int chunk_id = 0;
+        while (pos < len)
+        {
+            int chunk = std::min (chunk_sizes[chunk_id++ % 4], len - pos);
+            std::vector<double> buf (chunk * num_channels);
+            for (int channel = 0; channel < num_channels; channel++)
+            {
+                std::copy (data.begin () + channel * len + pos,
+                    data.begin () + channel * len + pos + chunk, buf.begin () + channel * chunk);
+            }
+            filter.process (buf.data (), chunk);
+            for (int channel = 0; channel < num_channels; channel++)
+            {
+                for (int i = 0; i < chunk; i++)
+                {
+                    ASSERT_EQ (buf[channel * chunk + i], reference[channel * len + pos + i]);
+                }
+            }
+            pos += chunk;
+        }
+
+        // after reset output is the same as for a new filter
+        filter.reset ();
+        std::vector<double> buf (data.begin (), data.begin () + len * num_channels);
+        filter.process (buf.data (), len);
+        for (int i = 0; i < len * num_channels; i++)
+        {
+            ASSERT_EQ (buf[i], reference[i]);
+        }
+    }
+}
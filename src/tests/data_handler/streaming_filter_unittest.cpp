@@ -0,0 +1,267 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <math.h>
+#include <vector>
+
+#include "brainflow_constants.h"
+#include "streaming_filter.h"
+
+#include "DspFilters/Dsp.h"
+
+using namespace testing;
+
+
+static std::vector<double> generate_signal (int len, int sampling_rate)
+{
+    std::vector<double> signal (len);
+    for (int i = 0; i < len; i++)
+    {
+        double t = (double)i / sampling_rate;
+        signal[i] = sin (2 * M_PI * 5.0 * t) + 0.5 * sin (2 * M_PI * 50.0 * t) + 0.1 * (i % 7);
+    }
+    return signal;
+}
+
+TEST (StreamingFilterTest, Process_Chunks_SameAsDspFilters)
+{
+    int sampling_rate = 250;
+    int len = 1000;
+    std::vector<double> reference = generate_signal (len, sampling_rate);
+    // the same way as perform_bandpass uses DSPFilters
+    Dsp::Filter *f =
+        new Dsp::FilterDesign<Dsp::Butterworth::Design::BandPass<MAX_FILTER_ORDER>, 1> ();
+    Dsp::Params params;
+    params[0] = sampling_rate;
+    params[1] = 4;
+    params[2] = 15.0;
+    params[3] = 20.0;
+    f->setParams (params);
+    double *ref_ptr = reference.data ();
+    f->process (len, &ref_ptr);
+    delete f;
+
+    std::vector<struct BiquadCoeffs> stages;
+    ASSERT_EQ ((int)BrainFlowExitCodes::STATUS_OK,
+        design_biquads ((int)FilterOperations::BANDPASS, sampling_rate, 5.0, 25.0, 4,
+            (int)FilterTypes::BUTTERWORTH, 0.0, stages));
+    StreamingFilter filter (stages, 1);
+    std::vector<double> signal = generate_signal (len, sampling_rate);
+    int chunk_sizes[] = {1, 7, 32, 100, 13};
+    int pos = 0;
+    for (int i = 0; pos < len; i++)
+    {
+        int chunk = std::min (chunk_sizes[i % 5], len - pos);
+        filter.process (signal.data () + pos, chunk);
+        pos += chunk;
+    }
+    for (int i = 0; i < len; i++)
+    {
+        EXPECT_EQ (signal[i], reference[i]) << i;
+    }
+}
+
+// max abs value of the second half of filtered sine
+static double get_filtered_amplitude (
+    std::vector<struct BiquadCoeffs> &stages, int sampling_rate, double freq)
+{
+    int len = sampling_rate * 8;
+    std::vector<double> signal (len);
+    for (int i = 0; i < len; i++)
+    {
+        signal[i] = sin (2 * M_PI * freq * i / sampling_rate);
+    }
+    StreamingFilter filter (stages, 1);
+    filter.process (signal.data (), len);
+    double amplitude = 0.0;
+    for (int i = len / 2; i < len; i++)
+    {
+        amplitude = std::max (amplitude, fabs (signal[i]));
+    }
+    return amplitude;
+}
+
+// perform_bandpass and perform_bandstop pass band width in params[3] and ripple in params[4]
+TEST (StreamingFilterTest, Process_ChebyshevBand_SameAsDspFiltersWithRipple)
+{
+    int sampling_rate = 250;
+    int len = 1000;
+    double ripple = 1.0;
+    for (int operation : {(int)FilterOperations::BANDPASS, (int)FilterOperations::BANDSTOP})
+    {
+        std::vector<double> reference = generate_signal (len, sampling_rate);
+        Dsp::Filter *f = NULL;
+        if (operation == (int)FilterOperations::BANDPASS)
+        {
+            f = new Dsp::FilterDesign<Dsp::ChebyshevI::Design::BandPass<MAX_FILTER_ORDER>, 1> ();
+        }
+        else
+        {
+            f = new Dsp::FilterDesign<Dsp::ChebyshevI::Design::BandStop<MAX_FILTER_ORDER>, 1> ();
+        }
+        Dsp::Params params;
+        params[0] = sampling_rate;
+        params[1] = 4;
+        params[2] = 15.0;
+        params[3] = 20.0;
+        params[4] = ripple;
+        f->setParams (params);
+        double *ref_ptr = reference.data ();
+        f->process (len, &ref_ptr);
+        delete f;
+
+        std::vector<struct BiquadCoeffs> stages;
+        ASSERT_EQ ((int)BrainFlowExitCodes::STATUS_OK,
+            design_biquads (operation, sampling_rate, 5.0, 25.0, 4,
+                (int)FilterTypes::CHEBYSHEV_TYPE_1, ripple, stages));
+        std::vector<double> signal = generate_signal (len, sampling_rate);
+        StreamingFilter filter (stages, 1);
+        for (int pos = 0; pos < len; pos += 50)
+        {
+            filter.process (signal.data () + pos, 50);
+        }
+        for (int i = 0; i < len; i++)
+        {
+            ASSERT_EQ (signal[i], reference[i]) << operation << " " << i;
+        }
+
+        // gain in pass band is within ripple, 5-25 Hz is the band
+        double in_band = get_filtered_amplitude (stages, sampling_rate, 15.0);
+        double out_of_band = get_filtered_amplitude (stages, sampling_rate, 60.0);
+        double min_gain = pow (10.0, -ripple / 20.0) - 0.01;
+        if (operation == (int)FilterOperations::BANDPASS)
+        {
+            EXPECT_GT (in_band, min_gain);
+            EXPECT_LT (in_band, 1.01);
+            EXPECT_LT (out_of_band, 0.01);
+        }
+        else
+        {
+            EXPECT_LT (in_band, 0.01);
+            EXPECT_GT (out_of_band, min_gain);
+            EXPECT_LT (out_of_band, 1.01);
+        }
+    }
+}
+
+TEST (StreamingFilterTest, Process_MultipleChannels_IndependentState)
+{
+    int sampling_rate = 250;
+    int len = 200;
+    std::vector<struct BiquadCoeffs> stages;
+    ASSERT_EQ ((int)BrainFlowExitCodes::STATUS_OK,
+        design_biquads ((int)FilterOperations::LOWPASS, sampling_rate, 30.0, 0.0, 3,
+            (int)FilterTypes::CHEBYSHEV_TYPE_1, 0.5, stages));
+    std::vector<double> single = generate_signal (len, sampling_rate);
+    StreamingFilter single_filter (stages, 1);
+    single_filter.process (single.data (), len);
+
+    std::vector<double> data (len * 2);
+    std::vector<double> signal = generate_signal (len, sampling_rate);
+    StreamingFilter filter (stages, 2);
+    // two chunks, each with both channels as contiguous rows
+    int half = len / 2;
+    for (int chunk = 0; chunk < 2; chunk++)
+    {
+        std::vector<double> rows (half * 2);
+        for (int ch = 0; ch < 2; ch++)
+        {
+            std::copy (signal.begin () + chunk * half, signal.begin () + (chunk + 1) * half,
+                rows.begin () + ch * half);
+        }
+        filter.process (rows.data (), half);
+        for (int ch = 0; ch < 2; ch++)
+        {
+            std::copy (rows.begin () + ch * half, rows.begin () + (ch + 1) * half,
+                data.begin () + ch * len + chunk * half);
+        }
+    }
+    for (int i = 0; i < len; i++)
+    {
+        EXPECT_EQ (data[i], single[i]) << i;
+        EXPECT_EQ (data[len + i], single[i]) << i;
+    }
+
+    filter.reset ();
+    std::vector<double> again = generate_signal (len, sampling_rate);
+    again.insert (again.end (), again.begin (), again.end ());
+    filter.process (again.data (), len);
+    EXPECT_EQ (std::vector<double> (again.begin (), again.begin () + len), single);
+    EXPECT_EQ (std::vector<double> (again.begin () + len, again.end ()), single);
+}
+
+TEST (StreamingFilterTest, DesignBiquads_InvalidArguments)
+{
+    std::vector<struct BiquadCoeffs> stages;
+    EXPECT_EQ ((int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR,
+        design_biquads ((int)FilterOperations::LOWPASS, 250, 30.0, 0.0, MAX_FILTER_ORDER + 1,
+            (int)FilterTypes::BUTTERWORTH, 0.0, stages));
+    EXPECT_EQ ((int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR,
+        design_biquads ((int)FilterOperations::BANDSTOP, 250, 30.0, 20.0, 2,
+            (int)FilterTypes::BUTTERWORTH, 0.0, stages));
+    EXPECT_EQ ((int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR,
+        design_biquads (10, 250, 30.0, 0.0, 2, (int)FilterTypes::BUTTERWORTH, 0.0, stages));
+}
+
+TEST (StreamingFilterTest, ProcessRows_SelectedChannels_SameAsSingleChannel)
+{
+    int sampling_rate = 250;
+    int rows = 12;
+    int cols = 500;
+    // odd number of channels to cover both SIMD groups and scalar tail
+    int channels[] = {1, 3, 4, 5, 7, 8, 10};
+    int num_channels = 7;
+    std::vector<struct BiquadCoeffs> stages;
+    ASSERT_EQ ((int)BrainFlowExitCodes::STATUS_OK,
+        design_biquads ((int)FilterOperations::BANDSTOP, sampling_rate, 48.0, 52.0, 4,
+            (int)FilterTypes::BUTTERWORTH, 0.0, stages));
+    std::vector<double> data (rows * cols);
+    for (int i = 0; i < rows; i++)
+    {
+        std::vector<double> row = generate_signal (cols, sampling_rate + i * 10);
+        std::copy (row.begin (), row.end (), data.begin () + i * cols);
+    }
+    std::vector<double> expected = data;
+    for (int i = 0; i < num_channels; i++)
+    {
+        StreamingFilter single (stages, 1);
+        single.process (expected.data () + channels[i] * cols, cols / 2);
+        single.process (expected.data () + channels[i] * cols + cols / 2, cols - cols / 2);
+    }
+
+    // whole rows in one call
+    StreamingFilter filter (stages, num_channels);
+    filter.process_rows (data.data (), cols, channels);
+    // the same rows split in two blocks, state is kept between calls
+    filter.reset ();
+    std::vector<double> chunked (rows * cols);
+    for (int i = 0; i < rows; i++)
+    {
+        std::vector<double> row = generate_signal (cols, sampling_rate + i * 10);
+        std::copy (row.begin (), row.end (), chunked.begin () + i * cols);
+    }
+    std::vector<double> first (rows * (cols / 2));
+    std::vector<double> last (rows * (cols - cols / 2));
+    for (int i = 0; i < rows; i++)
+    {
+        std::copy (chunked.begin () + i * cols, chunked.begin () + i * cols + cols / 2,
+            first.begin () + i * (cols / 2));
+        std::copy (chunked.begin () + i * cols + cols / 2, chunked.begin () + (i + 1) * cols,
+            last.begin () + i * (cols - cols / 2));
+    }
+    filter.process_rows (first.data (), cols / 2, channels);
+    filter.process_rows (last.data (), cols - cols / 2, channels);
+    for (int i = 0; i < rows; i++)
+    {
+        std::copy (first.begin () + i * (cols / 2), first.begin () + (i + 1) * (cols / 2),
+            chunked.begin () + i * cols);
+        std::copy (last.begin () + i * (cols - cols / 2),
+            last.begin () + (i + 1) * (cols - cols / 2), chunked.begin () + i * cols + cols / 2);
+    }
+
+    for (int i = 0; i < rows * cols; i++)
+    {
+        EXPECT_EQ (data[i], expected[i]) << i;
+        EXPECT_EQ (chunked[i], expected[i]) << i;
+    }
+}
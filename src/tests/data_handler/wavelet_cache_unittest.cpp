@@ -0,0 +1,120 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "brainflow_constants.h"
+#include "wavelet_cache.h"
+#include "wavelet_helpers.h"
+
+#include "wauxlib.h"
+
+using namespace testing;
+
+
+static std::vector<double> generate_signal (int len)
+{
+    srand (11);
+    std::vector<double> signal (len);
+    for (int i = 0; i < len; i++)
+    {
+        signal[i] = sin (i * 0.03) + 0.3 * ((double)rand () / RAND_MAX - 0.5);
+    }
+    return signal;
+}
+
+TEST (WaveletCacheTest, AcquireContext_SameParams_Reused)
+{
+    WaveletCache::clear ();
+    WaveletContext *context = WaveletCache::acquire_context (
+        (int)WaveletTypes::DB4, 500, 3, (int)WaveletExtensionTypes::SYMMETRIC);
+    ASSERT_NE (context, (WaveletContext *)NULL);
+    WaveletContext *another = WaveletCache::acquire_context (
+        (int)WaveletTypes::DB4, 500, 3, (int)WaveletExtensionTypes::SYMMETRIC);
+    // context is used exclusively until release
+    EXPECT_NE (context, another);
+    WaveletCache::release_context (another);
+    WaveletCache::release_context (context);
+    EXPECT_EQ (WaveletCache::acquire_context (
+                   (int)WaveletTypes::DB4, 500, 3, (int)WaveletExtensionTypes::SYMMETRIC),
+        context);
+    WaveletCache::release_context (context);
+
+    EXPECT_EQ (WaveletCache::acquire_context (-1, 500, 3, (int)WaveletExtensionTypes::SYMMETRIC),
+        (WaveletContext *)NULL);
+    EXPECT_EQ (WaveletCache::acquire_context (
+                   (int)WaveletTypes::DB4, 10, 5, (int)WaveletExtensionTypes::SYMMETRIC),
+        (WaveletContext *)NULL);
+}
+
+TEST (WaveletCacheTest, Denoise_CachedContext_SameAsWavelib)
+{
+    int len = 1000;
+    int level = 4;
+    std::vector<double> data = generate_signal (len);
+    const char *methods[] = {"visushrink", "sureshrink"};
+    int extensions[] = {
+        (int)WaveletExtensionTypes::SYMMETRIC, (int)WaveletExtensionTypes::PERIODIC};
+    int wavelets[] = {(int)WaveletTypes::DB4, (int)WaveletTypes::SYM8, (int)WaveletTypes::COIF3};
+    for (const char *method : methods)
+    {
+        for (int extension : extensions)
+        {
+            for (int wavelet : wavelets)
+            {
+                std::vector<double> expected (len);
+                denoise_object obj = denoise_init (len, level, get_wavelet_name (wavelet));
+                setDenoiseMethod (obj, method);
+                setDenoiseWTMethod (obj, "dwt");
+                setDenoiseWTExtension (obj, get_extension_type (extension));
+                setDenoiseParameters (obj, "soft", "all");
+                denoise (obj, data.data (), expected.data ());
+                denoise_free (obj);
+
+                // the second run checks that state from the first one doesnt affect results
+                for (int run = 0; run < 2; run++)
+                {
+                    WaveletContextGuard guard (wavelet, len, level, extension);
+                    ASSERT_NE (guard.get (), (WaveletContext *)NULL);
+                    std::vector<double> actual (len);
+                    if (strcmp (method, "visushrink") == 0)
+                    {
+                        visushrink_wt (
+                            guard.get ()->get_wt (), data.data (), "soft", "all", actual.data ());
+                    }
+                    else
+                    {
+                        sureshrink_wt (
+                            guard.get ()->get_wt (), data.data (), "soft", "all", actual.data ());
+                    }
+                    for (int i = 0; i < len; i++)
+                    {
+                        ASSERT_EQ (actual[i], expected[i]) << method << " " << wavelet;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST (WaveletCacheTest, Dwt_CachedContext_InverseRestoresSignal)
+{
+    int len = 777;
+    std::vector<double> data = generate_signal (len);
+    for (int run = 0; run < 2; run++)
+    {
+        WaveletContextGuard guard (
+            (int)WaveletTypes::DB3, len, 3, (int)WaveletExtensionTypes::SYMMETRIC);
+        ASSERT_NE (guard.get (), (WaveletContext *)NULL);
+        wt_object wt = guard.get ()->get_wt ();
+        dwt (wt, data.data ());
+        std::vector<double> restored (len);
+        idwt (wt, restored.data ());
+        for (int i = 0; i < len; i++)
+        {
+            EXPECT_NEAR (restored[i], data[i], 1e-9);
+        }
+    }
+}
@@ -0,0 +1,163 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "binary_file.h"
+
+using namespace testing;
+
+
+static std::string get_test_file (const char *name)
+{
+    std::string file_name = std::string ("binary_file_unittest_") + name + ".bin";
+    remove (file_name.c_str ());
+    return file_name;
+}
+
+// sample i, row j has value i * 10 + j
+static std::vector<double> make_samples (int first, int count, int num_rows)
+{
+    std::vector<double> samples ((size_t)count * num_rows);
+    for (int i = 0; i < count; i++)
+    {
+        for (int j = 0; j < num_rows; j++)
+        {
+            samples[(size_t)i * num_rows + j] = (first + i) * 10.0 + j;
+        }
+    }
+    return samples;
+}
+
+TEST (BinaryFileTest, WriteSamples_ReadRows_ReturnSameData)
+{
+    std::string file_name = get_test_file ("rows");
+    int num_rows = 3;
+    int count = BINARY_FILE_BLOCK_SIZE * 2 + 17;
+    std::vector<double> samples = make_samples (0, count, num_rows);
+
+    BinaryFileWriter writer (file_name.c_str (), "wb", num_rows, -1, 0, 250);
+    ASSERT_EQ (writer.open (), (int)BinaryFileReturnCodes::STATUS_OK);
+    EXPECT_EQ (writer.write_samples (samples.data (), count),
+        (int)BinaryFileReturnCodes::STATUS_OK);
+    EXPECT_EQ (writer.close (), (int)BinaryFileReturnCodes::STATUS_OK);
+
+    EXPECT_TRUE (is_binary_file (file_name.c_str ()));
+    BinaryFileReader reader (file_name.c_str ());
+    ASSERT_EQ (reader.open (), (int)BinaryFileReturnCodes::STATUS_OK);
+    EXPECT_EQ (reader.get_total_samples (), count);
+    EXPECT_EQ (reader.get_index ().size (), 3u);
+    EXPECT_EQ (reader.get_header ().board_id, -1);
+    EXPECT_EQ (reader.get_header ().sampling_rate, 250);
+
+    // range crosses block boundary
+    int first = BINARY_FILE_BLOCK_SIZE - 5;
+    int len = 20;
+    std::vector<double> rows ((size_t)num_rows * len);
+    EXPECT_EQ (
+        reader.read_rows (first, len, rows.data (), len), (int)BinaryFileReturnCodes::STATUS_OK);
+    for (int j = 0; j < num_rows; j++)
+    {
+        for (int i = 0; i < len; i++)
+        {
+            EXPECT_EQ (rows[j * len + i], (first + i) * 10.0 + j);
+        }
+    }
+    EXPECT_EQ (reader.read_rows (count - 1, 2, rows.data (), 2),
+        (int)BinaryFileReturnCodes::INVALID_ARGUMENTS_ERROR);
+    remove (file_name.c_str ());
+}
+
+TEST (BinaryFileTest, WriteRows_Float32_ReadSamples_ReturnSameData)
+{
+    std::string file_name = get_test_file ("f32");
+    int num_rows = 2;
+    int count = 100;
+    std::vector<double> rows ((size_t)num_rows * count);
+    for (int j = 0; j < num_rows; j++)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            rows[j * count + i] = i * 10.0 + j;
+        }
+    }
+
+    BinaryFileWriter writer (file_name.c_str (), "wb_f32", num_rows, -1, 0, 0);
+    ASSERT_EQ (writer.open (), (int)BinaryFileReturnCodes::STATUS_OK);
+    EXPECT_EQ (writer.write_rows (rows.data (), count), (int)BinaryFileReturnCodes::STATUS_OK);
+    EXPECT_EQ (writer.close (), (int)BinaryFileReturnCodes::STATUS_OK);
+
+    BinaryFileReader reader (file_name.c_str ());
+    ASSERT_EQ (reader.open (), (int)BinaryFileReturnCodes::STATUS_OK);
+    EXPECT_EQ (reader.get_header ().value_type, (int32_t)BinaryValueTypes::FLOAT32);
+    std::vector<double> samples ((size_t)num_rows * count);
+    EXPECT_EQ (
+        reader.read_samples (0, count, samples.data ()), (int)BinaryFileReturnCodes::STATUS_OK);
+    EXPECT_THAT (samples, ElementsAreArray (make_samples (0, count, num_rows)));
+    remove (file_name.c_str ());
+}
+
+TEST (BinaryFileTest, AppendMode_ExistingFile_ContinueIndex)
+{
+    std::string file_name = get_test_file ("append");
+    int num_rows = 2;
+    std::vector<double> first = make_samples (0, 10, num_rows);
+    std::vector<double> second = make_samples (10, BINARY_FILE_BLOCK_SIZE, num_rows);
+    {
+        BinaryFileWriter writer (file_name.c_str (), "ab", num_rows, -1, 0, 0);
+        ASSERT_EQ (writer.open (), (int)BinaryFileReturnCodes::STATUS_OK);
+        writer.write_samples (first.data (), 10);
+    }
+    {
+        BinaryFileWriter writer (file_name.c_str (), "ab", num_rows, -1, 0, 0);
+        ASSERT_EQ (writer.open (), (int)BinaryFileReturnCodes::STATUS_OK);
+        writer.write_samples (second.data (), BINARY_FILE_BLOCK_SIZE);
+    }
+    BinaryFileWriter wrong_rows (file_name.c_str (), "ab", num_rows + 1, -1, 0, 0);
+    EXPECT_EQ (wrong_rows.open (), (int)BinaryFileReturnCodes::INVALID_FORMAT_ERROR);
+
+    BinaryFileReader reader (file_name.c_str ());
+    ASSERT_EQ (reader.open (), (int)BinaryFileReturnCodes::STATUS_OK);
+    EXPECT_EQ (reader.get_total_samples (), 10 + BINARY_FILE_BLOCK_SIZE);
+    std::vector<double> samples ((size_t)num_rows * (10 + BINARY_FILE_BLOCK_SIZE));
+    EXPECT_EQ (reader.read_samples (0, 10 + BINARY_FILE_BLOCK_SIZE, samples.data ()),
+        (int)BinaryFileReturnCodes::STATUS_OK);
+    EXPECT_THAT (samples, ElementsAreArray (make_samples (0, 10 + BINARY_FILE_BLOCK_SIZE, 2)));
+    remove (file_name.c_str ());
+}
+
+TEST (BinaryFileTest, MissingIndex_RebuildIndexFromBlocks)
+{
+    std::string file_name = get_test_file ("no_index");
+    int num_rows = 1;
+    int count = BINARY_FILE_BLOCK_SIZE + 1;
+    std::vector<double> samples = make_samples (0, count, num_rows);
+    BinaryFileWriter writer (file_name.c_str (), "wb", num_rows, -1, 0, 0);
+    ASSERT_EQ (writer.open (), (int)BinaryFileReturnCodes::STATUS_OK);
+    writer.write_samples (samples.data (), count);
+    writer.close ();
+
+    // cut footer and part of index, like if recording was interrupted
+    FILE *fp = fopen (file_name.c_str (), "rb");
+    ASSERT_TRUE (fp != NULL);
+    std::vector<char> content;
+    char buf[4096];
+    size_t read_bytes = 0;
+    while ((read_bytes = fread (buf, 1, sizeof (buf), fp)) > 0)
+    {
+        content.insert (content.end (), buf, buf + read_bytes);
+    }
+    fclose (fp);
+    fp = fopen (file_name.c_str (), "wb");
+    fwrite (content.data (), 1, content.size () - 10, fp);
+    fclose (fp);
+
+    BinaryFileReader reader (file_name.c_str ());
+    ASSERT_EQ (reader.open (), (int)BinaryFileReturnCodes::STATUS_OK);
+    EXPECT_EQ (reader.get_total_samples (), count);
+    double value = 0;
+    EXPECT_EQ (reader.read_samples (count - 1, 1, &value), (int)BinaryFileReturnCodes::STATUS_OK);
+    EXPECT_EQ (value, (count - 1) * 10.0);
+    remove (file_name.c_str ());
+}
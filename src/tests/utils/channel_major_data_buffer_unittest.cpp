@@ -0,0 +1,158 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <vector>
+
+#include "base_data_buffer.h"
+#include "channel_major_data_buffer.h"
+#include "data_buffer.h"
+
+using namespace testing;
+
+
+static void add_samples (BaseDataBuffer &buffer, int num_values, int from, int to)
+{
+    std::vector<double> values (num_values);
+    for (int i = from; i < to; i++)
+    {
+        for (int j = 0; j < num_values; j++)
+        {
+            values[j] = i * 1000 + j;
+        }
+        buffer.add_data (values.data ());
+    }
+}
+
+TEST (ChannelMajorDataBufferTest, GetCurrentData_WrappedBuffer_SameAsInterleavedBuffer)
+{
+    ChannelMajorDataBuffer buffer (5, 8);
+    DataBuffer reference (5, 8);
+    add_samples (buffer, 5, 0, 13);
+    add_samples (reference, 5, 0, 13);
+
+    std::vector<double> retrieved (40);
+    std::vector<double> expected (40);
+    ASSERT_EQ (buffer.get_current_data (6, retrieved.data ()), 6);
+    ASSERT_EQ (reference.get_current_data (6, expected.data ()), 6);
+    EXPECT_EQ (retrieved, expected);
+
+    ASSERT_EQ (buffer.get_current_data_transposed (8, retrieved.data ()), 8);
+    ASSERT_EQ (reference.get_current_data_transposed (8, expected.data ()), 8);
+    EXPECT_EQ (retrieved, expected);
+    EXPECT_EQ (buffer.get_data_count (), 8);
+}
+
+TEST (ChannelMajorDataBufferTest, GetDataChannels_SelectedRows_RemoveWholeSamples)
+{
+    ChannelMajorDataBuffer buffer (5, 8);
+    add_samples (buffer, 5, 0, 11);
+
+    int channels[3] = {4, 0, 2};
+    double retrieved[5 * 8];
+    ASSERT_EQ (buffer.get_data_channels (4, channels, 3, retrieved), 4);
+    for (int r = 0; r < 3; r++)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            EXPECT_EQ (retrieved[r * 4 + i], (3 + i) * 1000 + channels[r]);
+        }
+    }
+    EXPECT_EQ (buffer.get_data_count (), 4);
+
+    // the rest of samples wraps around the end of ring
+    ASSERT_EQ (buffer.get_current_data_channels (10, channels, 3, retrieved), 4);
+    for (int r = 0; r < 3; r++)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            EXPECT_EQ (retrieved[r * 4 + i], (7 + i) * 1000 + channels[r]);
+        }
+    }
+    ASSERT_EQ (buffer.get_data (10, retrieved), 4);
+    EXPECT_EQ (retrieved[0], 7000);
+    EXPECT_EQ (retrieved[5], 8000);
+    EXPECT_EQ (buffer.get_data_count (), 0);
+}
+
+TEST (ChannelMajorDataBufferTest, GetDataChannels_InterleavedBuffers_ReturnSameRows)
+{
+    int channels[2] = {1, 3};
+    for (DataBufferTypes type : {DataBufferTypes::SPINLOCK, DataBufferTypes::LOCK_FREE})
+    {
+        BaseDataBuffer *buffer = BaseDataBuffer::create (4, 6, type);
+        add_samples (*buffer, 4, 0, 9);
+        double retrieved[2 * 6];
+        ASSERT_EQ (buffer->get_current_data_channels (6, channels, 2, retrieved), 6);
+        for (int i = 0; i < 6; i++)
+        {
+            EXPECT_EQ (retrieved[i], (3 + i) * 1000 + 1);
+            EXPECT_EQ (retrieved[6 + i], (3 + i) * 1000 + 3);
+        }
+        ASSERT_EQ (buffer->get_data_channels (2, channels + 1, 1, retrieved), 2);
+        EXPECT_EQ (retrieved[0], 3003);
+        EXPECT_EQ (retrieved[1], 4003);
+        EXPECT_EQ (buffer->get_data_count (), 4);
+        delete buffer;
+    }
+}
+
+TEST (ChannelMajorDataBufferTest, Create_ChannelMajorType_ReturnChannelMajorBuffer)
+{
+    DataBufferTypes type;
+    ASSERT_TRUE (BaseDataBuffer::type_from_string ("channel_major", type));
+    BaseDataBuffer *buffer = BaseDataBuffer::create (4, 16, type);
+    ASSERT_NE (buffer, nullptr);
+    EXPECT_NE (dynamic_cast<ChannelMajorDataBuffer *> (buffer), nullptr);
+    EXPECT_EQ (buffer->is_ready (), true);
+    delete buffer;
+
+    ChannelMajorDataBuffer empty (4, 0);
+    EXPECT_EQ (empty.is_ready (), false);
+}
+
+TEST (ChannelMajorDataBufferTest, AddData_Float32Precision_KeepFullPrecisionRows)
+{
+    std::vector<int> full_precision_rows {2};
+    ChannelMajorDataBuffer buffer (3, 4, DataBufferPrecision::FLOAT32, full_precision_rows);
+    ASSERT_EQ (buffer.is_ready (), true);
+    // 24 bit ADC value multiplied by scale, the same conversion as in galea boards
+    double exg_scale = 4.5 / 8388607.0 / 24.0 * 1000000.0;
+    double exg = 8388607 * exg_scale;
+    double timestamp = 1700000000.123456;
+    for (int i = 0; i < 6; i++)
+    {
+        double values[3] = {exg * (i - 3) / 3.0, 0.1 * i, timestamp + i};
+        buffer.add_data (values);
+    }
+
+    double retrieved[3 * 4];
+    int channels[3] = {0, 1, 2};
+    ASSERT_EQ (buffer.get_current_data_channels (4, channels, 3, retrieved), 4);
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ (retrieved[i], (double)(float)(exg * (i - 1) / 3.0));
+        EXPECT_NEAR (retrieved[i], exg * (i - 1) / 3.0, exg_scale);
+        EXPECT_EQ (retrieved[4 + i], (double)(float)(0.1 * (i + 2)));
+        EXPECT_EQ (retrieved[8 + i], timestamp + i + 2);
+    }
+
+    ASSERT_EQ (buffer.get_data (1, retrieved), 1);
+    EXPECT_EQ (retrieved[2], timestamp + 2);
+    EXPECT_EQ (buffer.get_data_count (), 3);
+}
+
+TEST (ChannelMajorDataBufferTest, Create_Float32ForInterleavedBuffer_ReturnNull)
+{
+    EXPECT_EQ (BaseDataBuffer::create (
+                   4, 16, DataBufferTypes::SPINLOCK, DataBufferPrecision::FLOAT32),
+        nullptr);
+    BaseDataBuffer *buffer = BaseDataBuffer::create (
+        4, 16, DataBufferTypes::CHANNEL_MAJOR, DataBufferPrecision::FLOAT32);
+    ASSERT_NE (buffer, nullptr);
+    EXPECT_EQ (buffer->is_ready (), true);
+    delete buffer;
+
+    DataBufferPrecision precision;
+    EXPECT_TRUE (BaseDataBuffer::precision_from_string ("float32", precision));
+    EXPECT_EQ (precision, DataBufferPrecision::FLOAT32);
+    EXPECT_FALSE (BaseDataBuffer::precision_from_string ("int8", precision));
+}
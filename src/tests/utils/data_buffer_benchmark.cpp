@@ -0,0 +1,107 @@
+// Contention benchmark for data buffers: one producer pushes samples as fast as possible while N
+// readers poll get_data_count and get_current_data_transposed like consumer threads of BoardShim
+// do.
+// Usage: data_buffer_benchmark [num_rows] [seconds]
+
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#include "base_data_buffer.h"
+
+
+struct BenchmarkResult
+{
+    double producer_rate;
+    double reader_rate;
+};
+
+static BenchmarkResult run_benchmark (
+    DataBufferTypes type, int num_rows, int num_readers, double seconds)
+{
+    BaseDataBuffer *buffer = BaseDataBuffer::create (num_rows, 45000, type);
+    std::atomic<bool> running (true);
+    std::atomic<long long> reader_ops (0);
+    long long produced = 0;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < num_readers; i++)
+    {
+        readers.push_back (std::thread (
+            [&] ()
+            {
+                std::vector<double> buf (250 * num_rows);
+                long long ops = 0;
+                while (running.load (std::memory_order_relaxed))
+                {
+                    if (buffer->get_data_count () > 0)
+                    {
+                        buffer->get_current_data_transposed (250, buf.data ());
+                    }
+                    ops++;
+                }
+                reader_ops += ops;
+            }));
+    }
+
+    std::vector<double> package (num_rows, 1.0);
+    auto start = std::chrono::high_resolution_clock::now ();
+    auto stop = start + std::chrono::duration<double> (seconds);
+    while (std::chrono::high_resolution_clock::now () < stop)
+    {
+        for (int i = 0; i < 1000; i++)
+        {
+            package[0] = (double)produced;
+            buffer->add_data (package.data ());
+            produced++;
+        }
+    }
+    double elapsed =
+        std::chrono::duration<double> (std::chrono::high_resolution_clock::now () - start)
+            .count ();
+    running = false;
+    for (auto &reader : readers)
+    {
+        reader.join ();
+    }
+    delete buffer;
+
+    BenchmarkResult result;
+    result.producer_rate = (double)produced / elapsed;
+    result.reader_rate = (double)reader_ops.load () / elapsed;
+    return result;
+}
+
+int main (int argc, char *argv[])
+{
+    int num_rows = (argc > 1) ? atoi (argv[1]) : 32;
+    double seconds = (argc > 2) ? atof (argv[2]) : 1.0;
+    int max_readers = (int)std::thread::hardware_concurrency ();
+    if (max_readers < 4)
+    {
+        max_readers = 4;
+    }
+
+    printf ("num_rows: %d, seconds per run: %.2lf\n", num_rows, seconds);
+    printf ("%-14s %-8s %-20s %-20s\n", "buffer", "readers", "samples/s", "reader polls/s");
+    for (int num_readers = 0; num_readers <= max_readers;
+         num_readers = (num_readers == 0) ? 1 : num_readers * 2)
+    {
+        BenchmarkResult spinlock =
+            run_benchmark (DataBufferTypes::SPINLOCK, num_rows, num_readers, seconds);
+        BenchmarkResult lock_free =
+            run_benchmark (DataBufferTypes::LOCK_FREE, num_rows, num_readers, seconds);
+        BenchmarkResult channel_major =
+            run_benchmark (DataBufferTypes::CHANNEL_MAJOR, num_rows, num_readers, seconds);
+        printf ("%-14s %-8d %-20.0lf %-20.0lf\n", "spinlock", num_readers,
+            spinlock.producer_rate, spinlock.reader_rate);
+        printf ("%-14s %-8d %-20.0lf %-20.0lf\n", "lock_free", num_readers,
+            lock_free.producer_rate, lock_free.reader_rate);
+        printf ("%-14s %-8d %-20.0lf %-20.0lf\n", "channel_major", num_readers,
+            channel_major.producer_rate, channel_major.reader_rate);
+    }
+    return 0;
+}
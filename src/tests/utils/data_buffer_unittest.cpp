@@ -4,7 +4,9 @@
 #include <gmock/gmock.h>
 #include <list>
 #include <thread>
+#include <vector>
 
+#include "base_data_buffer.h"
 #include "data_buffer.h"
 
 using namespace testing;
@@ -424,4 +426,86 @@ TEST (DataBufferTest, IsReady_BufferSizeIsZero_ReturnFalse)
 {
     DataBuffer buffer_zero (4, 0);
     EXPECT_EQ (buffer_zero.is_ready (), false);
-}
\ No newline at end of file
+}
+
+TEST (DataBufferTest, GetDataTransposed_WrappedBuffer_ReturnValuesAsRows)
+{
+    // more values and samples than transpose block to check tiles at the edges
+    const int num_values = 40;
+    DataBuffer buffer (num_values, 70);
+    std::vector<double> values (num_values);
+    for (int i = 0; i < 100; i++)
+    {
+        for (int j = 0; j < num_values; j++)
+        {
+            values[j] = i * 1000 + j;
+        }
+        buffer.add_data (values.data ());
+    }
+
+    std::vector<double> retrieved (num_values * 70);
+    ASSERT_EQ (buffer.get_current_data_transposed (50, retrieved.data ()), 50);
+    for (int j = 0; j < num_values; j++)
+    {
+        for (int i = 0; i < 50; i++)
+        {
+            ASSERT_EQ (retrieved[j * 50 + i], (50 + i) * 1000 + j);
+        }
+    }
+    EXPECT_EQ (buffer.get_data_count (), 70);
+
+    ASSERT_EQ (buffer.get_data_transposed (100, retrieved.data ()), 70);
+    for (int j = 0; j < num_values; j++)
+    {
+        for (int i = 0; i < 70; i++)
+        {
+            ASSERT_EQ (retrieved[j * 70 + i], (30 + i) * 1000 + j);
+        }
+    }
+    EXPECT_EQ (buffer.get_data_count (), 0);
+    EXPECT_EQ (buffer.get_data_transposed (1, retrieved.data ()), 0);
+}
+
+TEST (DataBufferTest, AddDataBlock_AllBufferTypes_SameAsAddData)
+{
+    const int num_values = 3;
+    const size_t buffer_size = 7;
+    // blocks wrap the ring, fill it exactly and exceed its size
+    const int block_sizes[] = {3, 5, 2, 9, 7, 1, 0, 4};
+    std::vector<double> block (num_values * 9);
+    for (DataBufferTypes type :
+        {DataBufferTypes::SPINLOCK, DataBufferTypes::LOCK_FREE, DataBufferTypes::CHANNEL_MAJOR})
+    {
+        BaseDataBuffer *expected = BaseDataBuffer::create (num_values, buffer_size, type);
+        BaseDataBuffer *buffer = BaseDataBuffer::create (num_values, buffer_size, type);
+        int sample = 0;
+        for (int block_size : block_sizes)
+        {
+            for (int i = 0; i < block_size; i++, sample++)
+            {
+                for (int j = 0; j < num_values; j++)
+                {
+                    block[i * num_values + j] = sample * 10 + j;
+                }
+                expected->add_data (&block[i * num_values]);
+            }
+            buffer->add_data_block (block.data (), block_size);
+
+            std::vector<double> expected_data (num_values * buffer_size);
+            std::vector<double> data (num_values * buffer_size);
+            ASSERT_EQ (buffer->get_current_data (buffer_size, data.data ()),
+                expected->get_current_data (buffer_size, expected_data.data ()));
+            EXPECT_EQ (data, expected_data);
+            struct DataBufferStats expected_stats;
+            struct DataBufferStats stats;
+            expected->get_stats (expected_stats);
+            buffer->get_stats (stats);
+            EXPECT_EQ (stats.overwritten, expected_stats.overwritten);
+        }
+        std::vector<double> data (num_values * buffer_size);
+        EXPECT_EQ (buffer->get_data (2, data.data ()), 2);
+        EXPECT_EQ (data[0], (sample - 7) * 10.0);
+        delete expected;
+        delete buffer;
+    }
+}
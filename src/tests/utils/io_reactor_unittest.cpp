@@ -0,0 +1,148 @@
+#include <atomic>
+#include <chrono>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <thread>
+#include <vector>
+
+#include "io_reactor.h"
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace testing;
+
+
+#ifdef __linux__
+
+// bound loopback udp socket, port is assigned by system
+static int create_udp_socket (int &port)
+{
+    int fd = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    struct sockaddr_in addr;
+    memset (&addr, 0, sizeof (addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    bind (fd, (const struct sockaddr *)&addr, sizeof (addr));
+    socklen_t len = sizeof (addr);
+    getsockname (fd, (struct sockaddr *)&addr, &len);
+    port = ntohs (addr.sin_port);
+    return fd;
+}
+
+static void send_datagram (int fd, int port, const void *data, int size)
+{
+    struct sockaddr_in addr;
+    memset (&addr, 0, sizeof (addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+    addr.sin_port = htons (port);
+    sendto (fd, data, size, 0, (const struct sockaddr *)&addr, sizeof (addr));
+}
+
+static bool wait_for (std::atomic<int> &value, int expected)
+{
+    for (int i = 0; (i < 200) && (value.load () < expected); i++)
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (10));
+    }
+    return value.load () >= expected;
+}
+
+TEST (IOReactorTest, AddSocket_ManySockets_AllDatagramsHandledInOrder)
+{
+    IOReactor reactor (2);
+    ASSERT_EQ (reactor.init (), (int)IOReactorReturnCodes::STATUS_OK);
+
+    const int num_sockets = 8;
+    const int num_datagrams = 100;
+    int sender = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    std::vector<int> fds (num_sockets);
+    std::vector<int> ports (num_sockets);
+    std::vector<std::vector<int>> received (num_sockets);
+    std::vector<std::atomic<int>> running (num_sockets);
+    std::atomic<int> num_received (0);
+    std::atomic<int> concurrent_calls (0);
+    for (int i = 0; i < num_sockets; i++)
+    {
+        running[i] = 0;
+        fds[i] = create_udp_socket (ports[i]);
+        ASSERT_EQ (reactor.add_socket (fds[i], 64,
+                       [&, i] (unsigned char *data, int size)
+                       {
+                           // handler of one socket is never called concurrently
+                           if (running[i].fetch_add (1) != 0)
+                           {
+                               concurrent_calls++;
+                           }
+                           int value = 0;
+                           memcpy (&value, data, sizeof (value));
+                           received[i].push_back ((size == sizeof (value)) ? value : -1);
+                           running[i]--;
+                           num_received++;
+                       }),
+            (int)IOReactorReturnCodes::STATUS_OK);
+    }
+    EXPECT_EQ (reactor.add_socket (fds[0], 64, [] (unsigned char *data, int size) {}),
+        (int)IOReactorReturnCodes::ALREADY_REGISTERED_ERROR);
+
+    for (int j = 0; j < num_datagrams; j++)
+    {
+        for (int i = 0; i < num_sockets; i++)
+        {
+            send_datagram (sender, ports[i], &j, sizeof (j));
+        }
+    }
+    EXPECT_TRUE (wait_for (num_received, num_sockets * num_datagrams));
+    for (int i = 0; i < num_sockets; i++)
+    {
+        EXPECT_EQ (reactor.remove_socket (fds[i]), (int)IOReactorReturnCodes::STATUS_OK);
+        ASSERT_EQ (received[i].size (), (size_t)num_datagrams);
+        for (int j = 0; j < num_datagrams; j++)
+        {
+            EXPECT_EQ (received[i][j], j);
+        }
+        close (fds[i]);
+    }
+    EXPECT_EQ (concurrent_calls.load (), 0);
+    close (sender);
+}
+
+TEST (IOReactorTest, RemoveSocket_DataAfterRemove_HandlerNotCalled)
+{
+    IOReactor reactor (1);
+    ASSERT_EQ (reactor.init (), (int)IOReactorReturnCodes::STATUS_OK);
+    int port = 0;
+    int fd = create_udp_socket (port);
+    int sender = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    std::atomic<int> num_received (0);
+    ASSERT_EQ (
+        reactor.add_socket (fd, 64, [&] (unsigned char *data, int size) { num_received++; }),
+        (int)IOReactorReturnCodes::STATUS_OK);
+    int value = 1;
+    send_datagram (sender, port, &value, sizeof (value));
+    EXPECT_TRUE (wait_for (num_received, 1));
+
+    EXPECT_EQ (reactor.remove_socket (fd), (int)IOReactorReturnCodes::STATUS_OK);
+    EXPECT_EQ (reactor.remove_socket (fd), (int)IOReactorReturnCodes::NOT_REGISTERED_ERROR);
+    send_datagram (sender, port, &value, sizeof (value));
+    std::this_thread::sleep_for (std::chrono::milliseconds (50));
+    EXPECT_EQ (num_received.load (), 1);
+    close (fd);
+    close (sender);
+}
+
+#else
+
+TEST (IOReactorTest, Init_NotLinux_NotSupported)
+{
+    IOReactor reactor (1);
+    EXPECT_FALSE (IOReactor::is_supported ());
+    EXPECT_EQ (reactor.init (), (int)IOReactorReturnCodes::NOT_SUPPORTED_ERROR);
+}
+
+#endif
@@ -0,0 +1,291 @@
+#include <atomic>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <thread>
+#include <vector>
+
+#include "base_data_buffer.h"
+#include "lock_free_data_buffer.h"
+
+using namespace testing;
+
+
+TEST (LockFreeDataBufferTest, AddData_AddLessDataThanBufferCapacity_StoreAllData)
+{
+    LockFreeDataBuffer buffer (4, 2);
+    double values[4] = {1.0, 2.0, 3.0, 4.0};
+    double retrieved[4];
+
+    buffer.add_data (values);
+    buffer.get_current_data (1, retrieved);
+
+    EXPECT_EQ (buffer.get_data_count (), 1);
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ (retrieved[i], values[i]);
+    }
+}
+
+TEST (LockFreeDataBufferTest, AddData_AddMoreDataThanBufferCapacity_OverwriteOldestData)
+{
+    LockFreeDataBuffer buffer (4, 2);
+    double first_values[4] = {1.0, 2.0, 3.0, 4.0};
+    double second_values[4] = {5.0, 6.0, 7.0, 8.0};
+    double third_values[4] = {9.0, 10.0, 11.0, 12.0};
+    double retrieved[8];
+
+    buffer.add_data (first_values);
+    buffer.add_data (second_values);
+    buffer.add_data (third_values);
+
+    EXPECT_EQ (buffer.get_data_count (), 2);
+
+    auto result = buffer.get_data (2, retrieved);
+    EXPECT_EQ (result, 2);
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ (retrieved[i], second_values[i]);
+        EXPECT_EQ (retrieved[i + 4], third_values[i]);
+    }
+}
+
+TEST (LockFreeDataBufferTest, AddData_BufferSizeIsNotPowerOfTwo_KeepBufferSizeSamples)
+{
+    LockFreeDataBuffer buffer (1, 3);
+    for (int i = 0; i < 10; i++)
+    {
+        double value = (double)i;
+        buffer.add_data (&value);
+    }
+
+    double retrieved[4];
+    auto result = buffer.get_data (4, retrieved);
+
+    EXPECT_EQ (result, 3);
+    EXPECT_EQ (retrieved[0], 7.0);
+    EXPECT_EQ (retrieved[1], 8.0);
+    EXPECT_EQ (retrieved[2], 9.0);
+}
+
+TEST (LockFreeDataBufferTest, AddData_BufferIsNotReady_DoNothing)
+{
+    LockFreeDataBuffer buffer_zero (4, 0);
+    double values[4] = {1.0, 2.0, 3.0, 4.0};
+    double retrieved[4] = {0.0, 0.0, 0.0, 0.0};
+
+    buffer_zero.add_data (values);
+
+    EXPECT_EQ (buffer_zero.get_data_count (), 0);
+    EXPECT_EQ (buffer_zero.get_current_data (1, retrieved), 0);
+    EXPECT_EQ (buffer_zero.get_data (1, retrieved), 0);
+}
+
+TEST (LockFreeDataBufferTest, GetData_CalledMultipleTimes_ReturnEachValueSetOnceStartingWithOldest)
+{
+    LockFreeDataBuffer buffer (4, 2);
+    double first_values[4] = {1.0, 2.0, 3.0, 4.0};
+    double second_values[4] = {5.0, 6.0, 7.0, 8.0};
+
+    buffer.add_data (first_values);
+    buffer.add_data (second_values);
+
+    double retrieved[4];
+    buffer.get_data (1, retrieved);
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ (retrieved[i], first_values[i]);
+    }
+
+    buffer.get_data (1, retrieved);
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ (retrieved[i], second_values[i]);
+    }
+    EXPECT_EQ (buffer.get_data_count (), 0);
+}
+
+TEST (LockFreeDataBufferTest, GetData_InvokedInMoreThreadsThanAvailableData_EachSampleReturnedOnce)
+{
+    LockFreeDataBuffer buffer (1, 1024);
+    for (int i = 0; i < 1024; i++)
+    {
+        double value = (double)i;
+        buffer.add_data (&value);
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<std::vector<double>> retrieved (8);
+    for (int i = 0; i < 8; i++)
+    {
+        threads.push_back (std::thread (
+            [&] (std::vector<double> *res)
+            {
+                double value;
+                while (buffer.get_data (1, &value) == 1)
+                {
+                    res->push_back (value);
+                }
+            },
+            &retrieved[i]));
+    }
+    for (auto &thread : threads)
+    {
+        thread.join ();
+    }
+
+    std::vector<int> counts (1024, 0);
+    size_t total = 0;
+    for (auto &res : retrieved)
+    {
+        total += res.size ();
+        for (double value : res)
+        {
+            counts[(int)value]++;
+        }
+    }
+    ASSERT_EQ (total, 1024);
+    for (int i = 0; i < 1024; i++)
+    {
+        EXPECT_EQ (counts[i], 1);
+    }
+}
+
+TEST (LockFreeDataBufferTest, GetCurrentData_CalledMultipleTimes_ReturnMostRecentValueSetEachTime)
+{
+    LockFreeDataBuffer buffer (4, 2);
+    double first_values[4] = {1.0, 2.0, 3.0, 4.0};
+    double second_values[4] = {5.0, 6.0, 7.0, 8.0};
+
+    buffer.add_data (first_values);
+    buffer.add_data (second_values);
+
+    double retrieved[4];
+    buffer.get_current_data (1, retrieved);
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ (retrieved[i], second_values[i]);
+    }
+
+    buffer.get_current_data (1, retrieved);
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ (retrieved[i], second_values[i]);
+    }
+    EXPECT_EQ (buffer.get_data_count (), 2);
+}
+
+TEST (LockFreeDataBufferTest, GetCurrentData_ConcurrentProducer_ReturnConsistentSamples)
+{
+    LockFreeDataBuffer buffer (4, 64);
+    std::atomic<bool> running (true);
+
+    std::thread producer (
+        [&] ()
+        {
+            for (int i = 0; i < 200000; i++)
+            {
+                double values[4] = {(double)i, (double)i, (double)i, (double)i};
+                buffer.add_data (values);
+            }
+            running = false;
+        });
+
+    double retrieved[64 * 4];
+    while (running)
+    {
+        size_t count = buffer.get_current_data (64, retrieved);
+        for (size_t i = 0; i < count; i++)
+        {
+            for (int j = 1; j < 4; j++)
+            {
+                ASSERT_EQ (retrieved[i * 4 + j], retrieved[i * 4]);
+            }
+            if (i > 0)
+            {
+                ASSERT_EQ (retrieved[i * 4], retrieved[(i - 1) * 4] + 1.0);
+            }
+        }
+    }
+    producer.join ();
+}
+
+TEST (LockFreeDataBufferTest, IsReady_BufferCannotFitInMemory_ReturnFalse)
+{
+    LockFreeDataBuffer buffer (INT_MAX, SIZE_MAX);
+    EXPECT_EQ (buffer.is_ready (), false);
+}
+
+TEST (LockFreeDataBufferTest, Create_LockFreeType_ReturnLockFreeBuffer)
+{
+    DataBufferTypes type;
+    ASSERT_TRUE (BaseDataBuffer::type_from_string ("lock_free", type));
+    BaseDataBuffer *buffer = BaseDataBuffer::create (4, 16, type);
+    ASSERT_NE (buffer, nullptr);
+    EXPECT_NE (dynamic_cast<LockFreeDataBuffer *> (buffer), nullptr);
+    EXPECT_EQ (buffer->is_ready (), true);
+    delete buffer;
+
+    EXPECT_FALSE (BaseDataBuffer::type_from_string ("unknown", type));
+}
+
+TEST (LockFreeDataBufferTest, GetDataTransposed_WrappedBuffer_ReturnValuesAsRows)
+{
+    LockFreeDataBuffer buffer (3, 5);
+    for (int i = 0; i < 7; i++)
+    {
+        double values[3] = {(double)i, i + 10.0, i + 20.0};
+        buffer.add_data (values);
+    }
+
+    double retrieved[15];
+    ASSERT_EQ (buffer.get_current_data_transposed (4, retrieved), 4);
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ (retrieved[i], 3.0 + i);
+        EXPECT_EQ (retrieved[4 + i], 13.0 + i);
+        EXPECT_EQ (retrieved[8 + i], 23.0 + i);
+    }
+    ASSERT_EQ (buffer.get_data_transposed (10, retrieved), 5);
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_EQ (retrieved[i], 2.0 + i);
+        EXPECT_EQ (retrieved[5 + i], 12.0 + i);
+        EXPECT_EQ (retrieved[10 + i], 22.0 + i);
+    }
+    EXPECT_EQ (buffer.get_data_count (), 0);
+}
+
+TEST (LockFreeDataBufferTest, GetCurrentDataTransposed_ConcurrentProducer_ReturnConsistentRows)
+{
+    LockFreeDataBuffer buffer (4, 64);
+    std::atomic<bool> running (true);
+
+    std::thread producer (
+        [&] ()
+        {
+            for (int i = 0; i < 200000; i++)
+            {
+                double values[4] = {(double)i, (double)i, (double)i, (double)i};
+                buffer.add_data (values);
+            }
+            running = false;
+        });
+
+    double retrieved[64 * 4];
+    while (running)
+    {
+        size_t count = buffer.get_current_data_transposed (64, retrieved);
+        for (size_t i = 0; i < count; i++)
+        {
+            for (int j = 1; j < 4; j++)
+            {
+                ASSERT_EQ (retrieved[j * count + i], retrieved[i]);
+            }
+            if (i > 0)
+            {
+                ASSERT_EQ (retrieved[i], retrieved[i - 1] + 1.0);
+            }
+        }
+    }
+    producer.join ();
+}
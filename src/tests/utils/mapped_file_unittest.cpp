@@ -0,0 +1,64 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+#include "mapped_file.h"
+
+using namespace testing;
+
+
+static std::string get_test_file (const char *name, const std::string &content)
+{
+    std::string file_name = std::string ("mapped_file_unittest_") + name + ".txt";
+    FILE *fp = fopen (file_name.c_str (), "wb");
+    if (fp != NULL)
+    {
+        fwrite (content.data (), 1, content.size (), fp);
+        fclose (fp);
+    }
+    return file_name;
+}
+
+TEST (MappedFileTest, Open_ExistingFile_MapsWholeContent)
+{
+    std::string content = "1.0\t2.0\n3.0\t4.0\n";
+    std::string file_name = get_test_file ("content", content);
+    {
+        MappedFile mapped_file (file_name.c_str ());
+        ASSERT_EQ (mapped_file.open (), (int)MappedFileReturnCodes::STATUS_OK);
+        ASSERT_EQ (mapped_file.get_size (), (int64_t)content.size ());
+        ASSERT_NE (mapped_file.get_data (), (const char *)NULL);
+        EXPECT_EQ (memcmp (mapped_file.get_data (), content.data (), content.size ()), 0);
+        EXPECT_GT (mapped_file.get_mtime (), 0);
+        EXPECT_EQ (mapped_file.open (), (int)MappedFileReturnCodes::ALREADY_OPEN_ERROR);
+
+        mapped_file.close ();
+        EXPECT_EQ (mapped_file.get_data (), (const char *)NULL);
+        EXPECT_EQ (mapped_file.get_size (), 0);
+        // can be opened again after close
+        ASSERT_EQ (mapped_file.open (), (int)MappedFileReturnCodes::STATUS_OK);
+        EXPECT_EQ (mapped_file.get_size (), (int64_t)content.size ());
+    }
+    remove (file_name.c_str ());
+}
+
+TEST (MappedFileTest, Open_EmptyFile_NothingMapped)
+{
+    std::string file_name = get_test_file ("empty", "");
+    {
+        MappedFile mapped_file (file_name.c_str ());
+        ASSERT_EQ (mapped_file.open (), (int)MappedFileReturnCodes::STATUS_OK);
+        EXPECT_EQ (mapped_file.get_size (), 0);
+        EXPECT_EQ (mapped_file.get_data (), (const char *)NULL);
+    }
+    remove (file_name.c_str ());
+}
+
+TEST (MappedFileTest, Open_MissingFile_OpenError)
+{
+    MappedFile mapped_file ("mapped_file_unittest_missing.txt");
+    EXPECT_EQ (mapped_file.open (), (int)MappedFileReturnCodes::OPEN_ERROR);
+    EXPECT_EQ (mapped_file.get_data (), (const char *)NULL);
+}
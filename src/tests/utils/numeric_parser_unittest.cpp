@@ -0,0 +1,80 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "numeric_parser.h"
+
+using namespace testing;
+
+
+static bool parse (const char *str, double *value, int *parsed_len)
+{
+    const char *pos = str;
+    bool res = parse_double (&pos, str + strlen (str), value);
+    *parsed_len = (int)(pos - str);
+    return res;
+}
+
+TEST (NumericParserTest, ParseDouble_PrintfOutput_SameAsStrtod)
+{
+    const char *values[] = {"0.000000", "-0.000000", "1.5", "-123.456789", "1700000000.123456",
+        "0.1", "3.14159265358979", "1e-7", "2.5E+10", "-4.9e-324", "1.7976931348623157e308",
+        "12345678901234567890123", "0.000000000000000000000123456"};
+    for (const char *str : values)
+    {
+        double value = 0;
+        int len = 0;
+        EXPECT_TRUE (parse (str, &value, &len)) << str;
+        EXPECT_EQ (value, strtod (str, NULL)) << str;
+        EXPECT_EQ (len, (int)strlen (str)) << str;
+    }
+}
+
+TEST (NumericParserTest, ParseDouble_NanAndInf_UseFallback)
+{
+    double value = 0;
+    int len = 0;
+    EXPECT_TRUE (parse ("nan\t1.0", &value, &len));
+    EXPECT_TRUE (isnan (value));
+    EXPECT_EQ (len, 3);
+    EXPECT_TRUE (parse ("-inf", &value, &len));
+    EXPECT_TRUE (isinf (value));
+    EXPECT_LT (value, 0);
+}
+
+TEST (NumericParserTest, ParseDouble_StopAtDelimiterAndRangeEnd)
+{
+    const char *str = "  42.5\t7";
+    const char *pos = str;
+    double value = 0;
+    EXPECT_TRUE (parse_double (&pos, str + strlen (str), &value));
+    EXPECT_EQ (value, 42.5);
+    EXPECT_EQ (*pos, '\t');
+
+    // input is not null terminated, only first 3 chars are available
+    const char *digits = "1234";
+    pos = digits;
+    EXPECT_TRUE (parse_double (&pos, digits + 3, &value));
+    EXPECT_EQ (value, 123.0);
+    EXPECT_EQ (pos, digits + 3);
+
+    // exponent without digits is not a part of the number
+    const char *exp = "5e,";
+    pos = exp;
+    EXPECT_TRUE (parse_double (&pos, exp + 3, &value));
+    EXPECT_EQ (value, 5.0);
+    EXPECT_EQ (pos, exp + 1);
+}
+
+TEST (NumericParserTest, ParseDouble_InvalidInput_ReturnFalse)
+{
+    double value = 0;
+    int len = 0;
+    EXPECT_FALSE (parse ("", &value, &len));
+    EXPECT_FALSE (parse ("abc", &value, &len));
+    EXPECT_FALSE (parse ("-", &value, &len));
+    EXPECT_FALSE (parse ("\t1", &value, &len));
+}
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <string.h>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <vector>
+
+#include "serial.h"
+#include "serial_frame_reader.h"
+
+using namespace testing;
+
+
+// returns prepared bytes in pieces of at most piece_size bytes, returns nothing after the end
+class FakeSerial : public Serial
+{
+public:
+    FakeSerial (const std::vector<unsigned char> &data, int piece_size)
+        : data (data), piece_size (piece_size), pos (0)
+    {
+    }
+
+    int open_serial_port ()
+    {
+        return SerialExitCodes::OK;
+    }
+    bool is_port_open ()
+    {
+        return true;
+    }
+    int set_serial_port_settings (int ms_timeout = 1000, bool timeout_only = false)
+    {
+        return SerialExitCodes::OK;
+    }
+    int set_custom_baudrate (int baudrate)
+    {
+        return SerialExitCodes::OK;
+    }
+    int set_custom_latency (int latency = 1)
+    {
+        return SerialExitCodes::OK;
+    }
+    int flush_buffer ()
+    {
+        return SerialExitCodes::OK;
+    }
+    int read_from_serial_port (void *bytes_to_read, int size)
+    {
+        int res = std::min (std::min (size, piece_size), (int)(data.size () - pos));
+        memcpy (bytes_to_read, data.data () + pos, res);
+        pos += res;
+        return res;
+    }
+    int send_to_serial_port (const void *message, int length)
+    {
+        return length;
+    }
+    int close_serial_port ()
+    {
+        return SerialExitCodes::OK;
+    }
+    const char *get_port_name ()
+    {
+        return "fake";
+    }
+
+private:
+    std::vector<unsigned char> data;
+    int piece_size;
+    size_t pos;
+};
+
+static void add_frame (std::vector<unsigned char> &data, int size, unsigned char id,
+    unsigned char end_byte = 0xC0)
+{
+    data.push_back (0xA0);
+    for (int i = 0; i < size - 1; i++)
+    {
+        data.push_back ((unsigned char)(id + i));
+    }
+    data.push_back (end_byte);
+}
+
+TEST (SerialFrameReaderTest, ReadFrame_FixedSizeWithGarbage_ResyncOnStartAndEndBytes)
+{
+    std::vector<unsigned char> data = {0x01, 0xA0, 0x02}; // stream starts in the middle
+    add_frame (data, 32, 0);
+    add_frame (data, 32, 1, 0xC6);
+    // wrong end byte, the whole frame is skipped
+    add_frame (data, 32, 2, 0xD0);
+    add_frame (data, 32, 3, 0xC1);
+    data.push_back (0xA0); // incomplete frame
+
+    for (int piece_size : {1, 7, 33, 4096})
+    {
+        FakeSerial serial (data, piece_size);
+        SerialFrameReader reader (&serial, 0xA0, 32, 32, 0xC0, 0xC6, 10);
+        unsigned char frame[32];
+        std::vector<unsigned char> ids;
+        int res = 0;
+        while ((res = reader.read_frame (frame)) > 0)
+        {
+            EXPECT_EQ (res, 32);
+            ids.push_back (frame[0]);
+        }
+        EXPECT_THAT (ids, ElementsAre (0, 1, 3)) << piece_size;
+        EXPECT_GT (reader.get_skipped_bytes (), 33u);
+    }
+}
+
+TEST (SerialFrameReaderTest, ReadFrame_VariableSize_FrameEndsBeforeNextStartByte)
+{
+    std::vector<unsigned char> data;
+    for (int i = 0; i < 10; i++)
+    {
+        add_frame (data, 20, (unsigned char)i);
+    }
+    // end and start bytes inside of data must not split frame
+    data[5] = 0xC0;
+    data[6] = 0xA0;
+    add_frame (data, 20, 10);
+
+    FakeSerial serial (data, 4096);
+    SerialFrameReader reader (&serial, 0xA0, 8, 100, 0xC0, 0xC0, 10);
+    unsigned char frame[100];
+    std::vector<int> sizes;
+    int res = 0;
+    while ((res = reader.read_frame (frame)) > 0)
+    {
+        sizes.push_back (res);
+        EXPECT_EQ (frame[res - 1], 0xC0);
+    }
+    // the last frame is not confirmed by the next start byte
+    EXPECT_EQ (sizes.size (), 10u);
+    for (int size : sizes)
+    {
+        EXPECT_EQ (size, 20);
+    }
+}
+
+TEST (SerialFrameReaderTest, ReadFrame_ManyFramesAvailable_ReadInLargeChunks)
+{
+    std::vector<unsigned char> data;
+    for (int i = 0; i < 1000; i++)
+    {
+        add_frame (data, 32, (unsigned char)i);
+    }
+    FakeSerial serial (data, 1 << 20);
+    SerialFrameReader reader (&serial, 0xA0, 32, 32, 0xC0, 0xC6, 10);
+    unsigned char frame[32];
+    int num_frames = 0;
+    while (reader.read_frame (frame) > 0)
+    {
+        EXPECT_EQ (frame[0], (unsigned char)num_frames);
+        num_frames++;
+    }
+    EXPECT_EQ (num_frames, 1000);
+    // 33 bytes per frame and 4096 bytes buffer
+    EXPECT_LT (reader.get_num_reads (), 1000u / 30);
+}
@@ -0,0 +1,280 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "base_data_buffer.h"
+#include "spill_data_buffer.h"
+
+using namespace testing;
+
+
+static void add_samples (BaseDataBuffer &buffer, int num_values, int from, int to)
+{
+    std::vector<double> values (num_values);
+    for (int i = from; i < to; i++)
+    {
+        for (int j = 0; j < num_values; j++)
+        {
+            values[j] = i * 1000 + j;
+        }
+        buffer.add_data (values.data ());
+    }
+}
+
+TEST (SpillDataBufferTest, AddData_AddMoreDataThanRingCapacity_KeepAllSamples)
+{
+    SpillDataBuffer buffer (3, 8, "");
+    ASSERT_EQ (buffer.is_ready (), true);
+    add_samples (buffer, 3, 0, 50);
+    EXPECT_EQ (buffer.get_data_count (), 50);
+
+    struct DataBufferStats stats;
+    buffer.get_stats (stats);
+    EXPECT_EQ (stats.overwritten, 0);
+    EXPECT_GT (stats.spilled, 40);
+    EXPECT_EQ (stats.spilled_pending, stats.spilled);
+
+    std::vector<double> retrieved (3 * 50);
+    ASSERT_EQ (buffer.get_data (100, retrieved.data ()), 50);
+    for (int i = 0; i < 50; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            ASSERT_EQ (retrieved[i * 3 + j], i * 1000 + j);
+        }
+    }
+    buffer.get_stats (stats);
+    EXPECT_EQ (stats.spilled_pending, 0);
+    EXPECT_EQ (buffer.get_data_count (), 0);
+}
+
+TEST (SpillDataBufferTest, GetDataChannels_PartialReads_DrainFileFirst)
+{
+    SpillDataBuffer buffer (4, 8, "");
+    add_samples (buffer, 4, 0, 40);
+
+    int channels[2] = {3, 0};
+    std::vector<double> retrieved (2 * 40);
+    ASSERT_EQ (buffer.get_data_channels (25, channels, 2, retrieved.data ()), 25);
+    for (int i = 0; i < 25; i++)
+    {
+        ASSERT_EQ (retrieved[i], i * 1000 + 3);
+        ASSERT_EQ (retrieved[25 + i], i * 1000);
+    }
+
+    // the rest is split between file and ring
+    ASSERT_EQ (buffer.get_data_transposed (40, retrieved.data ()), 15);
+    for (int i = 0; i < 15; i++)
+    {
+        ASSERT_EQ (retrieved[i], (25 + i) * 1000);
+        ASSERT_EQ (retrieved[2 * 15 + i], (25 + i) * 1000 + 2);
+    }
+
+    // file is reused after it was drained
+    add_samples (buffer, 4, 40, 60);
+    ASSERT_EQ (buffer.get_data_count (), 20);
+    ASSERT_EQ (buffer.get_data_transposed (40, retrieved.data ()), 20);
+    EXPECT_EQ (retrieved[0], 40000);
+    EXPECT_EQ (retrieved[19], 59000);
+}
+
+TEST (SpillDataBufferTest, GetCurrentData_MoreThanRing_ReadLatestSamplesFromFile)
+{
+    SpillDataBuffer buffer (3, 8, "");
+    add_samples (buffer, 3, 0, 30);
+
+    std::vector<double> retrieved (3 * 20);
+    ASSERT_EQ (buffer.get_current_data (20, retrieved.data ()), 20);
+    for (int i = 0; i < 20; i++)
+    {
+        ASSERT_EQ (retrieved[i * 3], (10 + i) * 1000);
+    }
+    int channels[2] = {2, 1};
+    ASSERT_EQ (buffer.get_current_data_channels (20, channels, 2, retrieved.data ()), 20);
+    for (int i = 0; i < 20; i++)
+    {
+        ASSERT_EQ (retrieved[i], (10 + i) * 1000 + 2);
+        ASSERT_EQ (retrieved[20 + i], (10 + i) * 1000 + 1);
+    }
+    ASSERT_EQ (buffer.get_current_data_transposed (2, retrieved.data ()), 2);
+    EXPECT_EQ (retrieved[0], 28000);
+    EXPECT_EQ (retrieved[1], 29000);
+    EXPECT_EQ (buffer.get_data_count (), 30);
+}
+
+TEST (SpillDataBufferTest, IsReady_InvalidSpillDir_ReturnFalse)
+{
+    SpillDataBuffer buffer (3, 8, "/not/existing/brainflow/dir");
+    EXPECT_EQ (buffer.is_ready (), false);
+    EXPECT_EQ (buffer.get_data_count (), 0);
+
+    DataBufferTypes type;
+    ASSERT_TRUE (BaseDataBuffer::type_from_string ("spill", type));
+    EXPECT_EQ (type, DataBufferTypes::SPILL);
+}
+
+TEST (DataBufferStatsTest, GetStats_InMemoryBuffers_CountOverwrittenSamples)
+{
+    for (DataBufferTypes type :
+        {DataBufferTypes::SPINLOCK, DataBufferTypes::LOCK_FREE, DataBufferTypes::CHANNEL_MAJOR})
+    {
+        BaseDataBuffer *buffer = BaseDataBuffer::create (2, 8, type);
+        add_samples (*buffer, 2, 0, 20);
+        struct DataBufferStats stats;
+        buffer->get_stats (stats);
+        EXPECT_EQ (stats.overwritten, 12);
+        EXPECT_EQ (stats.spilled, 0);
+        double retrieved[2 * 8];
+        EXPECT_EQ (buffer->get_data (8, retrieved), 8);
+        buffer->get_stats (stats);
+        EXPECT_EQ (stats.overwritten, 12);
+        delete buffer;
+    }
+}
+
+TEST (SpillDataBufferTest, AddDataBlock_BlockLargerThanRing_KeepAllSamples)
+{
+    SpillDataBuffer buffer (2, 8, "");
+    ASSERT_TRUE (buffer.is_ready ());
+    std::vector<double> block (2 * 30);
+    for (int i = 0; i < 30; i++)
+    {
+        block[i * 2] = i;
+        block[i * 2 + 1] = -i;
+    }
+    buffer.add_data_block (block.data (), 30);
+    buffer.add_data_block (block.data (), 5);
+    EXPECT_EQ (buffer.get_data_count (), 35);
+
+    std::vector<double> retrieved (2 * 35);
+    ASSERT_EQ (buffer.get_data (35, retrieved.data ()), 35);
+    for (int i = 0; i < 35; i++)
+    {
+        EXPECT_EQ (retrieved[i * 2], i % 30);
+        EXPECT_EQ (retrieved[i * 2 + 1], -(i % 30));
+    }
+    struct DataBufferStats stats;
+    buffer.get_stats (stats);
+    EXPECT_EQ (stats.overwritten, 0);
+}
+
+// emulates slow disk, file io waits while stalled is set
+class StalledSpillDataBuffer : public SpillDataBuffer
+{
+public:
+    std::atomic<bool> stalled;
+    std::atomic<int> stalled_reads;
+    std::atomic<size_t> written;
+
+    StalledSpillDataBuffer (int num_samples, size_t buffer_size)
+        : SpillDataBuffer (num_samples, buffer_size, "")
+    {
+        stalled = false;
+        stalled_reads = 0;
+        written = 0;
+    }
+
+    ~StalledSpillDataBuffer ()
+    {
+        stalled = false;
+        stop_writer ();
+    }
+
+protected:
+    bool write_file (int64_t pos, const double *data, size_t count) override
+    {
+        wait ();
+        bool res = SpillDataBuffer::write_file (pos, data, count);
+        written += count;
+        return res;
+    }
+
+    bool read_file (int64_t pos, size_t count, const int *channels, int num_channels,
+        double *data_buf, size_t result_size, size_t offset) override
+    {
+        if (stalled)
+        {
+            stalled_reads++;
+        }
+        wait ();
+        return SpillDataBuffer::read_file (
+            pos, count, channels, num_channels, data_buf, result_size, offset);
+    }
+
+private:
+    void wait ()
+    {
+        while (stalled)
+        {
+            std::this_thread::sleep_for (std::chrono::milliseconds (1));
+        }
+    }
+};
+
+TEST (SpillDataBufferTest, AddData_DiskStalledDuringRead_ProducerNotBlocked)
+{
+    StalledSpillDataBuffer buffer (2, 8);
+    ASSERT_TRUE (buffer.is_ready ());
+    add_samples (buffer, 2, 0, 40);
+    struct DataBufferStats stats;
+    buffer.get_stats (stats);
+    for (int i = 0; (i < 1000) && (buffer.written != stats.spilled); i++)
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (1));
+    }
+    ASSERT_EQ (buffer.written, stats.spilled);
+
+    // consumer waits for disk, concurrent reader of current data waits for consumer
+    buffer.stalled = true;
+    std::vector<double> drained (2 * 100);
+    auto consumer = std::async (
+        std::launch::async, [&buffer, &drained] { return buffer.get_data (100, drained.data ()); });
+    for (int i = 0; (i < 1000) && (buffer.stalled_reads == 0); i++)
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (1));
+    }
+    ASSERT_GT (buffer.stalled_reads, 0);
+    std::vector<double> current (2 * 100);
+    auto current_reader = std::async (std::launch::async,
+        [&buffer, &current] { return buffer.get_current_data (100, current.data ()); });
+
+    // new samples go to ring and pending blocks, writer is stalled too
+    auto producer = std::async (std::launch::async, [&buffer] {
+        add_samples (buffer, 2, 40, 48);
+        return buffer.get_data_count ();
+    });
+    bool producer_done =
+        (producer.wait_for (std::chrono::seconds (2)) == std::future_status::ready);
+    EXPECT_EQ (consumer.wait_for (std::chrono::milliseconds (0)), std::future_status::timeout);
+    buffer.stalled = false;
+    ASSERT_TRUE (producer_done);
+    EXPECT_EQ (producer.get (), 48);
+
+    // consumer takes samples which existed when it was called, in order
+    ASSERT_EQ (consumer.get (), 40);
+    for (int i = 0; i < 40; i++)
+    {
+        ASSERT_EQ (drained[i * 2], i * 1000);
+        ASSERT_EQ (drained[i * 2 + 1], i * 1000 + 1);
+    }
+    size_t current_count = current_reader.get ();
+    ASSERT_GT (current_count, 0);
+    EXPECT_EQ (current[(current_count - 1) * 2], 47000);
+    for (size_t i = 1; i < current_count; i++)
+    {
+        EXPECT_EQ (current[i * 2], current[(i - 1) * 2] + 1000);
+    }
+
+    ASSERT_EQ (buffer.get_data (100, drained.data ()), 8);
+    for (int i = 0; i < 8; i++)
+    {
+        EXPECT_EQ (drained[i * 2], (40 + i) * 1000);
+    }
+    buffer.get_stats (stats);
+    EXPECT_EQ (stats.overwritten, 0);
+    EXPECT_EQ (stats.spilled_pending, 0);
+}
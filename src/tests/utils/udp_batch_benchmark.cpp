@@ -0,0 +1,101 @@
+// Measures datagrams per second over loopback for SocketClientUDP send/recv against
+// send_batch/recv_batch (sendmmsg/recvmmsg on Linux).
+// Usage: udp_batch_benchmark [datagram_size] [num_bursts]
+// one thread sends a burst of datagrams which fits into socket buffer and receives it back, send
+// and recv calls are timed separately, so results dont depend on scheduling of threads
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "socket_client_udp.h"
+
+#define BENCHMARK_BURST_SIZE 32
+
+
+int main (int argc, char *argv[])
+{
+    // default is a streaming board datagram with 3 packages of 25 rows
+    int size = (argc > 1) ? atoi (argv[1]) : 600;
+    int num_bursts = (argc > 2) ? atoi (argv[2]) : 20000;
+    if ((size < 1) || (size > 4096) || (num_bursts < 1))
+    {
+        printf ("invalid arguments\n");
+        return 1;
+    }
+
+    SocketClientUDP receiver ("127.0.0.1", 0);
+    if (receiver.bind () != (int)SocketClientUDPReturnCodes::STATUS_OK)
+    {
+        printf ("failed to bind receiver\n");
+        return 1;
+    }
+    receiver.set_timeout (1);
+    SocketClientUDP sender ("127.0.0.1", receiver.get_local_port ());
+    if (sender.connect () != (int)SocketClientUDPReturnCodes::STATUS_OK)
+    {
+        printf ("failed to create sender\n");
+        return 1;
+    }
+    printf ("datagram size: %d bytes, bursts: %d of %d datagrams\n", size, num_bursts,
+        BENCHMARK_BURST_SIZE);
+
+    std::vector<char> out ((size_t)size * BENCHMARK_BURST_SIZE, 1);
+    std::vector<char> in ((size_t)size * BENCHMARK_BURST_SIZE);
+    int sizes[BENCHMARK_BURST_SIZE];
+    const char *names[] = {"send/recv", "send_batch/recv_batch"};
+    for (int batched = 0; batched < 2; batched++)
+    {
+        double send_time = 0.0;
+        double recv_time = 0.0;
+        long long num_sent = 0;
+        long long num_received = 0;
+        for (int burst = 0; burst < num_bursts; burst++)
+        {
+            auto start = std::chrono::steady_clock::now ();
+            int sent = 0;
+            if (batched)
+            {
+                int res = sender.send_batch (out.data (), size, BENCHMARK_BURST_SIZE);
+                sent = (res > 0) ? res : 0;
+            }
+            else
+            {
+                for (int i = 0; i < BENCHMARK_BURST_SIZE; i++)
+                {
+                    sent += (sender.send (out.data () + i * size, size) == size) ? 1 : 0;
+                }
+            }
+            auto middle = std::chrono::steady_clock::now ();
+            int received = 0;
+            while (received < sent)
+            {
+                int res = 0;
+                if (batched)
+                {
+                    res = receiver.recv_batch (
+                        in.data (), size, BENCHMARK_BURST_SIZE - received, sizes);
+                }
+                else
+                {
+                    res = (receiver.recv (in.data (), size) == size) ? 1 : -1;
+                }
+                if (res < 1)
+                {
+                    break;
+                }
+                received += res;
+            }
+            auto end = std::chrono::steady_clock::now ();
+            send_time += std::chrono::duration<double> (middle - start).count ();
+            recv_time += std::chrono::duration<double> (end - middle).count ();
+            num_sent += sent;
+            num_received += received;
+        }
+        printf ("%s: send %.0lf datagrams/s, recv %.0lf datagrams/s, lost %lld\n",
+            names[batched], num_sent / send_time, num_received / recv_time,
+            num_sent - num_received);
+    }
+    return 0;
+}
@@ -0,0 +1,190 @@
+#ifndef _WIN32
+
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+#include "udp_batch.h"
+
+using namespace testing;
+
+
+// udp socket bound to loopback with random port
+static int create_udp_socket (struct sockaddr_in *addr)
+{
+    int fd = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    memset (addr, 0, sizeof (*addr));
+    addr->sin_family = AF_INET;
+    addr->sin_port = 0;
+    addr->sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+    socklen_t len = (socklen_t)sizeof (*addr);
+    if ((fd < 0) || (bind (fd, (struct sockaddr *)addr, len) != 0) ||
+        (getsockname (fd, (struct sockaddr *)addr, &len) != 0))
+    {
+        return -1;
+    }
+    struct timeval timeout;
+    timeout.tv_sec = 1;
+    timeout.tv_usec = 0;
+    setsockopt (fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof (timeout));
+    return fd;
+}
+
+// datagram i has size bytes with value i in the first int
+static std::vector<unsigned char> make_datagrams (int size, int count)
+{
+    std::vector<unsigned char> data ((size_t)size * count, 0);
+    for (int i = 0; i < count; i++)
+    {
+        memcpy (data.data () + (size_t)i * size, &i, sizeof (i));
+    }
+    return data;
+}
+
+// receives datagrams until timeout or error, checks that they are numbered from first
+static int recv_in_order (UDPBatch &batch, int fd, int size, int first)
+{
+    std::vector<unsigned char> slots ((size_t)size * UDP_BATCH_MAX_DATAGRAMS);
+    int sizes[UDP_BATCH_MAX_DATAGRAMS];
+    int next = first;
+    while (true)
+    {
+        int res = batch.recv (fd, slots.data (), size, UDP_BATCH_MAX_DATAGRAMS, sizes);
+        if (res < 1)
+        {
+            break;
+        }
+        EXPECT_LE (res, UDP_BATCH_MAX_DATAGRAMS);
+        for (int i = 0; i < res; i++)
+        {
+            int num = -1;
+            memcpy (&num, slots.data () + (size_t)i * size, sizeof (num));
+            EXPECT_EQ (sizes[i], size);
+            EXPECT_EQ (num, next);
+            next++;
+        }
+    }
+    return next - first;
+}
+
+TEST (UDPBatchTest, SendRecv_MoreThanMaxDatagrams_CompleteAndInOrder)
+{
+    struct sockaddr_in sender_addr;
+    struct sockaddr_in receiver_addr;
+    int sender = create_udp_socket (&sender_addr);
+    int receiver = create_udp_socket (&receiver_addr);
+    ASSERT_GE (sender, 0);
+    ASSERT_GE (receiver, 0);
+
+    int size = 32;
+    int count = UDP_BATCH_MAX_DATAGRAMS * 2 + 5;
+    std::vector<unsigned char> data = make_datagrams (size, count);
+    UDPBatch batch;
+    EXPECT_EQ (batch.send (sender, data.data (), size, count, (struct sockaddr *)&receiver_addr,
+                   (socklen_t)sizeof (receiver_addr)),
+        count);
+    EXPECT_EQ (recv_in_order (batch, receiver, size, 0), count);
+
+    close (sender);
+    close (receiver);
+}
+
+TEST (UDPBatchTest, Send_PeerQueueIsFull_PartialResultCarriedOver)
+{
+    int fds[2];
+    ASSERT_EQ (socketpair (AF_UNIX, SOCK_DGRAM, 0, fds), 0);
+    fcntl (fds[0], F_SETFL, fcntl (fds[0], F_GETFL) | O_NONBLOCK);
+    fcntl (fds[1], F_SETFL, fcntl (fds[1], F_GETFL) | O_NONBLOCK);
+
+    int size = 64;
+    int count = 2000;
+    std::vector<unsigned char> data = make_datagrams (size, count);
+    UDPBatch batch;
+    int num_sent = 0;
+    int num_received = 0;
+    int num_partial = 0;
+    for (int attempt = 0; (attempt < 10000) && (num_sent < count); attempt++)
+    {
+        // datagrams which didnt fit into the queue are sent again from the first unsent one
+        int res = batch.send (
+            fds[0], data.data () + (size_t)num_sent * size, size, count - num_sent, NULL, 0);
+        if ((res > 0) && (res < count - num_sent))
+        {
+            num_partial++;
+        }
+        if (res > 0)
+        {
+            num_sent += res;
+        }
+        num_received += recv_in_order (batch, fds[1], size, num_received);
+    }
+    num_received += recv_in_order (batch, fds[1], size, num_received);
+    EXPECT_GT (num_partial, 0);
+    EXPECT_EQ (num_sent, count);
+    EXPECT_EQ (num_received, count);
+
+    close (fds[0]);
+    close (fds[1]);
+}
+
+TEST (UDPBatchTest, Recv_DatagramLongerThanSlot_TruncationReported)
+{
+    struct sockaddr_in sender_addr;
+    struct sockaddr_in receiver_addr;
+    int sender = create_udp_socket (&sender_addr);
+    int receiver = create_udp_socket (&receiver_addr);
+    ASSERT_GE (sender, 0);
+    ASSERT_GE (receiver, 0);
+
+    int slot_size = 50;
+    int datagram_sizes[3] = {100, 20, slot_size};
+    std::vector<unsigned char> out (100);
+    for (size_t i = 0; i < out.size (); i++)
+    {
+        out[i] = (unsigned char)i;
+    }
+    for (int datagram_size : datagram_sizes)
+    {
+        ASSERT_EQ (sendto (sender, out.data (), datagram_size, 0, (struct sockaddr *)&receiver_addr,
+                       (socklen_t)sizeof (receiver_addr)),
+            datagram_size);
+    }
+
+    UDPBatch batch;
+    std::vector<unsigned char> slots ((size_t)slot_size * 3);
+    int sizes[3];
+    int num_received = 0;
+    while (num_received < 3)
+    {
+        int res = batch.recv (receiver, slots.data () + (size_t)num_received * slot_size,
+            slot_size, 3 - num_received, sizes);
+        ASSERT_GT (res, 0);
+        for (int i = 0; i < res; i++)
+        {
+            int num = num_received + i;
+            if (datagram_sizes[num] > slot_size)
+            {
+                EXPECT_GT (sizes[i], slot_size);
+            }
+            else
+            {
+                EXPECT_EQ (sizes[i], datagram_sizes[num]);
+            }
+        }
+        num_received += res;
+    }
+    // truncated datagram keeps the first slot_size bytes
+    EXPECT_EQ (memcmp (slots.data (), out.data (), slot_size), 0);
+    EXPECT_EQ (memcmp (slots.data () + slot_size, out.data (), 20), 0);
+
+    close (sender);
+    close (receiver);
+}
+
+#endif
@@ -0,0 +1,100 @@
+#include <algorithm>
+
+#include "base_data_buffer.h"
+#include "brainflow_env_vars.h"
+#include "channel_major_data_buffer.h"
+#include "data_buffer.h"
+#include "lock_free_data_buffer.h"
+#include "spill_data_buffer.h"
+
+#define TRANSPOSE_BLOCK_SIZE 32
+
+
+BaseDataBuffer *BaseDataBuffer::create (int num_samples, size_t buffer_size,
+    DataBufferTypes type, DataBufferPrecision precision,
+    const std::vector<int> &full_precision_rows)
+{
+    // only channel major buffer has separate storage per row to keep some rows as doubles
+    if ((precision != DataBufferPrecision::FLOAT64) && (type != DataBufferTypes::CHANNEL_MAJOR))
+    {
+        return NULL;
+    }
+    switch (type)
+    {
+        case DataBufferTypes::SPINLOCK:
+            return new DataBuffer (num_samples, buffer_size);
+        case DataBufferTypes::LOCK_FREE:
+            return new LockFreeDataBuffer (num_samples, buffer_size);
+        case DataBufferTypes::CHANNEL_MAJOR:
+            return new ChannelMajorDataBuffer (
+                num_samples, buffer_size, precision, full_precision_rows);
+        case DataBufferTypes::SPILL:
+            return new SpillDataBuffer (num_samples, buffer_size, get_brainflow_spill_dir ());
+        default:
+            return NULL;
+    }
+}
+
+bool BaseDataBuffer::type_from_string (std::string type_str, DataBufferTypes &type)
+{
+    if ((type_str.empty ()) || (type_str == "spinlock"))
+    {
+        type = DataBufferTypes::SPINLOCK;
+        return true;
+    }
+    if (type_str == "lock_free")
+    {
+        type = DataBufferTypes::LOCK_FREE;
+        return true;
+    }
+    if (type_str == "channel_major")
+    {
+        type = DataBufferTypes::CHANNEL_MAJOR;
+        return true;
+    }
+    if (type_str == "spill")
+    {
+        type = DataBufferTypes::SPILL;
+        return true;
+    }
+    return false;
+}
+
+bool BaseDataBuffer::precision_from_string (
+    std::string precision_str, DataBufferPrecision &precision)
+{
+    if ((precision_str.empty ()) || (precision_str == "float64"))
+    {
+        precision = DataBufferPrecision::FLOAT64;
+        return true;
+    }
+    if (precision_str == "float32")
+    {
+        precision = DataBufferPrecision::FLOAT32;
+        return true;
+    }
+    return false;
+}
+
+void BaseDataBuffer::transpose (const double *src, size_t count, size_t num_samples,
+    const int *channels, int num_channels, double *dst, size_t dst_stride)
+{
+    // tile of TRANSPOSE_BLOCK_SIZE samples stays in L1 while its rows are written sequentially
+    for (size_t i0 = 0; i0 < count; i0 += TRANSPOSE_BLOCK_SIZE)
+    {
+        size_t i_end = std::min (i0 + TRANSPOSE_BLOCK_SIZE, count);
+        for (int r0 = 0; r0 < num_channels; r0 += TRANSPOSE_BLOCK_SIZE)
+        {
+            int r_end = std::min (r0 + TRANSPOSE_BLOCK_SIZE, num_channels);
+            for (int r = r0; r < r_end; r++)
+            {
+                double *out = dst + r * dst_stride;
+                const double *in = src + channels[r];
+                for (size_t i = i0; i < i_end; i++)
+                {
+                    out[i] = in[i * num_samples];
+                }
+            }
+        }
+    }
+}
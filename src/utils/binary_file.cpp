@@ -0,0 +1,653 @@
+#include <string.h>
+
+#include "binary_file.h"
+
+#ifdef _WIN32
+#define file_seek _fseeki64
+#define file_tell _ftelli64
+#else
+#define file_seek fseeko
+#define file_tell ftello
+#endif
+
+
+static int get_value_size (int32_t value_type)
+{
+    return (value_type == (int32_t)BinaryValueTypes::FLOAT32) ? (int)sizeof (float) :
+                                                                 (int)sizeof (double);
+}
+
+static int64_t get_file_size (FILE *fp)
+{
+    if (file_seek (fp, 0, SEEK_END) != 0)
+    {
+        return -1;
+    }
+    return (int64_t)file_tell (fp);
+}
+
+bool is_binary_file_mode (const char *file_mode)
+{
+    return ((strcmp (file_mode, "wb") == 0) || (strcmp (file_mode, "ab") == 0) ||
+        (strcmp (file_mode, "wb_f32") == 0) || (strcmp (file_mode, "ab_f32") == 0));
+}
+
+bool is_binary_file (const char *file_name)
+{
+    FILE *fp = fopen (file_name, "rb");
+    if (fp == NULL)
+    {
+        return false;
+    }
+    char magic[8];
+    bool res = (fread (magic, 1, sizeof (magic), fp) == sizeof (magic)) &&
+        (memcmp (magic, BINARY_FILE_MAGIC, sizeof (magic)) == 0);
+    fclose (fp);
+    return res;
+}
+
+int read_binary_file_header (FILE *fp, struct BinaryFileHeader &header)
+{
+    if (file_seek (fp, 0, SEEK_SET) != 0)
+    {
+        return (int)BinaryFileReturnCodes::READ_ERROR;
+    }
+    if (fread (&header, sizeof (header), 1, fp) != 1)
+    {
+        return (int)BinaryFileReturnCodes::INVALID_FORMAT_ERROR;
+    }
+    if ((memcmp (header.magic, BINARY_FILE_MAGIC, sizeof (header.magic)) != 0) ||
+        (header.version != BINARY_FILE_VERSION) || (header.byte_order != BINARY_FILE_BYTE_ORDER) ||
+        (header.num_rows <= 0) ||
+        ((header.value_type != (int32_t)BinaryValueTypes::FLOAT64) &&
+            (header.value_type != (int32_t)BinaryValueTypes::FLOAT32)))
+    {
+        return (int)BinaryFileReturnCodes::INVALID_FORMAT_ERROR;
+    }
+    return (int)BinaryFileReturnCodes::STATUS_OK;
+}
+
+static bool read_index_from_footer (FILE *fp, int64_t file_size,
+    std::vector<struct BinaryIndexEntry> &index, int64_t &total_samples, int64_t &data_end)
+{
+    int64_t min_size = (int64_t)(sizeof (struct BinaryFileHeader) +
+        sizeof (struct BinaryBlockHeader) + sizeof (struct BinaryFileFooter));
+    if (file_size < min_size)
+    {
+        return false;
+    }
+    struct BinaryFileFooter footer;
+    if ((file_seek (fp, file_size - (int64_t)sizeof (footer), SEEK_SET) != 0) ||
+        (fread (&footer, sizeof (footer), 1, fp) != 1) ||
+        (memcmp (footer.magic, BINARY_FILE_INDEX_MAGIC, sizeof (BINARY_FILE_INDEX_MAGIC)) != 0))
+    {
+        return false;
+    }
+    if ((footer.index_offset < (int64_t)sizeof (struct BinaryFileHeader)) ||
+        (footer.index_offset >= file_size))
+    {
+        return false;
+    }
+    struct BinaryBlockHeader block_header;
+    if ((file_seek (fp, footer.index_offset, SEEK_SET) != 0) ||
+        (fread (&block_header, sizeof (block_header), 1, fp) != 1))
+    {
+        return false;
+    }
+    int64_t expected_payload = (int64_t)block_header.num_samples *
+            (int64_t)sizeof (struct BinaryIndexEntry) +
+        (int64_t)sizeof (footer);
+    if ((block_header.block_type != (int32_t)BinaryBlockTypes::INDEX) ||
+        (block_header.num_samples < 0) || (block_header.payload_size != expected_payload) ||
+        (footer.index_offset + (int64_t)sizeof (block_header) + expected_payload != file_size))
+    {
+        return false;
+    }
+    std::vector<struct BinaryIndexEntry> entries (block_header.num_samples);
+    if ((block_header.num_samples > 0) &&
+        (fread (entries.data (), sizeof (struct BinaryIndexEntry), entries.size (), fp) !=
+            entries.size ()))
+    {
+        return false;
+    }
+    int64_t counter = 0;
+    for (size_t i = 0; i < entries.size (); i++)
+    {
+        if ((entries[i].first_sample != counter) || (entries[i].num_samples <= 0) ||
+            (entries[i].offset >= footer.index_offset))
+        {
+            return false;
+        }
+        counter += entries[i].num_samples;
+    }
+    if (counter != footer.total_samples)
+    {
+        return false;
+    }
+    index.swap (entries);
+    total_samples = footer.total_samples;
+    data_end = footer.index_offset;
+    return true;
+}
+
+static void read_index_by_scan (FILE *fp, const struct BinaryFileHeader &header,
+    int64_t file_size, std::vector<struct BinaryIndexEntry> &index, int64_t &total_samples,
+    int64_t &data_end)
+{
+    index.clear ();
+    total_samples = 0;
+    int64_t pos = (int64_t)sizeof (struct BinaryFileHeader);
+    data_end = pos;
+    int64_t sample_size = (int64_t)header.num_rows * get_value_size (header.value_type);
+    while (pos + (int64_t)sizeof (struct BinaryBlockHeader) <= file_size)
+    {
+        struct BinaryBlockHeader block_header;
+        if ((file_seek (fp, pos, SEEK_SET) != 0) ||
+            (fread (&block_header, sizeof (block_header), 1, fp) != 1))
+        {
+            break;
+        }
+        int64_t block_end = pos + (int64_t)sizeof (block_header) + block_header.payload_size;
+        if ((block_header.payload_size < 0) || (block_end > file_size))
+        {
+            break; // truncated block, ignore the rest
+        }
+        if (block_header.block_type == (int32_t)BinaryBlockTypes::DATA)
+        {
+            if ((block_header.num_samples <= 0) ||
+                (block_header.payload_size != block_header.num_samples * sample_size))
+            {
+                break;
+            }
+            struct BinaryIndexEntry entry;
+            entry.offset = pos;
+            entry.first_sample = total_samples;
+            entry.num_samples = block_header.num_samples;
+            entry.reserved = 0;
+            index.push_back (entry);
+            total_samples += block_header.num_samples;
+            data_end = block_end;
+        }
+        else if (block_header.block_type != (int32_t)BinaryBlockTypes::INDEX)
+        {
+            break;
+        }
+        pos = block_end;
+    }
+}
+
+int read_binary_file_index (FILE *fp, const struct BinaryFileHeader &header,
+    std::vector<struct BinaryIndexEntry> &index, int64_t &total_samples, int64_t &data_end)
+{
+    int64_t file_size = get_file_size (fp);
+    if (file_size < 0)
+    {
+        return (int)BinaryFileReturnCodes::READ_ERROR;
+    }
+    if (!read_index_from_footer (fp, file_size, index, total_samples, data_end))
+    {
+        read_index_by_scan (fp, header, file_size, index, total_samples, data_end);
+    }
+    return (int)BinaryFileReturnCodes::STATUS_OK;
+}
+
+
+///////////////////////////////
+/////////// Writer ////////////
+///////////////////////////////
+
+BinaryFileWriter::BinaryFileWriter (const char *file_name, const char *file_mode, int num_rows,
+    int board_id, int preset, int sampling_rate)
+{
+    this->file_name = file_name;
+    append = (file_mode[0] == 'a');
+    fp = NULL;
+    memset (&header, 0, sizeof (header));
+    memcpy (header.magic, BINARY_FILE_MAGIC, sizeof (header.magic));
+    header.version = BINARY_FILE_VERSION;
+    header.byte_order = BINARY_FILE_BYTE_ORDER;
+    header.board_id = board_id;
+    header.preset = preset;
+    header.num_rows = num_rows;
+    header.sampling_rate = sampling_rate;
+    header.value_type = (strstr (file_mode, "_f32") != NULL) ?
+        (int32_t)BinaryValueTypes::FLOAT32 :
+        (int32_t)BinaryValueTypes::FLOAT64;
+    pending_count = 0;
+    total_samples = 0;
+}
+
+BinaryFileWriter::~BinaryFileWriter ()
+{
+    close ();
+}
+
+int BinaryFileWriter::open ()
+{
+    if ((fp != NULL) || (header.num_rows <= 0))
+    {
+        return (int)BinaryFileReturnCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    pending.resize ((size_t)header.num_rows * BINARY_FILE_BLOCK_SIZE);
+    block_buf.resize (
+        (size_t)header.num_rows * BINARY_FILE_BLOCK_SIZE * get_value_size (header.value_type));
+    pending_count = 0;
+    index.clear ();
+    total_samples = 0;
+
+    if (append)
+    {
+        int res = open_for_append ();
+        if (res != (int)BinaryFileReturnCodes::OPEN_ERROR)
+        {
+            return res;
+        }
+        // file doesn't exist, create new one
+    }
+    fp = fopen (file_name.c_str (), "wb");
+    if (fp == NULL)
+    {
+        return (int)BinaryFileReturnCodes::OPEN_ERROR;
+    }
+    if (fwrite (&header, sizeof (header), 1, fp) != 1)
+    {
+        fclose (fp);
+        fp = NULL;
+        return (int)BinaryFileReturnCodes::WRITE_ERROR;
+    }
+    return (int)BinaryFileReturnCodes::STATUS_OK;
+}
+
+int BinaryFileWriter::open_for_append ()
+{
+    fp = fopen (file_name.c_str (), "r+b");
+    if (fp == NULL)
+    {
+        return (int)BinaryFileReturnCodes::OPEN_ERROR;
+    }
+    if (get_file_size (fp) == 0)
+    {
+        fclose (fp);
+        fp = NULL;
+        return (int)BinaryFileReturnCodes::OPEN_ERROR;
+    }
+    struct BinaryFileHeader existing_header;
+    int res = read_binary_file_header (fp, existing_header);
+    if ((res == (int)BinaryFileReturnCodes::STATUS_OK) &&
+        ((existing_header.num_rows != header.num_rows) ||
+            (existing_header.value_type != header.value_type)))
+    {
+        res = (int)BinaryFileReturnCodes::INVALID_FORMAT_ERROR;
+    }
+    int64_t data_end = 0;
+    if (res == (int)BinaryFileReturnCodes::STATUS_OK)
+    {
+        res = read_binary_file_index (fp, existing_header, index, total_samples, data_end);
+    }
+    // new data overwrites old index, it will be written again on close
+    if ((res == (int)BinaryFileReturnCodes::STATUS_OK) &&
+        (file_seek (fp, data_end, SEEK_SET) != 0))
+    {
+        res = (int)BinaryFileReturnCodes::READ_ERROR;
+    }
+    if (res != (int)BinaryFileReturnCodes::STATUS_OK)
+    {
+        fclose (fp);
+        fp = NULL;
+        index.clear ();
+        total_samples = 0;
+        return res;
+    }
+    header = existing_header;
+    return res;
+}
+
+int BinaryFileWriter::write_samples (const double *data, int count)
+{
+    if (fp == NULL)
+    {
+        return (int)BinaryFileReturnCodes::OPEN_ERROR;
+    }
+    if ((data == NULL) || (count < 0))
+    {
+        return (int)BinaryFileReturnCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int num_rows = header.num_rows;
+    for (int i = 0; i < count; i++)
+    {
+        const double *sample = data + (size_t)i * num_rows;
+        for (int j = 0; j < num_rows; j++)
+        {
+            pending[(size_t)j * BINARY_FILE_BLOCK_SIZE + pending_count] = sample[j];
+        }
+        pending_count++;
+        if (pending_count == BINARY_FILE_BLOCK_SIZE)
+        {
+            int res = flush_block ();
+            if (res != (int)BinaryFileReturnCodes::STATUS_OK)
+            {
+                return res;
+            }
+        }
+    }
+    return (int)BinaryFileReturnCodes::STATUS_OK;
+}
+
+int BinaryFileWriter::write_rows (const double *data, int num_cols)
+{
+    if (fp == NULL)
+    {
+        return (int)BinaryFileReturnCodes::OPEN_ERROR;
+    }
+    if ((data == NULL) || (num_cols < 0))
+    {
+        return (int)BinaryFileReturnCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int num_rows = header.num_rows;
+    int written = 0;
+    while (written < num_cols)
+    {
+        int chunk = BINARY_FILE_BLOCK_SIZE - pending_count;
+        if (chunk > num_cols - written)
+        {
+            chunk = num_cols - written;
+        }
+        for (int j = 0; j < num_rows; j++)
+        {
+            memcpy (pending.data () + (size_t)j * BINARY_FILE_BLOCK_SIZE + pending_count,
+                data + (size_t)j * num_cols + written, sizeof (double) * chunk);
+        }
+        pending_count += chunk;
+        written += chunk;
+        if (pending_count == BINARY_FILE_BLOCK_SIZE)
+        {
+            int res = flush_block ();
+            if (res != (int)BinaryFileReturnCodes::STATUS_OK)
+            {
+                return res;
+            }
+        }
+    }
+    return (int)BinaryFileReturnCodes::STATUS_OK;
+}
+
+int BinaryFileWriter::flush_block ()
+{
+    if (pending_count == 0)
+    {
+        return (int)BinaryFileReturnCodes::STATUS_OK;
+    }
+    int num_rows = header.num_rows;
+    int value_size = get_value_size (header.value_type);
+    struct BinaryBlockHeader block_header;
+    block_header.block_type = (int32_t)BinaryBlockTypes::DATA;
+    block_header.num_samples = pending_count;
+    block_header.payload_size = (int64_t)pending_count * num_rows * value_size;
+
+    if (header.value_type == (int32_t)BinaryValueTypes::FLOAT32)
+    {
+        float *values = (float *)block_buf.data ();
+        for (int j = 0; j < num_rows; j++)
+        {
+            const double *row = pending.data () + (size_t)j * BINARY_FILE_BLOCK_SIZE;
+            for (int i = 0; i < pending_count; i++)
+            {
+                values[(size_t)j * pending_count + i] = (float)row[i];
+            }
+        }
+    }
+    else
+    {
+        for (int j = 0; j < num_rows; j++)
+        {
+            memcpy (block_buf.data () + (size_t)j * pending_count * sizeof (double),
+                pending.data () + (size_t)j * BINARY_FILE_BLOCK_SIZE,
+                sizeof (double) * pending_count);
+        }
+    }
+
+    struct BinaryIndexEntry entry;
+    entry.offset = (int64_t)file_tell (fp);
+    entry.first_sample = total_samples;
+    entry.num_samples = pending_count;
+    entry.reserved = 0;
+    if ((fwrite (&block_header, sizeof (block_header), 1, fp) != 1) ||
+        (fwrite (block_buf.data (), 1, (size_t)block_header.payload_size, fp) !=
+            (size_t)block_header.payload_size))
+    {
+        return (int)BinaryFileReturnCodes::WRITE_ERROR;
+    }
+    index.push_back (entry);
+    total_samples += pending_count;
+    pending_count = 0;
+    return (int)BinaryFileReturnCodes::STATUS_OK;
+}
+
+int BinaryFileWriter::close ()
+{
+    if (fp == NULL)
+    {
+        return (int)BinaryFileReturnCodes::STATUS_OK;
+    }
+    int res = flush_block ();
+    if (res == (int)BinaryFileReturnCodes::STATUS_OK)
+    {
+        struct BinaryFileFooter footer;
+        footer.index_offset = (int64_t)file_tell (fp);
+        footer.total_samples = total_samples;
+        memset (footer.magic, 0, sizeof (footer.magic));
+        memcpy (footer.magic, BINARY_FILE_INDEX_MAGIC, sizeof (BINARY_FILE_INDEX_MAGIC));
+        struct BinaryBlockHeader block_header;
+        block_header.block_type = (int32_t)BinaryBlockTypes::INDEX;
+        block_header.num_samples = (int32_t)index.size ();
+        block_header.payload_size =
+            (int64_t)(index.size () * sizeof (struct BinaryIndexEntry) + sizeof (footer));
+        if ((fwrite (&block_header, sizeof (block_header), 1, fp) != 1) ||
+            (fwrite (index.data (), sizeof (struct BinaryIndexEntry), index.size (), fp) !=
+                index.size ()) ||
+            (fwrite (&footer, sizeof (footer), 1, fp) != 1))
+        {
+            res = (int)BinaryFileReturnCodes::WRITE_ERROR;
+        }
+    }
+    if (fflush (fp) != 0)
+    {
+        res = (int)BinaryFileReturnCodes::WRITE_ERROR;
+    }
+    fclose (fp);
+    fp = NULL;
+    return res;
+}
+
+
+///////////////////////////////
+/////////// Reader ////////////
+///////////////////////////////
+
+BinaryFileReader::BinaryFileReader (const char *file_name)
+{
+    this->file_name = file_name;
+    fp = NULL;
+    memset (&header, 0, sizeof (header));
+    total_samples = 0;
+    cached_block = -1;
+}
+
+BinaryFileReader::~BinaryFileReader ()
+{
+    close ();
+}
+
+int BinaryFileReader::open ()
+{
+    if (fp != NULL)
+    {
+        return (int)BinaryFileReturnCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    fp = fopen (file_name.c_str (), "rb");
+    if (fp == NULL)
+    {
+        return (int)BinaryFileReturnCodes::OPEN_ERROR;
+    }
+    int res = read_binary_file_header (fp, header);
+    int64_t data_end = 0;
+    if (res == (int)BinaryFileReturnCodes::STATUS_OK)
+    {
+        res = read_binary_file_index (fp, header, index, total_samples, data_end);
+    }
+    if (res != (int)BinaryFileReturnCodes::STATUS_OK)
+    {
+        close ();
+        return res;
+    }
+    cached_block = -1;
+    block_buf.resize (
+        (size_t)header.num_rows * BINARY_FILE_BLOCK_SIZE * get_value_size (header.value_type));
+    cached_values.resize ((size_t)header.num_rows * BINARY_FILE_BLOCK_SIZE);
+    return res;
+}
+
+void BinaryFileReader::close ()
+{
+    if (fp != NULL)
+    {
+        fclose (fp);
+        fp = NULL;
+    }
+    index.clear ();
+    total_samples = 0;
+    cached_block = -1;
+}
+
+int BinaryFileReader::load_block (int block_num)
+{
+    if (block_num == cached_block)
+    {
+        return (int)BinaryFileReturnCodes::STATUS_OK;
+    }
+    const struct BinaryIndexEntry &entry = index[block_num];
+    int num_rows = header.num_rows;
+    int value_size = get_value_size (header.value_type);
+    struct BinaryBlockHeader block_header;
+    if ((file_seek (fp, entry.offset, SEEK_SET) != 0) ||
+        (fread (&block_header, sizeof (block_header), 1, fp) != 1))
+    {
+        return (int)BinaryFileReturnCodes::READ_ERROR;
+    }
+    if ((block_header.block_type != (int32_t)BinaryBlockTypes::DATA) ||
+        (block_header.num_samples != entry.num_samples) ||
+        (block_header.num_samples > BINARY_FILE_BLOCK_SIZE) ||
+        (block_header.payload_size != (int64_t)block_header.num_samples * num_rows * value_size))
+    {
+        return (int)BinaryFileReturnCodes::INVALID_FORMAT_ERROR;
+    }
+    size_t num_values = (size_t)block_header.num_samples * num_rows;
+    if (header.value_type == (int32_t)BinaryValueTypes::FLOAT32)
+    {
+        if (fread (block_buf.data (), sizeof (float), num_values, fp) != num_values)
+        {
+            return (int)BinaryFileReturnCodes::READ_ERROR;
+        }
+        const float *values = (const float *)block_buf.data ();
+        for (size_t i = 0; i < num_values; i++)
+        {
+            cached_values[i] = (double)values[i];
+        }
+    }
+    else if (fread (cached_values.data (), sizeof (double), num_values, fp) != num_values)
+    {
+        return (int)BinaryFileReturnCodes::READ_ERROR;
+    }
+    cached_block = block_num;
+    return (int)BinaryFileReturnCodes::STATUS_OK;
+}
+
+int BinaryFileReader::read_rows (
+    int64_t first_sample, int64_t count, double *output, int64_t output_cols)
+{
+    if (fp == NULL)
+    {
+        return (int)BinaryFileReturnCodes::OPEN_ERROR;
+    }
+    if ((output == NULL) || (first_sample < 0) || (count < 0) || (output_cols < count) ||
+        (first_sample + count > total_samples))
+    {
+        return (int)BinaryFileReturnCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (count == 0)
+    {
+        return (int)BinaryFileReturnCodes::STATUS_OK;
+    }
+    // binary search for the block which contains first_sample
+    int left = 0;
+    int right = (int)index.size () - 1;
+    while (left < right)
+    {
+        int mid = (left + right + 1) / 2;
+        if (index[mid].first_sample <= first_sample)
+        {
+            left = mid;
+        }
+        else
+        {
+            right = mid - 1;
+        }
+    }
+    int num_rows = header.num_rows;
+    int64_t done = 0;
+    for (int block = left; done < count; block++)
+    {
+        int res = load_block (block);
+        if (res != (int)BinaryFileReturnCodes::STATUS_OK)
+        {
+            return res;
+        }
+        int64_t block_size = index[block].num_samples;
+        int64_t offset = first_sample + done - index[block].first_sample;
+        int64_t chunk = block_size - offset;
+        if (chunk > count - done)
+        {
+            chunk = count - done;
+        }
+        for (int j = 0; j < num_rows; j++)
+        {
+            memcpy (output + j * output_cols + done,
+                cached_values.data () + j * block_size + offset, sizeof (double) * chunk);
+        }
+        done += chunk;
+    }
+    return (int)BinaryFileReturnCodes::STATUS_OK;
+}
+
+int BinaryFileReader::read_samples (int64_t first_sample, int64_t count, double *output)
+{
+    if ((output == NULL) || (count < 0))
+    {
+        return (int)BinaryFileReturnCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int num_rows = header.num_rows;
+    std::vector<double> rows ((size_t)num_rows * BINARY_FILE_BLOCK_SIZE);
+    int64_t done = 0;
+    while (done < count)
+    {
+        int64_t chunk = count - done;
+        if (chunk > BINARY_FILE_BLOCK_SIZE)
+        {
+            chunk = BINARY_FILE_BLOCK_SIZE;
+        }
+        int res = read_rows (first_sample + done, chunk, rows.data (), BINARY_FILE_BLOCK_SIZE);
+        if (res != (int)BinaryFileReturnCodes::STATUS_OK)
+        {
+            return res;
+        }
+        for (int64_t i = 0; i < chunk; i++)
+        {
+            for (int j = 0; j < num_rows; j++)
+            {
+                output[(done + i) * num_rows + j] = rows[j * BINARY_FILE_BLOCK_SIZE + i];
+            }
+        }
+        done += chunk;
+    }
+    return (int)BinaryFileReturnCodes::STATUS_OK;
+}
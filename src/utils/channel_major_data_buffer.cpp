@@ -0,0 +1,316 @@
+#include "channel_major_data_buffer.h"
+
+#include <algorithm>
+#include <new>
+
+
+ChannelMajorDataBuffer::ChannelMajorDataBuffer (int num_samples, size_t buffer_size,
+    DataBufferPrecision precision, const std::vector<int> &full_precision_rows)
+{
+    this->buffer_size = buffer_size;
+    this->num_samples = num_samples;
+    first_free = first_used = count = 0;
+    overwritten = 0;
+
+    data = NULL;
+    compact_data = NULL;
+    if ((buffer_size == 0) || (num_samples <= 0))
+    {
+        return;
+    }
+    try
+    {
+        std::vector<bool> is_double (num_samples, precision == DataBufferPrecision::FLOAT64);
+        for (int row : full_precision_rows)
+        {
+            if ((row >= 0) && (row < num_samples))
+            {
+                is_double[row] = true;
+            }
+        }
+        size_t num_double_rows = std::count (is_double.begin (), is_double.end (), true);
+        size_t num_float_rows = (size_t)num_samples - num_double_rows;
+        data = new double[buffer_size * num_double_rows];
+        compact_data = new float[buffer_size * num_float_rows];
+        size_t double_pos = 0;
+        size_t float_pos = 0;
+        for (int i = 0; i < num_samples; i++)
+        {
+            if (is_double[i])
+            {
+                double_rows.push_back (data + buffer_size * double_pos++);
+                float_rows.push_back (NULL);
+            }
+            else
+            {
+                double_rows.push_back (NULL);
+                float_rows.push_back (compact_data + buffer_size * float_pos++);
+            }
+            all_channels.push_back (i);
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        delete[] data;
+        delete[] compact_data;
+        data = NULL;
+        compact_data = NULL;
+    }
+}
+
+ChannelMajorDataBuffer::~ChannelMajorDataBuffer ()
+{
+    delete[] data;
+    delete[] compact_data;
+}
+
+bool ChannelMajorDataBuffer::is_ready ()
+{
+    return ((data != NULL) && (compact_data != NULL));
+}
+
+void ChannelMajorDataBuffer::add_data (double *value)
+{
+    if (!is_ready ())
+    {
+        return;
+    }
+
+    lock.lock ();
+
+    if (count == 0)
+    {
+        first_used = first_free = 0;
+    }
+    else if (first_free == first_used)
+    {
+        first_used = (first_used + 1) % buffer_size;
+        count--;
+        overwritten++;
+    }
+
+    for (size_t i = 0; i < num_samples; i++)
+    {
+        if (double_rows[i] != NULL)
+        {
+            double_rows[i][first_free] = value[i];
+        }
+        else
+        {
+            float_rows[i][first_free] = (float)value[i];
+        }
+    }
+    first_free = (first_free + 1) % buffer_size;
+    count++;
+
+    lock.unlock ();
+}
+
+void ChannelMajorDataBuffer::add_data_block (const double *values, size_t count)
+{
+    if ((!is_ready ()) || (count == 0))
+    {
+        return;
+    }
+
+    lock.lock ();
+
+    size_t skipped = 0;
+    if (count >= buffer_size)
+    {
+        skipped = count - buffer_size;
+        overwritten += this->count + skipped;
+        first_used = first_free = 0;
+        this->count = 0;
+    }
+    else if (this->count == 0)
+    {
+        first_used = first_free = 0;
+    }
+    size_t to_copy = count - skipped;
+    size_t free_space = buffer_size - this->count;
+    if (to_copy > free_space)
+    {
+        first_used = (first_used + to_copy - free_space) % buffer_size;
+        overwritten += to_copy - free_space;
+        this->count = buffer_size;
+    }
+    else
+    {
+        this->count += to_copy;
+    }
+    // each row is filled by strided gather from block, at most two ranges per row
+    const double *src = values + skipped * num_samples;
+    size_t first_half = std::min (to_copy, buffer_size - first_free);
+    for (size_t i = 0; i < num_samples; i++)
+    {
+        for (size_t part = 0, done = 0; part < 2; part++)
+        {
+            size_t start = (part == 0) ? first_free : 0;
+            size_t size = (part == 0) ? first_half : to_copy - first_half;
+            const double *in = src + done * num_samples + i;
+            if (double_rows[i] != NULL)
+            {
+                double *out = double_rows[i] + start;
+                for (size_t j = 0; j < size; j++)
+                {
+                    out[j] = in[j * num_samples];
+                }
+            }
+            else
+            {
+                float *out = float_rows[i] + start;
+                for (size_t j = 0; j < size; j++)
+                {
+                    out[j] = (float)in[j * num_samples];
+                }
+            }
+            done += size;
+        }
+    }
+    first_free = (first_free + to_copy) % buffer_size;
+
+    lock.unlock ();
+}
+
+void ChannelMajorDataBuffer::get_chunk (size_t start, size_t size, double *data_buf,
+    const int *channels, int num_channels, size_t result_size, size_t offset)
+{
+    if (start + size > buffer_size)
+    {
+        size_t first_half = buffer_size - start;
+        get_chunk (start, first_half, data_buf, channels, num_channels, result_size, offset);
+        get_chunk (0, size - first_half, data_buf, channels, num_channels, result_size,
+            offset + first_half);
+    }
+    else if (channels != NULL)
+    {
+        for (int i = 0; i < num_channels; i++)
+        {
+            double *out = data_buf + i * result_size + offset;
+            if (double_rows[channels[i]] != NULL)
+            {
+                memcpy (out, double_rows[channels[i]] + start, size * sizeof (double));
+            }
+            else
+            {
+                const float *row = float_rows[channels[i]] + start;
+                for (size_t j = 0; j < size; j++)
+                {
+                    out[j] = row[j];
+                }
+            }
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < num_samples; i++)
+        {
+            double *out = data_buf + offset * num_samples + i;
+            if (double_rows[i] != NULL)
+            {
+                const double *row = double_rows[i] + start;
+                for (size_t j = 0; j < size; j++)
+                {
+                    out[j * num_samples] = row[j];
+                }
+            }
+            else
+            {
+                const float *row = float_rows[i] + start;
+                for (size_t j = 0; j < size; j++)
+                {
+                    out[j * num_samples] = row[j];
+                }
+            }
+        }
+    }
+}
+
+// Removes data from buffer
+size_t ChannelMajorDataBuffer::get_data (size_t max_count, double *data_buf)
+{
+    return read_data (max_count, NULL, 0, data_buf);
+}
+
+size_t ChannelMajorDataBuffer::get_data_transposed (size_t max_count, double *data_buf)
+{
+    return read_data (max_count, all_channels.data (), (int)num_samples, data_buf);
+}
+
+size_t ChannelMajorDataBuffer::get_data_channels (
+    size_t max_count, const int *channels, int num_channels, double *data_buf)
+{
+    return read_data (max_count, channels, num_channels, data_buf);
+}
+
+// Doesn't remove data from buffer
+size_t ChannelMajorDataBuffer::get_current_data (size_t max_count, double *data_buf)
+{
+    return read_current_data (max_count, NULL, 0, data_buf);
+}
+
+size_t ChannelMajorDataBuffer::get_current_data_transposed (size_t max_count, double *data_buf)
+{
+    return read_current_data (max_count, all_channels.data (), (int)num_samples, data_buf);
+}
+
+size_t ChannelMajorDataBuffer::get_current_data_channels (
+    size_t max_count, const int *channels, int num_channels, double *data_buf)
+{
+    return read_current_data (max_count, channels, num_channels, data_buf);
+}
+
+size_t ChannelMajorDataBuffer::read_data (
+    size_t max_count, const int *channels, int num_channels, double *data_buf)
+{
+    lock.lock ();
+    size_t result_count = max_count;
+    if (result_count > count)
+    {
+        result_count = count;
+    }
+    if (result_count)
+    {
+        get_chunk (first_used, result_count, data_buf, channels, num_channels, result_count, 0);
+        first_used = (first_used + result_count) % buffer_size;
+        count -= result_count;
+    }
+    lock.unlock ();
+    return result_count;
+}
+
+size_t ChannelMajorDataBuffer::read_current_data (
+    size_t max_count, const int *channels, int num_channels, double *data_buf)
+{
+    lock.lock ();
+    size_t result_count = max_count;
+    if (result_count > count)
+    {
+        result_count = count;
+    }
+    if (result_count)
+    {
+        size_t first_return = (first_used + (count - result_count)) % buffer_size;
+        get_chunk (first_return, result_count, data_buf, channels, num_channels, result_count, 0);
+    }
+    lock.unlock ();
+    return result_count;
+}
+
+size_t ChannelMajorDataBuffer::get_data_count ()
+{
+    lock.lock ();
+    size_t result = count;
+    lock.unlock ();
+    return result;
+}
+
+void ChannelMajorDataBuffer::get_stats (struct DataBufferStats &stats)
+{
+    lock.lock ();
+    stats.overwritten = overwritten;
+    lock.unlock ();
+    stats.spilled = 0;
+    stats.spilled_pending = 0;
+}
@@ -1,5 +1,6 @@
 #include "data_buffer.h"
 
+#include <algorithm>
 #include <new>
 
 DataBuffer::DataBuffer (int num_samples, size_t buffer_size)
@@ -7,19 +8,22 @@ DataBuffer::DataBuffer (int num_samples, size_t buffer_size)
     this->buffer_size = buffer_size;
     this->num_samples = num_samples;
     first_free = first_used = count = 0;
+    overwritten = 0;
 
-    if (buffer_size == 0)
-    {
-        data = NULL;
-    }
-    else
+    data = NULL;
+    if (buffer_size > 0)
     {
         try
         {
             data = new double[buffer_size * num_samples];
+            for (int i = 0; i < num_samples; i++)
+            {
+                all_channels.push_back (i);
+            }
         }
         catch (const std::bad_alloc &)
         {
+            delete[] data;
             data = NULL;
         }
     }
@@ -52,6 +56,7 @@ void DataBuffer::add_data (double *value)
     {
         first_used = next (first_used);
         count--;
+        overwritten++;
     }
 
     memcpy (this->data + first_free * num_samples, value, sizeof (double) * num_samples);
@@ -61,24 +66,108 @@ void DataBuffer::add_data (double *value)
     lock.unlock ();
 }
 
-void DataBuffer::get_chunk (size_t start, size_t size, double *data_buf)
+void DataBuffer::add_data_block (const double *values, size_t count)
 {
-    if (start + size < buffer_size)
+    if ((!is_ready ()) || (count == 0))
+    {
+        return;
+    }
+
+    lock.lock ();
+
+    size_t sample_size = sizeof (double) * num_samples;
+    if (count >= buffer_size)
+    {
+        // older samples from block would be overwritten by newer ones anyway
+        overwritten += this->count + count - buffer_size;
+        memcpy (data, values + (count - buffer_size) * num_samples, buffer_size * sample_size);
+        first_used = first_free = 0;
+        this->count = buffer_size;
+        lock.unlock ();
+        return;
+    }
+
+    if (this->count == 0)
     {
-        memcpy (data_buf, data + start * num_samples, size * sizeof (double) * num_samples);
+        first_used = first_free = 0;
+    }
+    size_t free_space = buffer_size - this->count;
+    if (count > free_space)
+    {
+        first_used = (first_used + count - free_space) % buffer_size;
+        overwritten += count - free_space;
+        this->count = buffer_size;
     }
     else
+    {
+        this->count += count;
+    }
+    size_t first_half = std::min (count, buffer_size - first_free);
+    memcpy (data + first_free * num_samples, values, first_half * sample_size);
+    memcpy (data, values + first_half * num_samples, (count - first_half) * sample_size);
+    first_free = (first_free + count) % buffer_size;
+
+    lock.unlock ();
+}
+
+void DataBuffer::get_chunk (size_t start, size_t size, double *data_buf, const int *channels,
+    int num_channels, size_t result_size, size_t offset)
+{
+    if (start + size > buffer_size)
     {
         size_t first_half = buffer_size - start;
-        size_t second_half = size - first_half;
-        memcpy (data_buf, data + start * num_samples, first_half * sizeof (double) * num_samples);
-        memcpy (
-            data_buf + first_half * num_samples, data, second_half * sizeof (double) * num_samples);
+        get_chunk (start, first_half, data_buf, channels, num_channels, result_size, offset);
+        get_chunk (0, size - first_half, data_buf, channels, num_channels, result_size,
+            offset + first_half);
+    }
+    else if (channels != NULL)
+    {
+        transpose (data + start * num_samples, size, num_samples, channels, num_channels,
+            data_buf + offset, result_size);
+    }
+    else
+    {
+        memcpy (data_buf + offset * num_samples, data + start * num_samples,
+            size * sizeof (double) * num_samples);
     }
 }
 
 // Removes data from buffer
 size_t DataBuffer::get_data (size_t max_count, double *data_buf)
+{
+    return read_data (max_count, NULL, 0, data_buf);
+}
+
+size_t DataBuffer::get_data_transposed (size_t max_count, double *data_buf)
+{
+    return read_data (max_count, all_channels.data (), (int)num_samples, data_buf);
+}
+
+size_t DataBuffer::get_data_channels (
+    size_t max_count, const int *channels, int num_channels, double *data_buf)
+{
+    return read_data (max_count, channels, num_channels, data_buf);
+}
+
+// Doesn't remove data from buffer
+size_t DataBuffer::get_current_data (size_t max_count, double *data_buf)
+{
+    return read_current_data (max_count, NULL, 0, data_buf);
+}
+
+size_t DataBuffer::get_current_data_transposed (size_t max_count, double *data_buf)
+{
+    return read_current_data (max_count, all_channels.data (), (int)num_samples, data_buf);
+}
+
+size_t DataBuffer::get_current_data_channels (
+    size_t max_count, const int *channels, int num_channels, double *data_buf)
+{
+    return read_current_data (max_count, channels, num_channels, data_buf);
+}
+
+size_t DataBuffer::read_data (
+    size_t max_count, const int *channels, int num_channels, double *data_buf)
 {
     lock.lock ();
     size_t result_count = max_count;
@@ -88,7 +177,7 @@ size_t DataBuffer::get_data (size_t max_count, double *data_buf)
     }
     if (result_count)
     {
-        get_chunk (first_used, result_count, data_buf);
+        get_chunk (first_used, result_count, data_buf, channels, num_channels, result_count, 0);
         first_used = (first_used + result_count) % buffer_size;
         count -= result_count;
     }
@@ -96,8 +185,8 @@ size_t DataBuffer::get_data (size_t max_count, double *data_buf)
     return result_count;
 }
 
-// Doesn't remove data from buffer
-size_t DataBuffer::get_current_data (size_t max_count, double *data_buf)
+size_t DataBuffer::read_current_data (
+    size_t max_count, const int *channels, int num_channels, double *data_buf)
 {
     lock.lock ();
     size_t result_count = max_count;
@@ -106,7 +195,7 @@ size_t DataBuffer::get_current_data (size_t max_count, double *data_buf)
     if (result_count)
     {
         size_t first_return = (first_used + (count - result_count)) % buffer_size;
-        get_chunk (first_return, result_count, data_buf);
+        get_chunk (first_return, result_count, data_buf, channels, num_channels, result_count, 0);
     }
     lock.unlock ();
     return result_count;
@@ -119,3 +208,12 @@ size_t DataBuffer::get_data_count ()
     lock.unlock ();
     return result;
 }
+
+void DataBuffer::get_stats (struct DataBufferStats &stats)
+{
+    lock.lock ();
+    stats.overwritten = overwritten;
+    lock.unlock ();
+    stats.spilled = 0;
+    stats.spilled_pending = 0;
+}
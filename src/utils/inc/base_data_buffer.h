@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+
+enum class DataBufferTypes : int
+{
+    SPINLOCK = 0,
+    LOCK_FREE = 1,
+    CHANNEL_MAJOR = 2,
+    SPILL = 3
+};
+
+// storage type of values in buffer, data is always returned as doubles
+enum class DataBufferPrecision : int
+{
+    FLOAT64 = 0,
+    FLOAT32 = 1
+};
+
+struct DataBufferStats
+{
+    size_t overwritten;     // samples lost because buffer was full
+    size_t spilled;         // samples moved to spill file since creation
+    size_t spilled_pending; // spilled samples which were not read yet
+};
+
+class BaseDataBuffer
+{
+public:
+    // returns NULL for unknown type or if type doesn't support precision, check is_ready () for
+    // allocation errors, rows from full_precision_rows are stored as doubles in any precision
+    static BaseDataBuffer *create (int num_samples, size_t buffer_size, DataBufferTypes type,
+        DataBufferPrecision precision = DataBufferPrecision::FLOAT64,
+        const std::vector<int> &full_precision_rows = std::vector<int> ());
+    static bool type_from_string (std::string type_str, DataBufferTypes &type);
+    static bool precision_from_string (std::string precision_str, DataBufferPrecision &precision);
+
+    virtual ~BaseDataBuffer ()
+    {
+    }
+
+    virtual void add_data (double *value) = 0;
+    // adds count samples stored one after another, same as count calls of add_data but buffer is
+    // locked once, if count exceeds buffer size only the newest samples are kept
+    virtual void add_data_block (const double *values, size_t count) = 0;
+    // Removes data from buffer
+    virtual size_t get_data (size_t max_count, double *data_buf) = 0;
+    // Doesn't remove data from buffer
+    virtual size_t get_current_data (size_t max_count, double *data_buf) = 0;
+    virtual size_t get_data_count () = 0;
+    virtual bool is_ready () = 0;
+    // same as get_data and get_current_data but data_buf is row-major [num_samples x result], so
+    // each value of a sample goes to its own row
+    virtual size_t get_data_transposed (size_t max_count, double *data_buf) = 0;
+    virtual size_t get_current_data_transposed (size_t max_count, double *data_buf) = 0;
+    // same as transposed methods but only values with indexes from channels are returned, data_buf
+    // is [num_channels x result], channels must be in range [0, num_samples)
+    virtual size_t get_data_channels (
+        size_t max_count, const int *channels, int num_channels, double *data_buf) = 0;
+    virtual size_t get_current_data_channels (
+        size_t max_count, const int *channels, int num_channels, double *data_buf) = 0;
+    virtual void get_stats (struct DataBufferStats &stats) = 0;
+
+protected:
+    // cache blocked copy of count samples stored one after another into rows of dst, value
+    // channels[r] of sample i goes to dst[r * dst_stride + i]
+    static void transpose (const double *src, size_t count, size_t num_samples,
+        const int *channels, int num_channels, double *dst, size_t dst_stride);
+};
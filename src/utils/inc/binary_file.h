@@ -0,0 +1,165 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// Binary recording format, values are stored in host byte order (little endian on all supported
+// platforms, byte_order field is used to detect mismatch):
+//   BinaryFileHeader
+//   data blocks: BinaryBlockHeader + num_rows arrays of num_samples values (channel by channel)
+//   index block: BinaryBlockHeader + BinaryIndexEntry for each data block + BinaryFileFooter
+// Index block is written on close, footer is the last part of the file and points to it. If file
+// was not closed properly readers rebuild index by walking block headers.
+
+#define BINARY_FILE_MAGIC "BFBINARY"
+#define BINARY_FILE_INDEX_MAGIC "BFINDEX"
+#define BINARY_FILE_VERSION 1
+#define BINARY_FILE_BYTE_ORDER 0x01020304
+#define BINARY_FILE_BLOCK_SIZE 1024 // max samples in data block
+
+
+enum class BinaryFileReturnCodes : int
+{
+    STATUS_OK = 0,
+    OPEN_ERROR = -1,
+    WRITE_ERROR = -2,
+    READ_ERROR = -3,
+    INVALID_FORMAT_ERROR = -4,
+    INVALID_ARGUMENTS_ERROR = -5
+};
+
+enum class BinaryValueTypes : int32_t
+{
+    FLOAT64 = 0,
+    FLOAT32 = 1
+};
+
+enum class BinaryBlockTypes : int32_t
+{
+    DATA = 1,
+    INDEX = 2
+};
+
+#pragma pack(push, 1)
+struct BinaryFileHeader
+{
+    char magic[8];
+    int32_t version;
+    int32_t byte_order;
+    int32_t board_id;
+    int32_t preset;
+    int32_t num_rows;
+    int32_t sampling_rate; // 0 if unknown
+    int32_t value_type;
+    int32_t reserved[7];
+};
+
+struct BinaryBlockHeader
+{
+    int32_t block_type;
+    int32_t num_samples;  // samples in data block or entries in index block
+    int64_t payload_size; // bytes after block header
+};
+
+struct BinaryIndexEntry
+{
+    int64_t offset; // offset of block header from the start of file
+    int64_t first_sample;
+    int32_t num_samples;
+    int32_t reserved;
+};
+
+struct BinaryFileFooter
+{
+    int64_t index_offset; // offset of index block header
+    int64_t total_samples;
+    char magic[8];
+};
+#pragma pack(pop)
+
+// file modes: wb and ab for float64, wb_f32 and ab_f32 for float32 values
+bool is_binary_file_mode (const char *file_mode);
+// returns true if file starts with BINARY_FILE_MAGIC
+bool is_binary_file (const char *file_name);
+
+
+class BinaryFileWriter
+{
+public:
+    BinaryFileWriter (const char *file_name, const char *file_mode, int num_rows, int board_id,
+        int preset, int sampling_rate);
+    ~BinaryFileWriter ();
+
+    int open ();
+    // count samples, each sample has num_rows values, layout used in DataBuffer
+    int write_samples (const double *data, int count);
+    // num_rows rows with num_cols values each, layout used in get_board_data
+    int write_rows (const double *data, int num_cols);
+    // writes pending samples and index, called from destructor
+    int close ();
+
+private:
+    std::string file_name;
+    bool append;
+    FILE *fp;
+    struct BinaryFileHeader header;
+    std::vector<double> pending; // num_rows arrays of BINARY_FILE_BLOCK_SIZE values
+    int pending_count;
+    std::vector<struct BinaryIndexEntry> index;
+    int64_t total_samples;
+    std::vector<char> block_buf;
+
+    int open_for_append ();
+    int flush_block ();
+};
+
+
+class BinaryFileReader
+{
+public:
+    BinaryFileReader (const char *file_name);
+    ~BinaryFileReader ();
+
+    int open ();
+    void close ();
+
+    const struct BinaryFileHeader &get_header ()
+    {
+        return header;
+    }
+
+    int64_t get_total_samples ()
+    {
+        return total_samples;
+    }
+
+    const std::vector<struct BinaryIndexEntry> &get_index ()
+    {
+        return index;
+    }
+
+    // reads samples [first_sample, first_sample + count) in get_board_data layout, value from row
+    // i and sample j is stored in output[i * output_cols + j]
+    int read_rows (int64_t first_sample, int64_t count, double *output, int64_t output_cols);
+    // reads samples [first_sample, first_sample + count) in DataBuffer layout
+    int read_samples (int64_t first_sample, int64_t count, double *output);
+
+private:
+    std::string file_name;
+    FILE *fp;
+    struct BinaryFileHeader header;
+    std::vector<struct BinaryIndexEntry> index;
+    int64_t total_samples;
+    int cached_block;
+    std::vector<double> cached_values;
+    std::vector<char> block_buf;
+
+    int load_block (int block_num);
+};
+
+// used by reader and writer, data_end is offset after the last data block
+int read_binary_file_header (FILE *fp, struct BinaryFileHeader &header);
+int read_binary_file_index (FILE *fp, const struct BinaryFileHeader &header,
+    std::vector<struct BinaryIndexEntry> &index, int64_t &total_samples, int64_t &data_end);
@@ -25,3 +25,70 @@ inline int get_brainflow_batch_size (int default_size = 3)
     }
     return size;
 }
+
+// spinlock (default), lock_free, channel_major or spill, see BaseDataBuffer::type_from_string
+inline std::string get_brainflow_buffer_type (std::string default_type = "spinlock")
+{
+    std::string type = default_type;
+    if (const char *env_p = std::getenv ("BRAINFLOW_BUFFER_TYPE"))
+    {
+        type = env_p;
+    }
+    return type;
+}
+
+// float64 (default) or float32 for all presets, or list of presets like
+// "default:float32,auxiliary:float64", see BaseDataBuffer::precision_from_string
+inline std::string get_brainflow_buffer_precision (std::string default_precision = "float64")
+{
+    std::string precision = default_precision;
+    if (const char *env_p = std::getenv ("BRAINFLOW_BUFFER_PRECISION"))
+    {
+        precision = env_p;
+    }
+    return precision;
+}
+
+// directory for spill files of spill buffer type, system temp dir is used if not set
+inline std::string get_brainflow_spill_dir (std::string default_dir = "")
+{
+    std::string dir = default_dir;
+    if (const char *env_p = std::getenv ("BRAINFLOW_SPILL_DIR"))
+    {
+        dir = env_p;
+    }
+    return dir;
+}
+
+// number of shared io reactor threads for network boards, 0 (default) to use thread per socket
+inline int get_brainflow_io_reactor_threads (int default_threads = 0)
+{
+    int num_threads = default_threads;
+    if (const char *env_p = std::getenv ("BRAINFLOW_IO_REACTOR_THREADS"))
+    {
+        std::string str_env = env_p;
+        try
+        {
+            int parsed_threads = std::stoi (str_env);
+            if ((parsed_threads >= 0) && (parsed_threads < 256))
+            {
+                num_threads = parsed_threads;
+            }
+        }
+        catch (...)
+        {
+        }
+    }
+    return num_threads;
+}
+
+// comma separated list of cores to pin io reactor threads to like "2,3", not pinned if not set
+inline std::string get_brainflow_io_reactor_cpus (std::string default_cpus = "")
+{
+    std::string cpus = default_cpus;
+    if (const char *env_p = std::getenv ("BRAINFLOW_IO_REACTOR_CPUS"))
+    {
+        cpus = env_p;
+    }
+    return cpus;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "base_data_buffer.h"
+#include "spinlock.h"
+
+
+// Ring buffer which keeps each value of a sample in its own circular array, rows of board data are
+// contiguous and reading them is a copy of at most two ranges per row. Adding a sample scatters it
+// across rows, it pays off for boards with many channels when data is read as rows.
+// With FLOAT32 precision rows are stored as floats and converted to doubles on read, it keeps full
+// resolution of 24 bit ADC values multiplied by a scale, rows which need more precision (e.g.
+// timestamps) are kept as doubles
+class ChannelMajorDataBuffer : public BaseDataBuffer
+{
+    SpinLock lock;
+    double *data;                      // [num_double_rows x buffer_size]
+    float *compact_data;               // [num_float_rows x buffer_size]
+    std::vector<double *> double_rows; // NULL for rows stored as floats
+    std::vector<float *> float_rows;   // NULL for rows stored as doubles
+
+    size_t buffer_size;
+    size_t first_used, first_free;
+    size_t count;
+    size_t num_samples;
+    size_t overwritten;
+    std::vector<int> all_channels;
+
+    // without channels chunk is interleaved as in DataBuffer, otherwise rows from channels are
+    // copied to rows with result_size values and chunk starts at column offset
+    void get_chunk (size_t start, size_t size, double *data_buf, const int *channels,
+        int num_channels, size_t result_size, size_t offset);
+    size_t read_data (size_t max_count, const int *channels, int num_channels, double *data_buf);
+    size_t read_current_data (
+        size_t max_count, const int *channels, int num_channels, double *data_buf);
+
+public:
+    ChannelMajorDataBuffer (int num_samples, size_t buffer_size,
+        DataBufferPrecision precision = DataBufferPrecision::FLOAT64,
+        const std::vector<int> &full_precision_rows = std::vector<int> ());
+    ~ChannelMajorDataBuffer ();
+
+    void add_data (double *value);
+    void add_data_block (const double *values, size_t count);
+    size_t get_data (size_t max_count, double *data_buf);
+    size_t get_current_data (size_t max_count, double *data_buf);
+    size_t get_data_count ();
+    bool is_ready ();
+    size_t get_data_transposed (size_t max_count, double *data_buf);
+    size_t get_current_data_transposed (size_t max_count, double *data_buf);
+    size_t get_data_channels (
+        size_t max_count, const int *channels, int num_channels, double *data_buf);
+    size_t get_current_data_channels (
+        size_t max_count, const int *channels, int num_channels, double *data_buf);
+    void get_stats (struct DataBufferStats &stats);
+};
@@ -1,10 +1,12 @@
 #pragma once
 
+#include "base_data_buffer.h"
 #include "spinlock.h"
 #include <stdlib.h>
 #include <string.h>
+#include <vector>
 
-class DataBuffer
+class DataBuffer : public BaseDataBuffer
 {
 
     SpinLock lock;
@@ -14,21 +16,44 @@ class DataBuffer
     size_t first_used, first_free;
     size_t count;
     size_t num_samples;
+    size_t overwritten;
 
     size_t next (size_t index)
     {
         return (index + 1) % buffer_size;
     }
 
-    void get_chunk (size_t start, size_t size, double *data_buf);
+    std::vector<int> all_channels;
+
+    // without channels chunk is copied as is, otherwise selected values are transposed to rows
+    // with result_size values per row and chunk starts at column offset
+    void get_chunk (size_t start, size_t size, double *data_buf, const int *channels,
+        int num_channels, size_t result_size, size_t offset);
+    size_t read_data (size_t max_count, const int *channels, int num_channels, double *data_buf);
+    size_t read_current_data (
+        size_t max_count, const int *channels, int num_channels, double *data_buf);
 
 public:
     DataBuffer (int num_samples, size_t buffer_size);
     ~DataBuffer ();
 
     void add_data (double *value);
+    void add_data_block (const double *values, size_t count);
     size_t get_data (size_t max_count, double *data_buf);
     size_t get_current_data (size_t max_count, double *data_buf);
     size_t get_data_count ();
     bool is_ready ();
+
+    size_t get_capacity ()
+    {
+        return buffer_size;
+    }
+
+    size_t get_data_transposed (size_t max_count, double *data_buf);
+    size_t get_current_data_transposed (size_t max_count, double *data_buf);
+    size_t get_data_channels (
+        size_t max_count, const int *channels, int num_channels, double *data_buf);
+    size_t get_current_data_channels (
+        size_t max_count, const int *channels, int num_channels, double *data_buf);
+    void get_stats (struct DataBufferStats &stats);
 };
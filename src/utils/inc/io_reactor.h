@@ -0,0 +1,82 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+// max number of datagrams read from one socket before other sockets get a chance
+#define IO_REACTOR_MAX_READS_PER_EVENT 64
+
+
+enum class IOReactorReturnCodes : int
+{
+    STATUS_OK = 0,
+    NOT_SUPPORTED_ERROR = 1,
+    CREATE_ERROR = 2,
+    ALREADY_REGISTERED_ERROR = 3,
+    NOT_REGISTERED_ERROR = 4,
+    INVALID_ARGUMENT_ERROR = 5
+};
+
+// Shared set of threads which wait for data on sockets of many boards (epoll on Linux) instead of
+// a blocking recv thread per socket. Handler of a socket is never called concurrently, so board
+// parsers dont need extra locking. Enabled by BRAINFLOW_IO_REACTOR_THREADS, not available on
+// other platforms, boards fall back to their own threads if get_instance returns NULL.
+class IOReactor
+{
+public:
+    // called with data of one recv call
+    typedef std::function<void (unsigned char *data, int size)> DataHandler;
+
+    // returns shared reactor or NULL if it's disabled or not supported
+    static IOReactor *get_instance ();
+    static bool is_supported ();
+
+    // cpus are core ids to pin threads to, thread i uses cpus[i % cpus.size ()]
+    IOReactor (int num_threads, std::vector<int> cpus = std::vector<int> ());
+    ~IOReactor ();
+
+    int init ();
+    // max_size is size of buffer passed to recv
+    int add_socket (int fd, int max_size, DataHandler handler);
+    // after return handler is not running and will not be called anymore, must not be called
+    // from handler
+    int remove_socket (int fd);
+
+    int get_num_threads ()
+    {
+        return num_threads;
+    }
+
+private:
+    struct Registration
+    {
+        int fd;
+        DataHandler handler;
+        std::vector<unsigned char> buffer;
+        bool busy;
+        bool removed;
+    };
+
+    int num_threads;
+    std::vector<int> cpus;
+    int epoll_fd;
+    int wakeup_fd;
+    volatile bool keep_alive;
+    std::vector<std::thread> threads;
+    // registrations are looked up by id, so events which arrive after removal are ignored
+    std::map<uint64_t, Registration *> registrations;
+    std::map<int, uint64_t> fd_to_id;
+    uint64_t next_id;
+    std::mutex m;
+    std::condition_variable cv;
+
+    void reactor_thread (int num);
+    void handle_event (uint64_t id);
+    void release ();
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "base_data_buffer.h"
+
+#define DATA_BUFFER_CACHE_LINE_SIZE 64
+
+
+// Ring buffer for one producer and many readers, producer never waits and overwrites the oldest
+// samples when buffer is full, readers validate copied samples against head counter and skip
+// samples which were overwritten during copy. Producer calls must be serialized by caller.
+class LockFreeDataBuffer : public BaseDataBuffer
+{
+    double *data;
+    size_t buffer_size; // max number of stored samples
+    size_t capacity;    // size of ring, power of two
+    size_t mask;
+    size_t num_samples;
+
+    // head and tail are monotonic counters of samples, position in ring is counter & mask
+    char pad0[DATA_BUFFER_CACHE_LINE_SIZE];
+    std::atomic<size_t> head;     // counter of published samples, modified only by producer
+    std::atomic<size_t> reserved; // counter of sample being written, modified only by producer
+    char pad1[DATA_BUFFER_CACHE_LINE_SIZE - 2 * sizeof (std::atomic<size_t>)];
+    std::atomic<size_t> tail; // counter of oldest not consumed sample, modified only by readers
+    // samples skipped by readers because producer overwrote them
+    std::atomic<size_t> overwritten;
+    char pad2[DATA_BUFFER_CACHE_LINE_SIZE - 2 * sizeof (std::atomic<size_t>)];
+
+    std::vector<int> all_channels;
+
+    // without channels chunk is copied as is, otherwise selected values are transposed to rows
+    // with result_size values per row and chunk starts at column offset
+    void get_chunk (size_t start, size_t size, double *data_buf, const int *channels,
+        int num_channels, size_t result_size, size_t offset);
+    size_t read_data (size_t max_count, const int *channels, int num_channels, double *data_buf);
+    size_t read_current_data (
+        size_t max_count, const int *channels, int num_channels, double *data_buf);
+    // first counter which was not overwritten by producer before reserved_counter was observed
+    size_t first_valid (size_t reserved_counter);
+
+public:
+    LockFreeDataBuffer (int num_samples, size_t buffer_size);
+    ~LockFreeDataBuffer ();
+
+    void add_data (double *value);
+    void add_data_block (const double *values, size_t count);
+    size_t get_data (size_t max_count, double *data_buf);
+    size_t get_current_data (size_t max_count, double *data_buf);
+    size_t get_data_count ();
+    bool is_ready ();
+    size_t get_data_transposed (size_t max_count, double *data_buf);
+    size_t get_current_data_transposed (size_t max_count, double *data_buf);
+    size_t get_data_channels (
+        size_t max_count, const int *channels, int num_channels, double *data_buf);
+    size_t get_current_data_channels (
+        size_t max_count, const int *channels, int num_channels, double *data_buf);
+    void get_stats (struct DataBufferStats &stats);
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+
+enum class MappedFileReturnCodes : int
+{
+    STATUS_OK = 0,
+    OPEN_ERROR = 1,
+    MAP_ERROR = 2,
+    ALREADY_OPEN_ERROR = 3
+};
+
+
+// read only memory mapping of the whole file
+class MappedFile
+{
+
+public:
+    MappedFile (const char *file_name);
+    ~MappedFile ()
+    {
+        close ();
+    }
+
+    int open ();
+    void close ();
+
+    const char *get_data ()
+    {
+        return data;
+    }
+
+    int64_t get_size ()
+    {
+        return size;
+    }
+
+    // modification time in seconds, used to validate caches built for this file
+    int64_t get_mtime ()
+    {
+        return mtime;
+    }
+
+private:
+    std::string file_name;
+    const char *data;
+    int64_t size;
+    int64_t mtime;
+#ifdef _WIN32
+    HANDLE file_handle;
+    HANDLE mapping_handle;
+#else
+    int fd;
+#endif
+};
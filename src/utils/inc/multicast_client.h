@@ -6,6 +6,8 @@
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #include <unistd.h>
+
+#include "udp_batch.h"
 #endif
 
 #include <stdlib.h>
@@ -35,7 +37,20 @@ public:
 
     int init ();
     int recv (void *data, int size);
+    // receives up to max_count datagrams into slots of slot_size bytes, blocks only for the first
+    // one, sizes[i] is the size of datagram i or greater than slot_size if it was truncated, returns
+    // number of datagrams or -1
+    int recv_batch (void *data, int slot_size, int max_count, int *sizes);
     void close ();
+    // native socket for IOReactor, -1 on Windows where reactor is not supported
+    int get_socket_fd ()
+    {
+#ifdef _WIN32
+        return -1;
+#else
+        return client_socket;
+#endif
+    }
 
 
 private:
@@ -48,5 +63,6 @@ private:
 #else
     int client_socket;
     struct sockaddr_in socket_addr;
+    UDPBatch batch;
 #endif
 };
@@ -16,6 +16,8 @@ public:
 
     int init ();
     int send (void *data, int size);
+    // sends count datagrams of size bytes each, returns number of sent datagrams or -1
+    int send_batch (void *data, int size, int count);
     void close ();
 
 private:
@@ -28,5 +30,6 @@ private:
     bool wsa_initialized;
 #else
     volatile int server_socket;
+    UDPBatch batch;
 #endif
 };
@@ -0,0 +1,6 @@
+#pragma once
+
+
+// parses a double from [*pos, end) without allocations, input doesn't need to be null terminated
+// leading spaces are skipped, on success *pos points to the first char after the number
+bool parse_double (const char **pos, const char *end, double *value);
@@ -24,6 +24,10 @@ public:
     int set_custom_latency (int latency = 1);
     int flush_buffer ();
     int read_from_serial_port (void *bytes_to_read, int size);
+#ifndef _WIN32
+    int read_chunk_from_serial_port (
+        void *bytes_to_read, int min_size, int max_size, int ms_timeout);
+#endif
     int send_to_serial_port (const void *message, int length);
     int close_serial_port ();
     const char *get_port_name ()
@@ -37,5 +41,8 @@ private:
     HANDLE port_descriptor;
 #else
     int port_descriptor;
+    int min_read_size; // VMIN of port, 0 for reads which return any available data
+
+    int set_min_read_size (int size);
 #endif
 };
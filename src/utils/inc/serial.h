@@ -32,6 +32,10 @@ public:
     virtual int set_custom_latency (int latency = 1) = 0;
     virtual int flush_buffer () = 0;
     virtual int read_from_serial_port (void *bytes_to_read, int size) = 0;
+    // reads at least min_size and at most max_size bytes, returns less than min_size bytes only
+    // if no data arrived for ms_timeout, default implementation repeats read_from_serial_port
+    virtual int read_chunk_from_serial_port (
+        void *bytes_to_read, int min_size, int max_size, int ms_timeout);
     virtual int send_to_serial_port (const void *message, int length) = 0;
     virtual int close_serial_port () = 0;
     virtual const char *get_port_name () = 0;
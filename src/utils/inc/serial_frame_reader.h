@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stdlib.h>
+#include <vector>
+
+#include "serial.h"
+
+#define SERIAL_FRAME_READER_BUFFER_SIZE 4096
+
+
+// Reads serial port in large chunks and splits data into frames in user space. Frame is a start
+// byte followed by payload, the last byte of payload is the end byte. For fixed size frames
+// min_size == max_size, otherwise frame ends at the first end byte after min_size bytes which is
+// followed by the start byte of the next frame. Bytes which dont form a valid frame are skipped one
+// by one, so reader resyncs on lost or corrupted bytes without extra reads from port.
+class SerialFrameReader
+{
+public:
+    // sizes are sizes of payload without start byte and include end byte, end byte is valid if it
+    // is in range [end_byte_min, end_byte_max]
+    SerialFrameReader (Serial *serial, unsigned char start_byte, int min_size, int max_size,
+        unsigned char end_byte_min, unsigned char end_byte_max, int ms_timeout = 1000);
+
+    // copies payload of the next frame to frame which must fit max_size bytes, returns payload
+    // size or 0 if no data arrived for ms_timeout
+    int read_frame (unsigned char *frame);
+    // drops buffered bytes, must be called if serial port is flushed
+    void reset ();
+
+    // bytes skipped during resync since creation
+    size_t get_skipped_bytes ()
+    {
+        return skipped_bytes;
+    }
+
+    // number of reads from serial port since creation
+    size_t get_num_reads ()
+    {
+        return num_reads;
+    }
+
+private:
+    Serial *serial;
+    unsigned char start_byte;
+    unsigned char end_byte_min;
+    unsigned char end_byte_max;
+    int min_size;
+    int max_size;
+    int ms_timeout;
+    std::vector<unsigned char> buffer;
+    size_t first; // first not processed byte in buffer
+    size_t last;  // position after the last received byte
+    size_t skipped_bytes;
+    size_t num_reads;
+
+    bool is_end_byte (unsigned char value)
+    {
+        return (value >= end_byte_min) && (value <= end_byte_max);
+    }
+
+    // returns payload size of frame starting at first, 0 if frame is invalid, -1 if more data is
+    // needed, needed is set to the number of missing bytes
+    int find_frame (size_t &needed);
+};
@@ -6,6 +6,8 @@
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #include <unistd.h>
+
+#include "udp_batch.h"
 #endif
 
 #include <stdlib.h>
@@ -41,6 +43,12 @@ public:
     int set_timeout (int num_seconds);
     int send (const char *data, int size);
     int recv (void *data, int size);
+    // sends count datagrams of size bytes each, returns number of sent datagrams or -1
+    int send_batch (const char *data, int size, int count);
+    // receives up to max_count datagrams into slots of slot_size bytes, blocks only for the first
+    // one, sizes[i] is the size of datagram i or greater than slot_size if it was truncated, returns
+    // number of datagrams or -1
+    int recv_batch (void *data, int slot_size, int max_count, int *sizes);
     void close ();
     int get_local_ip_addr (const char *local_ip);
     char *get_ip_addr ()
@@ -52,6 +60,15 @@ public:
         return port;
     }
     int get_local_port ();
+    // native socket for IOReactor, -1 on Windows where reactor is not supported
+    int get_socket_fd ()
+    {
+#ifdef _WIN32
+        return -1;
+#else
+        return connect_socket;
+#endif
+    }
 
 private:
     char ip_addr[32];
@@ -63,5 +80,6 @@ private:
 #else
     int connect_socket;
     struct sockaddr_in socket_addr;
+    UDPBatch batch;
 #endif
 };
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base_data_buffer.h"
+#include "data_buffer.h"
+
+#define SPILL_BLOCK_SIZE 4096 // max samples moved to spill file or read from it at once
+// max blocks waiting for writer thread, two are allocated on creation and others only if disk is
+// slower than producer, ring is overwritten if all are used
+#define SPILL_MAX_PENDING_BLOCKS 64
+
+
+// In memory ring backed by append only spill file, when ring is full its oldest samples are moved
+// to the file instead of being overwritten. Producer only copies them to a free block which is
+// written by a background thread, so add_data never waits for disk. Readers drain the file first
+// and read it without blocking producer, samples are lost only if disk write fails or if disk is
+// too slow and all blocks are used. File is reused from the start once it is fully read and
+// removed on destruction. Samples are stored in the same layout as in DataBuffer
+class SpillDataBuffer : public BaseDataBuffer
+{
+public:
+    // spill file is created in spill_dir or in system temp dir if it is empty
+    SpillDataBuffer (int num_samples, size_t buffer_size, const std::string &spill_dir);
+    ~SpillDataBuffer ();
+
+    void add_data (double *value);
+    void add_data_block (const double *values, size_t count);
+    size_t get_data (size_t max_count, double *data_buf);
+    size_t get_current_data (size_t max_count, double *data_buf);
+    size_t get_data_count ();
+    bool is_ready ();
+    size_t get_data_transposed (size_t max_count, double *data_buf);
+    size_t get_current_data_transposed (size_t max_count, double *data_buf);
+    size_t get_data_channels (
+        size_t max_count, const int *channels, int num_channels, double *data_buf);
+    size_t get_current_data_channels (
+        size_t max_count, const int *channels, int num_channels, double *data_buf);
+    void get_stats (struct DataBufferStats &stats);
+
+protected:
+    // disk io is virtual to emulate slow disk in tests, called without producer mutex
+    virtual bool write_file (int64_t pos, const double *data, size_t count);
+    // without channels samples are copied as is, otherwise selected values are transposed to
+    // rows with result_size values and chunk starts at column offset
+    virtual bool read_file (int64_t pos, size_t count, const int *channels, int num_channels,
+        double *data_buf, size_t result_size, size_t offset);
+    // waits for current write, pending blocks are not written after that
+    void stop_writer ();
+
+private:
+    struct SpillBlock
+    {
+        std::vector<double> data; // [spill_size x num_samples]
+        size_t first;             // samples before first were already read from memory
+        size_t count;
+    };
+
+    std::mutex mutex;      // protects ring, blocks and file positions, never held during disk io
+    std::mutex read_mutex; // readers are serialized to keep file range they read valid
+    std::mutex file_mutex; // reader and writer share file position
+    std::condition_variable cv;
+    std::thread writer;
+    bool keep_alive;
+    DataBuffer ring;
+    FILE *fp;
+    std::string file_name; // empty for tmpfile which is removed by os
+    size_t num_samples;
+    size_t spill_size; // samples moved to file at once
+    int64_t read_pos;  // position of the oldest sample in file, in samples
+    int64_t write_pos; // position after the newest sample in file, in samples
+    size_t overwritten;
+    size_t spilled;
+    // blocks are used as a queue, samples in them are newer than samples in file and older than
+    // samples in ring, the first block stays in queue while it is written
+    SpillBlock blocks[SPILL_MAX_PENDING_BLOCKS];
+    size_t first_pending;
+    size_t num_pending;
+    std::vector<double> read_block; // [spill_size x num_samples], used under read_mutex
+    std::vector<int> all_channels;
+
+    void write_thread ();
+    bool spill ();
+    size_t get_pending_count ();
+    // drops samples from file if it can not be read
+    void drop_file_data ();
+    // copies samples to result, the same layout as in read_file
+    void copy_samples (const double *src, size_t count, const int *channels, int num_channels,
+        double *data_buf, size_t result_size, size_t offset);
+    // removes up to max_count oldest samples from blocks and ring, file must be drained
+    size_t take_memory_data (size_t max_count, const int *channels, int num_channels,
+        double *data_buf, size_t result_size, size_t offset);
+    size_t read_data (size_t max_count, const int *channels, int num_channels, double *data_buf);
+    size_t read_current_data (
+        size_t max_count, const int *channels, int num_channels, double *data_buf);
+};
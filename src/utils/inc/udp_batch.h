@@ -0,0 +1,39 @@
+#pragma once
+
+#ifndef _WIN32
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+// max number of datagrams passed to kernel in one call
+#define UDP_BATCH_MAX_DATAGRAMS 64
+
+
+// Preallocated message vectors for recvmmsg and sendmmsg (Linux), datagrams are stored in equal
+// slots of a contiguous buffer. On other POSIX systems datagrams are received and sent one by one.
+// Receive and send vectors are separate, so one thread can receive while another one sends.
+class UDPBatch
+{
+public:
+    UDPBatch ();
+
+    // blocks like recv for the first datagram, after that takes all queued datagrams which fit
+    // into max_count slots of slot_size bytes, sizes[i] is the size of datagram i, returns number
+    // of datagrams or -1 on error or timeout. Longer datagrams are truncated to slot_size and
+    // their sizes[i] is greater than slot_size
+    int recv (int fd, void *data, int slot_size, int max_count, int *sizes);
+    // sends count datagrams of size bytes each, addr can be NULL for connected sockets, returns
+    // number of sent datagrams or -1 if nothing was sent
+    int send (int fd, const void *data, int size, int count, const struct sockaddr *addr,
+        socklen_t addr_len);
+
+private:
+#ifdef __linux__
+    struct mmsghdr recv_msgs[UDP_BATCH_MAX_DATAGRAMS];
+    struct iovec recv_iovecs[UDP_BATCH_MAX_DATAGRAMS];
+    struct mmsghdr send_msgs[UDP_BATCH_MAX_DATAGRAMS];
+    struct iovec send_iovecs[UDP_BATCH_MAX_DATAGRAMS];
+#endif
+};
+
+#endif
@@ -0,0 +1,316 @@
+#include <memory>
+#include <sstream>
+
+#include "brainflow_env_vars.h"
+#include "io_reactor.h"
+
+
+static IOReactor *create_reactor ()
+{
+    int num_threads = get_brainflow_io_reactor_threads ();
+    if ((num_threads < 1) || (!IOReactor::is_supported ()))
+    {
+        return NULL;
+    }
+    std::vector<int> cpus;
+    std::stringstream ss (get_brainflow_io_reactor_cpus ());
+    std::string cpu;
+    while (std::getline (ss, cpu, ','))
+    {
+        try
+        {
+            cpus.push_back (std::stoi (cpu));
+        }
+        catch (...)
+        {
+        }
+    }
+    IOReactor *reactor = new IOReactor (num_threads, cpus);
+    if (reactor->init () != (int)IOReactorReturnCodes::STATUS_OK)
+    {
+        delete reactor;
+        return NULL;
+    }
+    return reactor;
+}
+
+IOReactor *IOReactor::get_instance ()
+{
+    // created on first use, static init is thread safe since c++11
+    static std::unique_ptr<IOReactor> instance (create_reactor ());
+    return instance.get ();
+}
+
+IOReactor::IOReactor (int num_threads, std::vector<int> cpus)
+{
+    this->num_threads = num_threads;
+    this->cpus = cpus;
+    epoll_fd = -1;
+    wakeup_fd = -1;
+    keep_alive = false;
+    next_id = 1; // 0 is reserved for wakeup_fd
+}
+
+IOReactor::~IOReactor ()
+{
+    release ();
+}
+
+///////////////////////////////
+//////////// LINUX ////////////
+///////////////////////////////
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+bool IOReactor::is_supported ()
+{
+    return true;
+}
+
+int IOReactor::init ()
+{
+    if ((num_threads < 1) || (num_threads > 255))
+    {
+        return (int)IOReactorReturnCodes::INVALID_ARGUMENT_ERROR;
+    }
+    if (epoll_fd != -1)
+    {
+        return (int)IOReactorReturnCodes::ALREADY_REGISTERED_ERROR;
+    }
+    epoll_fd = epoll_create1 (EPOLL_CLOEXEC);
+    wakeup_fd = eventfd (0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if ((epoll_fd == -1) || (wakeup_fd == -1))
+    {
+        release ();
+        return (int)IOReactorReturnCodes::CREATE_ERROR;
+    }
+    // level triggered, wakes up all threads on release
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.u64 = 0;
+    if (epoll_ctl (epoll_fd, EPOLL_CTL_ADD, wakeup_fd, &event) != 0)
+    {
+        release ();
+        return (int)IOReactorReturnCodes::CREATE_ERROR;
+    }
+
+    keep_alive = true;
+    for (int i = 0; i < num_threads; i++)
+    {
+        threads.push_back (std::thread ([this, i] { this->reactor_thread (i); }));
+        if (!cpus.empty ())
+        {
+            cpu_set_t cpu_set;
+            CPU_ZERO (&cpu_set);
+            CPU_SET (cpus[i % cpus.size ()], &cpu_set);
+            // not fatal, thread works without pinning
+            pthread_setaffinity_np (threads.back ().native_handle (), sizeof (cpu_set), &cpu_set);
+        }
+    }
+    return (int)IOReactorReturnCodes::STATUS_OK;
+}
+
+void IOReactor::release ()
+{
+    if (keep_alive)
+    {
+        keep_alive = false;
+        uint64_t value = 1;
+        ssize_t res = write (wakeup_fd, &value, sizeof (value));
+        (void)res;
+        for (std::thread &thread : threads)
+        {
+            thread.join ();
+        }
+        threads.clear ();
+    }
+    for (auto &reg : registrations)
+    {
+        delete reg.second;
+    }
+    registrations.clear ();
+    fd_to_id.clear ();
+    if (epoll_fd != -1)
+    {
+        close (epoll_fd);
+        epoll_fd = -1;
+    }
+    if (wakeup_fd != -1)
+    {
+        close (wakeup_fd);
+        wakeup_fd = -1;
+    }
+}
+
+int IOReactor::add_socket (int fd, int max_size, DataHandler handler)
+{
+    if ((fd < 0) || (max_size < 1) || (!handler))
+    {
+        return (int)IOReactorReturnCodes::INVALID_ARGUMENT_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (m);
+    if (epoll_fd == -1)
+    {
+        return (int)IOReactorReturnCodes::CREATE_ERROR;
+    }
+    if (fd_to_id.find (fd) != fd_to_id.end ())
+    {
+        return (int)IOReactorReturnCodes::ALREADY_REGISTERED_ERROR;
+    }
+    Registration *reg = new Registration ();
+    reg->fd = fd;
+    reg->handler = handler;
+    reg->buffer.resize (max_size);
+    reg->busy = false;
+    reg->removed = false;
+    uint64_t id = next_id++;
+    // oneshot guarantees that only one thread handles socket, it's rearmed after handler
+    struct epoll_event event;
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.u64 = id;
+    if (epoll_ctl (epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+        delete reg;
+        return (int)IOReactorReturnCodes::CREATE_ERROR;
+    }
+    registrations[id] = reg;
+    fd_to_id[fd] = id;
+    return (int)IOReactorReturnCodes::STATUS_OK;
+}
+
+int IOReactor::remove_socket (int fd)
+{
+    std::unique_lock<std::mutex> lock (m);
+    auto it = fd_to_id.find (fd);
+    if (it == fd_to_id.end ())
+    {
+        return (int)IOReactorReturnCodes::NOT_REGISTERED_ERROR;
+    }
+    uint64_t id = it->second;
+    Registration *reg = registrations[id];
+    reg->removed = true;
+    epoll_ctl (epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+    cv.wait (lock, [reg] { return !reg->busy; });
+    registrations.erase (id);
+    fd_to_id.erase (fd);
+    delete reg;
+    return (int)IOReactorReturnCodes::STATUS_OK;
+}
+
+void IOReactor::reactor_thread (int num)
+{
+    (void)num;
+    struct epoll_event events[16];
+    while (keep_alive)
+    {
+        int num_events = epoll_wait (epoll_fd, events, 16, -1);
+        for (int i = 0; i < num_events; i++)
+        {
+            if (events[i].data.u64 != 0)
+            {
+                handle_event (events[i].data.u64);
+            }
+        }
+    }
+}
+
+void IOReactor::handle_event (uint64_t id)
+{
+    Registration *reg = NULL;
+    {
+        std::lock_guard<std::mutex> lock (m);
+        auto it = registrations.find (id);
+        if ((it == registrations.end ()) || (it->second->removed))
+        {
+            return;
+        }
+        reg = it->second;
+        reg->busy = true;
+    }
+
+    // drain socket, stream sockets return 0 if peer closed connection
+    bool closed = false;
+    for (int i = 0; i < IO_REACTOR_MAX_READS_PER_EVENT; i++)
+    {
+        ssize_t res = recv (reg->fd, reg->buffer.data (), reg->buffer.size (), MSG_DONTWAIT);
+        if (res > 0)
+        {
+            reg->handler (reg->buffer.data (), (int)res);
+            continue;
+        }
+        if (res == 0)
+        {
+            int type = 0;
+            socklen_t len = sizeof (type);
+            closed = (getsockopt (reg->fd, SOL_SOCKET, SO_TYPE, &type, &len) == 0) &&
+                (type == SOCK_STREAM);
+            if (!closed)
+            {
+                // empty datagram
+                continue;
+            }
+        }
+        break;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock (m);
+        reg->busy = false;
+        if ((!reg->removed) && (!closed))
+        {
+            struct epoll_event event;
+            event.events = EPOLLIN | EPOLLONESHOT;
+            event.data.u64 = id;
+            epoll_ctl (epoll_fd, EPOLL_CTL_MOD, reg->fd, &event);
+        }
+    }
+    cv.notify_all ();
+}
+
+///////////////////////////////
+//////// OTHER SYSTEMS ////////
+///////////////////////////////
+
+#else
+
+bool IOReactor::is_supported ()
+{
+    return false;
+}
+
+int IOReactor::init ()
+{
+    return (int)IOReactorReturnCodes::NOT_SUPPORTED_ERROR;
+}
+
+void IOReactor::release ()
+{
+}
+
+int IOReactor::add_socket (int fd, int max_size, DataHandler handler)
+{
+    return (int)IOReactorReturnCodes::NOT_SUPPORTED_ERROR;
+}
+
+int IOReactor::remove_socket (int fd)
+{
+    return (int)IOReactorReturnCodes::NOT_SUPPORTED_ERROR;
+}
+
+void IOReactor::reactor_thread (int num)
+{
+}
+
+void IOReactor::handle_event (uint64_t id)
+{
+}
+
+#endif
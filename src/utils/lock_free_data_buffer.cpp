@@ -0,0 +1,286 @@
+#include "lock_free_data_buffer.h"
+
+#include <new>
+#include <stdint.h>
+
+
+LockFreeDataBuffer::LockFreeDataBuffer (int num_samples, size_t buffer_size)
+{
+    this->buffer_size = buffer_size;
+    this->num_samples = num_samples;
+    head = 0;
+    reserved = 0;
+    tail = 0;
+    overwritten = 0;
+    capacity = 0;
+    mask = 0;
+    data = NULL;
+
+    if ((buffer_size == 0) || (num_samples <= 0) || (buffer_size > SIZE_MAX / 2))
+    {
+        return;
+    }
+    capacity = 1;
+    while (capacity < buffer_size)
+    {
+        capacity <<= 1;
+    }
+    mask = capacity - 1;
+    if (capacity > SIZE_MAX / sizeof (double) / (size_t)num_samples)
+    {
+        return;
+    }
+    try
+    {
+        data = new double[capacity * num_samples];
+        for (int i = 0; i < num_samples; i++)
+        {
+            all_channels.push_back (i);
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        delete[] data;
+        data = NULL;
+    }
+}
+
+LockFreeDataBuffer::~LockFreeDataBuffer ()
+{
+    delete[] data;
+}
+
+bool LockFreeDataBuffer::is_ready ()
+{
+    return (data != NULL);
+}
+
+size_t LockFreeDataBuffer::first_valid (size_t reserved_counter)
+{
+    // producer may be writing the slot of (reserved_counter - capacity)
+    return (reserved_counter > capacity) ? reserved_counter - capacity : 0;
+}
+
+void LockFreeDataBuffer::add_data (double *value)
+{
+    if (!is_ready ())
+    {
+        return;
+    }
+
+    size_t h = head.load (std::memory_order_relaxed);
+    reserved.store (h + 1, std::memory_order_relaxed);
+    // readers which see any part of new sample must see reserved == h + 1, pairs with acquire
+    // fence in readers
+    std::atomic_thread_fence (std::memory_order_release);
+    memcpy (data + (h & mask) * num_samples, value, sizeof (double) * num_samples);
+    head.store (h + 1, std::memory_order_release);
+}
+
+void LockFreeDataBuffer::add_data_block (const double *values, size_t count)
+{
+    if ((!is_ready ()) || (count == 0))
+    {
+        return;
+    }
+
+    // only the newest buffer_size samples can be read after publishing, counters of skipped
+    // samples are reserved and published too, readers count them as overwritten
+    size_t skipped = (count > buffer_size) ? count - buffer_size : 0;
+    size_t h = head.load (std::memory_order_relaxed);
+    reserved.store (h + count, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+    size_t sample_size = sizeof (double) * num_samples;
+    size_t pos = (h + skipped) & mask;
+    size_t to_copy = count - skipped;
+    size_t first_half = (to_copy < capacity - pos) ? to_copy : capacity - pos;
+    memcpy (data + pos * num_samples, values + skipped * num_samples, first_half * sample_size);
+    memcpy (data, values + (skipped + first_half) * num_samples,
+        (to_copy - first_half) * sample_size);
+    head.store (h + count, std::memory_order_release);
+}
+
+void LockFreeDataBuffer::get_chunk (size_t start, size_t size, double *data_buf,
+    const int *channels, int num_channels, size_t result_size, size_t offset)
+{
+    size_t pos = start & mask;
+    if (pos + size > capacity)
+    {
+        size_t first_half = capacity - pos;
+        get_chunk (pos, first_half, data_buf, channels, num_channels, result_size, offset);
+        get_chunk (0, size - first_half, data_buf, channels, num_channels, result_size,
+            offset + first_half);
+    }
+    else if (channels != NULL)
+    {
+        transpose (data + pos * num_samples, size, num_samples, channels, num_channels,
+            data_buf + offset, result_size);
+    }
+    else
+    {
+        memcpy (data_buf + offset * num_samples, data + pos * num_samples,
+            size * sizeof (double) * num_samples);
+    }
+}
+
+// Removes data from buffer, lock free, retries only if other reader consumed the same samples or
+// producer overwrote them during copy
+size_t LockFreeDataBuffer::get_data (size_t max_count, double *data_buf)
+{
+    return read_data (max_count, NULL, 0, data_buf);
+}
+
+size_t LockFreeDataBuffer::get_data_transposed (size_t max_count, double *data_buf)
+{
+    return read_data (max_count, all_channels.data (), (int)num_samples, data_buf);
+}
+
+size_t LockFreeDataBuffer::get_data_channels (
+    size_t max_count, const int *channels, int num_channels, double *data_buf)
+{
+    return read_data (max_count, channels, num_channels, data_buf);
+}
+
+// Doesn't remove data from buffer, wait free, if producer overwrote the oldest of copied samples
+// during copy they are dropped and less samples are returned
+size_t LockFreeDataBuffer::get_current_data (size_t max_count, double *data_buf)
+{
+    return read_current_data (max_count, NULL, 0, data_buf);
+}
+
+size_t LockFreeDataBuffer::get_current_data_transposed (size_t max_count, double *data_buf)
+{
+    return read_current_data (max_count, all_channels.data (), (int)num_samples, data_buf);
+}
+
+size_t LockFreeDataBuffer::get_current_data_channels (
+    size_t max_count, const int *channels, int num_channels, double *data_buf)
+{
+    return read_current_data (max_count, channels, num_channels, data_buf);
+}
+
+size_t LockFreeDataBuffer::read_data (
+    size_t max_count, const int *channels, int num_channels, double *data_buf)
+{
+    if (!is_ready ())
+    {
+        return 0;
+    }
+
+    while (true)
+    {
+        size_t t = tail.load (std::memory_order_acquire);
+        size_t h = head.load (std::memory_order_acquire);
+        size_t start = t;
+        if (h - start > buffer_size)
+        {
+            start = h - buffer_size; // oldest samples were overwritten
+        }
+        size_t result_count = max_count;
+        if (result_count > h - start)
+        {
+            result_count = h - start;
+        }
+        if (result_count == 0)
+        {
+            return 0;
+        }
+        get_chunk (start, result_count, data_buf, channels, num_channels, result_count, 0);
+        std::atomic_thread_fence (std::memory_order_acquire);
+        if (start < first_valid (reserved.load (std::memory_order_relaxed)))
+        {
+            continue;
+        }
+        if (tail.compare_exchange_strong (t, start + result_count, std::memory_order_acq_rel))
+        {
+            if (start > t)
+            {
+                overwritten.fetch_add (start - t, std::memory_order_relaxed);
+            }
+            return result_count;
+        }
+    }
+}
+
+size_t LockFreeDataBuffer::read_current_data (
+    size_t max_count, const int *channels, int num_channels, double *data_buf)
+{
+    if (!is_ready ())
+    {
+        return 0;
+    }
+
+    size_t t = tail.load (std::memory_order_acquire);
+    size_t h = head.load (std::memory_order_acquire);
+    size_t result_count = max_count;
+    size_t count = h - t;
+    if (count > buffer_size)
+    {
+        count = buffer_size;
+    }
+    if (result_count > count)
+    {
+        result_count = count;
+    }
+    if (result_count == 0)
+    {
+        return 0;
+    }
+
+    size_t start = h - result_count;
+    get_chunk (start, result_count, data_buf, channels, num_channels, result_count, 0);
+    std::atomic_thread_fence (std::memory_order_acquire);
+    size_t valid = first_valid (reserved.load (std::memory_order_relaxed));
+    if (start < valid)
+    {
+        size_t overwritten = valid - start;
+        if (overwritten >= result_count)
+        {
+            return 0;
+        }
+        size_t copied = result_count;
+        result_count -= overwritten;
+        if (channels != NULL)
+        {
+            // rows are compacted to the new row size, destination of a row never overlaps
+            // not yet moved rows
+            for (int j = 0; j < num_channels; j++)
+            {
+                memmove (data_buf + j * result_count, data_buf + j * copied + overwritten,
+                    result_count * sizeof (double));
+            }
+        }
+        else
+        {
+            memmove (data_buf, data_buf + overwritten * num_samples,
+                result_count * sizeof (double) * num_samples);
+        }
+    }
+    return result_count;
+}
+
+size_t LockFreeDataBuffer::get_data_count ()
+{
+    size_t t = tail.load (std::memory_order_acquire);
+    size_t h = head.load (std::memory_order_acquire);
+    size_t count = h - t;
+    if (count > buffer_size)
+    {
+        count = buffer_size;
+    }
+    return count;
+}
+
+void LockFreeDataBuffer::get_stats (struct DataBufferStats &stats)
+{
+    size_t t = tail.load (std::memory_order_acquire);
+    size_t h = head.load (std::memory_order_acquire);
+    // samples which are overwritten but not skipped by readers yet are counted too
+    stats.overwritten = overwritten.load (std::memory_order_relaxed);
+    if (h - t > buffer_size)
+    {
+        stats.overwritten += h - t - buffer_size;
+    }
+    stats.spilled = 0;
+    stats.spilled_pending = 0;
+}
@@ -0,0 +1,139 @@
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "mapped_file.h"
+
+
+MappedFile::MappedFile (const char *file_name)
+{
+    this->file_name = file_name;
+    data = NULL;
+    size = 0;
+    mtime = 0;
+#ifdef _WIN32
+    file_handle = INVALID_HANDLE_VALUE;
+    mapping_handle = NULL;
+#else
+    fd = -1;
+#endif
+}
+
+#ifdef _WIN32
+int MappedFile::open ()
+{
+    if (file_handle != INVALID_HANDLE_VALUE)
+    {
+        return (int)MappedFileReturnCodes::ALREADY_OPEN_ERROR;
+    }
+    file_handle = CreateFileA (file_name.c_str (), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file_handle == INVALID_HANDLE_VALUE)
+    {
+        return (int)MappedFileReturnCodes::OPEN_ERROR;
+    }
+    LARGE_INTEGER file_size;
+    FILETIME write_time;
+    if ((!GetFileSizeEx (file_handle, &file_size)) ||
+        (!GetFileTime (file_handle, NULL, NULL, &write_time)))
+    {
+        close ();
+        return (int)MappedFileReturnCodes::OPEN_ERROR;
+    }
+    size = (int64_t)file_size.QuadPart;
+    mtime = (int64_t)((((uint64_t)write_time.dwHighDateTime << 32) | write_time.dwLowDateTime) /
+        10000000ULL);
+    if (size == 0)
+    {
+        return (int)MappedFileReturnCodes::STATUS_OK; // nothing to map
+    }
+    mapping_handle = CreateFileMappingA (file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping_handle == NULL)
+    {
+        close ();
+        return (int)MappedFileReturnCodes::MAP_ERROR;
+    }
+    data = (const char *)MapViewOfFile (mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    if (data == NULL)
+    {
+        close ();
+        return (int)MappedFileReturnCodes::MAP_ERROR;
+    }
+    return (int)MappedFileReturnCodes::STATUS_OK;
+}
+
+void MappedFile::close ()
+{
+    if (data != NULL)
+    {
+        UnmapViewOfFile (data);
+        data = NULL;
+    }
+    if (mapping_handle != NULL)
+    {
+        CloseHandle (mapping_handle);
+        mapping_handle = NULL;
+    }
+    if (file_handle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle (file_handle);
+        file_handle = INVALID_HANDLE_VALUE;
+    }
+    size = 0;
+}
+#else
+int MappedFile::open ()
+{
+    if (fd >= 0)
+    {
+        return (int)MappedFileReturnCodes::ALREADY_OPEN_ERROR;
+    }
+    fd = ::open (file_name.c_str (), O_RDONLY);
+    if (fd < 0)
+    {
+        return (int)MappedFileReturnCodes::OPEN_ERROR;
+    }
+    struct stat file_stat;
+    if (fstat (fd, &file_stat) != 0)
+    {
+        close ();
+        return (int)MappedFileReturnCodes::OPEN_ERROR;
+    }
+    size = (int64_t)file_stat.st_size;
+    mtime = (int64_t)file_stat.st_mtime;
+    if (size == 0)
+    {
+        return (int)MappedFileReturnCodes::STATUS_OK; // mmap fails for empty files
+    }
+    void *mapping = mmap (NULL, (size_t)size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        close ();
+        return (int)MappedFileReturnCodes::MAP_ERROR;
+    }
+    data = (const char *)mapping;
+    // data is read from the beginning to the end during playback
+    madvise (mapping, (size_t)size, MADV_SEQUENTIAL);
+    return (int)MappedFileReturnCodes::STATUS_OK;
+}
+
+void MappedFile::close ()
+{
+    if (data != NULL)
+    {
+        munmap ((void *)data, (size_t)size);
+        data = NULL;
+    }
+    if (fd >= 0)
+    {
+        ::close (fd);
+        fd = -1;
+    }
+    size = 0;
+}
+#endif
@@ -100,6 +100,26 @@ int MultiCastClient::recv (void *data, int size)
     return res;
 }
 
+int MultiCastClient::recv_batch (void *data, int slot_size, int max_count, int *sizes)
+{
+    // no recvmmsg on windows, take one datagram per call
+    if (max_count < 1)
+    {
+        return -1;
+    }
+    int res = recv (data, slot_size);
+    if ((res < 0) && (WSAGetLastError () == WSAEMSGSIZE))
+    {
+        res = slot_size + 1; // datagram is truncated, real size is unknown
+    }
+    if (res < 0)
+    {
+        return -1;
+    }
+    sizes[0] = res;
+    return 1;
+}
+
 void MultiCastClient::close ()
 {
     if (client_socket != INVALID_SOCKET)
@@ -197,6 +217,15 @@ int MultiCastClient::recv (void *data, int size)
     return res;
 }
 
+int MultiCastClient::recv_batch (void *data, int slot_size, int max_count, int *sizes)
+{
+    if (max_count < 1)
+    {
+        return -1;
+    }
+    return batch.recv (client_socket, data, slot_size, max_count, sizes);
+}
+
 void MultiCastClient::close ()
 {
     if (client_socket != -1)
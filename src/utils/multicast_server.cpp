@@ -68,6 +68,20 @@ int MultiCastServer::send (void *data, int size)
     return res;
 }
 
+int MultiCastServer::send_batch (void *data, int size, int count)
+{
+    // no sendmmsg on windows
+    int total = 0;
+    for (; total < count; total++)
+    {
+        if (send ((char *)data + (size_t)total * size, size) < 0)
+        {
+            break;
+        }
+    }
+    return (total > 0) ? total : -1;
+}
+
 void MultiCastServer::close ()
 {
     if (server_socket != INVALID_SOCKET)
@@ -134,6 +148,12 @@ int MultiCastServer::send (void *data, int size)
     return res;
 }
 
+int MultiCastServer::send_batch (void *data, int size, int count)
+{
+    return batch.send (server_socket, data, size, count, (const struct sockaddr *)&server_addr,
+        (socklen_t)sizeof (server_addr));
+}
+
 void MultiCastServer::close ()
 {
     if (server_socket != -1)
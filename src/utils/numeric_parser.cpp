@@ -0,0 +1,160 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "numeric_parser.h"
+
+#define MAX_MANTISSA_DIGITS 19
+#define MAX_FAST_PATH_MANTISSA (1ULL << 53)
+#define MAX_FAST_PATH_EXPONENT 22
+#define MAX_NUMBER_LENGTH 64
+
+
+static const double powers_of_ten[MAX_FAST_PATH_EXPONENT + 1] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5,
+    1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21,
+    1e22};
+
+static inline bool is_digit (char c)
+{
+    return (c >= '0') && (c <= '9');
+}
+
+static inline bool is_delimiter (char c)
+{
+    return (c == '\t') || (c == ',') || (c == '\n') || (c == '\r') || (c == ' ') || (c == ';');
+}
+
+// nan, inf, very long or very precise numbers
+static bool parse_double_slow (const char **pos, const char *start, const char *end, double *value)
+{
+    char buf[MAX_NUMBER_LENGTH];
+    int len = 0;
+    while ((start + len < end) && (len < MAX_NUMBER_LENGTH - 1) && (!is_delimiter (start[len])))
+    {
+        buf[len] = start[len];
+        len++;
+    }
+    buf[len] = '\0';
+    char *parsed_end = NULL;
+    double res = strtod (buf, &parsed_end);
+    if (parsed_end == buf)
+    {
+        return false;
+    }
+    *value = res;
+    *pos = start + (parsed_end - buf);
+    return true;
+}
+
+bool parse_double (const char **pos, const char *end, double *value)
+{
+    const char *p = *pos;
+    while ((p < end) && (*p == ' '))
+    {
+        p++;
+    }
+    const char *start = p;
+    bool negative = false;
+    if ((p < end) && ((*p == '-') || (*p == '+')))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int significant_digits = 0;
+    int exponent = 0;
+    bool has_digits = false;
+    bool truncated = false;
+    while ((p < end) && (is_digit (*p)))
+    {
+        if (significant_digits < MAX_MANTISSA_DIGITS)
+        {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            if (mantissa != 0)
+            {
+                significant_digits++;
+            }
+        }
+        else
+        {
+            exponent++;
+            truncated = true;
+        }
+        has_digits = true;
+        p++;
+    }
+    if ((p < end) && (*p == '.'))
+    {
+        p++;
+        while ((p < end) && (is_digit (*p)))
+        {
+            if (significant_digits < MAX_MANTISSA_DIGITS)
+            {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                if (mantissa != 0)
+                {
+                    significant_digits++;
+                }
+                exponent--;
+            }
+            else
+            {
+                truncated = true;
+            }
+            has_digits = true;
+            p++;
+        }
+    }
+    if (!has_digits)
+    {
+        return parse_double_slow (pos, start, end, value);
+    }
+    if ((p < end) && ((*p == 'e') || (*p == 'E')))
+    {
+        const char *exp_start = p;
+        p++;
+        bool negative_exp = false;
+        if ((p < end) && ((*p == '-') || (*p == '+')))
+        {
+            negative_exp = (*p == '-');
+            p++;
+        }
+        if ((p < end) && (is_digit (*p)))
+        {
+            int exp_value = 0;
+            while ((p < end) && (is_digit (*p)))
+            {
+                if (exp_value < 100000)
+                {
+                    exp_value = exp_value * 10 + (*p - '0');
+                }
+                p++;
+            }
+            exponent += negative_exp ? -exp_value : exp_value;
+        }
+        else
+        {
+            p = exp_start; // 'e' is not a part of this number
+        }
+    }
+
+    // exact if mantissa and power of ten are both representable as double
+    if ((!truncated) && (mantissa <= MAX_FAST_PATH_MANTISSA) &&
+        (exponent >= -MAX_FAST_PATH_EXPONENT) && (exponent <= MAX_FAST_PATH_EXPONENT))
+    {
+        double res = (double)mantissa;
+        if (exponent < 0)
+        {
+            res /= powers_of_ten[-exponent];
+        }
+        else
+        {
+            res *= powers_of_ten[exponent];
+        }
+        *value = negative ? -res : res;
+        *pos = p;
+        return true;
+    }
+    return parse_double_slow (pos, start, end, value);
+}
@@ -116,13 +116,17 @@ int OSSerial::close_serial_port ()
 #else
 
 #include <fcntl.h>
+#include <poll.h>
 #include <termios.h>
 #include <unistd.h>
 
+#define MAX_TERMIOS_VMIN 255
+
 OSSerial::OSSerial (const char *port_name)
 {
     strcpy (this->port_name, port_name);
     port_descriptor = 0;
+    min_read_size = 0;
 }
 
 bool OSSerial::is_port_open ()
@@ -168,12 +172,38 @@ int OSSerial::set_serial_port_settings (int ms_timeout, bool timeout_only)
 
     if (tcsetattr (this->port_descriptor, TCSANOW, &port_settings) != 0)
         return SerialExitCodes::SET_PORT_STATE_ERROR;
+    min_read_size = 0;
     tcflush (this->port_descriptor, TCIOFLUSH);
     return SerialExitCodes::OK;
 }
 
+int OSSerial::set_min_read_size (int size)
+{
+    if (size == min_read_size)
+    {
+        return SerialExitCodes::OK;
+    }
+    struct termios port_settings;
+    if (tcgetattr (this->port_descriptor, &port_settings) != 0)
+    {
+        return SerialExitCodes::GET_PORT_STATE_ERROR;
+    }
+    port_settings.c_cc[VMIN] = (cc_t)size;
+    if (tcsetattr (this->port_descriptor, TCSANOW, &port_settings) != 0)
+    {
+        return SerialExitCodes::SET_PORT_STATE_ERROR;
+    }
+    min_read_size = size;
+    return SerialExitCodes::OK;
+}
+
 int OSSerial::read_from_serial_port (void *bytes_to_read, int size)
 {
+    // callers expect that read returns any available data after VTIME
+    if (set_min_read_size (0) != SerialExitCodes::OK)
+    {
+        return 0;
+    }
     int res = read (this->port_descriptor, bytes_to_read, size);
     if (res < 0)
     {
@@ -182,6 +212,39 @@ int OSSerial::read_from_serial_port (void *bytes_to_read, int size)
     return res;
 }
 
+// poll waits for the first byte with timeout, after that VMIN makes kernel return from read only
+// when min_size bytes are available or VTIME passed since the last byte, so a chunk is read with
+// two syscalls instead of a read per small piece of data
+int OSSerial::read_chunk_from_serial_port (
+    void *bytes_to_read, int min_size, int max_size, int ms_timeout)
+{
+    int vmin = (min_size < MAX_TERMIOS_VMIN) ? min_size : MAX_TERMIOS_VMIN;
+    if (set_min_read_size (vmin) != SerialExitCodes::OK)
+    {
+        return Serial::read_chunk_from_serial_port (bytes_to_read, min_size, max_size, ms_timeout);
+    }
+    unsigned char *bytes = (unsigned char *)bytes_to_read;
+    int pos = 0;
+    while (pos < min_size)
+    {
+        struct pollfd fds;
+        fds.fd = port_descriptor;
+        fds.events = POLLIN;
+        fds.revents = 0;
+        if (poll (&fds, 1, ms_timeout) <= 0)
+        {
+            break;
+        }
+        int res = read (port_descriptor, bytes + pos, max_size - pos);
+        if (res <= 0)
+        {
+            break;
+        }
+        pos += res;
+    }
+    return pos;
+}
+
 int OSSerial::flush_buffer ()
 {
     tcflush (this->port_descriptor, TCIOFLUSH);
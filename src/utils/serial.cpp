@@ -1,3 +1,5 @@
+#include <chrono>
+
 #include "serial.h"
 #include "libftdi_serial.h"
 #include "os_serial.h"
@@ -17,3 +19,27 @@ Serial *Serial::create (const char *port_name, Board *board)
 
     return new OSSerial (port_name);
 }
+
+int Serial::read_chunk_from_serial_port (
+    void *bytes_to_read, int min_size, int max_size, int ms_timeout)
+{
+    unsigned char *bytes = (unsigned char *)bytes_to_read;
+    int pos = 0;
+    auto last_data = std::chrono::steady_clock::now ();
+    while (pos < min_size)
+    {
+        int res = read_from_serial_port (bytes + pos, max_size - pos);
+        auto now = std::chrono::steady_clock::now ();
+        if (res > 0)
+        {
+            pos += res;
+            last_data = now;
+        }
+        else if (std::chrono::duration_cast<std::chrono::milliseconds> (now - last_data)
+                     .count () >= ms_timeout)
+        {
+            break;
+        }
+    }
+    return pos;
+}
@@ -0,0 +1,106 @@
+#include <string.h>
+
+#include "serial_frame_reader.h"
+
+
+SerialFrameReader::SerialFrameReader (Serial *serial, unsigned char start_byte, int min_size,
+    int max_size, unsigned char end_byte_min, unsigned char end_byte_max, int ms_timeout)
+{
+    this->serial = serial;
+    this->start_byte = start_byte;
+    this->min_size = min_size;
+    this->max_size = (max_size < min_size) ? min_size : max_size;
+    this->end_byte_min = end_byte_min;
+    this->end_byte_max = end_byte_max;
+    this->ms_timeout = ms_timeout;
+    // incomplete frame and lookahead byte always fit into the second half
+    size_t buffer_size = 2 * ((size_t)this->max_size + 2);
+    if (buffer_size < SERIAL_FRAME_READER_BUFFER_SIZE)
+    {
+        buffer_size = SERIAL_FRAME_READER_BUFFER_SIZE;
+    }
+    buffer.resize (buffer_size);
+    first = 0;
+    last = 0;
+    skipped_bytes = 0;
+    num_reads = 0;
+}
+
+void SerialFrameReader::reset ()
+{
+    first = 0;
+    last = 0;
+}
+
+int SerialFrameReader::find_frame (size_t &needed)
+{
+    size_t available = last - first;
+    if (min_size == max_size)
+    {
+        if (available < (size_t)min_size + 1)
+        {
+            needed = (size_t)min_size + 1 - available;
+            return -1;
+        }
+        return is_end_byte (buffer[first + min_size]) ? min_size : 0;
+    }
+    // variable size, start byte of the next frame confirms the end byte
+    for (int size = min_size; size <= max_size; size++)
+    {
+        if ((size_t)size + 2 > available)
+        {
+            needed = (size_t)size + 2 - available;
+            return -1;
+        }
+        if ((is_end_byte (buffer[first + size])) && (buffer[first + size + 1] == start_byte))
+        {
+            return size;
+        }
+    }
+    return 0;
+}
+
+int SerialFrameReader::read_frame (unsigned char *frame)
+{
+    while (true)
+    {
+        while ((first < last) && (buffer[first] != start_byte))
+        {
+            first++;
+            skipped_bytes++;
+        }
+        size_t needed = (size_t)min_size + ((min_size == max_size) ? 1 : 2);
+        if (first < last)
+        {
+            int size = find_frame (needed);
+            if (size > 0)
+            {
+                memcpy (frame, buffer.data () + first + 1, size);
+                first += size + 1;
+                return size;
+            }
+            if (size == 0)
+            {
+                // start byte was a part of data, look for the next one
+                first++;
+                skipped_bytes++;
+                continue;
+            }
+        }
+
+        if (buffer.size () - last < (size_t)max_size + 2)
+        {
+            memmove (buffer.data (), buffer.data () + first, last - first);
+            last -= first;
+            first = 0;
+        }
+        int res = serial->read_chunk_from_serial_port (
+            buffer.data () + last, (int)needed, (int)(buffer.size () - last), ms_timeout);
+        num_reads++;
+        if (res <= 0)
+        {
+            return 0;
+        }
+        last += res;
+    }
+}
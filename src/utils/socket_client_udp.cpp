@@ -227,6 +227,40 @@ int SocketClientUDP::recv (void *data, int size)
     return res;
 }
 
+int SocketClientUDP::recv_batch (void *data, int slot_size, int max_count, int *sizes)
+{
+    // no recvmmsg on windows, take one datagram per call
+    if (max_count < 1)
+    {
+        return -1;
+    }
+    int res = recv (data, slot_size);
+    if ((res < 0) && (WSAGetLastError () == WSAEMSGSIZE))
+    {
+        res = slot_size + 1; // datagram is truncated, real size is unknown
+    }
+    if (res < 0)
+    {
+        return -1;
+    }
+    sizes[0] = res;
+    return 1;
+}
+
+int SocketClientUDP::send_batch (const char *data, int size, int count)
+{
+    // no sendmmsg on windows
+    int total = 0;
+    for (; total < count; total++)
+    {
+        if (send (data + (size_t)total * size, size) < 0)
+        {
+            break;
+        }
+    }
+    return (total > 0) ? total : -1;
+}
+
 void SocketClientUDP::close ()
 {
     closesocket (connect_socket);
@@ -428,6 +462,21 @@ int SocketClientUDP::recv (void *data, int size)
     return res;
 }
 
+int SocketClientUDP::recv_batch (void *data, int slot_size, int max_count, int *sizes)
+{
+    if (max_count < 1)
+    {
+        return -1;
+    }
+    return batch.recv (connect_socket, data, slot_size, max_count, sizes);
+}
+
+int SocketClientUDP::send_batch (const char *data, int size, int count)
+{
+    return batch.send (connect_socket, data, size, count, (const struct sockaddr *)&socket_addr,
+        (socklen_t)sizeof (socket_addr));
+}
+
 void SocketClientUDP::close ()
 {
     ::close (connect_socket);
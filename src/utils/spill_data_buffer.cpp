@@ -0,0 +1,520 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <string.h>
+
+#include "spill_data_buffer.h"
+
+#ifdef _WIN32
+#define file_seek _fseeki64
+#else
+#define file_seek fseeko
+#endif
+
+
+static std::string get_spill_file_name (const std::string &spill_dir)
+{
+    static std::atomic<int> counter (0);
+    long long now = (long long)std::chrono::duration_cast<std::chrono::microseconds> (
+        std::chrono::system_clock::now ().time_since_epoch ())
+                        .count ();
+    return spill_dir + "/brainflow_spill_" + std::to_string (now) + "_" +
+        std::to_string (counter++) + ".bin";
+}
+
+SpillDataBuffer::SpillDataBuffer (
+    int num_samples, size_t buffer_size, const std::string &spill_dir)
+    : ring (num_samples, buffer_size)
+{
+    this->num_samples = (num_samples > 0) ? (size_t)num_samples : 0;
+    spill_size = std::max ((size_t)1, std::min (buffer_size / 4, (size_t)SPILL_BLOCK_SIZE));
+    read_pos = 0;
+    write_pos = 0;
+    overwritten = 0;
+    spilled = 0;
+    first_pending = 0;
+    num_pending = 0;
+    keep_alive = false;
+    fp = NULL;
+    for (int i = 0; i < SPILL_MAX_PENDING_BLOCKS; i++)
+    {
+        blocks[i].first = 0;
+        blocks[i].count = 0;
+    }
+
+    if (!ring.is_ready ())
+    {
+        return;
+    }
+    if (spill_dir.empty ())
+    {
+        fp = tmpfile ();
+    }
+    else
+    {
+        file_name = get_spill_file_name (spill_dir);
+        fp = fopen (file_name.c_str (), "w+b");
+    }
+    if (fp == NULL)
+    {
+        return;
+    }
+    try
+    {
+        // one block is filled while the other one is written, more are allocated if needed
+        read_block.resize (spill_size * this->num_samples);
+        for (int i = 0; i < 2; i++)
+        {
+            blocks[i].data.resize (spill_size * this->num_samples);
+        }
+        for (int i = 0; i < num_samples; i++)
+        {
+            all_channels.push_back (i);
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        fclose (fp);
+        fp = NULL;
+        if (!file_name.empty ())
+        {
+            remove (file_name.c_str ());
+        }
+        return;
+    }
+    keep_alive = true;
+    writer = std::thread ([this] { this->write_thread (); });
+}
+
+SpillDataBuffer::~SpillDataBuffer ()
+{
+    stop_writer ();
+    if (fp != NULL)
+    {
+        fclose (fp);
+        if (!file_name.empty ())
+        {
+            remove (file_name.c_str ());
+        }
+    }
+}
+
+bool SpillDataBuffer::is_ready ()
+{
+    return (fp != NULL);
+}
+
+void SpillDataBuffer::stop_writer ()
+{
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        keep_alive = false;
+    }
+    cv.notify_one ();
+    if (writer.joinable ())
+    {
+        writer.join ();
+    }
+}
+
+void SpillDataBuffer::add_data (double *value)
+{
+    if (!is_ready ())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock (mutex);
+    if (ring.get_data_count () == ring.get_capacity ())
+    {
+        // if writer is behind the oldest sample in ring is overwritten
+        spill ();
+    }
+    ring.add_data (value);
+}
+
+void SpillDataBuffer::add_data_block (const double *values, size_t count)
+{
+    if (!is_ready ())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock (mutex);
+    for (size_t done = 0; done < count;)
+    {
+        size_t free_space = ring.get_capacity () - ring.get_data_count ();
+        if (free_space == 0)
+        {
+            if (spill ())
+            {
+                continue;
+            }
+            // writer is behind, ring keeps only the newest samples
+            ring.add_data_block (values + done * num_samples, count - done);
+            break;
+        }
+        size_t size = std::min (free_space, count - done);
+        ring.add_data_block (values + done * num_samples, size);
+        done += size;
+    }
+}
+
+// moves the oldest samples from ring to a free block, called under mutex, disk io is done by
+// writer thread
+bool SpillDataBuffer::spill ()
+{
+    if (num_pending == SPILL_MAX_PENDING_BLOCKS)
+    {
+        return false;
+    }
+    SpillBlock &block = blocks[(first_pending + num_pending) % SPILL_MAX_PENDING_BLOCKS];
+    if (block.data.empty ())
+    {
+        // writer is behind, blocks are kept after it catches up
+        try
+        {
+            block.data.resize (spill_size * num_samples);
+        }
+        catch (const std::bad_alloc &)
+        {
+            return false;
+        }
+    }
+    block.first = 0;
+    block.count = ring.get_data (spill_size, block.data.data ());
+    num_pending++;
+    spilled += block.count;
+    cv.notify_one ();
+    return true;
+}
+
+void SpillDataBuffer::write_thread ()
+{
+    std::unique_lock<std::mutex> lock (mutex);
+    while (true)
+    {
+        cv.wait (lock, [this] { return ((num_pending > 0) || (!keep_alive)); });
+        if (!keep_alive)
+        {
+            break;
+        }
+        SpillBlock &block = blocks[first_pending];
+        if (read_pos == write_pos)
+        {
+            // file is reused from the start once it is fully read
+            read_pos = 0;
+            write_pos = 0;
+        }
+        // readers take samples from this block while it's written only if file is drained, such
+        // samples are skipped by moving read position after write
+        size_t first = block.first;
+        size_t count = block.count - first;
+        int64_t pos = write_pos;
+        bool res = true;
+        if (count > 0)
+        {
+            lock.unlock ();
+            res = write_file (pos, block.data.data () + first * num_samples, count);
+            lock.lock ();
+        }
+        if (res)
+        {
+            write_pos = pos + (int64_t)count;
+            read_pos += (int64_t)(block.first - first);
+        }
+        else
+        {
+            // samples which were not read from memory are lost
+            overwritten += block.count - block.first;
+        }
+        block.first = 0;
+        block.count = 0;
+        first_pending = (first_pending + 1) % SPILL_MAX_PENDING_BLOCKS;
+        num_pending--;
+    }
+}
+
+bool SpillDataBuffer::write_file (int64_t pos, const double *data, size_t count)
+{
+    size_t sample_size = sizeof (double) * num_samples;
+    std::lock_guard<std::mutex> lock (file_mutex);
+    return ((file_seek (fp, pos * (int64_t)sample_size, SEEK_SET) == 0) &&
+        (fwrite (data, sample_size, count, fp) == count));
+}
+
+bool SpillDataBuffer::read_file (int64_t pos, size_t count, const int *channels, int num_channels,
+    double *data_buf, size_t result_size, size_t offset)
+{
+    size_t sample_size = sizeof (double) * num_samples;
+    std::lock_guard<std::mutex> lock (file_mutex);
+    if (file_seek (fp, pos * (int64_t)sample_size, SEEK_SET) != 0)
+    {
+        return false;
+    }
+    if (channels == NULL)
+    {
+        return (fread (data_buf + offset * num_samples, sample_size, count, fp) == count);
+    }
+    for (size_t done = 0; done < count;)
+    {
+        size_t block_count = std::min (spill_size, count - done);
+        if (fread (read_block.data (), sample_size, block_count, fp) != block_count)
+        {
+            return false;
+        }
+        transpose (read_block.data (), block_count, num_samples, channels, num_channels,
+            data_buf + offset + done, result_size);
+        done += block_count;
+    }
+    return true;
+}
+
+void SpillDataBuffer::drop_file_data ()
+{
+    overwritten += (size_t)(write_pos - read_pos);
+    read_pos = write_pos;
+}
+
+size_t SpillDataBuffer::get_pending_count ()
+{
+    size_t count = 0;
+    for (size_t i = 0; i < num_pending; i++)
+    {
+        SpillBlock &block = blocks[(first_pending + i) % SPILL_MAX_PENDING_BLOCKS];
+        count += block.count - block.first;
+    }
+    return count;
+}
+
+void SpillDataBuffer::copy_samples (const double *src, size_t count, const int *channels,
+    int num_channels, double *data_buf, size_t result_size, size_t offset)
+{
+    if (channels == NULL)
+    {
+        memcpy (data_buf + offset * num_samples, src, sizeof (double) * count * num_samples);
+    }
+    else
+    {
+        transpose (src, count, num_samples, channels, num_channels, data_buf + offset,
+            result_size);
+    }
+}
+
+size_t SpillDataBuffer::take_memory_data (size_t max_count, const int *channels,
+    int num_channels, double *data_buf, size_t result_size, size_t offset)
+{
+    size_t done = 0;
+    // blocks which were fully read stay in queue, writer skips them
+    for (size_t i = 0; (i < num_pending) && (done < max_count); i++)
+    {
+        SpillBlock &block = blocks[(first_pending + i) % SPILL_MAX_PENDING_BLOCKS];
+        size_t count = std::min (block.count - block.first, max_count - done);
+        copy_samples (block.data.data () + block.first * num_samples, count, channels,
+            num_channels, data_buf, result_size, offset + done);
+        block.first += count;
+        done += count;
+    }
+    if (channels == NULL)
+    {
+        return done + ring.get_data (max_count - done, data_buf + (offset + done) * num_samples);
+    }
+    while (done < max_count)
+    {
+        size_t count = ring.get_data (std::min (spill_size, max_count - done), read_block.data ());
+        if (count == 0)
+        {
+            break;
+        }
+        transpose (read_block.data (), count, num_samples, channels, num_channels,
+            data_buf + offset + done, result_size);
+        done += count;
+    }
+    return done;
+}
+
+// Removes data from buffer, samples from file are returned first
+size_t SpillDataBuffer::get_data (size_t max_count, double *data_buf)
+{
+    return read_data (max_count, NULL, 0, data_buf);
+}
+
+size_t SpillDataBuffer::get_data_transposed (size_t max_count, double *data_buf)
+{
+    return read_data (max_count, all_channels.data (), (int)num_samples, data_buf);
+}
+
+size_t SpillDataBuffer::get_data_channels (
+    size_t max_count, const int *channels, int num_channels, double *data_buf)
+{
+    return read_data (max_count, channels, num_channels, data_buf);
+}
+
+// Doesn't remove data from buffer, samples from file are used only if ring has less than max_count
+size_t SpillDataBuffer::get_current_data (size_t max_count, double *data_buf)
+{
+    return read_current_data (max_count, NULL, 0, data_buf);
+}
+
+size_t SpillDataBuffer::get_current_data_transposed (size_t max_count, double *data_buf)
+{
+    return read_current_data (max_count, all_channels.data (), (int)num_samples, data_buf);
+}
+
+size_t SpillDataBuffer::get_current_data_channels (
+    size_t max_count, const int *channels, int num_channels, double *data_buf)
+{
+    return read_current_data (max_count, channels, num_channels, data_buf);
+}
+
+size_t SpillDataBuffer::read_data (
+    size_t max_count, const int *channels, int num_channels, double *data_buf)
+{
+    if (!is_ready ())
+    {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> read_lock (read_mutex);
+    std::unique_lock<std::mutex> lock (mutex);
+    size_t result_count = std::min (max_count,
+        (size_t)(write_pos - read_pos) + get_pending_count () + ring.get_data_count ());
+    size_t done = 0;
+    // writer moves blocks to file meanwhile, so the oldest part is checked again after each step
+    while (done < result_count)
+    {
+        size_t on_disk = (size_t)(write_pos - read_pos);
+        if (on_disk == 0)
+        {
+            size_t count = take_memory_data (
+                result_count - done, channels, num_channels, data_buf, result_count, done);
+            if (count == 0)
+            {
+                break;
+            }
+            done += count;
+            continue;
+        }
+        size_t from_disk = std::min (on_disk, result_count - done);
+        int64_t pos = read_pos;
+        // range stays in file until read position is moved, producer is not blocked by disk
+        lock.unlock ();
+        bool res = read_file (pos, from_disk, channels, num_channels, data_buf, result_count, done);
+        lock.lock ();
+        if (res)
+        {
+            read_pos += (int64_t)from_disk;
+            done += from_disk;
+        }
+        else
+        {
+            drop_file_data ();
+        }
+    }
+    if ((channels != NULL) && (done < result_count))
+    {
+        // samples were lost during read, rows are shorter than expected
+        for (int i = 0; i < num_channels; i++)
+        {
+            memmove (data_buf + i * done, data_buf + i * result_count, sizeof (double) * done);
+        }
+    }
+    return done;
+}
+
+size_t SpillDataBuffer::read_current_data (
+    size_t max_count, const int *channels, int num_channels, double *data_buf)
+{
+    if (!is_ready ())
+    {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> read_lock (read_mutex);
+    std::unique_lock<std::mutex> lock (mutex);
+    size_t in_ring = ring.get_data_count ();
+    size_t in_blocks = get_pending_count ();
+    size_t on_disk = (size_t)(write_pos - read_pos);
+    size_t result_count = std::min (max_count, on_disk + in_blocks + in_ring);
+    size_t from_ring = std::min (result_count, in_ring);
+    size_t from_blocks = std::min (result_count - from_ring, in_blocks);
+    size_t from_disk = result_count - from_ring - from_blocks;
+
+    // samples from memory are copied first, after that file is read without lock
+    size_t skip = in_blocks - from_blocks;
+    size_t done = from_disk;
+    for (size_t i = 0; (i < num_pending) && (done < from_disk + from_blocks); i++)
+    {
+        SpillBlock &block = blocks[(first_pending + i) % SPILL_MAX_PENDING_BLOCKS];
+        size_t first = block.first + std::min (skip, block.count - block.first);
+        skip -= first - block.first;
+        size_t count = block.count - first;
+        copy_samples (block.data.data () + first * num_samples, count, channels, num_channels,
+            data_buf, result_count, done);
+        done += count;
+    }
+    if (channels == NULL)
+    {
+        ring.get_current_data (from_ring, data_buf + done * num_samples);
+    }
+    else if (from_ring == result_count)
+    {
+        ring.get_current_data_channels (result_count, channels, num_channels, data_buf);
+    }
+    else if (from_ring > 0)
+    {
+        // rows from ring are shorter than rows of result
+        std::vector<double> rows (from_ring * num_channels);
+        ring.get_current_data_channels (from_ring, channels, num_channels, rows.data ());
+        for (int i = 0; i < num_channels; i++)
+        {
+            memcpy (data_buf + i * result_count + done, rows.data () + i * from_ring,
+                from_ring * sizeof (double));
+        }
+    }
+    if (from_disk == 0)
+    {
+        return result_count;
+    }
+
+    // readers are serialized and writer only appends, so range stays in file
+    int64_t pos = write_pos - (int64_t)from_disk;
+    lock.unlock ();
+    if (read_file (pos, from_disk, channels, num_channels, data_buf, result_count, 0))
+    {
+        return result_count;
+    }
+    lock.lock ();
+    drop_file_data ();
+    size_t count = result_count - from_disk;
+    if (channels == NULL)
+    {
+        memmove (data_buf, data_buf + from_disk * num_samples,
+            sizeof (double) * count * num_samples);
+    }
+    else
+    {
+        for (int i = 0; i < num_channels; i++)
+        {
+            memmove (data_buf + i * count, data_buf + i * result_count + from_disk,
+                sizeof (double) * count);
+        }
+    }
+    return count;
+}
+
+size_t SpillDataBuffer::get_data_count ()
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    return (size_t)(write_pos - read_pos) + get_pending_count () + ring.get_data_count ();
+}
+
+void SpillDataBuffer::get_stats (struct DataBufferStats &stats)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    ring.get_stats (stats);
+    stats.overwritten += overwritten;
+    stats.spilled = spilled;
+    stats.spilled_pending = (size_t)(write_pos - read_pos) + get_pending_count ();
+}
@@ -0,0 +1,148 @@
+#ifndef _WIN32
+
+#include <string.h>
+
+#include "udp_batch.h"
+
+
+///////////////////////////////
+//////////// LINUX ////////////
+///////////////////////////////
+
+#ifdef __linux__
+
+UDPBatch::UDPBatch ()
+{
+    memset (recv_msgs, 0, sizeof (recv_msgs));
+    memset (send_msgs, 0, sizeof (send_msgs));
+    for (int i = 0; i < UDP_BATCH_MAX_DATAGRAMS; i++)
+    {
+        recv_msgs[i].msg_hdr.msg_iov = &recv_iovecs[i];
+        recv_msgs[i].msg_hdr.msg_iovlen = 1;
+        send_msgs[i].msg_hdr.msg_iov = &send_iovecs[i];
+        send_msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+}
+
+int UDPBatch::recv (int fd, void *data, int slot_size, int max_count, int *sizes)
+{
+    if (max_count > UDP_BATCH_MAX_DATAGRAMS)
+    {
+        max_count = UDP_BATCH_MAX_DATAGRAMS;
+    }
+    unsigned char *bytes = (unsigned char *)data;
+    for (int i = 0; i < max_count; i++)
+    {
+        recv_iovecs[i].iov_base = bytes + (size_t)i * slot_size;
+        recv_iovecs[i].iov_len = slot_size;
+        recv_msgs[i].msg_hdr.msg_name = NULL;
+        recv_msgs[i].msg_hdr.msg_namelen = 0;
+        recv_msgs[i].msg_hdr.msg_flags = 0;
+    }
+    // first datagram uses socket timeout, others are taken only if already queued, with MSG_TRUNC
+    // msg_len is the real size of truncated datagram
+    int res = recvmmsg (fd, recv_msgs, max_count, MSG_WAITFORONE | MSG_TRUNC, NULL);
+    for (int i = 0; i < res; i++)
+    {
+        sizes[i] = (int)recv_msgs[i].msg_len;
+    }
+    return res;
+}
+
+int UDPBatch::send (
+    int fd, const void *data, int size, int count, const struct sockaddr *addr, socklen_t addr_len)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    int total = 0;
+    while (total < count)
+    {
+        int num = count - total;
+        if (num > UDP_BATCH_MAX_DATAGRAMS)
+        {
+            num = UDP_BATCH_MAX_DATAGRAMS;
+        }
+        for (int i = 0; i < num; i++)
+        {
+            send_iovecs[i].iov_base = (void *)(bytes + (size_t)(total + i) * size);
+            send_iovecs[i].iov_len = size;
+            send_msgs[i].msg_hdr.msg_name = (void *)addr;
+            send_msgs[i].msg_hdr.msg_namelen = (addr == NULL) ? 0 : addr_len;
+        }
+        int res = sendmmsg (fd, send_msgs, num, 0);
+        if (res <= 0)
+        {
+            break;
+        }
+        total += res;
+    }
+    return (total > 0) ? total : -1;
+}
+
+///////////////////////////////
+//////// OTHER SYSTEMS ////////
+///////////////////////////////
+
+#else
+
+UDPBatch::UDPBatch ()
+{
+}
+
+// real size of truncated datagram is unknown here, it's reported as slot_size + 1
+static int recv_one (int fd, unsigned char *data, int slot_size, int flags)
+{
+    struct iovec iov;
+    iov.iov_base = data;
+    iov.iov_len = slot_size;
+    struct msghdr msg;
+    memset (&msg, 0, sizeof (msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    int res = (int)recvmsg (fd, &msg, flags);
+    if ((res >= 0) && ((msg.msg_flags & MSG_TRUNC) != 0))
+    {
+        res = slot_size + 1;
+    }
+    return res;
+}
+
+int UDPBatch::recv (int fd, void *data, int slot_size, int max_count, int *sizes)
+{
+    unsigned char *bytes = (unsigned char *)data;
+    int res = recv_one (fd, bytes, slot_size, 0);
+    if (res < 0)
+    {
+        return -1;
+    }
+    sizes[0] = res;
+    int num = 1;
+    while (num < max_count)
+    {
+        res = recv_one (fd, bytes + (size_t)num * slot_size, slot_size, MSG_DONTWAIT);
+        if (res < 0)
+        {
+            break;
+        }
+        sizes[num++] = res;
+    }
+    return num;
+}
+
+int UDPBatch::send (
+    int fd, const void *data, int size, int count, const struct sockaddr *addr, socklen_t addr_len)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    int total = 0;
+    for (; total < count; total++)
+    {
+        if (sendto (fd, bytes + (size_t)total * size, size, 0, addr, addr_len) < 0)
+        {
+            break;
+        }
+    }
+    return (total > 0) ? total : -1;
+}
+
+#endif
+
+#endif
@@ -34,6 +34,14 @@ void visushrink (double *signal, int N, int J, const char *wname, const char *me
 void sureshrink (double *signal, int N, int J, const char *wname, const char *method,
     const char *ext, const char *thresh, const char *level, double *denoised);
 
+// the same as visushrink and sureshrink but use wt object created by caller, wt object can be
+// reused for signals of the same length
+void visushrink_wt (
+    wt_object wt, double *signal, const char *thresh, const char *level, double *denoised);
+
+void sureshrink_wt (
+    wt_object wt, double *signal, const char *thresh, const char *level, double *denoised);
+
 void modwtshrink (double *signal, int N, int J, const char *wname, const char *cmethod,
     const char *ext, const char *thresh, double *denoised);
 
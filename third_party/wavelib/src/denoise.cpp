@@ -32,28 +32,59 @@ denoise_object denoise_init (int length, int J, const char *wname)
 void visushrink (double *signal, int N, int J, const char *wname, const char *method,
     const char *ext, const char *thresh, const char *level, double *denoised)
 {
-    int filt_len, iter, i, dlen, dwt_len, sgn, MaxIter, it;
-    double sigma, td, tmp;
     wave_object wave;
     wt_object wt;
-    double *dout, *lnoise;
 
     wave = wave_init (wname);
+    try
+    {
+        wt = wt_init (wave, method, N, J);
+    }
+    catch (const std::exception &)
+    {
+        wave_free (wave);
+        throw;
+    }
+    if (!strcmp (method, "dwt"))
+    {
+        setDWTExtension (wt, ext);
+    }
+    try
+    {
+        visushrink_wt (wt, signal, thresh, level, denoised);
+    }
+    catch (const std::exception &)
+    {
+        wave_free (wave);
+        wt_free (wt);
+        throw;
+    }
+    wave_free (wave);
+    wt_free (wt);
+}
 
-    filt_len = wave->filtlength;
+void visushrink_wt (
+    wt_object wt, double *signal, const char *thresh, const char *level, double *denoised)
+{
+    int filt_len, iter, i, dlen, dwt_len, sgn, MaxIter, it, N, J;
+    double sigma, td, tmp;
+    const char *method;
+    double *dout, *lnoise;
+
+    N = wt->siglength;
+    J = wt->J;
+    method = wt->method;
+    filt_len = wt->wave->filtlength;
 
     MaxIter = (int)(log ((double)N / ((double)filt_len - 1.0)) / log (2.0));
 
     if (J > MaxIter)
     {
-        wave_free (wave);
         throw std::runtime_error ("to small buffer size for this wavelet");
     }
 
-    wt = wt_init (wave, method, N, J);
     if (!strcmp (method, "dwt"))
     {
-        setDWTExtension (wt, ext);
         dwt (wt, signal);
     }
     else if (!strcmp (method, "swt"))
@@ -62,8 +93,6 @@ void visushrink (double *signal, int N, int J, const char *wname, const char *me
     }
     else
     {
-        wave_free (wave);
-        wt_free (wt);
         throw std::runtime_error ("unsupported wavelet method");
     }
 
@@ -112,8 +141,6 @@ void visushrink (double *signal, int N, int J, const char *wname, const char *me
     {
         free (dout);
         free (lnoise);
-        wave_free (wave);
-        wt_free (wt);
         throw std::runtime_error ("acceptable noise extimation values are first and all");
     }
 
@@ -166,36 +193,64 @@ void visushrink (double *signal, int N, int J, const char *wname, const char *me
 
     free (dout);
     free (lnoise);
-    wave_free (wave);
-    wt_free (wt);
 }
 
 void sureshrink (double *signal, int N, int J, const char *wname, const char *method,
     const char *ext, const char *thresh, const char *level, double *denoised)
 {
-    int filt_len, i, it, len, dlen, dwt_len, min_index, sgn, MaxIter, iter;
-    double sigma, norm, td, tv, te, ct, thr, temp, x_sum;
     wave_object wave;
     wt_object wt;
-    double *dout, *risk, *dsum, *lnoise;
 
     wave = wave_init (wname);
+    try
+    {
+        wt = wt_init (wave, method, N, J);
+    }
+    catch (const std::exception &)
+    {
+        wave_free (wave);
+        throw;
+    }
+    if (!strcmp (method, "dwt"))
+    {
+        setDWTExtension (wt, ext);
+    }
+    try
+    {
+        sureshrink_wt (wt, signal, thresh, level, denoised);
+    }
+    catch (const std::exception &)
+    {
+        wave_free (wave);
+        wt_free (wt);
+        throw;
+    }
+    wave_free (wave);
+    wt_free (wt);
+}
 
-    filt_len = wave->filtlength;
+void sureshrink_wt (
+    wt_object wt, double *signal, const char *thresh, const char *level, double *denoised)
+{
+    int filt_len, i, it, len, dlen, dwt_len, min_index, sgn, MaxIter, iter, N, J;
+    double sigma, norm, td, tv, te, ct, thr, temp, x_sum;
+    const char *method;
+    double *dout, *risk, *dsum, *lnoise;
+
+    N = wt->siglength;
+    J = wt->J;
+    method = wt->method;
+    filt_len = wt->wave->filtlength;
 
     MaxIter = (int)(log ((double)N / ((double)filt_len - 1.0)) / log (2.0));
     // Depends on J
     if (J > MaxIter)
     {
-        wave_free (wave);
         throw std::runtime_error ("not enough data points for this wavelet");
     }
 
-    wt = wt_init (wave, method, N, J);
-
     if (!strcmp (method, "dwt"))
     {
-        setDWTExtension (wt, ext);
         dwt (wt, signal);
     }
     else if (!strcmp (method, "swt"))
@@ -204,8 +259,6 @@ void sureshrink (double *signal, int N, int J, const char *wname, const char *me
     }
     else
     {
-        wave_free (wave);
-        wt_free (wt);
         throw std::runtime_error ("unsupported wavelet type");
     }
 
@@ -257,8 +310,6 @@ void sureshrink (double *signal, int N, int J, const char *wname, const char *me
         free (risk);
         free (dsum);
         free (lnoise);
-        wave_free (wave);
-        wt_free (wt);
         throw std::runtime_error ("wrong noise estimation level value");
     }
 
@@ -360,8 +411,6 @@ void sureshrink (double *signal, int N, int J, const char *wname, const char *me
     free (dsum);
     free (risk);
     free (lnoise);
-    wave_free (wave);
-    wt_free (wt);
 }
 
 void modwtshrink (double *signal, int N, int J, const char *wname, const char *cmethod,